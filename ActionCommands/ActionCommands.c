@@ -10,30 +10,10 @@
 #include "ActionCommands.h"
 
 #include <VmbCExamplesCommon/ErrorCodeToMessage.h>
+#include <VmbCExamplesCommon/FeatureCommand.h>
 
 #include <VmbC/VmbC.h>
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <time.h>
-#endif
-
-/**
- * \brief Suspend the execution of the current thread for 100 milliseconds
- */
-void Sleep100Ms(void)
-{
-    #ifdef WIN32
-        Sleep(100);
-    #else
-        struct timespec duration;
-        duration.tv_sec = 0;
-        duration.tv_nsec = 100000000;
-        nanosleep(&duration, NULL);
-    #endif
-}
-
 VmbError_t SendActionCommand(const ActionCommandsOptions* const pOptions, const VmbCameraInfo_t* const pCamera)
 {
     /*
@@ -61,42 +41,26 @@ VmbError_t SendActionCommand(const ActionCommandsOptions* const pOptions, const
         return error;
     }
 
-    // Executing the feature ActionCommand sends the Action Command.
-    error = VmbFeatureCommandRun(handleToUse, "ActionCommand");
-    if (error != VmbErrorSuccess)
-    {
-        printf("Failed to run feature command \"ActionCommand\". Reason: %s", ErrorCodeToMessage(error));
-        return error;
-    }
-
     /*
+    Executing the feature ActionCommand sends the Action Command.
     Based on the used Transport Layer, an acknowledgement of the Action Command may be sent by the camera to the host
     in order to complete the command. It's recommended to query the completion of the Action Command to detect a
     wrong configuration of the related trigger and Action Command features.
     */
-    VmbBool_t actionCmdDone = VmbBoolFalse;
-    size_t    retries = 10;
-    do
+    VmbUint64_t latencyNs = 0;
+    error = RunFeatureCommand(handleToUse, "ActionCommand", FEATURE_COMMAND_DEFAULT_TIMEOUT_MS, &latencyNs);
+    if (error == VmbErrorSuccess)
     {
-        error = VmbFeatureCommandIsDone(handleToUse, "ActionCommand", &actionCmdDone);
-        if (error != VmbErrorSuccess)
-        {
-            printf("Failed to query completion of feature command \"ActionCommand\". Reason: %s", ErrorCodeToMessage(error));
-        }
-        else if (actionCmdDone != VmbBoolTrue)
-        {
-            retries -= 1;
-            Sleep100Ms();
-        }
-    } while ((actionCmdDone != VmbBoolTrue) && (error == VmbErrorSuccess) && (retries > 0));
-
-    if (actionCmdDone == VmbBoolTrue)
+        printf("Sending Action Command succeeded after %.1f us.\n", latencyNs / 1000.0);
+    }
+    else if (error == VmbErrorTimeout)
     {
-        printf("Sending Action Command succeeded.\n");
+        printf("Sending Action Command timed out.\n");
+        error = VmbErrorSuccess;
     }
     else
     {
-        printf("Sending Action Command timed out.\n");
+        printf("Failed to run feature command \"ActionCommand\". Reason: %s\n", ErrorCodeToMessage(error));
     }
 
     return error;
@@ -21,6 +21,14 @@ typedef struct ActionCommandsOptions
     const VmbUint32_t   deviceKey;
     const VmbUint32_t   groupKey;
     const VmbUint32_t   groupMask;
+
+    VmbBool_t           useAllCameras;      //!< Trigger all usable cameras instead of a single one
+    double              scheduledRate;      //!< Number of Action Commands per second sent by a timer thread; 0 for sending on key press
+    VmbUint32_t         scheduledCount;     //!< Number of Action Commands sent by the timer thread
+    VmbUint64_t         frameSetTolerance;  //!< Maximum timestamp difference of the frames of a frame set; 0 for matching the frame ids
+    const char*         benchmarkCsvPath;   //!< File the results of the trigger benchmark are written to; NULL for no benchmark
+    VmbBool_t           benchmarkStub;      //!< Run the trigger benchmark against simulated cameras
+    const char*         transportLayerFilter;   //!< Transport layers to load, see ParseTransportLayerFilter; NULL for all
 } ActionCommandsOptions;
 
 /**
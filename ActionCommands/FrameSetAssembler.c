@@ -0,0 +1,329 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "FrameSetAssembler.h"
+
+#include <VmbCExamplesCommon/MonotonicTime.h>
+
+// Layout of FrameSetSlot::state
+#define STATE_MEMBERS   0xFFFFull           // one bit per camera
+#define STATE_CLAIMED   (1ull << 30)        // the set is being passed to the handler; no more frames may join
+#define STATE_OCCUPIED  (1ull << 31)
+#define STATE_TAG_SHIFT 32                  // lower 32 bits of the key
+
+#define TAG_OF(key)     ((VmbUint64_t)(key) & 0xFFFFFFFFull)
+#define STATE_TAG(s)    ((s) >> STATE_TAG_SHIFT)
+
+VmbError_t FrameSetAssemblerInit(FrameSetAssembler* assembler,
+                                 VmbUint32_t cameraCount,
+                                 VmbUint64_t timestampTolerance,
+                                 VmbUint64_t timeoutNs,
+                                 FrameSetHandler handler,
+                                 FrameSetRelease release,
+                                 void* context)
+{
+    if (cameraCount == 0 || cameraCount > FRAME_SET_MAX_CAMERAS || handler == NULL || release == NULL)
+    {
+        return VmbErrorBadParameter;
+    }
+
+    memset(assembler, 0, sizeof(FrameSetAssembler));
+    assembler->cameraCount = cameraCount;
+    assembler->timestampTolerance = timestampTolerance;
+    assembler->timeoutNs = timeoutNs;
+    assembler->handler = handler;
+    assembler->release = release;
+    assembler->context = context;
+
+    for (VmbUint32_t i = 0; i < FRAME_SET_SLOT_COUNT; i++)
+    {
+        FrameSetSlot* const slot = &assembler->slots[i];
+        atomic_store(&slot->state, 0);
+        atomic_store(&slot->createdNs, 0);
+        atomic_store(&slot->referenceTimestamp, 0);
+        for (VmbUint32_t j = 0; j < FRAME_SET_MAX_CAMERAS; j++)
+        {
+            atomic_store(&slot->frames[j], 0);
+        }
+    }
+    atomic_store(&assembler->setsComplete, 0);
+    atomic_store(&assembler->setsPartial, 0);
+    atomic_store(&assembler->framesLate, 0);
+    atomic_store(&assembler->framesDropped, 0);
+    atomic_store(&assembler->stopExpiry, 0);
+    return VmbErrorSuccess;
+}
+
+/**
+ * \brief Pass a claimed set to the handler, release its frames and free the slot
+ *
+ * \param[in] state the state the set was claimed with
+ */
+static void EmitSet(FrameSetAssembler* assembler, FrameSetSlot* slot, VmbUint64_t state)
+{
+    FrameSet frameSet;
+    memset(&frameSet, 0, sizeof(frameSet));
+    frameSet.key = STATE_TAG(state);
+    frameSet.memberMask = (VmbUint32_t)(state & STATE_MEMBERS);
+    frameSet.complete = (frameSet.memberMask == (1u << assembler->cameraCount) - 1);
+
+    for (VmbUint32_t i = 0; i < assembler->cameraCount; i++)
+    {
+        if (frameSet.memberMask & (1u << i))
+        {
+            // the member may have joined, but not published its frame yet
+            VmbUint64_t frame;
+            while ((frame = atomic_load(&slot->frames[i])) == 0)
+            {
+            }
+            frameSet.frames[i] = (VmbFrame_t*)(uintptr_t)frame;
+            frameSet.receivedNs[i] = slot->receivedNs[i];
+        }
+    }
+
+    assembler->handler(&frameSet, assembler->context);
+    atomic_fetch_add(frameSet.complete ? &assembler->setsComplete : &assembler->setsPartial, 1);
+
+    for (VmbUint32_t i = 0; i < assembler->cameraCount; i++)
+    {
+        if (frameSet.frames[i] != NULL)
+        {
+            atomic_store(&slot->frames[i], 0);
+            assembler->release(i, frameSet.frames[i], assembler->context);
+        }
+    }
+    atomic_store(&slot->createdNs, 0);
+    atomic_store(&slot->referenceTimestamp, 0);
+    atomic_store(&slot->state, 0);
+}
+
+/**
+ * \brief Claim an unclaimed set and pass it to the handler
+ *
+ * \return false, if the state changed since it was read, e.g. because another thread claimed the set first
+ */
+static VmbBool_t TryEmitSet(FrameSetAssembler* assembler, FrameSetSlot* slot, VmbUint64_t state)
+{
+    if (!(state & STATE_OCCUPIED) || (state & STATE_CLAIMED)
+        || !atomic_compare_exchange_strong(&slot->state, &state, state | STATE_CLAIMED))
+    {
+        return VmbBoolFalse;
+    }
+    EmitSet(assembler, slot, state);
+    return VmbBoolTrue;
+}
+
+/**
+ * \brief Publish the frame of a camera that joined a set and emit the set, if it is complete now
+ */
+static void PublishFrame(FrameSetAssembler* assembler, FrameSetSlot* slot, VmbUint32_t cameraIndex, VmbFrame_t* frame, VmbUint64_t receivedNs, VmbUint64_t state)
+{
+    slot->receivedNs[cameraIndex] = receivedNs;
+    atomic_store(&slot->frames[cameraIndex], (VmbUint64_t)(uintptr_t)frame);
+
+    VmbUint64_t const allMembers = (1ull << assembler->cameraCount) - 1;
+    while ((state & STATE_MEMBERS) == allMembers && !(state & STATE_CLAIMED))
+    {
+        // the timeout may claim the set concurrently; whoever succeeds emits it
+        if (atomic_compare_exchange_strong(&slot->state, &state, state | STATE_CLAIMED))
+        {
+            EmitSet(assembler, slot, state);
+            return;
+        }
+    }
+}
+
+/**
+ * \brief Try to add the frame to the set with the given key
+ *
+ * \param[in] create    true, if a new set may be created in a free slot
+ *
+ * \return true, if the frame was added or released; false, if the set does not exist and create is false
+ */
+static VmbBool_t TryJoin(FrameSetAssembler* assembler, VmbUint64_t key, VmbBool_t create, VmbUint64_t timestamp,
+                         VmbUint32_t cameraIndex, VmbFrame_t* frame, VmbUint64_t receivedNs)
+{
+    FrameSetSlot* const slot = &assembler->slots[key % FRAME_SET_SLOT_COUNT];
+    VmbUint64_t const member = 1ull << cameraIndex;
+    VmbUint64_t state = atomic_load(&slot->state);
+
+    for (;;)
+    {
+        if (!(state & STATE_OCCUPIED))
+        {
+            if (!create)
+            {
+                return VmbBoolFalse;
+            }
+            VmbUint64_t const created = (TAG_OF(key) << STATE_TAG_SHIFT) | STATE_OCCUPIED | member;
+            if (atomic_compare_exchange_strong(&slot->state, &state, created))
+            {
+                atomic_store(&slot->referenceTimestamp, timestamp);
+                atomic_store(&slot->createdNs, receivedNs);
+                PublishFrame(assembler, slot, cameraIndex, frame, receivedNs, created);
+                return VmbBoolTrue;
+            }
+        }
+        else if (STATE_TAG(state) == TAG_OF(key))
+        {
+            if ((state & STATE_CLAIMED) || (state & member))
+            {
+                // the set was already emitted or the camera sent two frames with the same key
+                atomic_fetch_add(&assembler->framesLate, 1);
+                assembler->release(cameraIndex, frame, assembler->context);
+                return VmbBoolTrue;
+            }
+            if (atomic_compare_exchange_strong(&slot->state, &state, state | member))
+            {
+                PublishFrame(assembler, slot, cameraIndex, frame, receivedNs, state | member);
+                return VmbBoolTrue;
+            }
+        }
+        else if (!create)
+        {
+            return VmbBoolFalse;
+        }
+        else if ((VmbInt32_t)(VmbUint32_t)(STATE_TAG(state) - TAG_OF(key)) > 0)
+        {
+            // the slot is already used by a newer set; the set of the frame must have been emitted
+            atomic_fetch_add(&assembler->framesLate, 1);
+            assembler->release(cameraIndex, frame, assembler->context);
+            return VmbBoolTrue;
+        }
+        else
+        {
+            // The slot is used by an older set, e.g. because a camera stalled; bound the memory by emitting it early.
+            // If another thread claimed it first, the slot is freed soon.
+            TryEmitSet(assembler, slot, state);
+            state = atomic_load(&slot->state);
+        }
+    }
+}
+
+void FrameSetAssemblerAdd(FrameSetAssembler* assembler, VmbUint32_t cameraIndex, VmbFrame_t* frame, VmbUint64_t receivedNs)
+{
+    if (cameraIndex >= assembler->cameraCount)
+    {
+        assembler->release(cameraIndex, frame, assembler->context);
+        return;
+    }
+
+    if (assembler->timestampTolerance == 0)
+    {
+        if (!(frame->receiveFlags & VmbFrameFlagsFrameID))
+        {
+            atomic_fetch_add(&assembler->framesDropped, 1);
+            assembler->release(cameraIndex, frame, assembler->context);
+        }
+        else
+        {
+            // the first frame of every camera is assumed to be triggered by the same command
+            if (!assembler->firstFrameIdKnown[cameraIndex])
+            {
+                assembler->firstFrameId[cameraIndex] = frame->frameID;
+                assembler->firstFrameIdKnown[cameraIndex] = VmbBoolTrue;
+            }
+            VmbUint64_t const triggerIndex = frame->frameID - assembler->firstFrameId[cameraIndex];
+            TryJoin(assembler, triggerIndex, VmbBoolTrue, 0, cameraIndex, frame, receivedNs);
+        }
+    }
+    else if (!(frame->receiveFlags & VmbFrameFlagsTimestamp))
+    {
+        atomic_fetch_add(&assembler->framesDropped, 1);
+        assembler->release(cameraIndex, frame, assembler->context);
+    }
+    else
+    {
+        /*
+        Timestamps within the tolerance are in the same or in adjacent buckets of the size of the tolerance.
+        Join a set of an adjacent bucket, if its first timestamp is close enough, otherwise join or create the set of
+        the own bucket.
+        */
+        VmbUint64_t const timestamp = frame->timestamp;
+        VmbUint64_t const bucket = timestamp / assembler->timestampTolerance;
+        VmbBool_t added = VmbBoolFalse;
+        for (int offset = -1; offset <= 1 && !added; offset += 2)
+        {
+            FrameSetSlot* const slot = &assembler->slots[(bucket + offset) % FRAME_SET_SLOT_COUNT];
+            VmbUint64_t const reference = atomic_load(&slot->referenceTimestamp);
+            VmbUint64_t const difference = (reference > timestamp) ? reference - timestamp : timestamp - reference;
+            if (reference != 0 && difference <= assembler->timestampTolerance)
+            {
+                added = TryJoin(assembler, bucket + offset, VmbBoolFalse, timestamp, cameraIndex, frame, receivedNs);
+            }
+        }
+        if (!added)
+        {
+            TryJoin(assembler, bucket, VmbBoolTrue, timestamp, cameraIndex, frame, receivedNs);
+        }
+    }
+}
+
+/**
+ * \brief Checks for expired sets periodically until the assembler is stopped
+ */
+static int ExpiryThread(void* arg)
+{
+    FrameSetAssembler* const assembler = (FrameSetAssembler*)arg;
+    VmbUint64_t period = assembler->timeoutNs / FRAME_SET_EXPIRY_CHECKS;
+    period = (period < 1000000ull) ? 1000000ull : period;
+
+    // deadlines on a fixed schedule, so the time the handler takes does not accumulate
+    VmbUint64_t nextCheckNs = GetMonotonicTimeNs() + period;
+    while (atomic_load(&assembler->stopExpiry) == 0)
+    {
+        SleepUntilMonotonicNs(nextCheckNs);
+        VmbUint64_t const nowNs = GetMonotonicTimeNs();
+        FrameSetAssemblerExpire(assembler, nowNs);
+        do
+        {
+            nextCheckNs += period;
+        } while (nextCheckNs <= nowNs);
+    }
+    return 0;
+}
+
+VmbError_t FrameSetAssemblerStart(FrameSetAssembler* assembler)
+{
+    atomic_store(&assembler->stopExpiry, 0);
+    return (thrd_create(&assembler->expiryThread, ExpiryThread, assembler) == thrd_success) ? VmbErrorSuccess : VmbErrorResources;
+}
+
+void FrameSetAssemblerStop(FrameSetAssembler* assembler)
+{
+    atomic_store(&assembler->stopExpiry, 1);
+    thrd_join(assembler->expiryThread, NULL);
+}
+
+void FrameSetAssemblerExpire(FrameSetAssembler* assembler, VmbUint64_t nowNs)
+{
+    for (VmbUint32_t i = 0; i < FRAME_SET_SLOT_COUNT; i++)
+    {
+        FrameSetSlot* const slot = &assembler->slots[i];
+        VmbUint64_t const state = atomic_load(&slot->state);
+        VmbUint64_t const createdNs = atomic_load(&slot->createdNs);
+        if ((state & STATE_OCCUPIED) && !(state & STATE_CLAIMED)
+            && createdNs != 0 && nowNs > createdNs && nowNs - createdNs >= assembler->timeoutNs)
+        {
+            TryEmitSet(assembler, slot, state);
+        }
+    }
+}
+
+void FrameSetAssemblerFlush(FrameSetAssembler* assembler)
+{
+    for (VmbUint32_t i = 0; i < FRAME_SET_SLOT_COUNT; i++)
+    {
+        FrameSetSlot* const slot = &assembler->slots[i];
+        VmbUint64_t state = atomic_load(&slot->state);
+        while ((state & STATE_OCCUPIED) && !(state & STATE_CLAIMED) && !TryEmitSet(assembler, slot, state))
+        {
+            state = atomic_load(&slot->state);
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FRAME_SET_ASSEMBLER_H_
+#define FRAME_SET_ASSEMBLER_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#include <VmbCExamplesCommon/VmbStdatomic.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#define FRAME_SET_MAX_CAMERAS   16  //!< Maximum number of cameras contributing to a frame set
+#define FRAME_SET_SLOT_COUNT    64  //!< Maximum number of frame sets assembled at the same time
+#define FRAME_SET_EXPIRY_CHECKS 4   //!< Number of times per timeout the expiry thread checks for sets timing out
+
+/**
+ * \brief Frames of all cameras triggered by the same Action Command
+ */
+typedef struct FrameSet
+{
+    VmbUint64_t         key;                                //!< Trigger index or timestamp bucket of the set (lower 32 bits)
+    VmbUint32_t         memberMask;                         //!< Bit i is set, if the set contains a frame of camera i
+    VmbBool_t           complete;                           //!< True, if every camera contributed a frame
+    VmbFrame_t*         frames[FRAME_SET_MAX_CAMERAS];      //!< The frames indexed by camera; NULL for missing frames
+    VmbUint64_t         receivedNs[FRAME_SET_MAX_CAMERAS];  //!< Time the frames were received at in the time base of GetMonotonicTimeNs
+} FrameSet;
+
+/**
+ * \brief Function called for every complete set and for partial sets timing out
+ *
+ * The frames are released after the function returns.
+ */
+typedef void (*FrameSetHandler)(const FrameSet* frameSet, void* context);
+
+/**
+ * \brief Function returning ownership of a frame to the caller, e.g. to requeue it
+ */
+typedef void (*FrameSetRelease)(VmbUint32_t cameraIndex, VmbFrame_t* frame, void* context);
+
+/**
+ * \brief A frame set under construction
+ *
+ * state contains the lower 32 bits of the key, an occupied and a claimed flag and one bit per camera that joined the
+ * set. Frames join with a compare and swap of state and publish their pointer afterwards. The thread claiming the set
+ * (the one adding the last frame or detecting the timeout) is the only one accessing the slot until it is freed again.
+ */
+typedef struct FrameSetSlot
+{
+    atomic_ullong       state;
+    atomic_ullong       createdNs;                          //!< Arrival of the first frame; 0 while the slot is being initialized
+    atomic_ullong       referenceTimestamp;                 //!< Timestamp of the first frame; only used when keyed by timestamp
+    atomic_ullong       frames[FRAME_SET_MAX_CAMERAS];      //!< Published frame pointers; 0 until the frame is published
+    VmbUint64_t         receivedNs[FRAME_SET_MAX_CAMERAS];
+} FrameSetSlot;
+
+/**
+ * \brief Lock-free assembler matching the frames of multiple cameras
+ *
+ * Frames are matched by their trigger index, i.e. the frame id relative to the first frame id of the camera, or by
+ * their timestamps, if the clocks of the cameras are synchronized, e.g. via PTP. Complete sets are passed to the
+ * handler by the callback thread adding the last frame. Sets not completed within the timeout are passed to the handler
+ * as partial sets by an expiry thread started with ::FrameSetAssemblerStart. It does not depend on frames arriving:
+ * if a camera stops sending, the other cameras may run out of buffers held by partial sets and stop sending as well.
+ *
+ * The memory used is fixed. The frames of a partial set are held until it times out or its slot is needed for a newer
+ * set, so a stalled camera only delays the release of the frames of the other cameras by the timeout and the expiry
+ * check period of a fraction of it.
+ */
+typedef struct FrameSetAssembler
+{
+    VmbUint32_t         cameraCount;
+    VmbUint64_t         timestampTolerance;                 //!< Maximum timestamp difference of frames of a set; 0 for matching by trigger index
+    VmbUint64_t         timeoutNs;
+    FrameSetHandler     handler;
+    FrameSetRelease     release;
+    void*               context;
+
+    VmbBool_t           firstFrameIdKnown[FRAME_SET_MAX_CAMERAS];   //!< Only accessed by the frame callback of the camera
+    VmbUint64_t         firstFrameId[FRAME_SET_MAX_CAMERAS];
+
+    FrameSetSlot        slots[FRAME_SET_SLOT_COUNT];
+
+    atomic_ullong       setsComplete;
+    atomic_ullong       setsPartial;
+    atomic_ullong       framesLate;                         //!< Frames arriving after their set was passed to the handler
+    atomic_ullong       framesDropped;                      //!< Frames without the id or timestamp required for matching
+
+    thrd_t              expiryThread;
+    atomic_ullong       stopExpiry;                         //!< Set to 1 to stop the expiry thread
+} FrameSetAssembler;
+
+/**
+ * \brief Initialize an assembler without pending sets
+ *
+ * \param[out] assembler            the assembler to initialize
+ * \param[in]  cameraCount          the number of cameras contributing to every set; at most ::FRAME_SET_MAX_CAMERAS
+ * \param[in]  timestampTolerance   the maximum difference of the timestamps of a set in camera ticks; 0 for matching by trigger index
+ * \param[in]  timeoutNs            the time after the arrival of the first frame a partial set is passed to the handler
+ * \param[in]  handler              the function called for every set
+ * \param[in]  release              the function called for every frame no longer used by the assembler
+ * \param[in]  context              passed to handler and release
+ *
+ * \return ::VmbErrorBadParameter, if the camera count is not supported
+ */
+VmbError_t FrameSetAssemblerInit(FrameSetAssembler* assembler,
+                                 VmbUint32_t cameraCount,
+                                 VmbUint64_t timestampTolerance,
+                                 VmbUint64_t timeoutNs,
+                                 FrameSetHandler handler,
+                                 FrameSetRelease release,
+                                 void* context);
+
+/**
+ * \brief Add a received frame; the assembler takes ownership of the frame until it calls release
+ *
+ * Must not be called concurrently for the same camera.
+ */
+void FrameSetAssemblerAdd(FrameSetAssembler* assembler, VmbUint32_t cameraIndex, VmbFrame_t* frame, VmbUint64_t receivedNs);
+
+/**
+ * \brief Start the thread passing the sets older than the timeout to the handler
+ *
+ * \return ::VmbErrorResources, if the thread could not be created
+ */
+VmbError_t FrameSetAssemblerStart(FrameSetAssembler* assembler);
+
+/**
+ * \brief Stop the expiry thread started with ::FrameSetAssemblerStart
+ */
+void FrameSetAssemblerStop(FrameSetAssembler* assembler);
+
+/**
+ * \brief Pass all sets older than the timeout to the handler
+ */
+void FrameSetAssemblerExpire(FrameSetAssembler* assembler, VmbUint64_t nowNs);
+
+/**
+ * \brief Pass all pending sets to the handler, e.g. after the acquisition was stopped
+ */
+void FrameSetAssemblerFlush(FrameSetAssembler* assembler);
+
+#endif
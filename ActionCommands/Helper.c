@@ -12,6 +12,7 @@
 #include <VmbCExamplesCommon/ErrorCodeToMessage.h>
 #include <VmbCExamplesCommon/ListCameras.h>
 #include <VmbCExamplesCommon/PrintVmbVersion.h>
+#include <VmbCExamplesCommon/TimedStartup.h>
 
 #include <VmbC/VmbC.h>
 
@@ -50,9 +51,45 @@ VmbError_t FindCamera(const VmbBool_t needsAvtGigETL, const char* const pCameraI
     return error;
 }
 
-VmbError_t StartApi(void)
+VmbError_t FindCameras(const VmbBool_t needsAvtGigETL, VmbCameraInfo_t** const ppCameraInfos, VmbUint32_t* const pCameraCount)
 {
-    const VmbError_t error = VmbStartup(NULL);
+    VmbCameraInfo_t*    pCameras = 0;
+    VmbUint32_t         cameraCount = 0;
+
+    *ppCameraInfos = NULL;
+    *pCameraCount = 0;
+
+    const VmbError_t error = ListCameras(&pCameras, &cameraCount);
+    if (error != VmbErrorSuccess)
+    {
+        return error;
+    }
+
+    // Move the usable cameras to the front of the list
+    VmbUint32_t usableCount = 0;
+    for (VmbUint32_t i = 0; i < cameraCount; i++)
+    {
+        if (CheckCamera(pCameras + i, needsAvtGigETL) == VmbErrorSuccess)
+        {
+            pCameras[usableCount++] = pCameras[i];
+        }
+    }
+
+    if (usableCount == 0)
+    {
+        free(pCameras);
+        return VmbErrorNotFound;
+    }
+
+    *ppCameraInfos = pCameras;
+    *pCameraCount = usableCount;
+
+    return VmbErrorSuccess;
+}
+
+VmbError_t StartApi(const char* transportLayerFilter)
+{
+    const VmbError_t error = TimedStartup(transportLayerFilter, NULL);
     if (error != VmbErrorSuccess)
     {
         return error;
@@ -19,11 +19,24 @@
  */
 VmbError_t FindCamera(const VmbBool_t needsAvtGigETL, const char* const pCameraId, VmbCameraInfo_t* const pCameraInfo);
 
+/**
+ * \brief Searches for all cameras which can be used by this example.
+ *
+ * \param[in]   needsAvtGigETL    Sending Action Commands via the Transport Layer module requires Allied Vision GigE cameras
+ * \param[out]  ppCameraInfos     Array of the found cameras, which must be freed by the caller using free()
+ * \param[out]  pCameraCount      Number of cameras in the array
+ *
+ * \return An error code indicating success or the type of error that occurred. VmbErrorNotFound if no camera can be used.
+ */
+VmbError_t FindCameras(const VmbBool_t needsAvtGigETL, VmbCameraInfo_t** const ppCameraInfos, VmbUint32_t* const pCameraCount);
+
 /**
  * \brief Starts the API and prints version information about the API.
  *
+ * \param[in] transportLayerFilter   The transport layers to load, see ParseTransportLayerFilter; NULL for all
+ *
  * \return An error code indicating success or the type of error that occurred.
  */
-VmbError_t StartApi(void);
+VmbError_t StartApi(const char* transportLayerFilter);
 
 #endif
@@ -10,19 +10,63 @@
 #include "ImageAcquisition.h"
 
 #include <VmbCExamplesCommon/ErrorCodeToMessage.h>
+#include <VmbCExamplesCommon/FeatureCommand.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
 
 #include <VmbC/VmbC.h>
 
 //Number of frame buffers used for streaming
 #define FRAME_COUNT ((size_t)5)
 
-VmbFrame_t g_frames[FRAME_COUNT];
+/**
+ * \brief The frame buffers of a streaming camera
+ */
+typedef struct StreamingCamera
+{
+    VmbHandle_t cameraHandle;
+    VmbFrame_t  frames[FRAME_COUNT];
+} StreamingCamera;
+
+StreamingCamera g_streamingCameras[MAX_STREAMING_CAMERAS];
+
+FrameObserver g_frameObserver = NULL;
+
+void SetFrameObserver(FrameObserver observer)
+{
+    g_frameObserver = observer;
+}
+
+/**
+ * \brief Find the frame buffers of a camera
+ *
+ * \param[in] cameraHandle  Handle of the camera or NULL to find an unused entry
+ */
+StreamingCamera* FindStreamingCamera(const VmbHandle_t cameraHandle)
+{
+    for (size_t i = 0; i < MAX_STREAMING_CAMERAS; i++)
+    {
+        if (g_streamingCameras[i].cameraHandle == cameraHandle)
+        {
+            return &g_streamingCameras[i];
+        }
+    }
+    return NULL;
+}
 
 /**
- * \brief   The used frame callback, which prints information about the received frame
+ * \brief   The used frame callback, which prints information about the received frame or passes it to the frame observer
  */
 void VMB_CALL FrameCallback(const VmbHandle_t cameraHandle, const VmbHandle_t streamHandle, VmbFrame_t* frame)
 {
+    if (g_frameObserver != NULL)
+    {
+        if (!g_frameObserver(cameraHandle, frame, GetMonotonicTimeNs()))
+        {
+            VmbCaptureFrameQueue(cameraHandle, frame, &FrameCallback);
+        }
+        return;
+    }
+
     printf("New frame received - ");
 
     printf("FrameID: ");
@@ -72,7 +116,12 @@ void VMB_CALL FrameCallback(const VmbHandle_t cameraHandle, const VmbHandle_t st
     VmbCaptureFrameQueue(cameraHandle, frame, &FrameCallback);
 }
 
-void AdjustPacketSize(const VmbHandle_t cameraHandle)
+VmbError_t RequeueFrame(const VmbHandle_t cameraHandle, VmbFrame_t* frame)
+{
+    return VmbCaptureFrameQueue(cameraHandle, frame, &FrameCallback);
+}
+
+VmbError_t AdjustPacketSize(const VmbHandle_t cameraHandle)
 {
     //Query the camera information to get the camera's stream handle
     VmbCameraInfo_t info;
@@ -80,29 +129,27 @@ void AdjustPacketSize(const VmbHandle_t cameraHandle)
     if (error != VmbErrorSuccess)
     {
         printf("Could not query camera info. Reason: %s\n", ErrorCodeToMessage(error));
-        return;
+        return VmbErrorSuccess;
     }
 
     const VmbHandle_t stream = info.streamHandles[0];
 
     /*
     Adjust the packet size used during streaming.
-    Ignore any error because the feature is only implemented by the AVT GigE TL.
+    Ignore any error but a timeout because the feature is only implemented by the AVT GigE TL.
     */
 
-    error = VmbFeatureCommandRun(stream, "GVSPAdjustPacketSize");
-    if (error != VmbErrorSuccess)
+    VmbUint64_t latencyNs = 0;
+    error = RunFeatureCommand(stream, "GVSPAdjustPacketSize", FEATURE_COMMAND_ADJUST_PACKET_SIZE_TIMEOUT_MS, &latencyNs);
+    if (error == VmbErrorTimeout)
     {
-        return;
+        printf("GVSPAdjustPacketSize did not complete within %d ms\n", FEATURE_COMMAND_ADJUST_PACKET_SIZE_TIMEOUT_MS);
+        return error;
     }
-
-    // Wait until the packet size adjustment is completed.
-
-    VmbBool_t isCommandDone = VmbBoolFalse;
-    do
+    if (error != VmbErrorSuccess)
     {
-        error = VmbFeatureCommandIsDone(stream, "GVSPAdjustPacketSize", &isCommandDone);
-    } while ((VmbBoolFalse == isCommandDone) && (error == VmbErrorSuccess));
+        return VmbErrorSuccess;
+    }
 
     //Read and print the adjusted packet size
 
@@ -110,20 +157,36 @@ void AdjustPacketSize(const VmbHandle_t cameraHandle)
     error = VmbFeatureIntGet(stream, "GVSPPacketSize", &packetSize);
     if (error != VmbErrorSuccess)
     {
-        return;
+        return VmbErrorSuccess;
     }
 
-    printf("GVSPPacketSize adjusted to: %lld\n", packetSize);
+    printf("GVSPPacketSize adjusted to: %lld (in %.1f ms)\n", packetSize, latencyNs / 1e6);
+    return VmbErrorSuccess;
 }
 
 VmbError_t StartStream(const VmbHandle_t cameraHandle)
 {
-    AdjustPacketSize(cameraHandle);
+    StreamingCamera* const streamingCamera = FindStreamingCamera(NULL);
+    if (streamingCamera == NULL)
+    {
+        printf("Could not start stream. At most %d cameras can stream at the same time.\n", MAX_STREAMING_CAMERAS);
+        return VmbErrorResources;
+    }
+    streamingCamera->cameraHandle = cameraHandle;
+
+    VmbFrame_t* const frames = streamingCamera->frames;
+
+    VmbError_t error = AdjustPacketSize(cameraHandle);
+    if (error != VmbErrorSuccess)
+    {
+        // the packet size may still change
+        return error;
+    }
 
     // Read the current payload size to allocate the correct buffer size
 
     VmbUint32_t payloadSize = 0;
-    VmbError_t error = VmbPayloadSizeGet(cameraHandle, &payloadSize);
+    error = VmbPayloadSizeGet(cameraHandle, &payloadSize);
     if (error != VmbErrorSuccess)
     {
         printf("Could not query payload size. Reason %s\n", ErrorCodeToMessage(error));
@@ -134,14 +197,14 @@ VmbError_t StartStream(const VmbHandle_t cameraHandle)
 
     for (size_t i = 0; (i < FRAME_COUNT) && (error == VmbErrorSuccess); i++)
     {
-        g_frames[i].buffer = malloc((size_t)payloadSize);
-        if (g_frames[i].buffer == NULL)
+        frames[i].buffer = malloc((size_t)payloadSize);
+        if (frames[i].buffer == NULL)
         {
             error = VmbErrorResources;
         }
         else
         {
-            g_frames[i].bufferSize = payloadSize;
+            frames[i].bufferSize = payloadSize;
         }
     }
 
@@ -154,7 +217,7 @@ VmbError_t StartStream(const VmbHandle_t cameraHandle)
     // Announce the frames to the API
     for (size_t i = 0; (i < FRAME_COUNT) && (error == VmbErrorSuccess); i++)
     {
-        error = VmbFrameAnnounce(cameraHandle, &(g_frames[i]), (VmbUint32_t)sizeof(VmbFrame_t));
+        error = VmbFrameAnnounce(cameraHandle, &(frames[i]), (VmbUint32_t)sizeof(VmbFrame_t));
     }
 
     if (error != VmbErrorSuccess)
@@ -174,7 +237,7 @@ VmbError_t StartStream(const VmbHandle_t cameraHandle)
     // Queue the prepared frames
     for (size_t i = 0; (i < FRAME_COUNT) && (error == VmbErrorSuccess); i++)
     {
-        error = VmbCaptureFrameQueue(cameraHandle, &(g_frames[i]), FrameCallback);
+        error = VmbCaptureFrameQueue(cameraHandle, &(frames[i]), FrameCallback);
     }
 
     if (error != VmbErrorSuccess)
@@ -196,6 +259,12 @@ VmbError_t StartStream(const VmbHandle_t cameraHandle)
 
 VmbError_t StopStream(const VmbHandle_t cameraHandle)
 {
+    StreamingCamera* const streamingCamera = FindStreamingCamera(cameraHandle);
+    if (cameraHandle == NULL || streamingCamera == NULL)
+    {
+        return VmbErrorBadHandle;
+    }
+
     // Revert the steps previously done during StartStream
 
     VmbFeatureCommandRun(cameraHandle, "AcquisitionStop");
@@ -214,12 +283,12 @@ VmbError_t StopStream(const VmbHandle_t cameraHandle)
     // Free the allocated frame buffers
     for (size_t i = 0; i < FRAME_COUNT; i++)
     {
-        if (g_frames[i].buffer != NULL)
+        if (streamingCamera->frames[i].buffer != NULL)
         {
-            free(g_frames[i].buffer);
+            free(streamingCamera->frames[i].buffer);
         }
-        memset(&g_frames[i], 0, sizeof(VmbFrame_t));
     }
+    memset(streamingCamera, 0, sizeof(StreamingCamera));
 
     return error;
 }
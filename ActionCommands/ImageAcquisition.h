@@ -8,6 +8,38 @@
 
 #include <VmbC/VmbCTypeDefinitions.h>
 
+//Maximum number of cameras streaming at the same time
+#define MAX_STREAMING_CAMERAS 16
+
+/**
+ * \brief Function called for every received frame instead of printing information about the frame
+ *
+ * \param[in] cameraHandle  Handle of the camera the frame was received from
+ * \param[in] frame         The received frame
+ * \param[in] receivedNs    Time the frame callback was entered at in the time base of GetMonotonicTimeNs
+ *
+ * \return VmbBoolTrue, if the observer keeps the frame and requeues it later using RequeueFrame;
+ *         VmbBoolFalse, if the frame is requeued after the function returns
+ */
+typedef VmbBool_t (*FrameObserver)(const VmbHandle_t cameraHandle, VmbFrame_t* frame, VmbUint64_t receivedNs);
+
+/**
+ * \brief Sets the function called for every received frame.
+ *
+ * \param[in] observer  The function to call or NULL to print information about every frame
+ */
+void SetFrameObserver(FrameObserver observer);
+
+/**
+ * \brief Queues a frame kept by the frame observer again.
+ *
+ * \param[in] cameraHandle  Handle of the camera the frame was received from
+ * \param[in] frame         The frame to queue
+ *
+ * \return An error code indicating success or the type of error that occurred.
+ */
+VmbError_t RequeueFrame(const VmbHandle_t cameraHandle, VmbFrame_t* frame);
+
 /**
  * \brief Prepares and starts the stream.
  *
@@ -0,0 +1,442 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ScheduledActions.h"
+#include "Helper.h"
+#include "ImageAcquisition.h"
+
+#include <VmbCExamplesCommon/CameraClock.h>
+#include <VmbCExamplesCommon/ClockDriftEstimator.h>
+#include <VmbCExamplesCommon/ErrorCodeToMessage.h>
+#include <VmbCExamplesCommon/Histogram.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#include <VmbC/VmbC.h>
+
+#define START_DELAY_NS          200000000ull    // time between starting the timer thread and the first Action Command
+#define MAX_SCHEDULE_LEAD_NS    10000000ull     // time a scheduled Action Command is sent before its action time
+#define SETTLE_TIME_NS          500000000ull    // time frames are recorded after the last action time
+#define HISTOGRAM_BUCKETS       24
+#define PI                      3.14159265358979323846
+
+/**
+ * \brief The frames recorded for one camera
+ */
+typedef struct CameraRecord
+{
+    VmbHandle_t         cameraHandle;
+    const char*         cameraId;
+    double              nsPerTick;          //!< Duration of a tick of the frame timestamps
+    ClockDriftEstimator estimator;          //!< Maps the frame timestamps to host time, if the commands are not scheduled
+
+    VmbUint64_t*        frameTimestamps;    //!< Timestamps of the complete frames received
+    VmbUint32_t         frameCount;
+    VmbUint32_t         frameCapacity;
+    VmbUint64_t         framesDiscarded;    //!< Incomplete frames, frames without timestamp and frames exceeding the capacity
+} CameraRecord;
+
+/**
+ * \brief The times the Action Commands are sent and executed at
+ */
+typedef struct ActionSchedule
+{
+    VmbHandle_t     senderHandle;           //!< Transport Layer or Interface handle used to send the Action Commands
+    VmbBool_t       useScheduledTime;       //!< True, if ActionScheduledTime is set for every command
+    VmbUint32_t     commandCount;
+    VmbUint64_t     periodNs;
+    VmbUint64_t     leadNs;                 //!< Time between sending a command and its action time
+    VmbUint64_t*    actionHostNs;           //!< Action time of every command in the time base of GetMonotonicTimeNs
+    VmbUint64_t*    actionTicks;            //!< Action time of every command in the time base of the cameras
+
+    VmbUint32_t     commandsFailed;
+    VmbUint64_t     sumLatenessNs;          //!< Sum of the times the timer thread woke up too late
+    VmbUint64_t     maxLatenessNs;
+} ActionSchedule;
+
+static ActionSchedule   g_schedule;
+static CameraRecord     g_cameraRecords[MAX_STREAMING_CAMERAS];
+static VmbUint32_t      g_cameraRecordCount = 0;
+static mtx_t            g_recordMutex;          // protects the camera records while recording
+static VmbBool_t        g_recording = VmbBoolFalse;
+
+/**
+ * \brief Frame observer storing the timestamps of the received frames
+ */
+static VmbBool_t RecordFrame(const VmbHandle_t cameraHandle, VmbFrame_t* frame, VmbUint64_t receivedNs)
+{
+    CameraRecord* record = NULL;
+    for (VmbUint32_t i = 0; i < g_cameraRecordCount && record == NULL; i++)
+    {
+        record = (g_cameraRecords[i].cameraHandle == cameraHandle) ? &g_cameraRecords[i] : NULL;
+    }
+    if (record == NULL)
+    {
+        return VmbBoolFalse;
+    }
+
+    mtx_lock(&g_recordMutex);
+    if (g_recording)
+    {
+        if (frame->receiveStatus == VmbFrameStatusComplete
+            && (frame->receiveFlags & VmbFrameFlagsTimestamp)
+            && record->frameCount < record->frameCapacity)
+        {
+            record->frameTimestamps[record->frameCount++] = frame->timestamp;
+            ClockDriftEstimatorAddSample(&record->estimator, frame->timestamp, receivedNs);
+        }
+        else
+        {
+            ++record->framesDiscarded;
+        }
+    }
+    mtx_unlock(&g_recordMutex);
+    return VmbBoolFalse;
+}
+
+/**
+ * \brief Thread sending the Action Commands according to the schedule
+ */
+static int TimerThread(void* arg)
+{
+    ActionSchedule* const schedule = (ActionSchedule*)arg;
+
+    for (VmbUint32_t i = 0; i < schedule->commandCount; i++)
+    {
+        VmbUint64_t const sendNs = schedule->actionHostNs[i] - schedule->leadNs;
+        SleepUntilMonotonicNs(sendNs);
+
+        VmbUint64_t const now = GetMonotonicTimeNs();
+        VmbUint64_t const latenessNs = (now > sendNs) ? now - sendNs : 0;
+        schedule->sumLatenessNs += latenessNs;
+        schedule->maxLatenessNs = (latenessNs > schedule->maxLatenessNs) ? latenessNs : schedule->maxLatenessNs;
+
+        VmbError_t error = VmbErrorSuccess;
+        if (schedule->useScheduledTime)
+        {
+            error = VmbFeatureIntSet(schedule->senderHandle, "ActionScheduledTime", (VmbInt64_t)schedule->actionTicks[i]);
+        }
+        if (error == VmbErrorSuccess)
+        {
+            error = VmbFeatureCommandRun(schedule->senderHandle, "ActionCommand");
+        }
+        if (error != VmbErrorSuccess)
+        {
+            ++schedule->commandsFailed;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief Index of the action time closest to a frame timestamp
+ */
+static VmbUint32_t FindClosestAction(const ActionSchedule* const schedule, const VmbUint64_t timestamp)
+{
+    VmbUint32_t first = 0;
+    VmbUint32_t last = schedule->commandCount - 1;
+    while (first < last)
+    {
+        VmbUint32_t const middle = first + (last - first) / 2;
+        if (schedule->actionTicks[middle] < timestamp)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    if (first > 0 && timestamp - schedule->actionTicks[first - 1] < schedule->actionTicks[first] - timestamp)
+    {
+        --first;
+    }
+    return first;
+}
+
+/**
+ * \brief Deviations of the frames of a camera from the action times
+ *
+ * \param[in]  record           The frames of the camera
+ * \param[out] deviationsUs     One deviation per frame
+ * \param[out] pTriggeredCount  Number of Action Commands at least one frame was matched to
+ *
+ * \return the number of deviations written
+ */
+static VmbUint32_t ComputeScheduledDeviations(const CameraRecord* const record, double* const deviationsUs, VmbUint32_t* const pTriggeredCount)
+{
+    VmbInt64_t lastAction = -1;
+    *pTriggeredCount = 0;
+
+    for (VmbUint32_t i = 0; i < record->frameCount; i++)
+    {
+        VmbUint32_t const action = FindClosestAction(&g_schedule, record->frameTimestamps[i]);
+        double const deviationTicks = (double)(VmbInt64_t)(record->frameTimestamps[i] - g_schedule.actionTicks[action]);
+        deviationsUs[i] = deviationTicks * record->nsPerTick / 1000.0;
+
+        *pTriggeredCount += ((VmbInt64_t)action != lastAction) ? 1 : 0;
+        lastAction = (VmbInt64_t)action;
+    }
+    return record->frameCount;
+}
+
+/**
+ * \brief Deviations of the frames of a camera from the send schedule relative to the mean latency of the camera
+ *
+ * The frame timestamps are converted to host time. Their phase relative to the send period is compared to the
+ * circular mean of the phases of all frames, which does not require knowing which command triggered a frame.
+ *
+ * \return the number of deviations written
+ */
+static VmbUint32_t ComputeImmediateDeviations(const CameraRecord* const record, double* const deviationsUs)
+{
+    double const period = (double)g_schedule.periodNs;
+    double sumSin = 0.0;
+    double sumCos = 0.0;
+    VmbUint32_t count = 0;
+
+    for (VmbUint32_t i = 0; i < record->frameCount; i++)
+    {
+        VmbUint64_t hostNs = 0;
+        if (ClockDriftEstimatorToHostNs(&record->estimator, record->frameTimestamps[i], &hostNs))
+        {
+            double const phase = fmod((double)(VmbInt64_t)(hostNs - g_schedule.actionHostNs[0]), period);
+            deviationsUs[count++] = phase;
+            sumSin += sin(2.0 * PI * phase / period);
+            sumCos += cos(2.0 * PI * phase / period);
+        }
+    }
+
+    double const meanPhase = atan2(sumSin, sumCos) / (2.0 * PI) * period;
+    for (VmbUint32_t i = 0; i < count; i++)
+    {
+        double deviation = fmod(deviationsUs[i] - meanPhase, period);
+        deviation += (deviation < -period / 2.0) ? period : 0.0;
+        deviation -= (deviation >= period / 2.0) ? period : 0.0;
+        deviationsUs[i] = deviation / 1000.0;
+    }
+    return count;
+}
+
+static void PrintResults(void)
+{
+    printf("\nSent %u Action Commands every %.3f ms (%u failed), timer thread woke up %.1f us late on average, %.1f us at most\n",
+           g_schedule.commandCount,
+           g_schedule.periodNs / 1e6,
+           g_schedule.commandsFailed,
+           g_schedule.sumLatenessNs / 1000.0 / g_schedule.commandCount,
+           g_schedule.maxLatenessNs / 1000.0);
+
+    VmbUint32_t totalFrames = 0;
+    for (VmbUint32_t i = 0; i < g_cameraRecordCount; i++)
+    {
+        totalFrames += g_cameraRecords[i].frameCount;
+    }
+
+    double* const deviationsUs = (double*)malloc(sizeof(double) * (totalFrames + 1));
+    if (deviationsUs == NULL)
+    {
+        printf("Could not allocate memory for the evaluation.\n");
+        return;
+    }
+
+    // Deviations of all cameras are stored consecutively to build the histogram of the whole rig afterwards
+    VmbUint32_t deviationCount = 0;
+    for (VmbUint32_t i = 0; i < g_cameraRecordCount; i++)
+    {
+        const CameraRecord* const record = &g_cameraRecords[i];
+        double* const cameraDeviations = deviationsUs + deviationCount;
+
+        VmbUint32_t triggeredCount = 0;
+        VmbUint32_t const count = g_schedule.useScheduledTime
+            ? ComputeScheduledDeviations(record, cameraDeviations, &triggeredCount)
+            : ComputeImmediateDeviations(record, cameraDeviations);
+        deviationCount += count;
+
+        RunningStatistics cameraStatistics;
+        RunningStatisticsInit(&cameraStatistics);
+        for (VmbUint32_t j = 0; j < count; j++)
+        {
+            RunningStatisticsAdd(&cameraStatistics, cameraDeviations[j]);
+        }
+
+        printf("\nCamera %s: %u frames, %llu discarded", record->cameraId, record->frameCount, record->framesDiscarded);
+        if (g_schedule.useScheduledTime)
+        {
+            printf(", %u of %u Action Commands triggered a frame", triggeredCount, g_schedule.commandCount);
+        }
+        else
+        {
+            printf(", clock drift %.3f ppm", ClockDriftEstimatorDriftPpm(&record->estimator));
+        }
+        printf("\n    deviation mean %.3f us, std dev %.3f us, min %.3f us, max %.3f us\n",
+               RunningStatisticsMean(&cameraStatistics),
+               RunningStatisticsStdDev(&cameraStatistics),
+               cameraStatistics.min,
+               cameraStatistics.max);
+    }
+
+    if (deviationCount != 0)
+    {
+        double min = deviationsUs[0];
+        double max = deviationsUs[0];
+        for (VmbUint32_t i = 1; i < deviationCount; i++)
+        {
+            min = (deviationsUs[i] < min) ? deviationsUs[i] : min;
+            max = (deviationsUs[i] > max) ? deviationsUs[i] : max;
+        }
+
+        Histogram rigHistogram;
+        HistogramInit(&rigHistogram, floor(min), ceil(max + 1e-3), HISTOGRAM_BUCKETS);
+        for (VmbUint32_t i = 0; i < deviationCount; i++)
+        {
+            HistogramAdd(&rigHistogram, deviationsUs[i]);
+        }
+
+        printf("\nTrigger jitter of all cameras (%s):\n", g_schedule.useScheduledTime
+               ? "frame timestamp - ActionScheduledTime"
+               : "frame timestamp relative to the send schedule and the mean latency of each camera");
+        HistogramPrint(&rigHistogram, "us");
+    }
+
+    free(deviationsUs);
+}
+
+/**
+ * \brief Decide how the commands are sent and compute the action times
+ */
+static VmbError_t PrepareSchedule(const ActionCommandsOptions* const pOptions, const VmbHandle_t referenceCamera, const VmbUint64_t startNs)
+{
+    g_schedule.periodNs = (VmbUint64_t)(1e9 / pOptions->scheduledRate);
+    g_schedule.leadNs = 0;
+
+    // The action times are only meaningful, if the camera time can be related to the host time
+    VmbUint64_t latchTicks = 0;
+    VmbUint64_t latchHostNs = 0;
+    g_schedule.useScheduledTime =
+        VmbErrorSuccess == VmbFeatureBoolSet(g_schedule.senderHandle, "ActionScheduledTimeEnable", VmbBoolTrue)
+        && VmbErrorSuccess == LatchCameraTime(referenceCamera, &latchTicks, &latchHostNs, NULL);
+
+    if (g_schedule.useScheduledTime)
+    {
+        g_schedule.leadNs = (g_schedule.periodNs / 2 < MAX_SCHEDULE_LEAD_NS) ? g_schedule.periodNs / 2 : MAX_SCHEDULE_LEAD_NS;
+        printf("Sending Action Commands %.3f ms before their ActionScheduledTime\n", g_schedule.leadNs / 1e6);
+    }
+    else
+    {
+        VmbFeatureBoolSet(g_schedule.senderHandle, "ActionScheduledTimeEnable", VmbBoolFalse);
+        printf("ActionScheduledTime not supported, sending Action Commands for immediate execution\n");
+    }
+
+    double const nsPerTick = GetTimestampNsPerTick(referenceCamera);
+    for (VmbUint32_t i = 0; i < g_schedule.commandCount; i++)
+    {
+        g_schedule.actionHostNs[i] = startNs + g_schedule.leadNs + i * g_schedule.periodNs;
+        g_schedule.actionTicks[i] = latchTicks + (VmbUint64_t)llround((double)(g_schedule.actionHostNs[i] - latchHostNs) / nsPerTick);
+    }
+    return VmbErrorSuccess;
+}
+
+VmbError_t RunScheduledActionCommands(const ActionCommandsOptions* const pOptions, const VmbCameraInfo_t* const pCameras, const VmbHandle_t* const pCameraHandles, const VmbUint32_t cameraCount)
+{
+    if (cameraCount == 0 || cameraCount > MAX_STREAMING_CAMERAS || pOptions->scheduledRate <= 0.0 || pOptions->scheduledCount == 0)
+    {
+        return VmbErrorBadParameter;
+    }
+
+    memset(&g_schedule, 0, sizeof(g_schedule));
+    memset(g_cameraRecords, 0, sizeof(g_cameraRecords));
+
+    /*
+    The AVT GigE TL sends the Action Commands on all interfaces if the Transport Layer module is used.
+    Otherwise the cameras need to be connected to the interface of the first camera.
+    */
+    g_schedule.senderHandle = (pOptions->useAllInterfaces) ? pCameras[0].transportLayerHandle : pCameras[0].interfaceHandle;
+    g_schedule.commandCount = pOptions->scheduledCount;
+    g_schedule.actionHostNs = (VmbUint64_t*)malloc(sizeof(VmbUint64_t) * g_schedule.commandCount);
+    g_schedule.actionTicks = (VmbUint64_t*)malloc(sizeof(VmbUint64_t) * g_schedule.commandCount);
+
+    VmbError_t error = (g_schedule.actionHostNs != NULL && g_schedule.actionTicks != NULL) ? VmbErrorSuccess : VmbErrorResources;
+
+    // Allow some frames more than commands, e.g. if a camera is also triggered by another application
+    for (VmbUint32_t i = 0; i < cameraCount && error == VmbErrorSuccess; i++)
+    {
+        CameraRecord* const record = &g_cameraRecords[i];
+        record->cameraHandle = pCameraHandles[i];
+        record->cameraId = pCameras[i].cameraIdString;
+        record->nsPerTick = GetTimestampNsPerTick(pCameraHandles[i]);
+        ClockDriftEstimatorInit(&record->estimator, (VmbUint64_t)llround(1e9 / record->nsPerTick));
+        record->frameCapacity = g_schedule.commandCount + g_schedule.commandCount / 4 + 1;
+        record->frameTimestamps = (VmbUint64_t*)malloc(sizeof(VmbUint64_t) * record->frameCapacity);
+        error = (record->frameTimestamps != NULL) ? VmbErrorSuccess : VmbErrorResources;
+    }
+    g_cameraRecordCount = cameraCount;
+
+    if (error == VmbErrorSuccess)
+    {
+        error = PrepareActionCommand(g_schedule.senderHandle, pOptions);
+    }
+
+    thrd_t timerThread;
+    if (error == VmbErrorSuccess && mtx_init(&g_recordMutex, mtx_plain) == thrd_success)
+    {
+        error = PrepareSchedule(pOptions, pCameraHandles[0], GetMonotonicTimeNs() + START_DELAY_NS);
+
+        printf("Sending %u Action Commands at %.3f Hz to %u camera(s)...\n", g_schedule.commandCount, pOptions->scheduledRate, cameraCount);
+
+        mtx_lock(&g_recordMutex);
+        g_recording = VmbBoolTrue;
+        mtx_unlock(&g_recordMutex);
+        SetFrameObserver(RecordFrame);
+
+        if (thrd_create(&timerThread, TimerThread, &g_schedule) == thrd_success)
+        {
+            thrd_join(timerThread, NULL);
+
+            // Wait for the frames triggered by the last commands
+            SleepUntilMonotonicNs(g_schedule.actionHostNs[g_schedule.commandCount - 1] + SETTLE_TIME_NS);
+        }
+        else
+        {
+            printf("Could not start the timer thread.\n");
+            error = VmbErrorResources;
+        }
+
+        mtx_lock(&g_recordMutex);
+        g_recording = VmbBoolFalse;
+        mtx_unlock(&g_recordMutex);
+        SetFrameObserver(NULL);
+
+        if (error == VmbErrorSuccess)
+        {
+            PrintResults();
+        }
+
+        if (g_schedule.useScheduledTime)
+        {
+            VmbFeatureBoolSet(g_schedule.senderHandle, "ActionScheduledTimeEnable", VmbBoolFalse);
+        }
+        mtx_destroy(&g_recordMutex);
+    }
+    else if (error == VmbErrorSuccess)
+    {
+        error = VmbErrorResources;
+    }
+
+    for (VmbUint32_t i = 0; i < cameraCount; i++)
+    {
+        free(g_cameraRecords[i].frameTimestamps);
+    }
+    g_cameraRecordCount = 0;
+    free(g_schedule.actionHostNs);
+    free(g_schedule.actionTicks);
+
+    return error;
+}
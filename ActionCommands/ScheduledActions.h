@@ -0,0 +1,31 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef SCHEDULED_ACTIONS_H_
+#define SCHEDULED_ACTIONS_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#include "ActionCommands.h"
+
+/**
+ * \brief Send Action Commands at a fixed rate from a timer thread and print the trigger jitter of all cameras
+ *
+ * The Action Commands are sent as broadcast to the group configured by the options. If the Transport Layer supports
+ * ActionScheduledTime, every command is sent ahead of time and executed by the cameras at the scheduled time; the
+ * deviation of the frame timestamps from this time is reported. This requires cameras with synchronized clocks, e.g.
+ * via PTP. Otherwise the commands are executed immediately and the jitter of the frame timestamps relative to the
+ * send schedule is reported.
+ *
+ * \param[in] pOptions          Provided command line options and details for the Action Command
+ * \param[in] pCameras          Information about the used cameras
+ * \param[in] pCameraHandles    Handles of the used cameras, which must be prepared for Action Commands and streaming
+ * \param[in] cameraCount       Number of cameras
+ *
+ * \return An error code indicating success or the type of error that occurred.
+ */
+VmbError_t RunScheduledActionCommands(const ActionCommandsOptions* const pOptions, const VmbCameraInfo_t* const pCameras, const VmbHandle_t* const pCameraHandles, const VmbUint32_t cameraCount);
+
+#endif
@@ -0,0 +1,651 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "TriggerBenchmark.h"
+#include "Helper.h"
+#include "ImageAcquisition.h"
+
+#include <VmbCExamplesCommon/CameraClock.h>
+#include <VmbCExamplesCommon/ErrorCodeToMessage.h>
+#include <VmbCExamplesCommon/FeatureCommand.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#include <VmbC/VmbC.h>
+
+#define START_RATE_HZ           10.0
+#define RATE_FACTOR             1.5
+#define MAX_RATE_HZ             100000.0
+#define STEP_DURATION_NS        1000000000ull   // time every rate is kept
+#define MIN_STEP_COMMANDS       20
+#define MAX_STEP_COMMANDS       20000
+#define START_DELAY_NS          50000000ull     // time between the start of a step and its first command
+#define SETTLE_TIME_NS          300000000ull    // time frames are recorded after the last command of a step
+#define COMMAND_TIMEOUT_MS      100
+#define STOP_LOSS               0.2             // loss ending the benchmark
+#define MIN_ACHIEVED_RATE       0.8             // fraction of the requested rate the commands need to be sent at
+
+// Behavior of the simulated cameras
+#define STUB_CAMERA_COUNT       4
+#define STUB_ACK_LATENCY_NS     30000ull        // time until the completion of a command is reported
+#define STUB_TRIGGER_DELAY_NS   20000ull        // time between sending a command and the start of the exposure
+#define STUB_FRAME_LATENCY_NS   1500000ull      // time between the start of the exposure and the frame callback
+#define STUB_JITTER_NS          200000ull       // maximum additional random delay of a frame
+#define STUB_BUSY_NS            2000000ull      // commands received within this time after a trigger are ignored
+#define STUB_QUEUE_SIZE         64              // frames in transit; frames exceeding the queue are lost
+
+/**
+ * \brief A complete frame received during a step
+ */
+typedef struct FrameSample
+{
+    VmbUint64_t     timestamp;              //!< Frame timestamp in camera ticks
+    VmbBool_t       hasTimestamp;
+    VmbUint64_t     receivedNs;             //!< Time the frame callback was entered at
+} FrameSample;
+
+/**
+ * \brief The frames received from one camera during a step
+ */
+typedef struct BenchmarkCamera
+{
+    VmbHandle_t     cameraHandle;           //!< NULL for the simulated cameras
+    const char*     cameraId;
+    double          nsPerTick;
+
+    VmbBool_t       latched;                //!< True, if the camera time could be related to the host time for the step
+    VmbUint64_t     latchTicks;
+    VmbUint64_t     latchHostNs;
+    VmbUint64_t     latchUncertaintyNs;
+
+    FrameSample*    frames;
+    VmbUint32_t     frameCount;
+    VmbUint32_t     frameCapacity;
+    VmbUint32_t     framesIncomplete;       //!< Incomplete frames and frames exceeding the capacity
+} BenchmarkCamera;
+
+/**
+ * \brief The results of a single rate
+ */
+typedef struct StepResult
+{
+    double          rateHz;
+    double          achievedRateHz;         //!< Rate the commands were actually sent at
+    VmbUint32_t     commandsSent;
+    VmbUint32_t     commandsFailed;         //!< Commands not completed within the timeout
+    VmbUint32_t     framesExpected;
+    VmbUint32_t     framesMatched;
+    VmbUint32_t     framesIncomplete;       //!< Incomplete frames and frames exceeding the capacity of all cameras
+    double          loss;
+    double          ackUs[3];               //!< Median, 99th percentile and maximum of the acknowledgement latencies
+    double          latencyUs[4];           //!< Median, 90th, 99th percentile and maximum of the trigger to frame latencies
+} StepResult;
+
+/**
+ * \brief A simulated camera delivering the frames triggered by the commands from its own thread
+ */
+typedef struct StubCamera
+{
+    VmbUint32_t     index;
+    mtx_t           mutex;                  // protects the queue and stop
+    cnd_t           condition;
+    VmbUint64_t     queueTimestamps[STUB_QUEUE_SIZE];
+    VmbUint64_t     queueDeliveryNs[STUB_QUEUE_SIZE];
+    VmbUint32_t     queueHead;
+    VmbUint32_t     queueCount;
+    VmbBool_t       stop;
+    VmbUint64_t     busyUntilNs;            // only accessed by the sending thread
+    thrd_t          thread;
+} StubCamera;
+
+static BenchmarkCamera  g_cameras[MAX_STREAMING_CAMERAS];
+static VmbUint32_t      g_cameraCount = 0;
+static mtx_t            g_recordMutex;          // protects the camera records while recording
+static VmbBool_t        g_recording = VmbBoolFalse;
+static VmbHandle_t      g_senderHandle = NULL;  // NULL if the commands are sent to the simulated cameras
+static StubCamera       g_stubCameras[STUB_CAMERA_COUNT];
+
+/**
+ * \brief Store a frame of the camera with the given index
+ */
+static void RecordFrame(const VmbUint32_t cameraIndex, const VmbBool_t complete, const VmbBool_t hasTimestamp, const VmbUint64_t timestamp, const VmbUint64_t receivedNs)
+{
+    BenchmarkCamera* const camera = &g_cameras[cameraIndex];
+
+    mtx_lock(&g_recordMutex);
+    if (g_recording)
+    {
+        if (complete && camera->frameCount < camera->frameCapacity)
+        {
+            FrameSample* const sample = &camera->frames[camera->frameCount++];
+            sample->timestamp = timestamp;
+            sample->hasTimestamp = hasTimestamp;
+            sample->receivedNs = receivedNs;
+        }
+        else
+        {
+            ++camera->framesIncomplete;
+        }
+    }
+    mtx_unlock(&g_recordMutex);
+}
+
+/**
+ * \brief Frame observer recording the frames of the real cameras
+ */
+static VmbBool_t BenchmarkFrame(const VmbHandle_t cameraHandle, VmbFrame_t* frame, VmbUint64_t receivedNs)
+{
+    for (VmbUint32_t i = 0; i < g_cameraCount; i++)
+    {
+        if (g_cameras[i].cameraHandle == cameraHandle)
+        {
+            RecordFrame(i,
+                        frame->receiveStatus == VmbFrameStatusComplete,
+                        (frame->receiveFlags & VmbFrameFlagsTimestamp) ? VmbBoolTrue : VmbBoolFalse,
+                        frame->timestamp,
+                        receivedNs);
+            break;
+        }
+    }
+    return VmbBoolFalse;
+}
+
+/**
+ * \brief Thread of a simulated camera passing the queued frames to RecordFrame at their delivery time
+ */
+static int StubCameraThread(void* arg)
+{
+    StubCamera* const camera = (StubCamera*)arg;
+
+    mtx_lock(&camera->mutex);
+    for (;;)
+    {
+        while (!camera->stop && camera->queueCount == 0)
+        {
+            cnd_wait(&camera->condition, &camera->mutex);
+        }
+        if (camera->queueCount == 0)
+        {
+            break;
+        }
+
+        VmbUint64_t const timestamp = camera->queueTimestamps[camera->queueHead];
+        VmbUint64_t const deliveryNs = camera->queueDeliveryNs[camera->queueHead];
+        mtx_unlock(&camera->mutex);
+
+        // frames are delivered in order, as a real stream does
+        SleepUntilMonotonicNs(deliveryNs);
+        RecordFrame(camera->index, VmbBoolTrue, VmbBoolTrue, timestamp, GetMonotonicTimeNs());
+
+        mtx_lock(&camera->mutex);
+        camera->queueHead = (camera->queueHead + 1) % STUB_QUEUE_SIZE;
+        --camera->queueCount;
+    }
+    mtx_unlock(&camera->mutex);
+    return 0;
+}
+
+/**
+ * \brief Pass a command to all simulated cameras and wait for the simulated acknowledgement
+ */
+static VmbError_t StubSendCommand(const VmbUint64_t sendNs, VmbUint64_t* const pAckLatencyNs)
+{
+    for (VmbUint32_t i = 0; i < STUB_CAMERA_COUNT; i++)
+    {
+        StubCamera* const camera = &g_stubCameras[i];
+        if (sendNs < camera->busyUntilNs)
+        {
+            continue;
+        }
+        camera->busyUntilNs = sendNs + STUB_BUSY_NS;
+
+        // the timestamps of the simulated cameras are in the time base of GetMonotonicTimeNs
+        VmbUint64_t const timestamp = sendNs + STUB_TRIGGER_DELAY_NS;
+        VmbUint64_t const jitterNs = (VmbUint64_t)rand() % STUB_JITTER_NS;
+
+        mtx_lock(&camera->mutex);
+        if (camera->queueCount < STUB_QUEUE_SIZE)
+        {
+            VmbUint32_t const tail = (camera->queueHead + camera->queueCount) % STUB_QUEUE_SIZE;
+            camera->queueTimestamps[tail] = timestamp;
+            camera->queueDeliveryNs[tail] = timestamp + STUB_FRAME_LATENCY_NS + jitterNs;
+            ++camera->queueCount;
+            cnd_signal(&camera->condition);
+        }
+        mtx_unlock(&camera->mutex);
+    }
+
+    SleepUntilMonotonicNs(sendNs + STUB_ACK_LATENCY_NS);
+    *pAckLatencyNs = GetMonotonicTimeNs() - sendNs;
+    return VmbErrorSuccess;
+}
+
+/**
+ * \brief Start the threads of the simulated cameras
+ */
+static VmbError_t StartStubCameras(void)
+{
+    for (VmbUint32_t i = 0; i < STUB_CAMERA_COUNT; i++)
+    {
+        StubCamera* const camera = &g_stubCameras[i];
+        memset(camera, 0, sizeof(StubCamera));
+        camera->index = i;
+
+        if (mtx_init(&camera->mutex, mtx_plain) != thrd_success)
+        {
+            return VmbErrorResources;
+        }
+        if (cnd_init(&camera->condition) != thrd_success)
+        {
+            mtx_destroy(&camera->mutex);
+            return VmbErrorResources;
+        }
+        if (thrd_create(&camera->thread, StubCameraThread, camera) != thrd_success)
+        {
+            cnd_destroy(&camera->condition);
+            mtx_destroy(&camera->mutex);
+            return VmbErrorResources;
+        }
+        g_cameraCount = i + 1;
+    }
+    return VmbErrorSuccess;
+}
+
+/**
+ * \brief Stop the threads of the simulated cameras after they delivered the queued frames
+ */
+static void StopStubCameras(void)
+{
+    for (VmbUint32_t i = 0; i < g_cameraCount; i++)
+    {
+        StubCamera* const camera = &g_stubCameras[i];
+        mtx_lock(&camera->mutex);
+        camera->stop = VmbBoolTrue;
+        cnd_signal(&camera->condition);
+        mtx_unlock(&camera->mutex);
+
+        thrd_join(camera->thread, NULL);
+        cnd_destroy(&camera->condition);
+        mtx_destroy(&camera->mutex);
+    }
+}
+
+/**
+ * \brief Send an Action Command and wait for its completion
+ *
+ * \param[in]  sendNs           Time the command is sent at
+ * \param[out] pAckLatencyNs    Time until the completion of the command
+ */
+static VmbError_t SendCommand(const VmbUint64_t sendNs, VmbUint64_t* const pAckLatencyNs)
+{
+    if (g_senderHandle == NULL)
+    {
+        return StubSendCommand(sendNs, pAckLatencyNs);
+    }
+    return RunFeatureCommand(g_senderHandle, "ActionCommand", COMMAND_TIMEOUT_MS, pAckLatencyNs);
+}
+
+static int CompareDoubles(const void* lhs, const void* rhs)
+{
+    double const left = *(const double*)lhs;
+    double const right = *(const double*)rhs;
+    return (left > right) - (left < right);
+}
+
+/**
+ * \brief Nearest rank percentile of sorted values
+ */
+static double Percentile(const double* const sortedValues, const VmbUint32_t count, const double percentile)
+{
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    VmbUint32_t rank = (VmbUint32_t)(percentile / 100.0 * count + 0.999999);
+    rank = (rank == 0) ? 1 : ((rank > count) ? count : rank);
+    return sortedValues[rank - 1];
+}
+
+/**
+ * \brief Index of the last command sent at or before the given time
+ *
+ * \return -1, if all commands were sent later
+ */
+static VmbInt64_t FindTriggeringCommand(const VmbUint64_t* const sendNs, const VmbUint32_t commandCount, const VmbUint64_t timeNs)
+{
+    VmbUint32_t first = 0;
+    VmbUint32_t last = commandCount;
+    while (first < last)
+    {
+        VmbUint32_t const middle = first + (last - first) / 2;
+        if (sendNs[middle] <= timeNs)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return (VmbInt64_t)first - 1;
+}
+
+/**
+ * \brief Match the recorded frames to the commands and compute the loss and the latencies of the step
+ *
+ * \param[in]     sendNs        Time every command was sent at
+ * \param[in]     ackNs         Acknowledgement latency of every command; 0 for failed commands
+ * \param[in]     latencyUs     Buffer for the latencies of all frames
+ * \param[in,out] result        Result with the rate and command counts set
+ */
+static void EvaluateStep(const VmbUint64_t* const sendNs, const VmbUint64_t* const ackNs, double* const latencyUs, StepResult* const result)
+{
+    VmbUint32_t latencyCount = 0;
+    for (VmbUint32_t i = 0; i < g_cameraCount; i++)
+    {
+        const BenchmarkCamera* const camera = &g_cameras[i];
+        VmbInt64_t lastCommand = -1;
+        result->framesIncomplete += camera->framesIncomplete;
+
+        for (VmbUint32_t j = 0; j < camera->frameCount; j++)
+        {
+            /*
+            The exposure starts shortly after the command reached the camera, so the frame belongs to the last command
+            sent before the frame timestamp. Without the camera time, the receive time is used, which is only correct,
+            if the latency is below the period.
+            */
+            const FrameSample* const frame = &camera->frames[j];
+            VmbUint64_t triggerNs = frame->receivedNs;
+            if (camera->latched && frame->hasTimestamp)
+            {
+                double const offsetNs = (double)(VmbInt64_t)(frame->timestamp - camera->latchTicks) * camera->nsPerTick;
+                triggerNs = (VmbUint64_t)((double)camera->latchHostNs + offsetNs) + camera->latchUncertaintyNs;
+            }
+
+            VmbInt64_t const command = FindTriggeringCommand(sendNs, result->commandsSent, triggerNs);
+            if (command <= lastCommand || ackNs[command] == 0)
+            {
+                // sent before the first command, a second frame for a single command or triggered by a failed command
+                continue;
+            }
+            lastCommand = command;
+            latencyUs[latencyCount++] = (double)(VmbInt64_t)(frame->receivedNs - sendNs[command]) / 1000.0;
+        }
+    }
+
+    result->framesExpected = (result->commandsSent - result->commandsFailed) * g_cameraCount;
+    result->framesMatched = latencyCount;
+    result->loss = (result->framesExpected > latencyCount) ? 1.0 - (double)latencyCount / result->framesExpected : 0.0;
+
+    qsort(latencyUs, latencyCount, sizeof(double), CompareDoubles);
+    result->latencyUs[0] = Percentile(latencyUs, latencyCount, 50.0);
+    result->latencyUs[1] = Percentile(latencyUs, latencyCount, 90.0);
+    result->latencyUs[2] = Percentile(latencyUs, latencyCount, 99.0);
+    result->latencyUs[3] = Percentile(latencyUs, latencyCount, 100.0);
+
+    // the acknowledgement latencies of the successful commands
+    VmbUint32_t ackCount = 0;
+    for (VmbUint32_t i = 0; i < result->commandsSent; i++)
+    {
+        if (ackNs[i] != 0)
+        {
+            latencyUs[ackCount++] = ackNs[i] / 1000.0;
+        }
+    }
+    qsort(latencyUs, ackCount, sizeof(double), CompareDoubles);
+    result->ackUs[0] = Percentile(latencyUs, ackCount, 50.0);
+    result->ackUs[1] = Percentile(latencyUs, ackCount, 99.0);
+    result->ackUs[2] = Percentile(latencyUs, ackCount, 100.0);
+}
+
+/**
+ * \brief Send the commands of a single rate and evaluate the received frames
+ */
+static VmbError_t RunStep(const double rateHz, StepResult* const result)
+{
+    memset(result, 0, sizeof(StepResult));
+    result->rateHz = rateHz;
+
+    VmbUint64_t const periodNs = (VmbUint64_t)(1e9 / rateHz);
+    VmbUint32_t commandCount = (VmbUint32_t)(STEP_DURATION_NS / periodNs);
+    commandCount = (commandCount < MIN_STEP_COMMANDS) ? MIN_STEP_COMMANDS : ((commandCount > MAX_STEP_COMMANDS) ? MAX_STEP_COMMANDS : commandCount);
+
+    VmbUint64_t* const sendNs = (VmbUint64_t*)malloc(sizeof(VmbUint64_t) * commandCount);
+    VmbUint64_t* const ackNs = (VmbUint64_t*)malloc(sizeof(VmbUint64_t) * commandCount);
+    double* const latencyUs = (double*)malloc(sizeof(double) * (commandCount + 1) * (MAX_STREAMING_CAMERAS + 1));
+
+    VmbError_t error = (sendNs != NULL && ackNs != NULL && latencyUs != NULL) ? VmbErrorSuccess : VmbErrorResources;
+
+    // Allow some frames more than commands, e.g. if a camera is also triggered by another application
+    for (VmbUint32_t i = 0; i < g_cameraCount && error == VmbErrorSuccess; i++)
+    {
+        BenchmarkCamera* const camera = &g_cameras[i];
+        camera->frameCount = 0;
+        camera->framesIncomplete = 0;
+        camera->frameCapacity = commandCount + commandCount / 4 + 1;
+        camera->frames = (FrameSample*)malloc(sizeof(FrameSample) * camera->frameCapacity);
+        error = (camera->frames != NULL) ? VmbErrorSuccess : VmbErrorResources;
+
+        // relate the camera time to the host time at the start of every step, which keeps the effect of the clock drift small
+        if (camera->cameraHandle != NULL)
+        {
+            camera->latched = (VmbErrorSuccess == LatchCameraTime(camera->cameraHandle, &camera->latchTicks, &camera->latchHostNs, &camera->latchUncertaintyNs));
+        }
+    }
+
+    if (error == VmbErrorSuccess)
+    {
+        mtx_lock(&g_recordMutex);
+        g_recording = VmbBoolTrue;
+        mtx_unlock(&g_recordMutex);
+
+        VmbUint64_t const startNs = GetMonotonicTimeNs() + START_DELAY_NS;
+        for (VmbUint32_t i = 0; i < commandCount; i++)
+        {
+            SleepUntilMonotonicNs(startNs + i * periodNs);
+
+            sendNs[i] = GetMonotonicTimeNs();
+            VmbUint64_t latencyNs = 0;
+            if (SendCommand(sendNs[i], &latencyNs) == VmbErrorSuccess)
+            {
+                ackNs[i] = (latencyNs != 0) ? latencyNs : 1;
+            }
+            else
+            {
+                ackNs[i] = 0;
+                ++result->commandsFailed;
+            }
+        }
+        result->commandsSent = commandCount;
+        result->achievedRateHz = (commandCount > 1 && sendNs[commandCount - 1] > sendNs[0])
+            ? (commandCount - 1) * 1e9 / (double)(sendNs[commandCount - 1] - sendNs[0])
+            : rateHz;
+
+        // Wait for the frames triggered by the last commands
+        SleepUntilMonotonicNs(GetMonotonicTimeNs() + SETTLE_TIME_NS);
+
+        mtx_lock(&g_recordMutex);
+        g_recording = VmbBoolFalse;
+        mtx_unlock(&g_recordMutex);
+
+        EvaluateStep(sendNs, ackNs, latencyUs, result);
+    }
+
+    for (VmbUint32_t i = 0; i < g_cameraCount; i++)
+    {
+        free(g_cameras[i].frames);
+        g_cameras[i].frames = NULL;
+    }
+    free(sendNs);
+    free(ackNs);
+    free(latencyUs);
+    return error;
+}
+
+/**
+ * \brief Use the real cameras or start the simulated ones
+ */
+static VmbError_t PrepareCameras(const ActionCommandsOptions* const pOptions, const VmbCameraInfo_t* const pCameras, const VmbHandle_t* const pCameraHandles, const VmbUint32_t cameraCount)
+{
+    memset(g_cameras, 0, sizeof(g_cameras));
+    g_cameraCount = 0;
+    g_senderHandle = NULL;
+
+    if (pOptions->benchmarkStub)
+    {
+        // the frame timestamps of the simulated cameras are in the host time base
+        for (VmbUint32_t i = 0; i < STUB_CAMERA_COUNT; i++)
+        {
+            g_cameras[i].cameraId = "simulated";
+            g_cameras[i].nsPerTick = 1.0;
+            g_cameras[i].latched = VmbBoolTrue;
+        }
+        return StartStubCameras();
+    }
+
+    if (cameraCount == 0 || cameraCount > MAX_STREAMING_CAMERAS)
+    {
+        return VmbErrorBadParameter;
+    }
+
+    for (VmbUint32_t i = 0; i < cameraCount; i++)
+    {
+        g_cameras[i].cameraHandle = pCameraHandles[i];
+        g_cameras[i].cameraId = pCameras[i].cameraIdString;
+        g_cameras[i].nsPerTick = GetTimestampNsPerTick(pCameraHandles[i]);
+    }
+    g_cameraCount = cameraCount;
+
+    // The AVT GigE TL sends the Action Commands on all interfaces if the Transport Layer module is used
+    g_senderHandle = (pOptions->useAllInterfaces) ? pCameras[0].transportLayerHandle : pCameras[0].interfaceHandle;
+    VmbFeatureBoolSet(g_senderHandle, "ActionScheduledTimeEnable", VmbBoolFalse);
+    return PrepareActionCommand(g_senderHandle, pOptions);
+}
+
+static void PrintStep(const StepResult* const result)
+{
+    printf("%10.1f Hz (%10.1f Hz sent): %6u of %6u frames, %6u incomplete, %6.2f %% lost, ack %8.1f us, latency median %8.1f us, p99 %8.1f us\n",
+           result->rateHz,
+           result->achievedRateHz,
+           result->framesMatched,
+           result->framesExpected,
+           result->framesIncomplete,
+           result->loss * 100.0,
+           result->ackUs[0],
+           result->latencyUs[0],
+           result->latencyUs[2]);
+    fflush(stdout);
+}
+
+static void WriteStep(FILE* const csvFile, const StepResult* const result)
+{
+    fprintf(csvFile, "%.3f,%.3f,%u,%u,%u,%u,%u,%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+            result->rateHz,
+            result->achievedRateHz,
+            result->commandsSent,
+            result->commandsFailed,
+            result->framesExpected,
+            result->framesMatched,
+            result->framesIncomplete,
+            result->loss * 100.0,
+            result->ackUs[0],
+            result->ackUs[1],
+            result->ackUs[2],
+            result->latencyUs[0],
+            result->latencyUs[1],
+            result->latencyUs[2],
+            result->latencyUs[3]);
+    fflush(csvFile);
+}
+
+VmbError_t RunTriggerBenchmark(const ActionCommandsOptions* const pOptions, const VmbCameraInfo_t* const pCameras, const VmbHandle_t* const pCameraHandles, const VmbUint32_t cameraCount)
+{
+    FILE* const csvFile = fopen(pOptions->benchmarkCsvPath, "w");
+    if (csvFile == NULL)
+    {
+        printf("Could not open \"%s\" for writing\n", pOptions->benchmarkCsvPath);
+        return VmbErrorBadParameter;
+    }
+    fprintf(csvFile, "rate_hz,sent_rate_hz,commands,commands_failed,frames_expected,frames_received,frames_incomplete,loss_percent,"
+                     "ack_p50_us,ack_p99_us,ack_max_us,latency_p50_us,latency_p90_us,latency_p99_us,latency_max_us\n");
+
+    if (mtx_init(&g_recordMutex, mtx_plain) != thrd_success)
+    {
+        fclose(csvFile);
+        return VmbErrorResources;
+    }
+
+    VmbError_t error = PrepareCameras(pOptions, pCameras, pCameraHandles, cameraCount);
+    if (error == VmbErrorSuccess)
+    {
+        printf("Sending Action Commands to %u%s camera(s) at increasing rates, writing the results to \"%s\"...\n\n",
+               g_cameraCount, pOptions->benchmarkStub ? " simulated" : "", pOptions->benchmarkCsvPath);
+
+        if (!pOptions->benchmarkStub)
+        {
+            SetFrameObserver(BenchmarkFrame);
+        }
+
+        double firstLossRate = 0.0;
+        double maxLosslessRate = 0.0;
+        for (double rate = START_RATE_HZ; rate <= MAX_RATE_HZ && error == VmbErrorSuccess; rate *= RATE_FACTOR)
+        {
+            StepResult result;
+            error = RunStep(rate, &result);
+            if (error != VmbErrorSuccess)
+            {
+                printf("Could not allocate memory for %.1f Hz\n", rate);
+                break;
+            }
+
+            PrintStep(&result);
+            WriteStep(csvFile, &result);
+
+            if (result.framesMatched < result.framesExpected || result.framesIncomplete != 0 || result.commandsFailed != 0)
+            {
+                firstLossRate = (firstLossRate == 0.0) ? rate : firstLossRate;
+            }
+            else if (firstLossRate == 0.0)
+            {
+                maxLosslessRate = result.achievedRateHz;
+            }
+
+            // incomplete frames are not matched, but count on their own, since they may come in addition to complete ones
+            if (result.loss > STOP_LOSS
+                || result.framesIncomplete > STOP_LOSS * result.framesExpected
+                || result.achievedRateHz < MIN_ACHIEVED_RATE * rate)
+            {
+                break;
+            }
+        }
+
+        if (!pOptions->benchmarkStub)
+        {
+            SetFrameObserver(NULL);
+        }
+
+        if (firstLossRate != 0.0)
+        {
+            printf("\nFrames started being lost at %.1f Hz, the highest rate without loss was %.1f Hz\n", firstLossRate, maxLosslessRate);
+        }
+        else
+        {
+            printf("\nNo frames were lost up to %.1f Hz\n", maxLosslessRate);
+        }
+    }
+
+    if (pOptions->benchmarkStub)
+    {
+        StopStubCameras();
+    }
+    g_cameraCount = 0;
+    mtx_destroy(&g_recordMutex);
+    fclose(csvFile);
+    return error;
+}
@@ -0,0 +1,34 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef TRIGGER_BENCHMARK_H_
+#define TRIGGER_BENCHMARK_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#include "ActionCommands.h"
+
+/**
+ * \brief Send Action Commands at increasing rates and write the frame loss and latencies of every rate to a CSV file
+ *
+ * Every rate is kept for about a second. The completion of every command is awaited, so the acknowledgement latency
+ * also limits the rate the commands can be sent at. Frames are matched to the command triggering them using the frame
+ * timestamps, if the camera time can be latched, otherwise using the time the frames are received at. The benchmark
+ * stops once more than a fifth of the frames is lost or incomplete or the commands cannot be sent at the requested rate
+ * anymore.
+ *
+ * If pOptions->benchmarkStub is set, no camera is used. The commands are passed to simulated cameras running in
+ * threads of this process instead, which allows testing the evaluation without any hardware.
+ *
+ * \param[in] pOptions          Provided command line options and details for the Action Command
+ * \param[in] pCameras          Information about the used cameras; NULL for the simulated cameras
+ * \param[in] pCameraHandles    Handles of the used cameras, which must be prepared for Action Commands and streaming
+ * \param[in] cameraCount       Number of cameras; ignored for the simulated cameras
+ *
+ * \return An error code indicating success or the type of error that occurred.
+ */
+VmbError_t RunTriggerBenchmark(const ActionCommandsOptions* const pOptions, const VmbCameraInfo_t* const pCameras, const VmbHandle_t* const pCameraHandles, const VmbUint32_t cameraCount);
+
+#endif
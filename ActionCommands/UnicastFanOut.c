@@ -0,0 +1,273 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "UnicastFanOut.h"
+
+#include <VmbCExamplesCommon/ErrorCodeToMessage.h>
+#include <VmbCExamplesCommon/FeatureCommand.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+
+#include <VmbC/VmbC.h>
+
+/**
+ * \brief Send the Action Command to every camera of the interface
+ *
+ * The cameras share the destination address of the interface, so they are triggered one after another, each with a
+ * full round trip of RunFeatureCommand; only the groups of different interfaces run in parallel.
+ */
+static void SendToGroup(UnicastGroup* const group)
+{
+    UnicastFanOut* const fanOut = group->fanOut;
+
+    for (VmbUint32_t i = 0; i < group->cameraCount; i++)
+    {
+        VmbUint32_t const cameraIndex = group->cameraIndices[i];
+
+        // the destination of a single camera was already set by UnicastFanOutStart
+        VmbError_t error = VmbErrorSuccess;
+        if (group->cameraCount > 1)
+        {
+            error = VmbFeatureIntSet(group->interfaceHandle, "GevActionDestinationIPAddress", group->ipAddresses[i]);
+        }
+
+        VmbUint64_t latencyNs = 0;
+        if (error == VmbErrorSuccess)
+        {
+            error = RunFeatureCommand(group->interfaceHandle, "ActionCommand", FEATURE_COMMAND_DEFAULT_TIMEOUT_MS, &latencyNs);
+        }
+
+        fanOut->errors[cameraIndex] = error;
+        fanOut->latenciesNs[cameraIndex] = latencyNs;
+    }
+}
+
+/**
+ * \brief Worker thread of an interface sending the commands whenever the generation changes
+ */
+static int GroupWorker(void* arg)
+{
+    UnicastGroup* const group = (UnicastGroup*)arg;
+    UnicastFanOut* const fanOut = group->fanOut;
+
+    // the generation starts at 0 and is only incremented after all workers were created
+    VmbUint64_t handledGeneration = 0;
+    mtx_lock(&fanOut->mutex);
+    for (;;)
+    {
+        while (!fanOut->stop && fanOut->generation == handledGeneration)
+        {
+            cnd_wait(&fanOut->triggerCondition, &fanOut->mutex);
+        }
+        if (fanOut->stop)
+        {
+            break;
+        }
+        handledGeneration = fanOut->generation;
+        mtx_unlock(&fanOut->mutex);
+
+        SendToGroup(group);
+
+        mtx_lock(&fanOut->mutex);
+        if (--fanOut->pendingGroups == 0)
+        {
+            cnd_signal(&fanOut->doneCondition);
+        }
+    }
+    mtx_unlock(&fanOut->mutex);
+    return 0;
+}
+
+/**
+ * \brief Assign the cameras to the groups of their interfaces and read their IP addresses
+ */
+static VmbError_t GroupCameras(UnicastFanOut* fanOut, const VmbCameraInfo_t* const pCameras, const VmbUint32_t cameraCount)
+{
+    for (VmbUint32_t i = 0; i < cameraCount; i++)
+    {
+        VmbInt64_t cameraIp = 0;
+        VmbError_t const error = VmbFeatureIntGet(pCameras[i].localDeviceHandle, "GevDeviceIPAddress", &cameraIp);
+        if (error != VmbErrorSuccess)
+        {
+            printf("Could not get feature \"GevDeviceIPAddress\" of camera \"%s\". Reason: %s\n", pCameras[i].cameraIdString, ErrorCodeToMessage(error));
+            return error;
+        }
+
+        UnicastGroup* group = NULL;
+        for (VmbUint32_t j = 0; j < fanOut->groupCount && group == NULL; j++)
+        {
+            group = (fanOut->groups[j].interfaceHandle == pCameras[i].interfaceHandle) ? &fanOut->groups[j] : NULL;
+        }
+        if (group == NULL)
+        {
+            group = &fanOut->groups[fanOut->groupCount++];
+            group->fanOut = fanOut;
+            group->interfaceHandle = pCameras[i].interfaceHandle;
+        }
+
+        group->cameraIndices[group->cameraCount] = i;
+        group->ipAddresses[group->cameraCount] = cameraIp;
+        ++group->cameraCount;
+    }
+    return VmbErrorSuccess;
+}
+
+/**
+ * \brief Send the Action Commands of the first groups as broadcast again
+ */
+static void ResetDestinations(UnicastFanOut* fanOut, VmbUint32_t groupCount)
+{
+    for (VmbUint32_t i = 0; i < groupCount; i++)
+    {
+        VmbFeatureIntSet(fanOut->groups[i].interfaceHandle, "GevActionDestinationIPAddress", 0);
+    }
+}
+
+VmbError_t UnicastFanOutStart(UnicastFanOut* fanOut, const ActionCommandsOptions* const pOptions, const VmbCameraInfo_t* const pCameras, const VmbUint32_t cameraCount)
+{
+    if (cameraCount == 0 || cameraCount > MAX_STREAMING_CAMERAS)
+    {
+        return VmbErrorBadParameter;
+    }
+
+    memset(fanOut, 0, sizeof(UnicastFanOut));
+    fanOut->cameraCount = cameraCount;
+
+    VmbError_t error = GroupCameras(fanOut, pCameras, cameraCount);
+    VmbUint32_t preparedGroups = 0;
+    for (; preparedGroups < fanOut->groupCount && error == VmbErrorSuccess; preparedGroups++)
+    {
+        UnicastGroup* const group = &fanOut->groups[preparedGroups];
+        error = PrepareActionCommand(group->interfaceHandle, pOptions);
+        if (error == VmbErrorSuccess && group->cameraCount == 1)
+        {
+            error = VmbFeatureIntSet(group->interfaceHandle, "GevActionDestinationIPAddress", group->ipAddresses[0]);
+            if (error != VmbErrorSuccess)
+            {
+                printf("Could not set feature \"GevActionDestinationIPAddress\" to %X. Reason: %s\n", (VmbUint32_t)group->ipAddresses[0], ErrorCodeToMessage(error));
+            }
+        }
+    }
+    if (error != VmbErrorSuccess)
+    {
+        // the interface failing may already have been changed as well
+        ResetDestinations(fanOut, preparedGroups);
+        return error;
+    }
+
+    if (mtx_init(&fanOut->mutex, mtx_plain) != thrd_success)
+    {
+        ResetDestinations(fanOut, fanOut->groupCount);
+        return VmbErrorResources;
+    }
+    if (cnd_init(&fanOut->triggerCondition) != thrd_success)
+    {
+        mtx_destroy(&fanOut->mutex);
+        ResetDestinations(fanOut, fanOut->groupCount);
+        return VmbErrorResources;
+    }
+    if (cnd_init(&fanOut->doneCondition) != thrd_success)
+    {
+        cnd_destroy(&fanOut->triggerCondition);
+        mtx_destroy(&fanOut->mutex);
+        ResetDestinations(fanOut, fanOut->groupCount);
+        return VmbErrorResources;
+    }
+
+    VmbUint32_t startedGroups = 0;
+    while (startedGroups < fanOut->groupCount
+           && thrd_create(&fanOut->groups[startedGroups].thread, GroupWorker, &fanOut->groups[startedGroups]) == thrd_success)
+    {
+        ++startedGroups;
+    }
+
+    if (startedGroups != fanOut->groupCount)
+    {
+        printf("Could not start the worker threads.\n");
+        ResetDestinations(fanOut, fanOut->groupCount);
+        fanOut->groupCount = startedGroups;
+        UnicastFanOutStop(fanOut);
+        return VmbErrorResources;
+    }
+
+    VmbUint32_t maxGroupSize = 0;
+    for (VmbUint32_t i = 0; i < fanOut->groupCount; i++)
+    {
+        maxGroupSize = (fanOut->groups[i].cameraCount > maxGroupSize) ? fanOut->groups[i].cameraCount : maxGroupSize;
+    }
+    printf("Sending unicast Action Commands to %u camera(s) on %u interface(s); the interfaces are served in parallel, "
+           "the up to %u camera(s) of an interface one after another\n", cameraCount, fanOut->groupCount, maxGroupSize);
+    return VmbErrorSuccess;
+}
+
+VmbError_t UnicastFanOutTrigger(UnicastFanOut* fanOut, UnicastFanOutResult* const pResult)
+{
+    memset(pResult, 0, sizeof(UnicastFanOutResult));
+
+    VmbUint64_t const startNs = GetMonotonicTimeNs();
+
+    mtx_lock(&fanOut->mutex);
+    fanOut->pendingGroups = fanOut->groupCount;
+    ++fanOut->generation;
+    cnd_broadcast(&fanOut->triggerCondition);
+    while (fanOut->pendingGroups != 0)
+    {
+        cnd_wait(&fanOut->doneCondition, &fanOut->mutex);
+    }
+    mtx_unlock(&fanOut->mutex);
+
+    pResult->durationNs = GetMonotonicTimeNs() - startNs;
+
+    VmbError_t firstError = VmbErrorSuccess;
+    VmbUint64_t sumLatencyNs = 0;
+    for (VmbUint32_t i = 0; i < fanOut->cameraCount; i++)
+    {
+        VmbError_t const error = fanOut->errors[i];
+        if (error == VmbErrorSuccess)
+        {
+            VmbUint64_t const latencyNs = fanOut->latenciesNs[i];
+            pResult->minLatencyNs = (pResult->acknowledged == 0 || latencyNs < pResult->minLatencyNs) ? latencyNs : pResult->minLatencyNs;
+            pResult->maxLatencyNs = (latencyNs > pResult->maxLatencyNs) ? latencyNs : pResult->maxLatencyNs;
+            sumLatencyNs += latencyNs;
+            ++pResult->acknowledged;
+        }
+        else
+        {
+            if (error == VmbErrorTimeout)
+            {
+                ++pResult->timedOut;
+            }
+            else
+            {
+                ++pResult->failed;
+            }
+            firstError = (firstError == VmbErrorSuccess) ? error : firstError;
+        }
+    }
+    pResult->meanLatencyNs = (pResult->acknowledged != 0) ? sumLatencyNs / pResult->acknowledged : 0;
+
+    return firstError;
+}
+
+void UnicastFanOutStop(UnicastFanOut* fanOut)
+{
+    mtx_lock(&fanOut->mutex);
+    fanOut->stop = VmbBoolTrue;
+    cnd_broadcast(&fanOut->triggerCondition);
+    mtx_unlock(&fanOut->mutex);
+
+    for (VmbUint32_t i = 0; i < fanOut->groupCount; i++)
+    {
+        thrd_join(fanOut->groups[i].thread, NULL);
+    }
+    ResetDestinations(fanOut, fanOut->groupCount);
+    fanOut->groupCount = 0;
+
+    cnd_destroy(&fanOut->doneCondition);
+    cnd_destroy(&fanOut->triggerCondition);
+    mtx_destroy(&fanOut->mutex);
+}
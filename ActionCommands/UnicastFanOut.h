@@ -0,0 +1,97 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef UNICAST_FAN_OUT_H_
+#define UNICAST_FAN_OUT_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#include "ActionCommands.h"
+#include "ImageAcquisition.h"
+
+/**
+ * \brief The cameras connected to one interface and the worker thread sending their unicast Action Commands
+ */
+typedef struct UnicastGroup
+{
+    struct UnicastFanOut*   fanOut;
+    VmbHandle_t             interfaceHandle;
+    VmbUint32_t             cameraCount;
+    VmbUint32_t             cameraIndices[MAX_STREAMING_CAMERAS];   //!< Index of every camera in the array passed to UnicastFanOutStart
+    VmbInt64_t              ipAddresses[MAX_STREAMING_CAMERAS];
+    thrd_t                  thread;
+} UnicastGroup;
+
+/**
+ * \brief Sends unicast Action Commands to the cameras of many interfaces in parallel
+ *
+ * The parallelism is per interface only: every interface has its own worker thread, but the destination address is
+ * a feature of the Interface module, so the commands for the cameras of one interface are sent one after another,
+ * each waiting for its completion. The Action Command keys are only set once per interface and the destination
+ * address is only rewritten if more than one camera is connected to the interface.
+ */
+typedef struct UnicastFanOut
+{
+    UnicastGroup    groups[MAX_STREAMING_CAMERAS];
+    VmbUint32_t     groupCount;
+    VmbUint32_t     cameraCount;
+
+    mtx_t           mutex;                                  // protects the members below
+    cnd_t           triggerCondition;
+    cnd_t           doneCondition;
+    VmbUint64_t     generation;                             //!< Incremented for every trigger
+    VmbUint32_t     pendingGroups;
+    VmbBool_t       stop;
+
+    VmbError_t      errors[MAX_STREAMING_CAMERAS];          //!< Result of the last command of every camera
+    VmbUint64_t     latenciesNs[MAX_STREAMING_CAMERAS];     //!< Acknowledgement latency of the last command of every camera
+} UnicastFanOut;
+
+/**
+ * \brief Aggregated results of sending a unicast Action Command to every camera
+ */
+typedef struct UnicastFanOutResult
+{
+    VmbUint32_t     acknowledged;
+    VmbUint32_t     timedOut;
+    VmbUint32_t     failed;
+    VmbUint64_t     minLatencyNs;           //!< Minimum acknowledgement latency of the acknowledged commands
+    VmbUint64_t     maxLatencyNs;
+    VmbUint64_t     meanLatencyNs;
+    VmbUint64_t     durationNs;             //!< Time until all commands were acknowledged, timed out or failed
+} UnicastFanOutResult;
+
+/**
+ * \brief Groups the cameras by interface, prepares the Action Command features of every interface and starts the workers
+ *
+ * On failure the destination addresses already set are reverted to broadcast.
+ *
+ * \param[out] fanOut       The fan out to start
+ * \param[in]  pOptions     Provided command line options and details for the Action Command
+ * \param[in]  pCameras     Information about the used and already opened cameras
+ * \param[in]  cameraCount  Number of cameras; at most MAX_STREAMING_CAMERAS
+ *
+ * \return An error code indicating success or the type of error that occurred.
+ */
+VmbError_t UnicastFanOutStart(UnicastFanOut* fanOut, const ActionCommandsOptions* const pOptions, const VmbCameraInfo_t* const pCameras, const VmbUint32_t cameraCount);
+
+/**
+ * \brief Sends a unicast Action Command to every camera and waits until all of them were completed
+ *
+ * \param[in]  fanOut   The started fan out
+ * \param[out] pResult  The aggregated results
+ *
+ * \return VmbErrorSuccess, if every camera acknowledged the command; the first error of a camera otherwise
+ */
+VmbError_t UnicastFanOutTrigger(UnicastFanOut* fanOut, UnicastFanOutResult* const pResult);
+
+/**
+ * \brief Stops the workers and reverts the destination addresses to broadcast
+ */
+void UnicastFanOutStop(UnicastFanOut* fanOut);
+
+#endif
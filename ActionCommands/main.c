@@ -4,23 +4,42 @@
 =============================================================================*/
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <VmbC/VmbC.h>
 
 #include "ActionCommands.h"
 #include "Helper.h"
+#include "FrameSetAssembler.h"
 #include "ImageAcquisition.h"
+#include "ScheduledActions.h"
+#include "TriggerBenchmark.h"
+#include "UnicastFanOut.h"
 
 #include <VmbCExamplesCommon/ErrorCodeToMessage.h>
 
-// Globally stored handle of the used camera (needed for the signal handlers)
-VmbHandle_t g_CameraHandle = NULL;
+// Globally stored handles of the used cameras (needed for the signal handlers)
+VmbHandle_t g_CameraHandles[MAX_STREAMING_CAMERAS];
+VmbUint32_t g_CameraCount = 0;
+
+// Matches the frames of the cameras, if multiple cameras are used
+FrameSetAssembler g_FrameSetAssembler;
+
+// Sends the unicast Action Commands to multiple cameras
+UnicastFanOut g_UnicastFanOut;
 
 // Used command line parameters
 #define VMB_PARAM_PRINT_HELP        "/h"
 #define VMB_PARAM_ON_ALL_INTERFACES "/a"
 #define VMB_PARAM_AS_UNICAST        "/u"
+#define VMB_PARAM_ALL_CAMERAS       "/m"
+#define VMB_PARAM_SCHEDULED_RATE    "/s"
+#define VMB_PARAM_SCHEDULED_COUNT   "/n"
+#define VMB_PARAM_SET_TOLERANCE     "/t"
+#define VMB_PARAM_BENCHMARK         "/b"
+#define VMB_PARAM_BENCHMARK_STUB    "/stub"
+#define VMB_PARAM_TRANSPORT_LAYERS  "/tl"
 
 // Keys used during the example
 #define VMB_ACTION_KEY              'a'
@@ -31,6 +50,27 @@ VmbHandle_t g_CameraHandle = NULL;
 #define VMB_ACTION_GROUP_KEY        1
 #define VMB_ACTION_GROUP_MASK       1
 
+// Number of Action Commands sent by the timer thread if not specified
+#define VMB_DEFAULT_SCHEDULED_COUNT 1000
+
+// Time after the first frame of a frame set the set is printed, even if frames of some cameras are missing
+#define VMB_FRAME_SET_TIMEOUT_NS    500000000ull
+
+/**
+ * \brief Stops the streams and closes all used cameras
+ */
+void CloseCameras(void)
+{
+    SetFrameObserver(NULL);
+
+    for (VmbUint32_t i = 0; i < g_CameraCount; i++)
+    {
+        StopStream(g_CameraHandles[i]);
+        VmbCameraClose(g_CameraHandles[i]);
+    }
+    g_CameraCount = 0;
+}
+
 /**
  * \brief Handling of signals related to forced closing of the example application.
  *
@@ -42,8 +82,7 @@ void HandleForcedClose(void)
     // In this example it is called to reduce the complexity.
     printf("Press %c + 'ENTER' to stop the example.\n", VMB_QUIT_KEY);
 
-    StopStream(g_CameraHandle);
-    VmbCameraClose(g_CameraHandle);
+    CloseCameras();
     VmbShutdown();
 }
 
@@ -72,25 +111,57 @@ void ConsoleHandler(int signal)
 
 #endif
 
-#define CLEANUP_AND_RETURN(camera, error)   if(camera != NULL)          \
-                                            {                           \
-                                                VmbCameraClose(camera); \
-                                            }                           \
-                                            VmbShutdown();              \
-                                            return error;
+#define CLEANUP_AND_RETURN(error)   CloseCameras();     \
+                                    VmbShutdown();      \
+                                    return error;
 
 void PrintUsage(void)
 {
-    printf( "Usage: ActionCommands [CameraID] [%s] [%s] [%s]\n"
+    printf( "Usage: ActionCommands [CameraID] [%s] [%s] [%s] [%s <ns>] [%s <rate>] [%s <count>] [%s <csv file> [%s]] [%s <filter>] [%s]\n"
             "Parameters:    CameraID    ID of the camera to use (using first camera if not specified)\n"
             "               %s          Send the Action Command on all interfaces (requires the AVT GigETL)\n"
             "               %s          Send the Action Command as unicast directly to the camera (otherwise as broadcast)\n"
+            "               %s          Use all cameras which can be used by this example instead of a single one\n"
+            "                           (only cameras on the interface of the first camera for broadcasts without %s);\n"
+            "                           the frames of all cameras triggered by the same Action Command are printed as one set;\n"
+            "                           with %s the unicast Action Commands are sent on all interfaces in parallel\n"
+            "                           (the cameras of a single interface are triggered one after another)\n"
+            "               %s <ns>     Match the frames of a set by timestamps within the given tolerance instead of the\n"
+            "                           frame ids (requires synchronized camera clocks with ns timestamps, e.g. PTP)\n"
+            "               %s <rate>   Send Action Commands with the given rate in Hz from a timer thread and print the\n"
+            "                           trigger jitter of all cameras (uses ActionScheduledTime, if supported)\n"
+            "               %s <count>  Number of Action Commands sent with %s (default %d)\n"
+            "               %s <file>   Send Action Commands at increasing rates until frames are lost and write the\n"
+            "                           loss and the latencies of every rate to the given CSV file\n"
+            "               %s       Run %s against simulated cameras instead of real ones\n"
+            "               %s <filter>\n"
+            "                           Load only the transport layers of a comma separated list of types and paths,\n"
+            "                           e.g. GigE or /opt/VimbaX/cti/VimbaGigETL.cti\n"
             "               %s          Print out help\n",
             VMB_PARAM_ON_ALL_INTERFACES,
             VMB_PARAM_AS_UNICAST,
+            VMB_PARAM_ALL_CAMERAS,
+            VMB_PARAM_SET_TOLERANCE,
+            VMB_PARAM_SCHEDULED_RATE,
+            VMB_PARAM_SCHEDULED_COUNT,
+            VMB_PARAM_BENCHMARK,
+            VMB_PARAM_BENCHMARK_STUB,
+            VMB_PARAM_TRANSPORT_LAYERS,
             VMB_PARAM_PRINT_HELP,
             VMB_PARAM_ON_ALL_INTERFACES,
             VMB_PARAM_AS_UNICAST,
+            VMB_PARAM_ALL_CAMERAS,
+            VMB_PARAM_ON_ALL_INTERFACES,
+            VMB_PARAM_AS_UNICAST,
+            VMB_PARAM_SET_TOLERANCE,
+            VMB_PARAM_SCHEDULED_RATE,
+            VMB_PARAM_SCHEDULED_COUNT,
+            VMB_PARAM_SCHEDULED_RATE,
+            VMB_DEFAULT_SCHEDULED_COUNT,
+            VMB_PARAM_BENCHMARK,
+            VMB_PARAM_BENCHMARK_STUB,
+            VMB_PARAM_BENCHMARK,
+            VMB_PARAM_TRANSPORT_LAYERS,
             VMB_PARAM_PRINT_HELP);
 }
 
@@ -134,6 +205,79 @@ VmbError_t ParseCommandLineParameters(ActionCommandsOptions* cmdOptions, VmbBool
                 continue;
             }
 
+            if (0 == strcmp(*param, VMB_PARAM_ALL_CAMERAS))
+            {
+                cmdOptions->useAllCameras = VmbBoolTrue;
+                continue;
+            }
+
+            if (0 == strcmp(*param, VMB_PARAM_BENCHMARK_STUB))
+            {
+                cmdOptions->benchmarkStub = VmbBoolTrue;
+                continue;
+            }
+
+            if (0 == strcmp(*param, VMB_PARAM_BENCHMARK))
+            {
+                if (++param == paramsEnd)
+                {
+                    printf("%s requires a value\n", VMB_PARAM_BENCHMARK);
+                    result = VmbErrorBadParameter;
+                    break;
+                }
+                cmdOptions->benchmarkCsvPath = *param;
+                continue;
+            }
+
+            if (0 == strcmp(*param, VMB_PARAM_TRANSPORT_LAYERS))
+            {
+                if (++param == paramsEnd)
+                {
+                    printf("%s requires a value\n", VMB_PARAM_TRANSPORT_LAYERS);
+                    result = VmbErrorBadParameter;
+                    break;
+                }
+                cmdOptions->transportLayerFilter = *param;
+                continue;
+            }
+
+            if (0 == strcmp(*param, VMB_PARAM_SCHEDULED_RATE)
+                || 0 == strcmp(*param, VMB_PARAM_SCHEDULED_COUNT)
+                || 0 == strcmp(*param, VMB_PARAM_SET_TOLERANCE))
+            {
+                const char* const option = *param;
+                char* end = NULL;
+                if (++param == paramsEnd)
+                {
+                    printf("%s requires a value\n", option);
+                    result = VmbErrorBadParameter;
+                    break;
+                }
+
+                if (0 == strcmp(option, VMB_PARAM_SCHEDULED_RATE))
+                {
+                    cmdOptions->scheduledRate = strtod(*param, &end);
+                    result = (end != *param && *end == '\0' && cmdOptions->scheduledRate > 0.0) ? VmbErrorSuccess : VmbErrorBadParameter;
+                }
+                else if (0 == strcmp(option, VMB_PARAM_SET_TOLERANCE))
+                {
+                    cmdOptions->frameSetTolerance = strtoull(*param, &end, 10);
+                    result = (end != *param && *end == '\0' && **param != '-' && cmdOptions->frameSetTolerance != 0) ? VmbErrorSuccess : VmbErrorBadParameter;
+                }
+                else
+                {
+                    const unsigned long count = strtoul(*param, &end, 10);
+                    cmdOptions->scheduledCount = (VmbUint32_t)count;
+                    result = (end != *param && *end == '\0' && **param != '-' && count != 0 && count <= 10000000) ? VmbErrorSuccess : VmbErrorBadParameter;
+                }
+
+                if (result != VmbErrorSuccess)
+                {
+                    printf("Invalid value for %s: %s\n", option, *param);
+                }
+                continue;
+            }
+
             if (**param == '/')
             {
                 printf("unknown command line option: %s\n", *param);
@@ -157,20 +301,146 @@ VmbError_t ParseCommandLineParameters(ActionCommandsOptions* cmdOptions, VmbBool
             result = VmbErrorBadParameter;
         }
     }
+
+    if (result == VmbErrorSuccess && cmdOptions->useAllCameras && cmdOptions->pCameraId != NULL)
+    {
+        printf("%s cannot be combined with a camera id\n", VMB_PARAM_ALL_CAMERAS);
+        result = VmbErrorBadParameter;
+    }
+    if (result == VmbErrorSuccess && cmdOptions->scheduledRate > 0.0 && cmdOptions->sendAsUnicast)
+    {
+        printf("%s cannot be combined with %s\n", VMB_PARAM_SCHEDULED_RATE, VMB_PARAM_AS_UNICAST);
+        result = VmbErrorBadParameter;
+    }
+    if (result == VmbErrorSuccess && cmdOptions->benchmarkCsvPath != NULL && (cmdOptions->scheduledRate > 0.0 || cmdOptions->sendAsUnicast))
+    {
+        printf("%s cannot be combined with %s or %s\n", VMB_PARAM_BENCHMARK, VMB_PARAM_SCHEDULED_RATE, VMB_PARAM_AS_UNICAST);
+        result = VmbErrorBadParameter;
+    }
+    if (result == VmbErrorSuccess && cmdOptions->benchmarkStub && cmdOptions->benchmarkCsvPath == NULL)
+    {
+        printf("%s requires %s\n", VMB_PARAM_BENCHMARK_STUB, VMB_PARAM_BENCHMARK);
+        result = VmbErrorBadParameter;
+    }
     return result;
 }
 
+/**
+ * \brief Frame observer passing the frames of all cameras to the frame set assembler
+ */
+VmbBool_t AssembleFrame(const VmbHandle_t cameraHandle, VmbFrame_t* frame, VmbUint64_t receivedNs)
+{
+    for (VmbUint32_t i = 0; i < g_CameraCount; i++)
+    {
+        if (g_CameraHandles[i] == cameraHandle)
+        {
+            FrameSetAssemblerAdd(&g_FrameSetAssembler, i, frame, receivedNs);
+            return VmbBoolTrue;
+        }
+    }
+    return VmbBoolFalse;
+}
+
+/**
+ * \brief Queues the frames of a frame set again after it was printed
+ */
+void ReleaseFrame(VmbUint32_t cameraIndex, VmbFrame_t* frame, void* context)
+{
+    RequeueFrame(g_CameraHandles[cameraIndex], frame);
+}
+
+/**
+ * \brief Prints information about a frame set
+ */
+void PrintFrameSet(const FrameSet* frameSet, void* context)
+{
+    VmbUint32_t members = 0;
+    VmbUint64_t minTimestamp = 0;
+    VmbUint64_t maxTimestamp = 0;
+    VmbUint64_t firstReceived = 0;
+    VmbUint64_t lastReceived = 0;
+
+    for (VmbUint32_t i = 0; i < g_CameraCount; i++)
+    {
+        const VmbFrame_t* const frame = frameSet->frames[i];
+        if (frame == NULL)
+        {
+            continue;
+        }
+
+        if (frame->receiveFlags & VmbFrameFlagsTimestamp)
+        {
+            minTimestamp = (members == 0 || frame->timestamp < minTimestamp) ? frame->timestamp : minTimestamp;
+            maxTimestamp = (members == 0 || frame->timestamp > maxTimestamp) ? frame->timestamp : maxTimestamp;
+        }
+        firstReceived = (members == 0 || frameSet->receivedNs[i] < firstReceived) ? frameSet->receivedNs[i] : firstReceived;
+        lastReceived = (members == 0 || frameSet->receivedNs[i] > lastReceived) ? frameSet->receivedNs[i] : lastReceived;
+        ++members;
+    }
+
+    printf("%s frame set %llu - Cameras: %u of %u, timestamp spread: %llu ticks, assembled %.3f ms after the first frame\n",
+           frameSet->complete ? "Complete" : "Partial",
+           frameSet->key,
+           members,
+           g_CameraCount,
+           maxTimestamp - minTimestamp,
+           (lastReceived - firstReceived) / 1e6);
+    fflush(stdout);
+}
+
+/**
+ * \brief Opens a camera and prepares it for being triggered by Action Commands
+ *
+ * \param[in]     pOptions     Provided command line options and details for the Action Command
+ * \param[in,out] pCameraInfo  Information about the camera; updated after opening the camera
+ *
+ * \return An error code indicating success or the type of error that occurred.
+ */
+VmbError_t OpenCamera(const ActionCommandsOptions* const pOptions, VmbCameraInfo_t* const pCameraInfo)
+{
+    printf("\nUsing camera %s\n", pCameraInfo->cameraIdString);
+
+    // Open the found camera
+    VmbHandle_t cameraHandle = NULL;
+    VmbError_t error = VmbCameraOpen(pCameraInfo->cameraIdString, VmbAccessModeFull, &cameraHandle);
+    if (error != VmbErrorSuccess)
+    {
+        printf("Could not open %s. Reason: %s\n", pCameraInfo->cameraIdString, ErrorCodeToMessage(error));
+        return error;
+    }
+    g_CameraHandles[g_CameraCount++] = cameraHandle;
+
+    // Update the camera information (some values are only available after the camera is opened)
+    error = VmbCameraInfoQuery(pCameraInfo->cameraIdString, pCameraInfo, sizeof(VmbCameraInfo_t));
+    if (error != VmbErrorSuccess)
+    {
+        printf("Could not query camera info for %s. Reason: %s\n", pCameraInfo->cameraIdString, ErrorCodeToMessage(error));
+        return error;
+    }
+
+    // Prepare the camera to be triggered by received Action Commands
+    error = PrepareCameraForActionCommands(cameraHandle);
+    if (error != VmbErrorSuccess)
+    {
+        return error;
+    }
+
+    //Set up the Action Command values on the camera
+    return PrepareActionCommand(cameraHandle, pOptions);
+}
+
 int main(int argc, char* argv[])
 {
     printf("////////////////////////////////////////\n"
            "/// Vmb API Action Commands Example ////\n"
            "////////////////////////////////////////\n\n");
 
-    ActionCommandsOptions cmdOptions = { VmbBoolFalse, VmbBoolFalse, NULL, VMB_ACTION_DEVICE_KEY, VMB_ACTION_GROUP_KEY, VMB_ACTION_GROUP_MASK };
+    ActionCommandsOptions cmdOptions = { VmbBoolFalse, VmbBoolFalse, NULL, VMB_ACTION_DEVICE_KEY, VMB_ACTION_GROUP_KEY, VMB_ACTION_GROUP_MASK,
+                                         VmbBoolFalse, 0.0, VMB_DEFAULT_SCHEDULED_COUNT, 0, NULL, VmbBoolFalse, NULL };
 
     VmbBool_t printHelp = VmbBoolFalse;
-    VmbCameraInfo_t cameraToUse;
-    memset(&cameraToUse, 0, sizeof(cameraToUse));
+    VmbCameraInfo_t camerasToUse[MAX_STREAMING_CAMERAS];
+    memset(camerasToUse, 0, sizeof(camerasToUse));
 
     VmbError_t error = ParseCommandLineParameters(&cmdOptions, &printHelp, argc, argv);
 
@@ -186,57 +456,109 @@ int main(int argc, char* argv[])
         signal(SIGINT, ConsoleHandler);
     #endif
 
-    error = StartApi();
-    if (error != VmbErrorSuccess)
+    // The simulated cameras do not need the API
+    if (cmdOptions.benchmarkStub)
     {
-        return error;
+        return RunTriggerBenchmark(&cmdOptions, NULL, NULL, 0);
     }
 
-    // Find a camera which can be used by this example or check the compatibility of the given camera
-    error = FindCamera(cmdOptions.useAllInterfaces, cmdOptions.pCameraId, &cameraToUse);
+    error = StartApi(cmdOptions.transportLayerFilter);
     if (error != VmbErrorSuccess)
     {
-        printf("\nNo camera found which could be used by the example");
-        CLEANUP_AND_RETURN(g_CameraHandle, error);
+        return error;
     }
 
-    printf("\nUsing camera %s\n", cameraToUse.cameraIdString);
-
-    // Open the found camera
-    error = VmbCameraOpen(cameraToUse.cameraIdString, VmbAccessModeFull, &g_CameraHandle);
-    if (error != VmbErrorSuccess)
+    // Find the cameras which can be used by this example or check the compatibility of the given camera
+    VmbCameraInfo_t* pFoundCameras = NULL;
+    VmbUint32_t foundCameraCount = 0;
+    if (cmdOptions.useAllCameras)
     {
-        printf("Could not open %s. Reason: %s\n", cameraToUse.cameraIdString, ErrorCodeToMessage(error));
-        CLEANUP_AND_RETURN(g_CameraHandle, error);
+        error = FindCameras(cmdOptions.useAllInterfaces, &pFoundCameras, &foundCameraCount);
+    }
+    else
+    {
+        error = FindCamera(cmdOptions.useAllInterfaces, cmdOptions.pCameraId, camerasToUse);
+        foundCameraCount = 1;
     }
 
-    // Update the camera information (some values are only available after the camera is opened)
-    error = VmbCameraInfoQuery(cameraToUse.cameraIdString, &cameraToUse, sizeof(cameraToUse));
     if (error != VmbErrorSuccess)
     {
-        printf("Could not query camera info for %s. Reason: %s\n", cameraToUse.cameraIdString, ErrorCodeToMessage(error));
-        CLEANUP_AND_RETURN(g_CameraHandle, error);
+        printf("\nNo camera found which could be used by the example");
+        CLEANUP_AND_RETURN(error);
     }
 
-    // Prepare the camera to be triggered by received Action Commands
-    error = PrepareCameraForActionCommands(g_CameraHandle);
-    if (error != VmbErrorSuccess)
+    VmbUint32_t cameraCount = 0;
+    for (VmbUint32_t i = 0; i < foundCameraCount && cameraCount < MAX_STREAMING_CAMERAS; i++)
     {
-        CLEANUP_AND_RETURN(g_CameraHandle, error);
+        if (pFoundCameras != NULL)
+        {
+            // Without the Transport Layer module the broadcast Action Commands only reach the interface of the first camera
+            if (!cmdOptions.useAllInterfaces && !cmdOptions.sendAsUnicast && cameraCount != 0 && pFoundCameras[i].interfaceHandle != camerasToUse[0].interfaceHandle)
+            {
+                printf("Ignoring camera \"%s\" (connected to another interface, use %s)\n", pFoundCameras[i].cameraIdString, VMB_PARAM_ON_ALL_INTERFACES);
+                continue;
+            }
+            camerasToUse[cameraCount] = pFoundCameras[i];
+        }
+
+        error = OpenCamera(&cmdOptions, &camerasToUse[cameraCount++]);
+        if (error != VmbErrorSuccess)
+        {
+            free(pFoundCameras);
+            CLEANUP_AND_RETURN(error);
+        }
     }
+    free(pFoundCameras);
 
-    //Set up the Action Command values on the camera
-    error = PrepareActionCommand(g_CameraHandle, &cmdOptions);
-    if (error != VmbErrorSuccess)
+    // Print the frames of multiple cameras as sets; partial sets are printed after the timeout
+    VmbBool_t assembleFrameSets = VmbBoolFalse;
+    if (g_CameraCount > 1 && cmdOptions.scheduledRate <= 0.0 && cmdOptions.benchmarkCsvPath == NULL)
     {
-        CLEANUP_AND_RETURN(g_CameraHandle, error);
+        if (FrameSetAssemblerInit(&g_FrameSetAssembler, g_CameraCount, cmdOptions.frameSetTolerance, VMB_FRAME_SET_TIMEOUT_NS, PrintFrameSet, ReleaseFrame, NULL) == VmbErrorSuccess
+            && FrameSetAssemblerStart(&g_FrameSetAssembler) == VmbErrorSuccess)
+        {
+            SetFrameObserver(AssembleFrame);
+            assembleFrameSets = VmbBoolTrue;
+        }
+        else
+        {
+            printf("Could not prepare the frame set assembly; the frames are printed individually\n");
+        }
     }
 
-    //Prepare and start the stream
-    error = StartStream(g_CameraHandle);
+    //Prepare and start the streams
+    for (VmbUint32_t i = 0; i < g_CameraCount && error == VmbErrorSuccess; i++)
+    {
+        error = StartStream(g_CameraHandles[i]);
+    }
 
-    if (error == VmbErrorSuccess)
+    if (error == VmbErrorSuccess && cmdOptions.scheduledRate > 0.0)
+    {
+        error = RunScheduledActionCommands(&cmdOptions, camerasToUse, g_CameraHandles, g_CameraCount);
+    }
+    else if (error == VmbErrorSuccess && cmdOptions.benchmarkCsvPath != NULL)
     {
+        error = RunTriggerBenchmark(&cmdOptions, camerasToUse, g_CameraHandles, g_CameraCount);
+    }
+    else if (error == VmbErrorSuccess)
+    {
+        // Multiple cameras get their unicast Action Commands from one worker thread per interface
+        VmbBool_t const useFanOut = (cmdOptions.sendAsUnicast && g_CameraCount > 1);
+        if (useFanOut)
+        {
+            error = UnicastFanOutStart(&g_UnicastFanOut, &cmdOptions, camerasToUse, g_CameraCount);
+            if (error != VmbErrorSuccess)
+            {
+                printf("Could not prepare the unicast Action Commands. Reason: %s\n", ErrorCodeToMessage(error));
+                if (assembleFrameSets)
+                {
+                    SetFrameObserver(NULL);
+                    FrameSetAssemblerStop(&g_FrameSetAssembler);
+                }
+                CLEANUP_AND_RETURN(error);
+            }
+        }
+
         printf("\nExample ready to send Action Commands\n");
         printf("Press %c + ENTER to send an Action Command\n", VMB_ACTION_KEY);
         printf("Press %c + ENTER to quit\n", VMB_QUIT_KEY);
@@ -245,19 +567,47 @@ int main(int argc, char* argv[])
         do
         {
             key = getchar();
-            if (key == VMB_ACTION_KEY)
+            if (key == VMB_ACTION_KEY && useFanOut)
+            {
+                UnicastFanOutResult fanOutResult;
+                error = UnicastFanOutTrigger(&g_UnicastFanOut, &fanOutResult);
+                printf("Unicast Action Commands completed after %.1f us: %u acknowledged (latency min %.1f us, mean %.1f us, max %.1f us), %u timed out, %u failed\n",
+                       fanOutResult.durationNs / 1000.0,
+                       fanOutResult.acknowledged,
+                       fanOutResult.minLatencyNs / 1000.0,
+                       fanOutResult.meanLatencyNs / 1000.0,
+                       fanOutResult.maxLatencyNs / 1000.0,
+                       fanOutResult.timedOut,
+                       fanOutResult.failed);
+            }
+            else if (key == VMB_ACTION_KEY)
             {
-                error = SendActionCommand(&cmdOptions, &cameraToUse);
+                error = SendActionCommand(&cmdOptions, &camerasToUse[0]);
             }
-        } while ( (key != VMB_QUIT_KEY) && (g_CameraHandle != NULL));
+        } while ( (key != VMB_QUIT_KEY) && (g_CameraCount != 0));
         printf("Terminating example...\n");
+
+        if (useFanOut)
+        {
+            UnicastFanOutStop(&g_UnicastFanOut);
+        }
     }
 
-    //Clean up the API before the example is closed
+    if (assembleFrameSets)
+    {
+        SetFrameObserver(NULL);
+        FrameSetAssemblerStop(&g_FrameSetAssembler);
+        FrameSetAssemblerFlush(&g_FrameSetAssembler);
+        printf("Frame sets: %llu complete, %llu partial; frames arriving too late: %llu, without id or timestamp: %llu\n",
+               atomic_load(&g_FrameSetAssembler.setsComplete),
+               atomic_load(&g_FrameSetAssembler.setsPartial),
+               atomic_load(&g_FrameSetAssembler.framesLate),
+               atomic_load(&g_FrameSetAssembler.framesDropped));
+    }
 
-    StopStream(g_CameraHandle);
+    //Clean up the API before the example is closed
 
-    VmbCameraClose(g_CameraHandle);
+    CloseCameras();
 
     VmbShutdown();
     return error;
@@ -10,8 +10,11 @@
 
 #include "AsynchronousGrab.h"
 
+#include <VmbCExamplesCommon/ChunkDecoder.h>
+#include <VmbCExamplesCommon/FeatureCommand.h>
 #include <VmbCExamplesCommon/ListCameras.h>
 #include <VmbCExamplesCommon/PrintVmbVersion.h>
+#include <VmbCExamplesCommon/TimedStartup.h>
 #include <VmbCExamplesCommon/VmbStdatomic.h>
 #include <VmbCExamplesCommon/VmbThreads.h>
 
@@ -52,6 +55,9 @@ volatile atomic_flag    g_shutdown                 = ATOMIC_FLAG_INIT;  // flag
 
 VmbBool_t               g_bUseAllocAndAnnouce      = VmbBoolFalse;      // Holds the optional decision about frame alloc and announce mode to access it from StopContinuousImageAcquisition()
 
+FramePredicate          g_framePredicate;                               // Decides which complete frames are processed
+ChunkDecoder            g_chunkDecoder;                                 // Extracts the chunk values needed by the predicate
+
 
 #ifdef _WIN32
 double          g_frequency                = 0.0;              //Frequency of tick counter in _WIN32
@@ -264,6 +270,29 @@ void VMB_CALL FrameCallback(const VmbHandle_t cameraHandle, const VmbHandle_t st
         }
     }
 
+    if (VmbFrameStatusComplete == frame->receiveStatus && 0 != g_framePredicate.conditionCount)
+    {
+        // decide based on the metadata only to avoid touching the image data of frames we'd discard anyway
+        ChunkValues values;
+        VmbBool_t valuesAvailable = VmbBoolFalse;
+        if (0 != g_framePredicate.requiredChunkFields)
+        {
+            valuesAvailable = (VmbErrorSuccess == ChunkDecoderDecode(&g_chunkDecoder, frame, &values));
+        }
+
+        if (!FramePredicateEvaluate(&g_framePredicate, frame, valuesAvailable ? &values : NULL))
+        {
+            // the statistics are guarded by the same mutex as the other counters
+            if (thrd_success == mtx_lock(&g_frameInfoMutex))
+            {
+                streamStatistics->framesRejected++;
+                mtx_unlock(&g_frameInfoMutex);
+            }
+            VmbCaptureFrameQueue(cameraHandle, frame, &FrameCallback);
+            return;
+        }
+    }
+
     if(showFrameInfos)
     {
         VmbBool_t frameIdAvailable = VmbFrameFlagsFrameID & frame->receiveFlags;
@@ -339,6 +368,7 @@ VmbError_t StartContinuousImageAcquisition(AsynchronousGrabOptions* options, Str
         g_frameID                  = 0;
         g_frameIdValid             = VmbBoolFalse;
         g_bUseAllocAndAnnouce      = options->allocAndAnnounce;
+        g_framePredicate           = options->framePredicate;
 
 #ifdef _WIN32
         LARGE_INTEGER nFrequency;
@@ -346,7 +376,7 @@ VmbError_t StartContinuousImageAcquisition(AsynchronousGrabOptions* options, Str
         g_frequency = (double)nFrequency.QuadPart;
 #endif  //_WIN32
 
-        err = VmbStartup(NULL);
+        err = TimedStartup(options->transportLayerFilter, NULL);
 
         PrintVmbVersion();
 
@@ -393,21 +423,19 @@ VmbError_t StartContinuousImageAcquisition(AsynchronousGrabOptions* options, Str
                     VmbCameraInfo_t info;
                     err = VmbCameraInfoQuery(cameraId, &info, sizeof(info));
                     VmbHandle_t stream = info.streamHandles[0];
-                    if (VmbErrorSuccess == VmbFeatureCommandRun(stream, ADJUST_PACKAGE_SIZE_COMMAND))
+                    VmbUint64_t adjustLatencyNs = 0;
+                    VmbError_t const adjustErr = RunFeatureCommand(stream, ADJUST_PACKAGE_SIZE_COMMAND, FEATURE_COMMAND_ADJUST_PACKET_SIZE_TIMEOUT_MS, &adjustLatencyNs);
+                    if (VmbErrorSuccess == adjustErr)
                     {
-                        VmbBool_t isCommandDone = VmbBoolFalse;
-                        do
-                        {
-                            if (VmbErrorSuccess != VmbFeatureCommandIsDone(stream,
-                                ADJUST_PACKAGE_SIZE_COMMAND,
-                                &isCommandDone))
-                            {
-                                break;
-                            }
-                        } while (VmbBoolFalse == isCommandDone);
                         VmbInt64_t packetSize = 0;
                         VmbFeatureIntGet(stream, "GVSPPacketSize", &packetSize);
-                        printf("GVSPAdjustPacketSize: %lld\n", packetSize);
+                        printf("GVSPAdjustPacketSize: %lld (in %.1f ms)\n", packetSize, adjustLatencyNs / 1e6);
+                    }
+                    else if (VmbErrorTimeout == adjustErr)
+                    {
+                        // the packet size may still change, so the stream must not be started
+                        printf("%s did not complete within %d ms\n", ADJUST_PACKAGE_SIZE_COMMAND, FEATURE_COMMAND_ADJUST_PACKET_SIZE_TIMEOUT_MS);
+                        err = adjustErr;
                     }
 
                     // Evaluate required alignment for frame buffer in case announce frame method is used
@@ -433,6 +461,15 @@ VmbError_t StartContinuousImageAcquisition(AsynchronousGrabOptions* options, Str
                         printf("StreamBufferAlignment=%lld (%ld)\n", nStreamBufferAlignment, alignment);
                     }
 
+                    if (VmbErrorSuccess == err && 0 != g_framePredicate.requiredChunkFields)
+                    {
+                        // the chunks need to be enabled before the payload size is queried
+                        if (VmbErrorSuccess != ChunkDecoderEnableChunks(g_cameraHandle, g_framePredicate.requiredChunkFields))
+                        {
+                            printf("Could not activate the chunk mode; frames are rejected by filters requiring chunk values\n");
+                        }
+                    }
+
                     if (VmbErrorSuccess == err)
                     {
                         VmbUint32_t payloadSize = 0;
@@ -441,6 +478,8 @@ VmbError_t StartContinuousImageAcquisition(AsynchronousGrabOptions* options, Str
                         err = VmbPayloadSizeGet(g_cameraHandle, &payloadSize);
                         if (VmbErrorSuccess == err)
                         {
+                            ChunkDecoderInit(&g_chunkDecoder, payloadSize, g_framePredicate.requiredChunkFields);
+
                             const size_t offset = payloadSize & mask;
                             const size_t offsetToNext = (alignment - offset) & mask;
                             const size_t alignedPayloadSize = payloadSize + offsetToNext;
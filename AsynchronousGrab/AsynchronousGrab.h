@@ -8,6 +8,8 @@
 
 #include <VmbC/VmbCommonTypes.h>
 
+#include <VmbCExamplesCommon/FramePredicate.h>
+
 typedef enum FrameInfos
 {
     FrameInfos_Undefined,
@@ -23,6 +25,8 @@ typedef struct AsynchronousGrabOptions
     VmbBool_t   enableColorProcessing;
     VmbBool_t   allocAndAnnounce;
     char const* cameraId;
+    char const* transportLayerFilter;   // see ParseTransportLayerFilter; NULL for all transport layers
+    FramePredicate framePredicate;  // complete frames rejected by the predicate are requeued without being processed
 } AsynchronousGrabOptions;
 
 typedef struct FrameStatistics
@@ -32,6 +36,7 @@ typedef struct FrameStatistics
     VmbUint64_t framesIncomplete;
     VmbUint64_t framesTooSmall;
     VmbUint64_t framesInvalid;
+    VmbUint64_t framesRejected;
 } StreamStatistics;
 
 /**
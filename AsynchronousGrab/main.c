@@ -32,17 +32,26 @@ BOOL WINAPI ConsoleHandler(DWORD signal)
 #define VMB_PARAM_FRAME_INFOS "/i"
 #define VMB_PARAM_SHOW_CORRUPT_FRAMES "/a"
 #define VMB_PARAM_ALLOC_AND_ANNOUNCE "/x"
+#define VMB_PARAM_FILTER "/f"
+#define VMB_PARAM_TRANSPORT_LAYERS "/tl"
 #define VMB_PARAM_PRINT_HELP "/h"
 
 void PrintUsage(void)
 {
-    printf("Usage: AsynchronousGrab [CameraID] [/i] [/h]\n"
+    printf("Usage: AsynchronousGrab [CameraID] [/i] [/f <condition>]... [/tl <filter>] [/h]\n"
            "Parameters:   CameraID    ID of the camera to use (using first camera if not specified)\n"
            "              %s          Convert to RGB and show RGB values\n"
            "              %s          Enable color processing (includes %s)\n"
            "              %s          Show frame infos\n"
            "              %s          Automatically only show frame infos of corrupt frames\n"
            "              %s          AllocAndAnnounce mode: Buffers are allocated by the GenTL producer\n"
+           "              %s <cond>   Only process complete frames fulfilling the condition; may be specified multiple times:\n"
+           "                          exposure=<min>:<max>  exposure time in us within the range (uses chunk data)\n"
+           "                          line=<bit>            line status bit set (uses chunk data)\n"
+           "                          nth=<n>               frame id is a multiple of n\n"
+           "              %s <filter>\n"
+           "                          Load only the transport layers of a comma separated list of types and paths,\n"
+           "                          e.g. GigE,USB or /opt/VimbaX/cti/VimbaUSBTL.cti\n"
            "              %s          Print out help\n",
            VMB_PARAM_RGB,
            VMB_PARAM_COLOR_PROCESSING,
@@ -50,6 +59,8 @@ void PrintUsage(void)
            VMB_PARAM_FRAME_INFOS,
            VMB_PARAM_SHOW_CORRUPT_FRAMES,
            VMB_PARAM_ALLOC_AND_ANNOUNCE,
+           VMB_PARAM_FILTER,
+           VMB_PARAM_TRANSPORT_LAYERS,
            VMB_PARAM_PRINT_HELP);
 }
 
@@ -63,6 +74,8 @@ VmbError_t ParseCommandLineParameters(AsynchronousGrabOptions* cmdOptions, VmbBo
     cmdOptions->enableColorProcessing   = VmbBoolFalse;
     cmdOptions->allocAndAnnounce        = VmbBoolFalse;
     cmdOptions->cameraId                = NULL;
+    cmdOptions->transportLayerFilter    = NULL;
+    FramePredicateInit(&cmdOptions->framePredicate);
 
     char** const paramsEnd = argv + argc;
     for (char** param = argv + 1; result == VmbErrorSuccess && param != paramsEnd; ++param)
@@ -107,6 +120,32 @@ VmbError_t ParseCommandLineParameters(AsynchronousGrabOptions* cmdOptions, VmbBo
             {
                 cmdOptions->allocAndAnnounce = VmbBoolTrue;
             }
+            else if (0 == strcmp(*param, VMB_PARAM_FILTER))
+            {
+                ++param;
+                if (param == paramsEnd)
+                {
+                    printf("%s requires a condition\n", VMB_PARAM_FILTER);
+                    result = VmbErrorBadParameter;
+                    break;
+                }
+                if (VmbErrorSuccess != FramePredicateAddCondition(&cmdOptions->framePredicate, *param))
+                {
+                    printf("invalid filter condition: %s\n", *param);
+                    result = VmbErrorBadParameter;
+                }
+            }
+            else if (0 == strcmp(*param, VMB_PARAM_TRANSPORT_LAYERS))
+            {
+                ++param;
+                if (param == paramsEnd)
+                {
+                    printf("%s requires a list of transport layer types and paths\n", VMB_PARAM_TRANSPORT_LAYERS);
+                    result = VmbErrorBadParameter;
+                    break;
+                }
+                cmdOptions->transportLayerFilter = *param;
+            }
             else if (0 == strcmp(*param, VMB_PARAM_PRINT_HELP))
             {
                 if (argc != 2)
@@ -159,7 +198,7 @@ int main(int argc, char* argv[])
     VmbBool_t printHelp;
     VmbError_t err = ParseCommandLineParameters(&cmdOptions, &printHelp, argc, argv);
 
-    StreamStatistics streamStatistics = { 0, 0, 0, 0, 0 };
+    StreamStatistics streamStatistics = { 0, 0, 0, 0, 0, 0 };
 
     if (err == VmbErrorSuccess && !printHelp)
     {
@@ -188,6 +227,11 @@ int main(int argc, char* argv[])
                 printf("Frames total      = %llu\n", framesTotal);
                 printf("Frames missing    = %llu\n", streamStatistics.framesMissing);
             }
+
+            if (cmdOptions.framePredicate.conditionCount != 0)
+            {
+                printf("Frames rejected by the filter = %llu\n", streamStatistics.framesRejected);
+            }
         }
         else
         {
@@ -15,7 +15,7 @@
 #include "AcquisitionManager.h"
 #include "VmbException.h"
 
-#include "UI/MainWindow.h"
+#include <VmbCExamplesCommon/FeatureCommand.h>
 
 namespace VmbC
 {
@@ -29,6 +29,11 @@ namespace VmbC
              */
             constexpr char const* AdjustPackageSizeCommand = "GVSPAdjustPacketSize";
 
+            /**
+             * \brief timeout for starting and stopping the acquisition
+             */
+            constexpr VmbUint32_t AcquisitionCommandTimeoutMs = 10000;
+
             struct AcquisitionContext
             {
                 AcquisitionManager* m_acquisitionManager;
@@ -60,13 +65,37 @@ namespace VmbC
 
         void AcquisitionManager::StopAcquisition() noexcept
         {
+            try
+            {
+                m_frameSaver.CancelRequest();
+            }
+            catch (...)
+            {
+            }
             m_imageTranscoder.Stop();
             m_openCamera.reset();
         }
 
-        AcquisitionManager::AcquisitionManager(MainWindow& renderWindow)
-            : m_renderWindow(renderWindow),
-            m_imageTranscoder(*this)
+        void AcquisitionManager::StartFrameInjection()
+        {
+            StopAcquisition();
+            m_imageTranscoder.Start();
+        }
+
+        void AcquisitionManager::InjectFrame(VmbFrame_t const& frame)
+        {
+            m_imageTranscoder.PostImage(nullptr, nullptr, &frame);
+        }
+
+        ImageTranscoder::Statistics AcquisitionManager::GetTranscodingStatistics() const
+        {
+            return m_imageTranscoder.GetStatistics();
+        }
+
+        AcquisitionManager::AcquisitionManager(Listener& listener)
+            : m_listener(listener),
+            m_imageTranscoder(*this),
+            m_frameSaver([this](std::string const& message) { m_listener.ReportCaptureProgress(message); })
         {
         }
 
@@ -78,7 +107,7 @@ namespace VmbC
 
         void AcquisitionManager::ConvertedFrameReceived(QPixmap image)
         {
-            m_renderWindow.RenderImage(image);
+            m_listener.RenderImage(image);
         }
 
         void AcquisitionManager::SetOutputSize(QSize size)
@@ -86,6 +115,16 @@ namespace VmbC
             m_imageTranscoder.SetOutputSize(size);
         }
 
+        void AcquisitionManager::SetViewport(QRectF visibleRegion, bool panning)
+        {
+            m_imageTranscoder.SetViewport(visibleRegion, panning);
+        }
+
+        bool AcquisitionManager::CaptureFrames(std::string const& directory, FrameSaver::FileFormat format, VmbUint32_t frameCount)
+        {
+            return m_frameSaver.RequestFrames(directory, format, frameCount);
+        }
+
         void VMB_CALL AcquisitionManager::FrameCallback(VmbHandle_t /* cameraHandle */, VmbHandle_t const streamHandle, VmbFrame_t* frame)
         {
             if (frame != nullptr)
@@ -100,6 +139,18 @@ namespace VmbC
 
         void AcquisitionManager::FrameReceived(VmbHandle_t const streamHandle, VmbFrame_t const* frame)
         {
+            if (frame != nullptr && frame->receiveStatus == VmbFrameStatusComplete)
+            {
+                try
+                {
+                    // copies the frame data, if requested, before the frame is passed on for requeuing
+                    m_frameSaver.FrameReceived(*frame);
+                }
+                catch (std::bad_alloc const&)
+                {
+                    m_listener.ReportCaptureProgress("Not enough memory to copy frame " + std::to_string(frame->frameID));
+                }
+            }
             m_imageTranscoder.PostImage(streamHandle, &AcquisitionManager::FrameCallback, frame);
         }
 
@@ -142,21 +193,20 @@ namespace VmbC
             if (!errorHappened)
             {
                 // execute packet size adjustment, if this is a AVT GigE camera
-                if (VmbErrorSuccess == VmbFeatureCommandRun(refreshedCameraInfo.streamHandles[0], AdjustPackageSizeCommand))
+                VmbUint64_t adjustLatencyNs = 0;
+                error = RunFeatureCommand(refreshedCameraInfo.streamHandles[0], AdjustPackageSizeCommand,
+                                          FEATURE_COMMAND_ADJUST_PACKET_SIZE_TIMEOUT_MS, &adjustLatencyNs);
+                if (error == VmbErrorSuccess)
                 {
-                    VmbBool_t isCommandDone = VmbBoolFalse;
-                    do
-                    {
-                        if (VmbErrorSuccess != VmbFeatureCommandIsDone(refreshedCameraInfo.streamHandles[0],
-                            AdjustPackageSizeCommand,
-                            &isCommandDone))
-                        {
-                            break;
-                        }
-                    } while (VmbBoolFalse == isCommandDone);
                     VmbInt64_t packetSize = 0;
                     VmbFeatureIntGet(refreshedCameraInfo.streamHandles[0], "GVSPPacketSize", &packetSize);
-                    printf("GVSPAdjustPacketSize: %lld\n", packetSize);
+                    printf("GVSPAdjustPacketSize: %lld (in %.1f ms)\n", packetSize, adjustLatencyNs / 1e6);
+                }
+                else if (error == VmbErrorTimeout)
+                {
+                    // the packet size may still change, so the stream must not be started
+                    VmbCameraClose(m_cameraHandle);
+                    throw VmbException::ForOperation(error, std::string("RunFeatureCommand(") + AdjustPackageSizeCommand + ")");
                 }
 
                 try
@@ -216,22 +266,15 @@ namespace VmbC
         {
             void RunCommand(VmbHandle_t const camHandle, std::string const& command)
             {
-                auto error = VmbFeatureCommandRun(camHandle, command.c_str());
+                VmbUint64_t latencyNs = 0;
+                auto const error = RunFeatureCommand(camHandle, command.c_str(), AcquisitionCommandTimeoutMs, &latencyNs);
 
                 if (error != VmbErrorSuccess)
                 {
-                    throw VmbException::ForOperation(error, "VmbFeatureCommandRun");
+                    throw VmbException::ForOperation(error, "RunFeatureCommand(" + command + ")");
                 }
 
-                VmbBool_t done = false;
-                while (!done)
-                {
-                    error = VmbFeatureCommandIsDone(camHandle, command.c_str(), &done);
-                    if (error != VmbErrorSuccess)
-                    {
-                        throw VmbException::ForOperation(error, "VmbFeatureCommandIsDone");
-                    }
-                }
+                printf("%s completed after %.1f us\n", command.c_str(), latencyNs / 1000.0);
             }
         }
 
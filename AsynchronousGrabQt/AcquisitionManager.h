@@ -13,17 +13,18 @@
 #define ASYNCHRONOUSGRAB_C_ACQUISITION_MANAGER_H
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <QPixmap>
+#include <QRectF>
 #include <QSize>
 
 #include <VmbC/VmbC.h>
 
+#include "FrameSaver.h"
 #include "ImageTranscoder.h"
 
-class MainWindow;
-
 namespace VmbC
 {
     namespace Examples
@@ -40,6 +41,24 @@ namespace VmbC
         public:
             static constexpr VmbUint32_t BufferCount = 10;
 
+            /**
+             * \brief interface for objects receiving the results of the acquisition
+             */
+            struct Listener
+            {
+                virtual ~Listener() = default;
+
+                /**
+                 * \brief receives a converted frame; called from a background thread
+                 */
+                virtual void RenderImage(QPixmap image) = 0;
+
+                /**
+                 * \brief receives a message about saving frames; called from a background thread
+                 */
+                virtual void ReportCaptureProgress(std::string const& message) = 0;
+            };
+
             /**
              * \return true, if currently an acquisition is running
              */
@@ -58,7 +77,26 @@ namespace VmbC
              */
             void StopAcquisition() noexcept;
 
-            AcquisitionManager(MainWindow& renderWindow);
+            /**
+             * \brief start the conversion of frames passed to InjectFrame without
+             *        opening a camera, e.g. for benchmarking the conversion
+             */
+            void StartFrameInjection();
+
+            /**
+             * \brief pass a frame to the conversion as if it was received from
+             *        a camera; the frame is not requeued
+             *
+             * \warning The frame needs to stay valid until StopAcquisition is called
+             */
+            void InjectFrame(VmbFrame_t const& frame);
+
+            /**
+             * \brief get the statistics of the frame conversion since the last start
+             */
+            ImageTranscoder::Statistics GetTranscodingStatistics() const;
+
+            AcquisitionManager(Listener& listener);
 
             ~AcquisitionManager();
 
@@ -73,8 +111,21 @@ namespace VmbC
              */
             void SetOutputSize(QSize size);
 
+            /**
+             * \brief informs this object about the change of the part of the
+             *        image that is visible
+             */
+            void SetViewport(QRectF visibleRegion, bool panning);
+
+            /**
+             * \brief save the next frameCount frames received to a directory
+             *
+             * \return false, if a previous snapshot/burst is still in progress
+             */
+            bool CaptureFrames(std::string const& directory, FrameSaver::FileFormat format, VmbUint32_t frameCount);
+
         private:
-            MainWindow& m_renderWindow;
+            Listener& m_listener;
 
             class StreamLifetime;
 
@@ -158,6 +209,11 @@ namespace VmbC
              */
             ImageTranscoder m_imageTranscoder;
 
+            /**
+             * \brief Object used for saving snapshots and bursts of frames
+             */
+            FrameSaver m_frameSaver;
+
             /**
              * \brief callback to receive the notification about new frames from VmbC
              */
@@ -0,0 +1,314 @@
+/**
+ * \date 2023
+ * \copyright Allied Vision Technologies. All Rights Reserved.
+ *
+ * \copyright Subject to the BSD 3-Clause License.
+ *
+ * \brief Implementation of ::VmbC::Examples::FrameSaver
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QString>
+
+#include "FrameSaver.h"
+#include "Image.h"
+#include "VmbException.h"
+
+namespace VmbC
+{
+    namespace Examples
+    {
+        namespace
+        {
+            /**
+             * \brief the maximum number of threads used for encoding
+             */
+            constexpr unsigned MaxWorkerCount = 8;
+
+            char const* GetFileExtension(FrameSaver::FileFormat format) noexcept
+            {
+                switch (format)
+                {
+                case FrameSaver::FileFormat::Png:
+                    return "png";
+                case FrameSaver::FileFormat::Tiff:
+                    return "tiff";
+                default:
+                    return "raw";
+                }
+            }
+
+            double ToMilliseconds(std::chrono::steady_clock::duration duration) noexcept
+            {
+                return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(duration).count();
+            }
+        }
+
+        FrameSaver::FrameSaver(ProgressCallback progressCallback)
+            : m_progressCallback(std::move(progressCallback))
+        {
+            unsigned const workerCount = (std::max)(1u, (std::min)(std::thread::hardware_concurrency(), MaxWorkerCount));
+
+            m_workers.reserve(workerCount);
+            for (unsigned i = 0; i != workerCount; ++i)
+            {
+                m_workers.emplace_back(&FrameSaver::WorkerLoop, this);
+            }
+        }
+
+        FrameSaver::~FrameSaver()
+        {
+            CancelRequest();
+            {
+                std::lock_guard<std::mutex> lock(m_taskMutex);
+                m_terminated = true;
+            }
+            m_taskCondition.notify_all();
+            for (auto& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        bool FrameSaver::RequestFrames(std::string const& directory, FileFormat format, VmbUint32_t frameCount)
+        {
+            if (frameCount == 0)
+            {
+                return true;
+            }
+
+            std::shared_ptr<CaptureJob> job(new CaptureJob());
+            job->m_directory = directory;
+            job->m_format = format;
+            job->m_frameCount = frameCount;
+            job->m_framesExpected.store(frameCount);
+            job->m_filePrefix = QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz").toStdString();
+
+            std::lock_guard<std::mutex> lock(m_requestMutex);
+            if (m_framesRequested.load() != 0)
+            {
+                return false;
+            }
+            m_currentJob = std::move(job);
+            m_framesRequested.store(frameCount);
+            return true;
+        }
+
+        void FrameSaver::CancelRequest()
+        {
+            std::shared_ptr<CaptureJob> job;
+            {
+                std::lock_guard<std::mutex> lock(m_requestMutex);
+                m_framesRequested.store(0);
+                std::swap(job, m_currentJob);
+            }
+
+            if (job)
+            {
+                m_progressCallback("Capture canceled after " + std::to_string(job->m_framesCopied) + " of "
+                                   + std::to_string(job->m_frameCount) + " frames");
+
+                // the frames already copied are still saved; if they are done, no worker reports the summary
+                job->m_framesExpected.store(job->m_framesCopied);
+                ReportSummaryIfDone(*job);
+            }
+        }
+
+        void FrameSaver::FrameReceived(VmbFrame_t const& frame)
+        {
+            if (m_framesRequested.load(std::memory_order_relaxed) == 0)
+            {
+                return;
+            }
+
+            std::unique_ptr<SaveTask> task(new SaveTask());
+
+            {
+                std::lock_guard<std::mutex> lock(m_requestMutex);
+                if (m_framesRequested.load() == 0 || !m_currentJob)
+                {
+                    return;
+                }
+
+                if (m_currentJob->m_framesCopied == 0)
+                {
+                    m_currentJob->m_startTime = std::chrono::steady_clock::now();
+                }
+                ++m_currentJob->m_framesCopied;
+                task->m_job = m_currentJob;
+
+                if (m_framesRequested.fetch_sub(1) == 1)
+                {
+                    m_currentJob.reset();
+                }
+            }
+
+            // copy the image data only; the frame buffer may contain additional chunk data.
+            // Pixel format ids contain the number of bits per pixel in bits 16 to 23
+            auto const imageData = static_cast<unsigned char const*>(frame.imageData);
+            auto const bufferEnd = static_cast<unsigned char const*>(frame.buffer) + frame.bufferSize;
+            size_t const bitsPerPixel = (frame.pixelFormat >> 16) & 0xFF;
+            size_t const imageSize = (std::min)(static_cast<size_t>(frame.width) * frame.height * bitsPerPixel / 8,
+                                                static_cast<size_t>(bufferEnd - imageData));
+            task->m_data.assign(imageData, imageData + imageSize);
+
+            task->m_frame = frame;
+            task->m_frame.buffer = task->m_data.data();
+            task->m_frame.bufferSize = static_cast<VmbUint32_t>(task->m_data.size());
+            task->m_frame.imageData = task->m_data.data();
+
+            {
+                std::lock_guard<std::mutex> lock(m_taskMutex);
+                m_tasks.emplace_back(std::move(task));
+            }
+            m_taskCondition.notify_one();
+        }
+
+        void FrameSaver::WorkerLoop()
+        {
+            std::unique_lock<std::mutex> lock(m_taskMutex);
+
+            while (true)
+            {
+                m_taskCondition.wait(lock, [this]() { return m_terminated || !m_tasks.empty(); });
+
+                if (m_tasks.empty())
+                {
+                    // terminated and no frames left to save
+                    return;
+                }
+
+                std::unique_ptr<SaveTask> task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+
+                lock.unlock();
+
+                bool success = false;
+                VmbUint64_t bytesWritten = 0;
+                try
+                {
+                    bytesWritten = SaveFrame(*task);
+                    success = true;
+                }
+                catch (VmbException const& ex)
+                {
+                    m_progressCallback(std::string("Error saving frame ") + std::to_string(task->m_frame.frameID) + ": " + ex.what());
+                }
+                catch (std::bad_alloc const&)
+                {
+                    m_progressCallback("Error saving frame " + std::to_string(task->m_frame.frameID) + ": out of memory");
+                }
+
+                ReportFrameDone(*(task->m_job), success, bytesWritten);
+
+                lock.lock();
+            }
+        }
+
+        VmbUint64_t FrameSaver::SaveFrame(SaveTask const& task)
+        {
+            CaptureJob const& job = *task.m_job;
+            VmbFrame_t const& frame = task.m_frame;
+
+            std::ostringstream fileName;
+            fileName << job.m_filePrefix << '_' << frame.frameID;
+            if (job.m_format == FileFormat::Raw)
+            {
+                // raw files don't contain any info about the image, so store it in the file name
+                fileName << '_' << frame.width << 'x' << frame.height << "_0x" << std::hex << frame.pixelFormat;
+            }
+            fileName << '.' << GetFileExtension(job.m_format);
+
+            QString const path = QDir(QString::fromStdString(job.m_directory)).filePath(QString::fromStdString(fileName.str()));
+
+            if (job.m_format == FileFormat::Raw)
+            {
+                QFile file(path);
+                if (!file.open(QIODevice::WriteOnly)
+                    || file.write(reinterpret_cast<char const*>(task.m_data.data()), static_cast<qint64>(task.m_data.size())) != static_cast<qint64>(task.m_data.size()))
+                {
+                    throw VmbException("Unable to write " + path.toStdString());
+                }
+                return task.m_data.size();
+            }
+
+            Image const source(frame);
+            Image target(VmbPixelFormatRgb8);
+            target.Convert(source);
+
+            QImage const image(target.GetData(),
+                               target.GetWidth(),
+                               target.GetHeight(),
+                               target.GetBytesPerLine(),
+                               QImage::Format_RGB888);
+
+            if (!image.save(path, job.m_format == FileFormat::Png ? "PNG" : "TIFF"))
+            {
+                throw VmbException("Unable to write " + path.toStdString());
+            }
+            return static_cast<VmbUint64_t>(QFile(path).size());
+        }
+
+        void FrameSaver::ReportFrameDone(CaptureJob& job, bool success, VmbUint64_t bytesWritten)
+        {
+            VmbUint32_t done;
+            if (success)
+            {
+                job.m_bytesWritten += bytesWritten;
+                done = ++job.m_framesSaved + job.m_framesFailed.load();
+            }
+            else
+            {
+                done = job.m_framesSaved.load() + ++job.m_framesFailed;
+            }
+
+            if (!ReportSummaryIfDone(job)
+                && job.m_frameCount >= 10 && (done % (job.m_frameCount / 10)) == 0)
+            {
+                // report progress of bursts in steps of 10%
+                m_progressCallback("Saved " + std::to_string(done) + " of " + std::to_string(job.m_frameCount) + " frames");
+            }
+        }
+
+        bool FrameSaver::ReportSummaryIfDone(CaptureJob& job)
+        {
+            VmbUint32_t const expected = job.m_framesExpected.load();
+            VmbUint32_t const saved = job.m_framesSaved.load();
+            VmbUint32_t const failed = job.m_framesFailed.load();
+
+            // a job canceled before its first frame was copied has nothing to summarize
+            if (expected == 0 || saved + failed != expected || job.m_summaryReported.exchange(true))
+            {
+                return false;
+            }
+
+            double const milliseconds = ToMilliseconds(std::chrono::steady_clock::now() - job.m_startTime);
+            double const seconds = (std::max)(milliseconds / 1000.0, 1e-6);
+            double const megaBytes = job.m_bytesWritten.load() / (1024.0 * 1024.0);
+
+            std::ostringstream message;
+            message.precision(1);
+            message << std::fixed
+                    << "Saved " << saved << " of " << job.m_frameCount << " frames to " << job.m_directory
+                    << " in " << milliseconds << " ms ("
+                    << (saved / seconds) << " frames/s, "
+                    << (megaBytes / seconds) << " MB/s)";
+            if (failed != 0)
+            {
+                message << ", " << failed << " failed";
+            }
+            if (expected != job.m_frameCount)
+            {
+                message << ", canceled";
+            }
+            m_progressCallback(message.str());
+            return true;
+        }
+    }
+}
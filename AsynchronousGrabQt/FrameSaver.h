@@ -0,0 +1,212 @@
+/**
+ * \date 2023
+ * \copyright Allied Vision Technologies. All Rights Reserved.
+ *
+ * \copyright Subject to the BSD 3-Clause License.
+ *
+ * \brief Definition of a class responsible for copying frames and saving
+ *        them to disk using a pool of background threads
+ */
+
+#ifndef ASYNCHRONOUSGRAB_C_FRAME_SAVER_H
+#define ASYNCHRONOUSGRAB_C_FRAME_SAVER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <VmbC/VmbC.h>
+
+namespace VmbC
+{
+    namespace Examples
+    {
+
+        /**
+         * \brief Copies the data of requested frames and encodes the copies
+         *        on a pool of background threads.
+         *
+         * Copying the data allows the frame buffers to be requeued without
+         * waiting for the encoding to be done.
+         */
+        class FrameSaver
+        {
+        public:
+            /**
+             * \brief the formats the frames can be written in
+             */
+            enum class FileFormat
+            {
+                Png,
+                Tiff,
+                Raw,
+            };
+
+            /**
+             * \brief function receiving progress messages; called from
+             *        background threads
+             */
+            using ProgressCallback = std::function<void(std::string const&)>;
+
+            FrameSaver(ProgressCallback progressCallback);
+
+            /**
+             * \brief finishes encoding the frames already copied and stops
+             *        the background threads
+             */
+            ~FrameSaver();
+
+            FrameSaver(FrameSaver const&) = delete;
+            FrameSaver& operator=(FrameSaver const&) = delete;
+
+            /**
+             * \brief request the next frameCount complete frames to be saved
+             *
+             * \param[in] directory     the directory to write the files to
+             * \param[in] format        the file format to use
+             * \param[in] frameCount    the number of frames to save
+             *
+             * \return false, if the frames of a previous request still need to be copied
+             */
+            bool RequestFrames(std::string const& directory, FileFormat format, VmbUint32_t frameCount);
+
+            /**
+             * \brief cancel the copying of frames of the current request; frames
+             *        already copied are still saved
+             */
+            void CancelRequest();
+
+            /**
+             * \brief copy the frame, if frames are requested and schedule encoding it
+             *
+             * Called from the VmbC frame callback; the frame can be requeued as soon
+             * as this function returns.
+             */
+            void FrameReceived(VmbFrame_t const& frame);
+        private:
+            /**
+             * \brief info about a snapshot/burst request shared by all of its frames
+             */
+            struct CaptureJob
+            {
+                std::string m_directory;
+                FileFormat m_format;
+                VmbUint32_t m_frameCount;
+
+                /**
+                 * \brief prefix used for all file names of the job
+                 */
+                std::string m_filePrefix;
+
+                /**
+                 * \brief the time the first frame was copied
+                 */
+                std::chrono::steady_clock::time_point m_startTime;
+
+                /**
+                 * \brief number of frames already copied; guarded by FrameSaver::m_requestMutex
+                 */
+                VmbUint32_t m_framesCopied { 0 };
+
+                /**
+                 * \brief number of frames the job ends with; lowered to the
+                 *        number of frames copied, if the job is canceled
+                 */
+                std::atomic<VmbUint32_t> m_framesExpected { 0 };
+
+                std::atomic<VmbUint32_t> m_framesSaved { 0 };
+                std::atomic<VmbUint32_t> m_framesFailed { 0 };
+                std::atomic<VmbUint64_t> m_bytesWritten { 0 };
+
+                /**
+                 * \brief set by the thread reporting the summary of the job
+                 */
+                std::atomic<bool> m_summaryReported { false };
+            };
+
+            /**
+             * \brief a copy of a single frame waiting to be encoded
+             */
+            struct SaveTask
+            {
+                std::shared_ptr<CaptureJob> m_job;
+
+                /**
+                 * \brief frame info; imageData points to m_data
+                 */
+                VmbFrame_t m_frame;
+
+                std::vector<unsigned char> m_data;
+            };
+
+            ProgressCallback m_progressCallback;
+
+            /**
+             * \brief the number of frames still to be copied; allows the frame
+             *        callback to skip locking m_requestMutex in the common case
+             */
+            std::atomic<VmbUint32_t> m_framesRequested { 0 };
+
+            /**
+             * \brief mutex guarding m_currentJob
+             */
+            std::mutex m_requestMutex;
+
+            /**
+             * \brief the job frames are currently copied for
+             */
+            std::shared_ptr<CaptureJob> m_currentJob;
+
+            /**
+             * \brief mutex guarding m_tasks and m_terminated
+             */
+            std::mutex m_taskMutex;
+
+            /**
+             * \brief condition variable used to notify the workers about new
+             *        tasks; guarded by m_taskMutex
+             */
+            std::condition_variable m_taskCondition;
+
+            std::deque<std::unique_ptr<SaveTask>> m_tasks;
+
+            bool m_terminated { false };
+
+            std::vector<std::thread> m_workers;
+
+            /**
+             * \brief contains the logic executed by the worker threads
+             */
+            void WorkerLoop();
+
+            /**
+             * \brief encode and write a single frame
+             *
+             * \return the number of bytes written
+             */
+            VmbUint64_t SaveFrame(SaveTask const& task);
+
+            /**
+             * \brief update the job statistics and report the progress
+             */
+            void ReportFrameDone(CaptureJob& job, bool success, VmbUint64_t bytesWritten);
+
+            /**
+             * \brief report the summary of the job, if all of its frames are
+             *        done and no other thread reported it yet
+             *
+             * \return true, if the summary was reported
+             */
+            bool ReportSummaryIfDone(CaptureJob& job);
+        };
+    }
+}
+
+#endif
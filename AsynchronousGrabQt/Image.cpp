@@ -7,7 +7,9 @@
  * \brief Implementation of ::VmbC::Examples::Image
  */
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 
 #include <VmbImageTransform/VmbTransform.h>
 
@@ -60,7 +62,96 @@ namespace VmbC
                 throw VmbException::ForOperation(error, "VmbSetImageInfoFromPixelFormat");
             }
 
-            size_t requiredCapacity = GetBytesPerLine() * GetHeight();
+            Reserve(GetBytesPerLine() * GetHeight());
+
+            error = VmbImageTransform(&conversionSource.m_image, &m_image, nullptr, 0);
+            if (error != VmbErrorSuccess)
+            {
+                throw VmbException::ForOperation(error, "VmbImageTransform");
+            }
+        }
+
+        void Image::ExtractRegion(Image const& source,
+                                  VmbUint32_t offsetX,
+                                  VmbUint32_t offsetY,
+                                  VmbUint32_t width,
+                                  VmbUint32_t height,
+                                  VmbUint32_t step)
+        {
+            if (&source == this)
+            {
+                return;
+            }
+
+            VmbUint32_t const bitsPerPixel = source.m_image.ImageInfo.PixelInfo.BitsPerPixel;
+            VmbUint32_t const sourceWidth = source.m_image.ImageInfo.Width;
+            VmbUint32_t const sourceHeight = source.m_image.ImageInfo.Height;
+
+            // packed formats can only be cut at byte boundaries
+            bool const packed = (bitsPerPixel % 8) != 0;
+            VmbUint32_t const blockWidth = packed ? 8 : 2;
+            VmbUint32_t const blockHeight = 2;
+            if (packed || step == 0)
+            {
+                step = 1;
+            }
+
+            // extend the region to whole blocks within the source image
+            VmbUint32_t const left = (std::min)(offsetX, sourceWidth) / blockWidth * blockWidth;
+            VmbUint32_t const top = (std::min)(offsetY, sourceHeight) / blockHeight * blockHeight;
+            VmbUint32_t const right = (std::min)((std::min)(offsetX, sourceWidth) + width + blockWidth - 1, sourceWidth) / blockWidth * blockWidth;
+            VmbUint32_t const bottom = (std::min)((std::min)(offsetY, sourceHeight) + height + blockHeight - 1, sourceHeight) / blockHeight * blockHeight;
+
+            VmbUint32_t const blocksX = (right > left) ? ((right - left) / blockWidth + step - 1) / step : 0;
+            VmbUint32_t const blocksY = (bottom > top) ? ((bottom - top) / blockHeight + step - 1) / step : 0;
+
+            if (blocksX == 0 || blocksY == 0)
+            {
+                throw VmbException("Empty image region requested", VmbErrorBadParameter);
+            }
+
+            m_pixelFormat = source.m_pixelFormat;
+            auto error = VmbSetImageInfoFromPixelFormat(m_pixelFormat, blocksX * blockWidth, blocksY * blockHeight, &m_image);
+            if (error != VmbErrorSuccess)
+            {
+                throw VmbException::ForOperation(error, "VmbSetImageInfoFromPixelFormat");
+            }
+
+            size_t const sourceBytesPerLine = static_cast<size_t>(sourceWidth) * bitsPerPixel / 8;
+            size_t const targetBytesPerLine = static_cast<size_t>(blocksX) * blockWidth * bitsPerPixel / 8;
+            size_t const blockBytes = static_cast<size_t>(blockWidth) * bitsPerPixel / 8;
+            size_t const leftBytes = static_cast<size_t>(left) * bitsPerPixel / 8;
+
+            Reserve(targetBytesPerLine * blocksY * blockHeight);
+
+            auto const sourceData = static_cast<unsigned char const*>(source.m_image.Data);
+            auto targetLine = static_cast<unsigned char*>(m_image.Data);
+
+            for (VmbUint32_t blockY = 0; blockY != blocksY; ++blockY)
+            {
+                for (VmbUint32_t lineInBlock = 0; lineInBlock != blockHeight; ++lineInBlock, targetLine += targetBytesPerLine)
+                {
+                    size_t const sourceLineIndex = static_cast<size_t>(top) + static_cast<size_t>(blockY) * step * blockHeight + lineInBlock;
+                    unsigned char const* sourcePos = sourceData + sourceLineIndex * sourceBytesPerLine + leftBytes;
+
+                    if (step == 1)
+                    {
+                        std::memcpy(targetLine, sourcePos, targetBytesPerLine);
+                    }
+                    else
+                    {
+                        unsigned char* targetPos = targetLine;
+                        for (VmbUint32_t blockX = 0; blockX != blocksX; ++blockX, targetPos += blockBytes, sourcePos += blockBytes * step)
+                        {
+                            std::memcpy(targetPos, sourcePos, blockBytes);
+                        }
+                    }
+                }
+            }
+        }
+
+        void Image::Reserve(size_t requiredCapacity)
+        {
             if (requiredCapacity > m_capacity)
             {
                 void* newData;
@@ -81,12 +172,6 @@ namespace VmbC
                 m_image.Data = newData;
                 m_capacity = requiredCapacity;
             }
-
-            error = VmbImageTransform(&conversionSource.m_image, &m_image, nullptr, 0);
-            if (error != VmbErrorSuccess)
-            {
-                throw VmbException::ForOperation(error, "VmbImageTransform");
-            }
         }
     }
 }
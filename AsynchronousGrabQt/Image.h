@@ -73,6 +73,29 @@ namespace VmbC
              * \brief convert the data of conversionImage to the pixel format of this image
              */
             void Convert(Image const& conversionSource);
+
+            /**
+             * \brief copy a rectangular region of source to this image using the pixel
+             *        format of source, optionally skipping pixels to reduce the resolution
+             *
+             * The region is extended to blocks of 2x2 pixels to preserve bayer patterns
+             * and YUV macro pixels. For formats using a number of bits per pixel that is
+             * not divisible by 8 the region is extended to 8 pixel wide blocks and no
+             * pixels are skipped.
+             *
+             * \param[in] source   the image to copy the data from
+             * \param[in] offsetX  the horizontal offset of the region in pixels
+             * \param[in] offsetY  the vertical offset of the region in pixels
+             * \param[in] width    the width of the region in pixels
+             * \param[in] height   the height of the region in pixels
+             * \param[in] step     only every step-th block of pixels is copied in both directions
+             */
+            void ExtractRegion(Image const& source,
+                               VmbUint32_t offsetX,
+                               VmbUint32_t offsetY,
+                               VmbUint32_t width,
+                               VmbUint32_t height,
+                               VmbUint32_t step);
         private:
             bool m_dataOwned{true};
             VmbImage m_image;
@@ -83,6 +106,11 @@ namespace VmbC
              */
             size_t m_capacity { 0 };
 
+            /**
+             * \brief make sure the owned buffer provides at least requiredCapacity bytes
+             */
+            void Reserve(size_t requiredCapacity);
+
         };
     }
 }
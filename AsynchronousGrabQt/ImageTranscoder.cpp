@@ -8,6 +8,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <thread>
 #include <type_traits>
@@ -20,6 +21,12 @@
 #include <QImage>
 #include <QPixmap>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
 #include <VmbC/VmbC.h>
 
 namespace VmbC
@@ -50,12 +57,17 @@ namespace VmbC
                         }
                         else
                         {
+                            ++m_statistics.m_framesPosted;
+                            if (m_task)
+                            {
+                                ++m_statistics.m_framesDropped;
+                            }
                             m_task = std::move(message);
                             notify = true;
                         }
                     }
                 }
-                else
+                else if (callback != nullptr)
                 {
                     // try to renequeue the frame we won't pass to the image transformation
                     VmbCaptureFrameQueue(streamHandle, frame, callback);
@@ -77,6 +89,7 @@ namespace VmbC
                     throw VmbException("ImageTranscoder is still running");
                 }
                 m_terminated = false;
+                m_statistics = Statistics();
             }
             m_thread = std::thread(&ImageTranscoder::TranscodeLoop, std::ref(*this));
         }
@@ -106,6 +119,19 @@ namespace VmbC
             m_outputSize = size;
         }
 
+        void ImageTranscoder::SetViewport(QRectF visibleRegion, bool panning)
+        {
+            std::lock_guard<std::mutex> lock(m_sizeMutex);
+            m_visibleRegion = visibleRegion & QRectF(0.0, 0.0, 1.0, 1.0);
+            m_panning = panning;
+        }
+
+        ImageTranscoder::Statistics ImageTranscoder::GetStatistics() const
+        {
+            std::lock_guard<std::mutex> lock(m_inputMutex);
+            return m_statistics;
+        }
+
         ImageTranscoder::~ImageTranscoder()
         {
             // tell the thread about the shutdown
@@ -115,6 +141,36 @@ namespace VmbC
             }
         }
 
+        namespace
+        {
+            /**
+             * \brief get the CPU time used by the calling thread
+             */
+            std::chrono::nanoseconds GetThreadCpuTime() noexcept
+            {
+#ifdef _WIN32
+                FILETIME creationTime;
+                FILETIME exitTime;
+                FILETIME kernelTime;
+                FILETIME userTime;
+                if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+                {
+                    return std::chrono::nanoseconds(0);
+                }
+                // FILETIME uses units of 100 ns
+                auto const toTicks = [](FILETIME const& time) { return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime; };
+                return std::chrono::nanoseconds((toTicks(kernelTime) + toTicks(userTime)) * 100);
+#else
+                timespec time;
+                if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+                {
+                    return std::chrono::nanoseconds(0);
+                }
+                return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+#endif
+            }
+        }
+
         void ImageTranscoder::TranscodeLoopMember()
         {
             std::unique_lock<std::mutex> lock(m_inputMutex);
@@ -138,11 +194,15 @@ namespace VmbC
 
                     lock.unlock();
 
+                    bool success = false;
+                    auto const cpuTimeStart = GetThreadCpuTime();
+
                     if (task)
                     {
                         try
                         {
                             TranscodeImage(*task);
+                            success = true;
                         }
                         catch (VmbException const&)
                         {
@@ -154,8 +214,16 @@ namespace VmbC
                         }
                     }
 
+                    auto const cpuTime = GetThreadCpuTime() - cpuTimeStart;
+
                     lock.lock();
 
+                    if (task)
+                    {
+                        ++(success ? m_statistics.m_framesConverted : m_statistics.m_framesFailed);
+                        m_statistics.m_conversionCpuTime += cpuTime;
+                    }
+
                     if (m_terminated)
                     {
                         // got terminated during conversion -> don't reenqueue frames
@@ -204,17 +272,55 @@ namespace VmbC
 
         void ImageTranscoder::TranscodeImage(TransformationTask& task)
         {
-            VmbFrame_t const& frame = task.m_frame;
+            QSize size;
+            QRectF visibleRegion;
+            bool panning;
+
+            {
+                std::lock_guard<std::mutex> lock(m_sizeMutex);
+                size = m_outputSize;
+                visibleRegion = m_visibleRegion;
+                panning = m_panning;
+            }
 
             Image const source(task.m_frame);
 
-            // allocate new image, if necessary
+            // determine the part of the frame that is visible
+            double const frameWidth = source.GetWidth();
+            double const frameHeight = source.GetHeight();
+            VmbUint32_t const left = static_cast<VmbUint32_t>(std::floor(visibleRegion.left() * frameWidth));
+            VmbUint32_t const top = static_cast<VmbUint32_t>(std::floor(visibleRegion.top() * frameHeight));
+            VmbUint32_t const width = (std::max)(static_cast<VmbUint32_t>(std::ceil(visibleRegion.right() * frameWidth)), left + 1) - left;
+            VmbUint32_t const height = (std::max)(static_cast<VmbUint32_t>(std::ceil(visibleRegion.bottom() * frameHeight)), top + 1) - top;
+
+            // skip pixels that would not be visible at the display resolution anyways;
+            // round up while panning to keep the conversion cheap
+            VmbUint32_t step = 1;
+            if (size.width() > 0 && size.height() > 0)
+            {
+                double const ratio = (std::max)(static_cast<double>(width) / size.width(), static_cast<double>(height) / size.height());
+                step = static_cast<VmbUint32_t>((std::max)(panning ? std::ceil(ratio) : std::floor(ratio), 1.0));
+            }
+
+            // allocate new images, if necessary
             if (!m_transformTarget)
             {
                 m_transformTarget.reset(new Image(ConversionFormats.VmbTransformFormat));
             }
 
-            m_transformTarget->Convert(source);
+            if (step == 1 && width == task.m_frame.width && height == task.m_frame.height)
+            {
+                m_transformTarget->Convert(source);
+            }
+            else
+            {
+                if (!m_regionImage)
+                {
+                    m_regionImage.reset(new Image());
+                }
+                m_regionImage->ExtractRegion(source, left, top, width, height, step);
+                m_transformTarget->Convert(*m_regionImage);
+            }
 
             QImage qImage(m_transformTarget->GetData(),
                           m_transformTarget->GetWidth(),
@@ -222,16 +328,13 @@ namespace VmbC
                           m_transformTarget->GetBytesPerLine(),
                           ConversionFormats.QtImageFormat);
 
-            QPixmap pixmap = QPixmap::fromImage(qImage, Qt::ImageConversionFlag::ColorOnly);
-
-            QSize size;
-
-            {
-                std::lock_guard<std::mutex> lock(m_sizeMutex);
-                size = m_outputSize;
-            }
+            // the converted image is already close to the display resolution: use the more expensive
+            // smooth transformation for the remaining scaling unless the user is panning the image
+            QImage const scaled = qImage.scaled(size,
+                                                Qt::AspectRatioMode::KeepAspectRatio,
+                                                panning ? Qt::TransformationMode::FastTransformation : Qt::TransformationMode::SmoothTransformation);
 
-            m_acquisitionManager.ConvertedFrameReceived(pixmap.scaled(size, Qt::AspectRatioMode::KeepAspectRatio));
+            m_acquisitionManager.ConvertedFrameReceived(QPixmap::fromImage(scaled, Qt::ImageConversionFlag::ColorOnly));
         }
 
         void ImageTranscoder::TranscodeLoop(ImageTranscoder& transcoder)
@@ -248,7 +351,7 @@ namespace VmbC
 
         ImageTranscoder::TransformationTask::~TransformationTask()
         {
-            if (!m_canceled)
+            if (!m_canceled && m_callback != nullptr)
             {
                 VmbCaptureFrameQueue(m_streamHandle, &m_frame, m_callback);
             }
@@ -11,11 +11,13 @@
 #ifndef ASYNCHRONOUSGRAB_C_IMAGE_TRANSCODER_H
 #define ASYNCHRONOUSGRAB_C_IMAGE_TRANSCODER_H
 
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
 
+#include <QRectF>
 #include <QSize>
 
 #include <VmbC/VmbC.h>
@@ -34,12 +36,46 @@ namespace VmbC
         class ImageTranscoder
         {
         public:
+            /**
+             * \brief counters for the frames passed to PostImage
+             */
+            struct Statistics
+            {
+                /**
+                 * \brief the number of complete frames passed to PostImage
+                 */
+                VmbUint64_t m_framesPosted{ 0 };
+
+                /**
+                 * \brief the number of frames converted successfully
+                 */
+                VmbUint64_t m_framesConverted{ 0 };
+
+                /**
+                 * \brief the number of frames replaced by a newer frame before
+                 *        the conversion started
+                 */
+                VmbUint64_t m_framesDropped{ 0 };
+
+                /**
+                 * \brief the number of frames the conversion failed for
+                 */
+                VmbUint64_t m_framesFailed{ 0 };
+
+                /**
+                 * \brief the CPU time of the background thread spent on converting
+                 *        the frames
+                 */
+                std::chrono::nanoseconds m_conversionCpuTime{ 0 };
+            };
+
             ImageTranscoder(AcquisitionManager& manager);
             ~ImageTranscoder();
 
             /**
              * \brief Asynchronously schedule the conversion of a frame
-             * \param callback the callback to use the old frame that is reenqueued
+             * \param callback the callback to use the old frame that is reenqueued;
+             *                 nullptr, if the frame should not be reenqueued
              */
             void PostImage(VmbHandle_t streamHandle, VmbFrameCallback callback, VmbFrame_t const* frame);
 
@@ -57,6 +93,20 @@ namespace VmbC
              * \brief update the size of the QPixmaps to produce
              */
             void SetOutputSize(QSize size);
+
+            /**
+             * \brief update the part of the frames to convert
+             *
+             * \param visibleRegion the region to convert relative to the frame size
+             * \param panning true, if the region is currently changing quickly and
+             *                conversion speed is preferred to quality
+             */
+            void SetViewport(QRectF visibleRegion, bool panning);
+
+            /**
+             * \brief get the statistics since the last call of Start()
+             */
+            Statistics GetStatistics() const;
         private:
             /**
              * \brief size of QPixmaps to produce
@@ -64,7 +114,18 @@ namespace VmbC
             QSize m_outputSize;
 
             /**
-             * \brief mutex for guarding access to m_outputSize
+             * \brief the part of the frame to convert relative to the frame size
+             */
+            QRectF m_visibleRegion{ 0.0, 0.0, 1.0, 1.0 };
+
+            /**
+             * \brief true, if the fast nearest-neighbour scaling should be used
+             */
+            bool m_panning{ false };
+
+            /**
+             * \brief mutex for guarding access to m_outputSize, m_visibleRegion
+             *        and m_panning
              */
             std::mutex m_sizeMutex;
 
@@ -113,7 +174,7 @@ namespace VmbC
             /**
              * \brief mutex guarding the frame data received
              */
-            std::mutex m_inputMutex;
+            mutable std::mutex m_inputMutex;
 
             /**
              * \brief condition variable used to notify the background thread
@@ -121,6 +182,11 @@ namespace VmbC
              */
             std::condition_variable m_inputCondition;
 
+            /**
+             * \brief statistics about the frames posted; guarded by m_inputMutex
+             */
+            Statistics m_statistics;
+
             /**
              * \brief info about the next conversion to do
              */
@@ -131,6 +197,11 @@ namespace VmbC
              */
             std::unique_ptr<Image> m_transformTarget;
 
+            /**
+             * \brief copy of the visible part of the frame at reduced resolution
+             */
+            std::unique_ptr<Image> m_regionImage;
+
             /**
              * \brief true, if the background thread should terminate; guarded
              *        by m_inputMutex
@@ -3,17 +3,145 @@
   Subject to the BSD 3-Clause License.
 =============================================================================*/
 
+#include <algorithm>
+#include <cmath>
+
+#include <QMouseEvent>
+#include <QPixmap>
 #include <QResizeEvent>
+#include <QWheelEvent>
 
 #include "UI/ImageLabel.h"
 
+namespace
+{
+    constexpr double MaxZoom = 32.0;
+
+    /**
+     * \brief zoom factor applied per wheel step (120 units of QWheelEvent::angleDelta())
+     */
+    constexpr double ZoomPerWheelStep = 1.25;
+}
+
 ImageLabel::ImageLabel(QWidget* parent, Qt::WindowFlags flags)
     : QLabel(parent, flags)
 {
 }
 
+QRectF ImageLabel::GetVisibleRegion() const
+{
+    double const extent = 1.0 / m_zoom;
+    return QRectF(m_center.x() - extent / 2, m_center.y() - extent / 2, extent, extent);
+}
+
 void ImageLabel::resizeEvent(QResizeEvent* event)
 {
     QLabel::resizeEvent(event);
     emit sizeChanged(event->size());
 }
+
+void ImageLabel::wheelEvent(QWheelEvent* event)
+{
+    double const steps = event->angleDelta().y() / 120.0;
+    double const newZoom = (std::min)((std::max)(m_zoom * std::pow(ZoomPerWheelStep, steps), 1.0), MaxZoom);
+
+    if (newZoom == m_zoom)
+    {
+        return;
+    }
+
+    // keep the image position under the cursor at the same place, if the cursor is above the image
+    QRectF const pixmapRect = GetPixmapRect();
+    QPointF relativeCursorPos(0.5, 0.5);
+    if (pixmapRect.contains(event->pos()))
+    {
+        relativeCursorPos = QPointF((event->pos().x() - pixmapRect.left()) / pixmapRect.width(),
+                                    (event->pos().y() - pixmapRect.top()) / pixmapRect.height());
+    }
+
+    QPointF const offset = relativeCursorPos - QPointF(0.5, 0.5);
+    QPointF const imagePos = m_center + offset / m_zoom;
+
+    m_zoom = newZoom;
+    m_center = imagePos - offset / m_zoom;
+    ClampCenter();
+
+    EmitViewportChanged();
+    event->accept();
+}
+
+void ImageLabel::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton && m_zoom > 1.0)
+    {
+        m_panning = true;
+        m_lastMousePosition = event->pos();
+        EmitViewportChanged();
+    }
+    QLabel::mousePressEvent(event);
+}
+
+void ImageLabel::mouseMoveEvent(QMouseEvent* event)
+{
+    if (m_panning)
+    {
+        QRectF const pixmapRect = GetPixmapRect();
+        if (!pixmapRect.isEmpty())
+        {
+            QPoint const delta = event->pos() - m_lastMousePosition;
+            m_center -= QPointF(delta.x() / pixmapRect.width(), delta.y() / pixmapRect.height()) / m_zoom;
+            ClampCenter();
+            EmitViewportChanged();
+        }
+        m_lastMousePosition = event->pos();
+    }
+    QLabel::mouseMoveEvent(event);
+}
+
+void ImageLabel::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton && m_panning)
+    {
+        m_panning = false;
+        EmitViewportChanged(); // request a frame converted with full quality again
+    }
+    QLabel::mouseReleaseEvent(event);
+}
+
+void ImageLabel::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    m_zoom = 1.0;
+    m_center = QPointF(0.5, 0.5);
+    m_panning = false;
+    EmitViewportChanged();
+    QLabel::mouseDoubleClickEvent(event);
+}
+
+QRectF ImageLabel::GetPixmapRect() const
+{
+    QPixmap const* currentPixmap = pixmap();
+    if (currentPixmap == nullptr || currentPixmap->isNull())
+    {
+        return QRectF();
+    }
+
+    // the pixmap is centered in the label (Qt::AlignCenter)
+    QSizeF const pixmapSize = currentPixmap->size();
+    QRectF const area = contentsRect();
+    return QRectF(area.left() + (area.width() - pixmapSize.width()) / 2,
+                  area.top() + (area.height() - pixmapSize.height()) / 2,
+                  pixmapSize.width(),
+                  pixmapSize.height());
+}
+
+void ImageLabel::ClampCenter()
+{
+    double const halfExtent = 0.5 / m_zoom;
+    m_center.setX((std::min)((std::max)(m_center.x(), halfExtent), 1.0 - halfExtent));
+    m_center.setY((std::min)((std::max)(m_center.y(), halfExtent), 1.0 - halfExtent));
+}
+
+void ImageLabel::EmitViewportChanged()
+{
+    emit viewportChanged(GetVisibleRegion(), m_panning);
+}
@@ -11,22 +11,62 @@
 #define ASYNCHRONOUSGRAB_C_IMAGE_LABEL_H
 
 #include <QLabel>
+#include <QPoint>
+#include <QPointF>
+#include <QRectF>
 #include <QSize>
 
 /**
  * \brief Widget for displaying a the images received from a camera.
- *        Provides a signal for listening to size updates
+ *        Provides a signal for listening to size updates.
+ *
+ * The mouse wheel zooms into the image, dragging with the left mouse button
+ * pans the zoomed image and a double click resets the view. The visible part
+ * of the image is reported via the viewportChanged signal.
  */
 class ImageLabel : public QLabel
 {
     Q_OBJECT
 public:
     ImageLabel(QWidget* parent = 0, Qt::WindowFlags flags = Qt::Widget);
+
+    /**
+     * \brief get the part of the image that is currently visible
+     *
+     * \return the visible region in coordinates relative to the image size,
+     *         i.e. (0, 0, 1, 1) is the full image
+     */
+    QRectF GetVisibleRegion() const;
 protected:
     /**
      * \brief adds sizeChanged signal emission to QLabel::resizeEvent
      */
     void resizeEvent(QResizeEvent* event) override;
+
+    /**
+     * \brief zooms in/out keeping the image position under the cursor fixed
+     */
+    void wheelEvent(QWheelEvent* event) override;
+
+    /**
+     * \brief starts panning the image
+     */
+    void mousePressEvent(QMouseEvent* event) override;
+
+    /**
+     * \brief moves the visible region while panning
+     */
+    void mouseMoveEvent(QMouseEvent* event) override;
+
+    /**
+     * \brief stops panning the image
+     */
+    void mouseReleaseEvent(QMouseEvent* event) override;
+
+    /**
+     * \brief resets zoom and pan
+     */
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
 signals:
     /**
      * \brief signal triggered during the resize event
@@ -34,6 +74,44 @@ signals:
      */
     void sizeChanged(QSize value);
 
+    /**
+     * \brief signal triggered whenever zoom, pan position or panning state change
+     * \param visibleRegion the visible region as returned by GetVisibleRegion()
+     * \param panning true, if the user is currently dragging the image
+     */
+    void viewportChanged(QRectF visibleRegion, bool panning);
+private:
+    /**
+     * \brief the zoom factor; 1 means the whole image is visible
+     */
+    double m_zoom{ 1.0 };
+
+    /**
+     * \brief center of the visible region relative to the image size
+     */
+    QPointF m_center{ 0.5, 0.5 };
+
+    /**
+     * \brief true while the left mouse button is held down
+     */
+    bool m_panning{ false };
+
+    /**
+     * \brief the mouse position of the last move event while panning
+     */
+    QPoint m_lastMousePosition;
+
+    /**
+     * \brief get the rectangle the current pixmap is drawn to
+     */
+    QRectF GetPixmapRect() const;
+
+    /**
+     * \brief move m_center to keep the visible region inside the image
+     */
+    void ClampCenter();
+
+    void EmitViewportChanged();
 };
 
 #endif
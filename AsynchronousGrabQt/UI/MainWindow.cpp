@@ -5,6 +5,7 @@
 
 #include <algorithm>
 
+#include <QFileDialog>
 #include <QItemSelection>
 #include <QPixmap>
 
@@ -18,10 +19,57 @@
 
 #include <QTreeWidgetItem>
 
+#include <VmbCExamplesCommon/HandleIndex.h>
+
 using VmbC::Examples::VmbException;
 using VmbC::Examples::LogEntry;
 using VmbC::Examples::LogEntryListModel;
 
+namespace
+{
+    /**
+     * \brief Maps the handles of modules to their data using a HandleIndex
+     */
+    class ModuleIndex
+    {
+    public:
+        explicit ModuleIndex(size_t expectedCount)
+        {
+            VmbError_t const error = HandleIndexInit(&m_index, static_cast<VmbUint32_t>(expectedCount));
+            if (error != VmbErrorSuccess)
+            {
+                throw VmbException::ForOperation(error, "HandleIndexInit");
+            }
+        }
+
+        ~ModuleIndex()
+        {
+            HandleIndexFree(&m_index);
+        }
+
+        ModuleIndex(ModuleIndex const&) = delete;
+        ModuleIndex& operator=(ModuleIndex const&) = delete;
+
+        void Insert(VmbHandle_t handle, VmbC::Examples::ModuleData* module)
+        {
+            VmbError_t const error = HandleIndexInsert(&m_index, handle, module);
+            if (error != VmbErrorSuccess)
+            {
+                throw VmbException::ForOperation(error, "HandleIndexInsert");
+            }
+        }
+
+        template<class T>
+        T* Find(VmbHandle_t handle) const
+        {
+            return static_cast<T*>(static_cast<VmbC::Examples::ModuleData*>(HandleIndexFind(&m_index, handle)));
+        }
+
+    private:
+        HandleIndex m_index;
+    };
+}
+
 namespace Text
 {
     QString StartAcquisition()
@@ -34,6 +82,11 @@ namespace Text
         return "Stop Acquisition";
     }
 
+    QString SelectSaveDirectory()
+    {
+        return "Select Directory for Saved Frames";
+    }
+
     QString WindowTitleStartupError()
     {
         return "Vmb C AsynchronousGrab API Version";
@@ -92,6 +145,7 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags flags)
         SetupCameraTree();
         m_acquisitionManager.SetOutputSize(m_ui->m_renderLabel->size());
         QObject::connect(m_ui->m_renderLabel, &ImageLabel::sizeChanged, this, &MainWindow::ImageLabelSizeChanged);
+        QObject::connect(m_ui->m_renderLabel, &ImageLabel::viewportChanged, this, &MainWindow::ImageLabelViewportChanged);
     }
     else
     {
@@ -130,11 +184,70 @@ void MainWindow::StartStopClicked()
 
 }
 
+void MainWindow::SnapshotClicked()
+{
+    CaptureFrames(1);
+}
+
+void MainWindow::BurstClicked()
+{
+    CaptureFrames(static_cast<VmbUint32_t>(m_ui->m_burstFrameCountSpinBox->value()));
+}
+
+void MainWindow::CaptureFrames(VmbUint32_t frameCount)
+{
+    if (m_saveDirectory.isEmpty())
+    {
+        m_saveDirectory = QFileDialog::getExistingDirectory(this, Text::SelectSaveDirectory());
+        if (m_saveDirectory.isEmpty())
+        {
+            return;
+        }
+        Log("Saving frames to " + m_saveDirectory.toStdString());
+    }
+
+    using FileFormat = VmbC::Examples::FrameSaver::FileFormat;
+
+    FileFormat format;
+    switch (m_ui->m_saveFormatComboBox->currentIndex())
+    {
+    case 0:
+        format = FileFormat::Png;
+        break;
+    case 1:
+        format = FileFormat::Tiff;
+        break;
+    default:
+        format = FileFormat::Raw;
+        break;
+    }
+
+    if (!m_acquisitionManager.CaptureFrames(m_saveDirectory.toStdString(), format, frameCount))
+    {
+        Log("The frames of the previous snapshot/burst are still being copied");
+    }
+}
+
+void MainWindow::ReportCaptureProgress(std::string const& message)
+{
+    emit CaptureProgressReported(QString::fromStdString(message));
+}
+
+void MainWindow::LogCaptureProgress(QString message)
+{
+    Log(message.toStdString());
+}
+
 void MainWindow::ImageLabelSizeChanged(QSize newSize)
 {
     m_acquisitionManager.SetOutputSize(newSize);
 }
 
+void MainWindow::ImageLabelViewportChanged(QRectF visibleRegion, bool panning)
+{
+    m_acquisitionManager.SetViewport(visibleRegion, panning);
+}
+
 void MainWindow::RenderImage()
 {
     QPixmap pixmap;
@@ -161,6 +274,9 @@ void MainWindow::SetupUi(VmbC::Examples::ApiController& controller)
 
     QObject::connect(m_ui->m_acquisitionStartStopButton, &QPushButton::clicked, this, &MainWindow::StartStopClicked);
     QObject::connect(this, &MainWindow::ImageReady, this, static_cast<void (MainWindow::*)()>(&MainWindow::RenderImage), Qt::ConnectionType::QueuedConnection);
+    QObject::connect(m_ui->m_snapshotButton, &QPushButton::clicked, this, &MainWindow::SnapshotClicked);
+    QObject::connect(m_ui->m_burstButton, &QPushButton::clicked, this, &MainWindow::BurstClicked);
+    QObject::connect(this, &MainWindow::CaptureProgressReported, this, &MainWindow::LogCaptureProgress, Qt::ConnectionType::QueuedConnection);
 }
 
 void MainWindow::SetupLogView()
@@ -189,6 +305,8 @@ void MainWindow::StartAcquisition(VmbCameraInfo_t const& cameraInfo)
         Log("Acquisition Started");
         // update button text
         m_ui->m_acquisitionStartStopButton->setText(Text::StopAcquisition());
+        m_ui->m_snapshotButton->setEnabled(true);
+        m_ui->m_burstButton->setEnabled(true);
     }
 }
 
@@ -202,6 +320,9 @@ void MainWindow::StopAcquisition()
 
     button.setText(Text::StartAcquisition());
     button.setEnabled(m_ui->m_cameraSelectionTree->selectionModel()->hasSelection());
+
+    m_ui->m_snapshotButton->setEnabled(false);
+    m_ui->m_burstButton->setEnabled(false);
 }
 
 void MainWindow::CameraSelected(QItemSelection const& newSelection)
@@ -227,6 +348,7 @@ void MainWindow::CameraSelected(QItemSelection const& newSelection)
 MainWindow::~MainWindow()
 {
     QObject::disconnect(m_ui->m_renderLabel, &ImageLabel::sizeChanged, this, &MainWindow::ImageLabelSizeChanged);
+    QObject::disconnect(m_ui->m_renderLabel, &ImageLabel::viewportChanged, this, &MainWindow::ImageLabelViewportChanged);
     m_acquisitionManager.StopAcquisition();
 }
 
@@ -270,47 +392,52 @@ void MainWindow::SetupCameraTree()
         auto interfaces = m_apiController->GetInterfaceList();
         auto cameras = m_apiController->GetCameraList();
 
-        auto const systemsBegin = systems.begin();
-        auto const systemsEnd = systems.end();
+        // index the parent modules by handle, so every child module is matched in constant time
+        ModuleIndex systemIndex(systems.size());
+        for (auto const& sysPtr : systems)
+        {
+            systemIndex.Insert(sysPtr->GetInfo().transportLayerHandle, sysPtr.get());
+        }
 
         auto ifEnd = std::stable_partition(interfaces.begin(), interfaces.end(),
-                                           [this, systemsBegin, systemsEnd](std::unique_ptr<InterfaceData> const& ifPtr)
+                                           [this, &systemIndex](std::unique_ptr<InterfaceData> const& ifPtr)
                                            {
                                                auto iface = ifPtr.get();
-                                               auto parentIter = std::find_if(systemsBegin, systemsEnd, [iface](std::unique_ptr<TlData> const& sysPtr)
-                                                                              {
-                                                                                  return sysPtr->GetInfo().transportLayerHandle == iface->GetInfo().transportLayerHandle;
-                                                                              });
-                                               if (parentIter == systemsEnd)
+                                               auto parent = systemIndex.Find<TlData>(iface->GetInfo().transportLayerHandle);
+                                               if (parent == nullptr)
                                                {
                                                    Log(std::string("parent module not found for interface ") + iface->GetInfo().interfaceName + " ignoring interface");
                                                    return false;
                                                }
                                                else
                                                {
-                                                   iface->SetParent(parentIter->get());
+                                                   iface->SetParent(parent);
                                                    return true;
                                                }
                                            });
 
         auto ifBegin = interfaces.begin();
 
+        // only the interfaces with a parent are part of the tree
+        ModuleIndex interfaceIndex(static_cast<size_t>(std::distance(ifBegin, ifEnd)));
+        for (auto iter = ifBegin; iter != ifEnd; ++iter)
+        {
+            interfaceIndex.Insert((*iter)->GetInfo().interfaceHandle, iter->get());
+        }
+
         auto camerasEnd = std::stable_partition(cameras.begin(), cameras.end(),
-                                           [this, ifBegin, ifEnd](std::unique_ptr<CameraData> const& camPtr)
+                                           [this, &interfaceIndex](std::unique_ptr<CameraData> const& camPtr)
                                            {
                                                auto cam = camPtr.get();
-                                               auto parentIter = std::find_if(ifBegin, ifEnd, [cam](std::unique_ptr<InterfaceData> const& ifacePtr)
-                                                                              {
-                                                                                  return ifacePtr->GetInfo().interfaceHandle == cam->GetInfo().interfaceHandle;
-                                                                              });
-                                               if (parentIter == ifEnd)
+                                               auto parent = interfaceIndex.Find<InterfaceData>(cam->GetInfo().interfaceHandle);
+                                               if (parent == nullptr)
                                                {
                                                    Log(std::string("parent module not found for camera ") + cam->GetInfo().cameraName + " ignoring camera");
                                                    return false;
                                                }
                                                else
                                                {
-                                                   cam->SetParent(parentIter->get());
+                                                   cam->SetParent(parent);
                                                    return true;
                                                }
                                            });
@@ -15,6 +15,8 @@
 
 #include <QMainWindow>
 #include <QPixmap>
+#include <QRectF>
+#include <QString>
 
 #include <VmbC/VmbC.h>
 
@@ -52,7 +54,7 @@ namespace VmbC
  * \brief The GUI. Displays the available cameras, the image received and an
  *        event log.
  */
-class MainWindow : public QMainWindow
+class MainWindow : public QMainWindow, public VmbC::Examples::AcquisitionManager::Listener
 {
     Q_OBJECT
 public:
@@ -63,7 +65,13 @@ public:
     /**
      * \brief Asynchonously schedule rendering of image
      */
-    void RenderImage(QPixmap image);
+    void RenderImage(QPixmap image) override;
+
+    /**
+     * \brief Asynchonously add a message about saving frames to the log;
+     *        may be called from any thread
+     */
+    void ReportCaptureProgress(std::string const& message) override;
 private:
     using Gui = Ui::AsynchronousGrabGui;
 
@@ -89,6 +97,12 @@ private:
      */
     std::mutex m_imageSynchronizer;
 
+    /**
+     * \brief the directory snapshots and bursts are written to; empty, if
+     *        not selected yet
+     */
+    QString m_saveDirectory;
+
     /**
      * \brief Object for managing the acquisition; this includes the transfer
      *        of converted images to this object
@@ -139,6 +153,11 @@ private:
      */
     void StopAcquisition();
 
+    /**
+     * \brief save the next frameCount frames using the format selected in the gui
+     */
+    void CaptureFrames(VmbUint32_t frameCount);
+
 private slots:
 
     /**
@@ -151,11 +170,33 @@ private slots:
      */
     void StartStopClicked();
 
+    /**
+     * \brief Slot for clicks of the snapshot button
+     */
+    void SnapshotClicked();
+
+    /**
+     * \brief Slot for clicks of the burst button
+     */
+    void BurstClicked();
+
+    /**
+     * \brief Slot for adding messages reported via ReportCaptureProgress to the log.
+     *
+     * Thread affinity with this object required
+     */
+    void LogCaptureProgress(QString message);
+
     /**
      * \brief Slot for the size changes of the label used for rendering the images
      */
     void ImageLabelSizeChanged(QSize newSize);
 
+    /**
+     * \brief Slot for zoom and pan changes of the label used for rendering the images
+     */
+    void ImageLabelViewportChanged(QRectF visibleRegion, bool panning);
+
     /**
      * \brief Slot for replacing the pixmap of the label used for rendering.
      *
@@ -168,6 +209,12 @@ signals:
      *        a new image being available for rendering
      */
     void ImageReady();
+
+    /**
+     * \brief signal emitted from a background thread to pass a message about
+     *        saving frames to the gui
+     */
+    void CaptureProgressReported(QString message);
 };
 
 #endif // ASYNCHRONOUSGRAB_C_MAIN_WINDOW_H
@@ -0,0 +1,324 @@
+/**
+ * \date 2023
+ * \copyright Allied Vision Technologies. All Rights Reserved.
+ *
+ * \copyright Subject to the BSD 3-Clause License.
+ *
+ * \brief Headless benchmark of the frame conversion of the Asynchronous Grab
+ *        Qt example.
+ *
+ * Synthetic frames in different pixel formats and resolutions are passed to
+ * ::VmbC::Examples::AcquisitionManager at a fixed rate; the results are
+ * written as JSON. No camera or display is required: the Qt offscreen
+ * platform is used, unless QT_QPA_PLATFORM is set explicitly.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QGuiApplication>
+#include <QPixmap>
+#include <QSize>
+
+#include <VmbC/VmbC.h>
+
+#include "AcquisitionManager.h"
+
+using VmbC::Examples::AcquisitionManager;
+using VmbC::Examples::ImageTranscoder;
+
+namespace
+{
+    constexpr char const* ParamDuration = "/d";
+    constexpr char const* ParamFrameRate = "/r";
+    constexpr char const* ParamOutputSize = "/s";
+    constexpr char const* ParamOutputFile = "/o";
+    constexpr char const* ParamHelp = "/h";
+
+    struct BenchmarkOptions
+    {
+        std::chrono::milliseconds m_duration{ 2000 };
+
+        /**
+         * \brief the rate frames are passed to the AcquisitionManager at; 0 for as fast as possible
+         */
+        double m_frameRate{ 100.0 };
+        QSize m_outputSize{ 1024, 768 };
+        char const* m_outputFile{ nullptr };
+    };
+
+    struct PixelFormatInfo
+    {
+        VmbPixelFormat_t m_pixelFormat;
+        char const* m_name;
+    };
+
+    PixelFormatInfo const PixelFormats[] =
+    {
+        { VmbPixelFormatMono8, "Mono8" },
+        { VmbPixelFormatMono12, "Mono12" },
+        { VmbPixelFormatMono12p, "Mono12p" },
+        { VmbPixelFormatBayerRG8, "BayerRG8" },
+        { VmbPixelFormatBayerRG12, "BayerRG12" },
+        { VmbPixelFormatRgb8, "RGB8" },
+    };
+
+    QSize const Resolutions[] =
+    {
+        { 640, 480 },
+        { 1936, 1216 },
+        { 4112, 3008 },
+    };
+
+    /**
+     * \brief counts the converted frames and ignores everything else
+     */
+    class BenchmarkListener : public AcquisitionManager::Listener
+    {
+    public:
+        void RenderImage(QPixmap) override
+        {
+            ++m_imagesRendered;
+        }
+
+        void ReportCaptureProgress(std::string const&) override
+        {
+        }
+
+        std::atomic<VmbUint64_t> m_imagesRendered{ 0 };
+    };
+
+    /**
+     * \brief frame filled with a synthetic pattern
+     */
+    struct SyntheticFrame
+    {
+        SyntheticFrame(VmbPixelFormat_t pixelFormat, VmbUint32_t width, VmbUint32_t height, VmbUint64_t frameId)
+        {
+            // pixel format ids contain the number of bits per pixel in bits 16 to 23
+            size_t const bitsPerPixel = (pixelFormat >> 16) & 0xFF;
+            m_data.resize((static_cast<size_t>(width) * height * bitsPerPixel + 7) / 8);
+
+            // use a different pattern for every frame to avoid benefitting from caches more than a camera would
+            VmbUint32_t state = static_cast<VmbUint32_t>(frameId * 2654435761u + 1);
+            for (auto& byte : m_data)
+            {
+                state = state * 1664525u + 1013904223u;
+                byte = static_cast<unsigned char>(state >> 24);
+            }
+
+            std::memset(&m_frame, 0, sizeof(m_frame));
+            m_frame.buffer = m_data.data();
+            m_frame.bufferSize = static_cast<VmbUint32_t>(m_data.size());
+            m_frame.imageData = m_data.data();
+            m_frame.receiveStatus = VmbFrameStatusComplete;
+            m_frame.receiveFlags = VmbFrameFlagsDimension | VmbFrameFlagsFrameID | VmbFrameFlagsImageData;
+            m_frame.pixelFormat = pixelFormat;
+            m_frame.width = width;
+            m_frame.height = height;
+            m_frame.frameID = frameId;
+        }
+
+        std::vector<unsigned char> m_data;
+        VmbFrame_t m_frame;
+    };
+
+    struct CaseResult
+    {
+        char const* m_pixelFormat;
+        QSize m_resolution;
+        double m_seconds;
+        ImageTranscoder::Statistics m_statistics;
+        VmbUint64_t m_imagesRendered;
+    };
+
+    CaseResult RunCase(BenchmarkOptions const& options, PixelFormatInfo const& format, QSize resolution)
+    {
+        std::vector<std::unique_ptr<SyntheticFrame>> frames;
+        for (VmbUint32_t i = 0; i != AcquisitionManager::BufferCount; ++i)
+        {
+            frames.emplace_back(new SyntheticFrame(format.m_pixelFormat, resolution.width(), resolution.height(), i));
+        }
+
+        BenchmarkListener listener;
+        AcquisitionManager manager(listener);
+        manager.SetOutputSize(options.m_outputSize);
+        manager.StartFrameInjection();
+
+        using Clock = std::chrono::steady_clock;
+        auto const start = Clock::now();
+        auto const end = start + options.m_duration;
+        auto const frameInterval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options.m_frameRate > 0.0 ? 1.0 / options.m_frameRate : 0.0));
+
+        auto nextFrameTime = start;
+        for (size_t frameIndex = 0; Clock::now() < end; ++frameIndex)
+        {
+            manager.InjectFrame(frames[frameIndex % frames.size()]->m_frame);
+
+            if (options.m_frameRate > 0.0)
+            {
+                nextFrameTime += frameInterval;
+                std::this_thread::sleep_until(nextFrameTime);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        auto const stop = Clock::now();
+        manager.StopAcquisition();
+
+        return CaseResult{ format.m_name,
+                           resolution,
+                           std::chrono::duration<double>(stop - start).count(),
+                           manager.GetTranscodingStatistics(),
+                           listener.m_imagesRendered.load() };
+    }
+
+    void WriteJson(std::ostream& out, BenchmarkOptions const& options, std::vector<CaseResult> const& results)
+    {
+        out << "{\n"
+            << "  \"inputFrameRate\": " << options.m_frameRate << ",\n"
+            << "  \"outputWidth\": " << options.m_outputSize.width() << ",\n"
+            << "  \"outputHeight\": " << options.m_outputSize.height() << ",\n"
+            << "  \"results\": [";
+
+        bool first = true;
+        for (auto const& result : results)
+        {
+            auto const& statistics = result.m_statistics;
+            double const cpuMicroseconds = std::chrono::duration<double, std::micro>(statistics.m_conversionCpuTime).count();
+            VmbUint64_t const conversions = statistics.m_framesConverted + statistics.m_framesFailed;
+
+            out << (first ? "\n" : ",\n")
+                << "    {\n"
+                << "      \"pixelFormat\": \"" << result.m_pixelFormat << "\",\n"
+                << "      \"width\": " << result.m_resolution.width() << ",\n"
+                << "      \"height\": " << result.m_resolution.height() << ",\n"
+                << "      \"durationSeconds\": " << result.m_seconds << ",\n"
+                << "      \"framesPosted\": " << statistics.m_framesPosted << ",\n"
+                << "      \"framesConverted\": " << statistics.m_framesConverted << ",\n"
+                << "      \"framesDropped\": " << statistics.m_framesDropped << ",\n"
+                << "      \"framesFailed\": " << statistics.m_framesFailed << ",\n"
+                << "      \"imagesRendered\": " << result.m_imagesRendered << ",\n"
+                << "      \"convertedFramesPerSecond\": " << (statistics.m_framesConverted / result.m_seconds) << ",\n"
+                << "      \"cpuTimePerFrameMicroseconds\": " << (conversions == 0 ? 0.0 : cpuMicroseconds / conversions) << "\n"
+                << "    }";
+            first = false;
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    void PrintUsage()
+    {
+        std::cerr << "Usage: AsynchronousGrabQtBenchmark [" << ParamDuration << " <milliseconds>] [" << ParamFrameRate << " <fps>] ["
+                  << ParamOutputSize << " <width>x<height>] [" << ParamOutputFile << " <file>]\n"
+                  << "Parameters:   " << ParamDuration << "    duration of each measurement (default 2000)\n"
+                  << "              " << ParamFrameRate << "    rate frames are passed to the conversion at; 0 for as fast as possible (default 100)\n"
+                  << "              " << ParamOutputSize << "    size of the pixmaps to produce (default 1024x768)\n"
+                  << "              " << ParamOutputFile << "    file to write the JSON results to (default: standard output)\n"
+                  << "              " << ParamHelp << "    Print out help\n";
+    }
+
+    bool ParseCommandLineParameters(BenchmarkOptions& options, int argc, char* argv[])
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string const param = argv[i];
+            bool const hasValue = (i + 1) < argc;
+
+            if (param == ParamDuration && hasValue)
+            {
+                options.m_duration = std::chrono::milliseconds(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (param == ParamFrameRate && hasValue)
+            {
+                options.m_frameRate = std::strtod(argv[++i], nullptr);
+            }
+            else if (param == ParamOutputSize && hasValue)
+            {
+                int width = 0;
+                int height = 0;
+                char* end = nullptr;
+                width = static_cast<int>(std::strtol(argv[++i], &end, 10));
+                if (*end == 'x')
+                {
+                    height = static_cast<int>(std::strtol(end + 1, nullptr, 10));
+                }
+                if (width <= 0 || height <= 0)
+                {
+                    std::cerr << "invalid output size: " << argv[i] << '\n';
+                    return false;
+                }
+                options.m_outputSize = QSize(width, height);
+            }
+            else if (param == ParamOutputFile && hasValue)
+            {
+                options.m_outputFile = argv[++i];
+            }
+            else
+            {
+                if (param != ParamHelp)
+                {
+                    std::cerr << "unknown command line option: " << param << "\n\n";
+                }
+                return false;
+            }
+        }
+        return options.m_duration.count() > 0 && options.m_frameRate >= 0.0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    if (!ParseCommandLineParameters(options, argc, argv))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // QPixmap requires a QGuiApplication, but no display is needed for the benchmark
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QGuiApplication application(argc, argv);
+
+    std::vector<CaseResult> results;
+    for (auto const& format : PixelFormats)
+    {
+        for (auto const& resolution : Resolutions)
+        {
+            std::cerr << "Measuring " << format.m_name << ' ' << resolution.width() << 'x' << resolution.height() << "...\n";
+            results.push_back(RunCase(options, format, resolution));
+        }
+    }
+
+    if (options.m_outputFile != nullptr)
+    {
+        std::ofstream file(options.m_outputFile);
+        if (!file)
+        {
+            std::cerr << "Unable to open " << options.m_outputFile << '\n';
+            return 1;
+        }
+        WriteJson(file, options, results);
+    }
+    else
+    {
+        WriteJson(std::cout, options, results);
+    }
+
+    return 0;
+}
@@ -13,57 +13,264 @@
 #endif
 
 #include "ChunkAccessProg.h"
+#include "ChunkLog.h"
 
+#include <VmbCExamplesCommon/CameraClock.h>
+#include <VmbCExamplesCommon/ChunkDecoder.h>
+#include <VmbCExamplesCommon/ClockDriftEstimator.h>
+#include <VmbCExamplesCommon/FeatureCommand.h>
 #include <VmbCExamplesCommon/ListCameras.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
 #include <VmbCExamplesCommon/PrintVmbVersion.h>
+#include <VmbCExamplesCommon/TimedStartup.h>
 
 #include <VmbC/VmbC.h>
 
 #define NUM_FRAMES ((size_t)5)
 
+#define BENCHMARK_DURATION_MS 10000
+
+/**
+ * \brief The chunk values extracted from every frame
+ */
+#define REQUESTED_CHUNK_FIELDS (CHUNK_FIELD_BIT(ChunkFieldTimestamp)       \
+                                | CHUNK_FIELD_BIT(ChunkFieldWidth)         \
+                                | CHUNK_FIELD_BIT(ChunkFieldHeight)        \
+                                | CHUNK_FIELD_BIT(ChunkFieldExposureTime)  \
+                                | CHUNK_FIELD_BIT(ChunkFieldGain)          \
+                                | CHUNK_FIELD_BIT(ChunkFieldFrameId)       \
+                                | CHUNK_FIELD_BIT(ChunkFieldLineStatusAll))
+
+/**
+ * \brief Timings collected in benchmark mode
+ */
+typedef struct BenchmarkStatistics
+{
+    VmbUint64_t framesMeasured;         //!< Number of frames the values were extracted from the buffer and via VmbChunkDataAccess for
+    VmbUint64_t decoderTimeNs;          //!< Total time spent in ChunkDecoderDecode
+    VmbUint64_t chunkAccessTimeNs;      //!< Total time spent reading the values via VmbChunkDataAccess
+    VmbUint64_t mismatches;             //!< Number of frames the values of both paths differed for
+} BenchmarkStatistics;
+
+static ChunkAccessOptions   g_options;
+static ChunkDecoder         g_chunkDecoder;         // only used from the frame callback of the single stream
+static BenchmarkStatistics  g_benchmarkStatistics;
+static ClockDriftEstimator  g_clockDriftEstimator;  // maps the camera timestamps to the host clock
+static ChunkLog             g_chunkLog;
+static VmbUint64_t          g_chunkLogErrors;
+
+static VmbBool_t ChunkValuesEqual(const ChunkValues* a, const ChunkValues* b)
+{
+    return a->validFields == b->validFields
+        && a->timestamp == b->timestamp
+        && a->width == b->width
+        && a->height == b->height
+        && a->exposureTime == b->exposureTime
+        && a->gain == b->gain
+        && a->frameId == b->frameId
+        && a->lineStatusAll == b->lineStatusAll;
+}
 
-VmbError_t VMB_CALL ChunkCallback(VmbHandle_t featureAccessHandle, void* userContext)
+/**
+ * \brief Print the relation between camera and host clock estimated from the frames received
+ */
+static void PrintClockDriftEstimation(void)
 {
-    VmbError_t err = VmbErrorSuccess;
-    VmbInt64_t ts = 0, w = 0, h = 0;
+    ClockDriftEstimator const* estimator = &g_clockDriftEstimator;
 
-    err = VmbFeatureIntGet(featureAccessHandle, "ChunkWidth", &w);
+    printf("\nCamera clock\n");
+    if (!estimator->modelValid)
+    {
+        printf("  Not enough frames received to estimate the drift\n");
+        return;
+    }
+    printf("  Drift                 : %.3f ppm\n", ClockDriftEstimatorDriftPpm(estimator));
+    printf("  Residual std deviation: %.1f us\n", estimator->residualStdDevNs / 1000.0);
+    printf("  Outliers in window    : %u of %u frames\n", estimator->sampleCount - estimator->inlierCount, estimator->sampleCount);
+    printf("  Clock resets          : %llu\n", estimator->resets);
+}
 
-    err = VmbFeatureIntGet(featureAccessHandle, "ChunkHeight", &h);
+static void PrintChunkValues(const ChunkValues* values)
+{
+    printf("  Chunk Data:");
+    if (values->validFields & CHUNK_FIELD_BIT(ChunkFieldTimestamp))
+    {
+        printf(" ts=%lld", values->timestamp);
+    }
+    if (values->validFields & CHUNK_FIELD_BIT(ChunkFieldWidth))
+    {
+        printf(" width=%lld", values->width);
+    }
+    if (values->validFields & CHUNK_FIELD_BIT(ChunkFieldHeight))
+    {
+        printf(" height=%lld", values->height);
+    }
+    if (values->validFields & CHUNK_FIELD_BIT(ChunkFieldExposureTime))
+    {
+        printf(" exposure=%.1f", values->exposureTime);
+    }
+    if (values->validFields & CHUNK_FIELD_BIT(ChunkFieldGain))
+    {
+        printf(" gain=%.2f", values->gain);
+    }
+    if (values->validFields & CHUNK_FIELD_BIT(ChunkFieldFrameId))
+    {
+        printf(" frameId=%lld", values->frameId);
+    }
+    if (values->validFields & CHUNK_FIELD_BIT(ChunkFieldLineStatusAll))
+    {
+        printf(" lineStatus=0x%llx", values->lineStatusAll);
+    }
+    printf("\n");
+}
 
-    err = VmbFeatureIntGet(featureAccessHandle, "ChunkTimestamp", &ts);
+/**
+ * \brief Extract the chunk values using both the decoder and VmbChunkDataAccess and record the time taken by each
+ */
+static VmbError_t MeasureChunkAccess(const VmbFrame_t* frame, ChunkValues* decoded)
+{
+    ChunkValues expected;
+
+    VmbUint64_t const framesDecodedBefore = g_chunkDecoder.framesDecoded;
 
-    printf("  Chunk Data: ts=%lld width=%lld height=%lld\n", ts, w, h);
+    VmbUint64_t const start = GetMonotonicTimeNs();
+    VmbError_t const decoderErr = ChunkDecoderDecode(&g_chunkDecoder, frame, decoded);
+    VmbUint64_t const decoderDone = GetMonotonicTimeNs();
+    VmbError_t const chunkAccessErr = ChunkDecoderReadWithChunkAccess(frame, REQUESTED_CHUNK_FIELDS, &expected);
+    VmbUint64_t const chunkAccessDone = GetMonotonicTimeNs();
 
-    return err;
+    // frames used for learning the layout would distort the comparison
+    if (g_chunkDecoder.framesDecoded != framesDecodedBefore)
+    {
+        ++g_benchmarkStatistics.framesMeasured;
+        g_benchmarkStatistics.decoderTimeNs += decoderDone - start;
+        g_benchmarkStatistics.chunkAccessTimeNs += chunkAccessDone - decoderDone;
+
+        if (decoderErr != chunkAccessErr || !ChunkValuesEqual(decoded, &expected))
+        {
+            ++g_benchmarkStatistics.mismatches;
+        }
+    }
+
+    return decoderErr;
+}
+
+static void PrintBenchmarkResults(void)
+{
+    BenchmarkStatistics const* stats = &g_benchmarkStatistics;
+
+    printf("\nChunk decoding benchmark\n");
+    printf("  Frames decoded from buffer     : %llu\n", g_chunkDecoder.framesDecoded);
+    printf("  Frames using VmbChunkDataAccess: %llu\n", g_chunkDecoder.framesChunkAccess);
+    printf("  Layout changes                 : %llu\n", g_chunkDecoder.layoutChanges);
+
+    if (g_chunkDecoder.learningFailed)
+    {
+        printf("  The chunk layout could not be learned; all values were read via VmbChunkDataAccess\n");
+    }
+    else if (g_chunkDecoder.chunkAccessFields != 0)
+    {
+        // values still matching several locations, e.g. a line status staying 0, or stored in an unsupported way
+        printf("  Read via VmbChunkDataAccess    :");
+        for (int field = 0; field < ChunkFieldCount; ++field)
+        {
+            if (g_chunkDecoder.chunkAccessFields & CHUNK_FIELD_BIT(field))
+            {
+                printf(" %s", ChunkFieldFeatureName((ChunkField)field));
+            }
+        }
+        printf("\n");
+    }
+
+    if (stats->framesMeasured == 0)
+    {
+        printf("  No frames measured\n");
+        return;
+    }
+
+    double const decoderNs = (double)stats->decoderTimeNs / (double)stats->framesMeasured;
+    double const chunkAccessNs = (double)stats->chunkAccessTimeNs / (double)stats->framesMeasured;
+
+    printf("  Frames measured                : %llu\n", stats->framesMeasured);
+    printf("  Decoder                        : %.0f ns per frame\n", decoderNs);
+    printf("  VmbChunkDataAccess             : %.0f ns per frame\n", chunkAccessNs);
+    printf("  Speedup                        : %.1fx\n", decoderNs > 0.0 ? chunkAccessNs / decoderNs : 0.0);
+    printf("  Mismatches                     : %llu\n", stats->mismatches);
 }
 
 
 void VMB_CALL FrameDoneCallback(const VmbHandle_t hCamera, const VmbHandle_t stream, VmbFrame_t* pFrame)
 {
+    VmbUint64_t const arrivalTimeNs = GetMonotonicTimeNs();
+
     VmbError_t err;
+    VmbBool_t const printFrames = !g_options.benchmark && g_options.logFile == NULL;
+    ChunkValues values;
+    VmbBool_t valuesAvailable = VmbBoolFalse;
 
     if (VmbFrameStatusComplete == pFrame->receiveStatus)
     {
-        printf("  Frame Done: id=%2.2lld ts=%lld  complete\n", pFrame->frameID, pFrame->timestamp);
+        if (g_options.benchmark)
+        {
+            valuesAvailable = (MeasureChunkAccess(pFrame, &values) == VmbErrorSuccess);
+        }
+        else
+        {
+            valuesAvailable = (ChunkDecoderDecode(&g_chunkDecoder, pFrame, &values) == VmbErrorSuccess);
+        }
+
+        // prefer the chunk timestamp, since the frame timestamp is not provided by all transport layers
+        VmbBool_t const chunkTimestampAvailable = valuesAvailable && (values.validFields & CHUNK_FIELD_BIT(ChunkFieldTimestamp));
+        VmbUint64_t const cameraTicks = chunkTimestampAvailable ? (VmbUint64_t)values.timestamp : pFrame->timestamp;
+        ClockDriftEstimatorAddSample(&g_clockDriftEstimator, cameraTicks, arrivalTimeNs);
+
+        if (!FramePredicateEvaluate(&g_options.framePredicate, pFrame, valuesAvailable ? &values : NULL))
+        {
+            // return the frame to the camera right away; it's neither printed nor logged
+            err = VmbCaptureFrameQueue(hCamera, pFrame, FrameDoneCallback);
+            return;
+        }
 
-        if (pFrame->chunkDataPresent)
+        if (printFrames)
         {
-            err = VmbChunkDataAccess(pFrame, ChunkCallback, 0);
+            printf("  Frame Done: id=%2.2lld ts=%lld  complete\n", pFrame->frameID, pFrame->timestamp);
+            if (valuesAvailable)
+            {
+                PrintChunkValues(&values);
+            }
+
+            VmbUint64_t hostNs;
+            if (ClockDriftEstimatorToHostNs(&g_clockDriftEstimator, cameraTicks, &hostNs))
+            {
+                printf("  Host time: %llu ns (received %+.1f us later)\n", hostNs, ((double)(VmbInt64_t)(arrivalTimeNs - hostNs)) / 1000.0);
+            }
         }
     }
-    else
+    else if (printFrames)
     {
         printf("  Frame Done: id=%2.2lld not successfully received. Error code: %d %s\n", pFrame->frameID, pFrame->receiveStatus, pFrame->receiveStatus == VmbFrameStatusIncomplete ? "(incomplete)" : "");
     }
 
+    // incomplete frames are logged too to allow evaluating the frame loss later
+    if (g_options.logFile != NULL && ChunkLogAppend(&g_chunkLog, pFrame, valuesAvailable ? &values : NULL) != VmbErrorSuccess)
+    {
+        ++g_chunkLogErrors;
+    }
+
     err = VmbCaptureFrameQueue(hCamera, pFrame, FrameDoneCallback);
 }
 
 
-int ChunkAccessProg(void)
+int ChunkAccessProg(const ChunkAccessOptions* options)
 {
-    VmbError_t err = VmbStartup(NULL);
+    g_options = *options;
+
+    if (g_options.logFile != NULL && ChunkLogOpen(&g_chunkLog, g_options.logFile) != VmbErrorSuccess)
+    {
+        return 1;
+    }
+
+    VmbError_t err = TimedStartup(g_options.transportLayerFilter, NULL);
     PrintVmbVersion();
 
     if (err == VmbErrorSuccess)
@@ -97,14 +304,11 @@ int ChunkAccessProg(void)
                         cameraInfo.serialString);
 
                     // activate chunk features
-                    err = VmbFeatureBoolSet(hCamera, "ChunkModeActive", VmbBoolFalse);
-                    err = VmbFeatureEnumSet(hCamera, "ChunkSelector", "Timestamp");
-                    err = VmbFeatureBoolSet(hCamera, "ChunkEnable", VmbBoolTrue);
-                    err = VmbFeatureEnumSet(hCamera, "ChunkSelector", "Width");
-                    err = VmbFeatureBoolSet(hCamera, "ChunkEnable", VmbBoolTrue);
-                    err = VmbFeatureEnumSet(hCamera, "ChunkSelector", "Height");
-                    err = VmbFeatureBoolSet(hCamera, "ChunkEnable", VmbBoolTrue);
-                    err = VmbFeatureBoolSet(hCamera, "ChunkModeActive", VmbBoolTrue);
+                    err = ChunkDecoderEnableChunks(hCamera, REQUESTED_CHUNK_FIELDS);
+                    if (err != VmbErrorSuccess)
+                    {
+                        printf("Could not enable all chunks. Error code: %d\n", err);
+                    }
 
                     // show camera setup
                     VmbInt64_t w = -1, h = -1, PLS = 0;
@@ -125,27 +329,26 @@ int ChunkAccessProg(void)
                     printf("ChunkModeActive: %d\n\n", cma);
 
                     // Try to execute custom command available to Allied Vision GigE Cameras to ensure the packet size is chosen well
-                    if (VmbErrorSuccess == VmbFeatureCommandRun(cameraInfo.streamHandles[0], "GVSPAdjustPacketSize"))
+                    VmbUint64_t adjustLatencyNs = 0;
+                    err = RunFeatureCommand(cameraInfo.streamHandles[0], "GVSPAdjustPacketSize", FEATURE_COMMAND_ADJUST_PACKET_SIZE_TIMEOUT_MS, &adjustLatencyNs);
+                    if (VmbErrorSuccess == err)
                     {
-                        VmbBool_t isCommandDone = VmbBoolFalse;
-                        do
-                        {
-                            if (VmbErrorSuccess != VmbFeatureCommandIsDone(cameraInfo.streamHandles[0],
-                                "GVSPAdjustPacketSize",
-                                &isCommandDone))
-                            {
-                                break;
-                            }
-                        } while (VmbBoolFalse == isCommandDone);
                         VmbInt64_t packetSize = 0;
                         VmbFeatureIntGet(cameraInfo.streamHandles[0], "GVSPPacketSize", &packetSize);
-                        printf("GVSPAdjustPacketSize: %lld\n", packetSize);
+                        printf("GVSPAdjustPacketSize: %lld (in %.1f ms)\n", packetSize, adjustLatencyNs / 1e6);
+                    }
+                    else if (VmbErrorTimeout == err)
+                    {
+                        printf("GVSPAdjustPacketSize did not complete within %d ms\n", FEATURE_COMMAND_ADJUST_PACKET_SIZE_TIMEOUT_MS);
                     }
 
                     // allocate and announce frame buffer
                     VmbFrame_t frames[NUM_FRAMES];
                     VmbUint32_t payloadSize = 0;
                     err = VmbPayloadSizeGet(hCamera, &payloadSize);
+                    ChunkDecoderInit(&g_chunkDecoder, payloadSize, REQUESTED_CHUNK_FIELDS);
+
+                    ClockDriftEstimatorInit(&g_clockDriftEstimator, GetTimestampFrequency(hCamera));
 
                     // Evaluate required alignment for frame buffer in case announce frame method is used
                     VmbInt64_t nStreamBufferAlignment = 1;  // Required alignment of the frame buffer
@@ -192,12 +395,29 @@ int ChunkAccessProg(void)
                         printf("AcquisitionStart...\n");
                         err = VmbFeatureCommandRun(hCamera, "AcquisitionStart");
 
-                        printf("Wait 5000ms...\n");
+                        if (g_options.logFile != NULL)
+                        {
+                            printf("Logging to %s. Press <enter> to stop acquisition...\n", g_options.logFile);
+                            ((void)getchar());
+                        }
+                        else if (g_options.benchmark)
+                        {
+                            printf("Measuring for %dms...\n", BENCHMARK_DURATION_MS);
+#ifdef _WIN32
+                            Sleep(BENCHMARK_DURATION_MS);
+#else
+                            sleep(BENCHMARK_DURATION_MS / 1000);
+#endif
+                        }
+                        else
+                        {
+                            printf("Wait 5000ms...\n");
 #ifdef _WIN32
-                        Sleep(5000);
+                            Sleep(5000);
 #else
-                        usleep(500000);
+                            usleep(500000);
 #endif
+                        }
                         // Stop acquisition on the camera
                         printf("AcquisitionStop...\n");
                         err = VmbFeatureCommandRun(hCamera, "AcquisitionStop");
@@ -209,6 +429,25 @@ int ChunkAccessProg(void)
                         printf("VmbCaptureQueueFlush...\n");
                         err = VmbCaptureQueueFlush(hCamera);
 
+                        if (g_options.benchmark)
+                        {
+                            PrintBenchmarkResults();
+                        }
+
+                        PrintClockDriftEstimation();
+
+                        if (g_options.framePredicate.conditionCount != 0)
+                        {
+                            printf("\nFrames accepted by the filter: %llu, rejected: %llu\n",
+                                   g_options.framePredicate.framesAccepted,
+                                   g_options.framePredicate.framesRejected);
+                        }
+
+                        if (g_options.logFile != NULL)
+                        {
+                            printf("Logged %llu frames (%llu frames could not be logged)\n", g_chunkLog.header->frameCount, g_chunkLogErrors);
+                        }
+
                         printf("VmbFrameRevoke...\n");
                         for (int i = 0; i < NUM_FRAMES; ++i)
                         {
@@ -243,5 +482,10 @@ int ChunkAccessProg(void)
         VmbShutdown();
     }
 
+    if (g_options.logFile != NULL)
+    {
+        ChunkLogClose(&g_chunkLog);
+    }
+
     return err == VmbErrorSuccess ? 0 : 1;
 }
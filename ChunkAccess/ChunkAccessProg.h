@@ -6,9 +6,23 @@
 #ifndef CHUNK_ACCESS_PROG_H_
 #define CHUNK_ACCESS_PROG_H_
 
+#include <VmbC/VmbCommonTypes.h>
+
+#include <VmbCExamplesCommon/FramePredicate.h>
+
+typedef struct ChunkAccessOptions
+{
+    VmbBool_t       benchmark;      //!< Compare the chunk decoder with VmbChunkDataAccess instead of printing the chunk values
+    const char*     logFile;        //!< File to log the metadata of all frames to; NULL to print the chunk values instead
+    const char*     transportLayerFilter;   //!< See ParseTransportLayerFilter; NULL to load all transport layers
+    FramePredicate  framePredicate; //!< Complete frames rejected by the predicate are neither printed nor logged
+} ChunkAccessOptions;
+
 /**
  * Starts Vmb, get first connected camera, starts acquisition and dumps chunk data
+ *
+ * \param[in] options  the command line options
  */
-int ChunkAccessProg(void);
+int ChunkAccessProg(const ChunkAccessOptions* options);
 
 #endif
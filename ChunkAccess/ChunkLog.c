@@ -0,0 +1,252 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <VmbCExamplesCommon/VmbStdatomic.h>
+
+#include "ChunkLog.h"
+
+/**
+ * \brief The columns written by ChunkLogAppend
+ */
+typedef enum ChunkLogColumn
+{
+    ChunkLogColumnFrameId,
+    ChunkLogColumnTimestamp,
+    ChunkLogColumnReceiveStatus,
+    ChunkLogColumnChunkFields,
+    ChunkLogColumnChunkTimestamp,
+    ChunkLogColumnChunkFrameId,
+    ChunkLogColumnExposureTime,
+    ChunkLogColumnGain,
+    ChunkLogColumnWidth,
+    ChunkLogColumnHeight,
+    ChunkLogColumnLineStatusAll,
+    ChunkLogColumnCount
+} ChunkLogColumn;
+
+static const ChunkLogColumnInfo ColumnInfos[ChunkLogColumnCount] =
+{
+    { "FrameId",        ChunkLogColumnTypeUInt64,   ChunkLogColumnFlagsMonotonic,   CHUNK_LOG_ALWAYS_VALID },
+    { "Timestamp",      ChunkLogColumnTypeUInt64,   ChunkLogColumnFlagsMonotonic,   CHUNK_LOG_ALWAYS_VALID },
+    { "ReceiveStatus",  ChunkLogColumnTypeInt64,    ChunkLogColumnFlagsNone,        CHUNK_LOG_ALWAYS_VALID },
+    { "ChunkFields",    ChunkLogColumnTypeUInt64,   ChunkLogColumnFlagsNone,        CHUNK_LOG_ALWAYS_VALID },
+    { "ChunkTimestamp", ChunkLogColumnTypeInt64,    ChunkLogColumnFlagsMonotonic,   ChunkFieldTimestamp },
+    { "ChunkFrameID",   ChunkLogColumnTypeInt64,    ChunkLogColumnFlagsMonotonic,   ChunkFieldFrameId },
+    { "ExposureTime",   ChunkLogColumnTypeDouble,   ChunkLogColumnFlagsNone,        ChunkFieldExposureTime },
+    { "Gain",           ChunkLogColumnTypeDouble,   ChunkLogColumnFlagsNone,        ChunkFieldGain },
+    { "Width",          ChunkLogColumnTypeInt64,    ChunkLogColumnFlagsNone,        ChunkFieldWidth },
+    { "Height",         ChunkLogColumnTypeInt64,    ChunkLogColumnFlagsNone,        ChunkFieldHeight },
+    { "LineStatusAll",  ChunkLogColumnTypeInt64,    ChunkLogColumnFlagsNone,        ChunkFieldLineStatusAll },
+};
+
+#define CHUNK_LOG_EXTENT_SIZE ((VmbUint64_t)ChunkLogColumnCount * CHUNK_LOG_EXTENT_FRAMES * CHUNK_LOG_VALUE_SIZE)
+
+static void UnmapExtent(ChunkLog* log)
+{
+    if (log->extent != NULL)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(log->extent);
+#else
+        munmap(log->extent, log->extentSize);
+#endif
+        log->extent = NULL;
+    }
+}
+
+/**
+ * \brief Grow the file by one extent and map the new extent
+ */
+static VmbError_t AddExtent(ChunkLog* log, VmbUint64_t extentIndex)
+{
+    UnmapExtent(log);
+
+    VmbUint64_t const offset = CHUNK_LOG_HEADER_SIZE + extentIndex * log->extentSize;
+
+#ifdef _WIN32
+    // creating a mapping larger than the file extends the file
+    VmbUint64_t const fileSize = offset + log->extentSize;
+    HANDLE const mapping = CreateFileMappingA(log->fileHandle, NULL, PAGE_READWRITE, (DWORD)(fileSize >> 32), (DWORD)fileSize, NULL);
+    if (mapping == NULL)
+    {
+        return VmbErrorResources;
+    }
+    log->extent = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_WRITE, (DWORD)(offset >> 32), (DWORD)offset, (SIZE_T)log->extentSize);
+    CloseHandle(mapping); // the view keeps the mapping alive
+    if (log->extent == NULL)
+    {
+        return VmbErrorResources;
+    }
+#else
+    // reserve the disk space now instead of failing with SIGBUS while writing to the mapped memory
+#ifdef __APPLE__
+    if (ftruncate(log->fileDescriptor, (off_t)(offset + log->extentSize)) != 0)
+#else
+    if (posix_fallocate(log->fileDescriptor, (off_t)offset, (off_t)log->extentSize) != 0)
+#endif
+    {
+        return VmbErrorResources;
+    }
+    void* const extent = mmap(NULL, log->extentSize, PROT_READ | PROT_WRITE, MAP_SHARED, log->fileDescriptor, (off_t)offset);
+    if (extent == MAP_FAILED)
+    {
+        return VmbErrorResources;
+    }
+    log->extent = (unsigned char*)extent;
+#endif
+
+    log->extentIndex = extentIndex;
+    return VmbErrorSuccess;
+}
+
+VmbError_t ChunkLogOpen(ChunkLog* log, const char* path)
+{
+    memset(log, 0, sizeof(ChunkLog));
+    log->extentSize = CHUNK_LOG_EXTENT_SIZE;
+
+#ifdef _WIN32
+    log->fileHandle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (log->fileHandle == INVALID_HANDLE_VALUE)
+    {
+        printf("Could not create %s\n", path);
+        return VmbErrorResources;
+    }
+
+    HANDLE const mapping = CreateFileMappingA(log->fileHandle, NULL, PAGE_READWRITE, 0, CHUNK_LOG_HEADER_SIZE, NULL);
+    if (mapping != NULL)
+    {
+        log->header = (ChunkLogHeader*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, CHUNK_LOG_HEADER_SIZE);
+        CloseHandle(mapping);
+    }
+#else
+    log->fileDescriptor = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (log->fileDescriptor < 0)
+    {
+        printf("Could not create %s\n", path);
+        return VmbErrorResources;
+    }
+
+    if (ftruncate(log->fileDescriptor, CHUNK_LOG_HEADER_SIZE) == 0)
+    {
+        void* const header = mmap(NULL, CHUNK_LOG_HEADER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, log->fileDescriptor, 0);
+        log->header = (header == MAP_FAILED) ? NULL : (ChunkLogHeader*)header;
+    }
+#endif
+
+    if (log->header == NULL)
+    {
+        printf("Could not map the header of %s\n", path);
+        ChunkLogClose(log);
+        return VmbErrorResources;
+    }
+
+    memcpy(log->header->magic, CHUNK_LOG_MAGIC, sizeof(log->header->magic));
+    log->header->version = CHUNK_LOG_VERSION;
+    log->header->byteOrderMark = CHUNK_LOG_BYTE_ORDER_MARK;
+    log->header->columnCount = ChunkLogColumnCount;
+    log->header->validityColumn = ChunkLogColumnChunkFields;
+    log->header->extentFrames = CHUNK_LOG_EXTENT_FRAMES;
+    log->header->frameCount = 0;
+    memcpy(log->header->columns, ColumnInfos, sizeof(ColumnInfos));
+
+    return VmbErrorSuccess;
+}
+
+static void SetUInt(unsigned char* row, ChunkLogColumn column, VmbUint64_t value)
+{
+    memcpy(row + (size_t)column * CHUNK_LOG_EXTENT_FRAMES * CHUNK_LOG_VALUE_SIZE, &value, CHUNK_LOG_VALUE_SIZE);
+}
+
+static void SetInt(unsigned char* row, ChunkLogColumn column, VmbInt64_t value)
+{
+    memcpy(row + (size_t)column * CHUNK_LOG_EXTENT_FRAMES * CHUNK_LOG_VALUE_SIZE, &value, CHUNK_LOG_VALUE_SIZE);
+}
+
+static void SetDouble(unsigned char* row, ChunkLogColumn column, double value)
+{
+    memcpy(row + (size_t)column * CHUNK_LOG_EXTENT_FRAMES * CHUNK_LOG_VALUE_SIZE, &value, CHUNK_LOG_VALUE_SIZE);
+}
+
+VmbError_t ChunkLogAppend(ChunkLog* log, const VmbFrame_t* frame, const ChunkValues* values)
+{
+    VmbUint64_t const frameIndex = log->header->frameCount;
+    VmbUint64_t const extentIndex = frameIndex / CHUNK_LOG_EXTENT_FRAMES;
+
+    if (log->extent == NULL || log->extentIndex != extentIndex)
+    {
+        VmbError_t const err = AddExtent(log, extentIndex);
+        if (err != VmbErrorSuccess)
+        {
+            return err;
+        }
+    }
+
+    // pointer to the value of the first column; the other columns follow in steps of a column
+    unsigned char* const row = log->extent + (frameIndex % CHUNK_LOG_EXTENT_FRAMES) * CHUNK_LOG_VALUE_SIZE;
+
+    ChunkValues const noValues = { 0 };
+    if (values == NULL)
+    {
+        values = &noValues;
+    }
+
+    SetUInt(row, ChunkLogColumnFrameId, frame->frameID);
+    SetUInt(row, ChunkLogColumnTimestamp, frame->timestamp);
+    SetInt(row, ChunkLogColumnReceiveStatus, frame->receiveStatus);
+    SetUInt(row, ChunkLogColumnChunkFields, values->validFields);
+    SetInt(row, ChunkLogColumnChunkTimestamp, values->timestamp);
+    SetInt(row, ChunkLogColumnChunkFrameId, values->frameId);
+    SetDouble(row, ChunkLogColumnExposureTime, values->exposureTime);
+    SetDouble(row, ChunkLogColumnGain, values->gain);
+    SetInt(row, ChunkLogColumnWidth, values->width);
+    SetInt(row, ChunkLogColumnHeight, values->height);
+    SetInt(row, ChunkLogColumnLineStatusAll, values->lineStatusAll);
+
+    // the frame count is published last with an atomic store ordering the row before it, so readers loading it
+    // with acquire semantics never see partial rows of a file still written
+    atomic_store((volatile atomic_ullong*)&log->header->frameCount, frameIndex + 1);
+
+    return VmbErrorSuccess;
+}
+
+void ChunkLogClose(ChunkLog* log)
+{
+    UnmapExtent(log);
+
+#ifdef _WIN32
+    if (log->header != NULL)
+    {
+        UnmapViewOfFile(log->header);
+    }
+    if (log->fileHandle != NULL && log->fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(log->fileHandle);
+    }
+    log->fileHandle = NULL;
+#else
+    if (log->header != NULL)
+    {
+        munmap(log->header, CHUNK_LOG_HEADER_SIZE);
+    }
+    if (log->fileDescriptor >= 0)
+    {
+        close(log->fileDescriptor);
+    }
+    log->fileDescriptor = -1;
+#endif
+    log->header = NULL;
+}
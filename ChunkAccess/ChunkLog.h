@@ -0,0 +1,58 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef CHUNK_LOG_H_
+#define CHUNK_LOG_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#include <VmbCExamplesCommon/ChunkDecoder.h>
+
+#include "ChunkLogFormat.h"
+
+/**
+ * \brief Writer appending the metadata of frames to a memory mapped log file
+ *
+ * Only the header and the extent currently written are mapped; the file is grown by a whole extent
+ * whenever the current one is full. See ChunkLogFormat.h for the file layout.
+ *
+ * The functions must not be called concurrently for the same log.
+ */
+typedef struct ChunkLog
+{
+#ifdef _WIN32
+    void*           fileHandle;
+#else
+    int             fileDescriptor;
+#endif
+    ChunkLogHeader* header;             //!< Mapped header of the file
+    unsigned char*  extent;             //!< Mapped extent frames are currently written to; NULL, if a new extent needs to be added
+    VmbUint64_t     extentIndex;        //!< Index of the mapped extent
+    VmbUint64_t     extentSize;         //!< Size of an extent in bytes
+} ChunkLog;
+
+/**
+ * \brief Create a new log file replacing an existing file
+ *
+ * \param[out] log  the log to initialize
+ * \param[in]  path the path of the file
+ */
+VmbError_t ChunkLogOpen(ChunkLog* log, const char* path);
+
+/**
+ * \brief Append the metadata of a frame
+ *
+ * \param[in,out] log       the log
+ * \param[in]     frame     the frame received
+ * \param[in]     values    the chunk values of the frame; may be NULL, if no chunk values are available
+ */
+VmbError_t ChunkLogAppend(ChunkLog* log, const VmbFrame_t* frame, const ChunkValues* values);
+
+/**
+ * \brief Unmap and close the file
+ */
+void ChunkLogClose(ChunkLog* log);
+
+#endif
@@ -0,0 +1,84 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef CHUNK_LOG_FORMAT_H_
+#define CHUNK_LOG_FORMAT_H_
+
+/**
+ * Layout of the chunk metadata log files written by ChunkAccess and read by ChunkLogReader.
+ *
+ * The file starts with a ChunkLogHeader padded to CHUNK_LOG_HEADER_SIZE bytes followed by extents of
+ * ChunkLogHeader::extentFrames frames each. Inside of an extent every column is stored contiguously:
+ * the value of column c for the frame with index i is located at
+ *
+ *     CHUNK_LOG_HEADER_SIZE
+ *     + (i / extentFrames) * columnCount * extentFrames * CHUNK_LOG_VALUE_SIZE
+ *     + (c * extentFrames + i % extentFrames) * CHUNK_LOG_VALUE_SIZE
+ *
+ * All values are 8 bytes wide and stored in the byte order of the host writing the file. The file is
+ * always a whole number of extents; ChunkLogHeader::frameCount tells how many frames are valid.
+ */
+
+#include <VmbC/VmbCommonTypes.h>
+
+#define CHUNK_LOG_MAGIC             "VMBCHLOG"
+#define CHUNK_LOG_VERSION           1
+#define CHUNK_LOG_BYTE_ORDER_MARK   0x01020304u
+
+#define CHUNK_LOG_HEADER_SIZE       65536   //!< Multiple of the allocation granularity of Windows and the page size of other systems
+#define CHUNK_LOG_EXTENT_FRAMES     65536   //!< Number of frames the file is grown by at once
+#define CHUNK_LOG_VALUE_SIZE        8
+#define CHUNK_LOG_MAX_COLUMNS       32
+#define CHUNK_LOG_COLUMN_NAME_SIZE  24
+
+#define CHUNK_LOG_ALWAYS_VALID      0xFF    //!< ChunkLogColumnInfo::validityBit of columns available for every frame
+
+/**
+ * \brief The type of the values of a column
+ */
+typedef enum ChunkLogColumnType
+{
+    ChunkLogColumnTypeUInt64    = 0,
+    ChunkLogColumnTypeInt64     = 1,
+    ChunkLogColumnTypeDouble    = 2
+} ChunkLogColumnType;
+
+/**
+ * \brief Flags of a column
+ */
+typedef enum ChunkLogColumnFlags
+{
+    ChunkLogColumnFlagsNone         = 0,
+    ChunkLogColumnFlagsMonotonic    = 1     //!< The values are expected to increase from frame to frame, e.g. timestamps
+} ChunkLogColumnFlags;
+
+/**
+ * \brief Description of a single column
+ */
+typedef struct ChunkLogColumnInfo
+{
+    char        name[CHUNK_LOG_COLUMN_NAME_SIZE];   //!< Null terminated column name
+    VmbUint8_t  type;                               //!< See ChunkLogColumnType
+    VmbUint8_t  flags;                              //!< Combination of ChunkLogColumnFlags
+    VmbUint8_t  validityBit;                        //!< Bit in the validity column telling if the value is available; CHUNK_LOG_ALWAYS_VALID if it always is
+    VmbUint8_t  reserved[5];
+} ChunkLogColumnInfo;
+
+/**
+ * \brief The header at the start of the file
+ */
+typedef struct ChunkLogHeader
+{
+    char                magic[8];               //!< CHUNK_LOG_MAGIC without terminating 0
+    VmbUint32_t         version;                //!< CHUNK_LOG_VERSION
+    VmbUint32_t         byteOrderMark;          //!< CHUNK_LOG_BYTE_ORDER_MARK
+    VmbUint32_t         columnCount;
+    VmbUint32_t         validityColumn;         //!< Index of the column containing the bit masks of the values available
+    VmbUint64_t         extentFrames;
+    VmbUint64_t         frameCount;             //!< Number of frames written; stored atomically after every frame, load it with acquire semantics
+    ChunkLogColumnInfo  columns[CHUNK_LOG_MAX_COLUMNS];
+} ChunkLogHeader;
+
+#endif
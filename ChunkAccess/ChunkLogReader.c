@@ -0,0 +1,415 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+/*
+ * Computes statistics of the columns of a chunk metadata log written by ChunkAccess /l.
+ * The file is mapped into memory and the columns are scanned directly; no parsing is needed.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/VmbStdatomic.h>
+
+#include "ChunkLogFormat.h"
+
+#define VMB_PARAM_COLUMN "/c"
+#define VMB_PARAM_PRINT_HELP "/h"
+
+/**
+ * \brief Read only mapping of a whole log file
+ */
+typedef struct MappedFile
+{
+    const unsigned char*    data;
+    VmbUint64_t             size;
+#ifdef _WIN32
+    HANDLE                  fileHandle;
+#else
+    int                     fileDescriptor;
+#endif
+} MappedFile;
+
+/**
+ * \brief Statistics of a column
+ */
+typedef struct ColumnStatistics
+{
+    VmbUint64_t count;      //!< Number of frames the value is available for
+    double      min;
+    double      max;
+    double      mean;
+    double      stdDev;
+
+    VmbUint64_t deltaCount; //!< Number of differences between consecutive available values; only for monotonic columns
+    double      deltaMin;
+    double      deltaMax;
+    double      deltaMean;
+    VmbUint64_t decreases;  //!< Number of times a monotonic value decreased
+
+    VmbUint64_t scanTimeNs; //!< Time needed to compute the statistics
+} ColumnStatistics;
+
+void PrintUsage(void)
+{
+    printf("Usage: ChunkLogReader <file> [%s <column>]\n"
+           "Parameters:   file       Log file written by ChunkAccess\n"
+           "              %s <name>  Only evaluate the column with the given name (evaluating all columns if not specified)\n"
+           "              %s         Print out help\n",
+           VMB_PARAM_COLUMN,
+           VMB_PARAM_COLUMN,
+           VMB_PARAM_PRINT_HELP);
+}
+
+static int MapFile(MappedFile* file, const char* path)
+{
+    memset(file, 0, sizeof(MappedFile));
+
+#ifdef _WIN32
+    file->fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file->fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return 0;
+    }
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file->fileHandle, &size) && size.QuadPart != 0)
+    {
+        HANDLE const mapping = CreateFileMappingA(file->fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping != NULL)
+        {
+            file->data = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            file->size = (VmbUint64_t)size.QuadPart;
+            CloseHandle(mapping);
+        }
+    }
+
+    if (file->data == NULL)
+    {
+        CloseHandle(file->fileHandle);
+        return 0;
+    }
+#else
+    file->fileDescriptor = open(path, O_RDONLY);
+    if (file->fileDescriptor < 0)
+    {
+        return 0;
+    }
+
+    struct stat status;
+    if (fstat(file->fileDescriptor, &status) == 0 && status.st_size != 0)
+    {
+        void* const data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, file->fileDescriptor, 0);
+        if (data != MAP_FAILED)
+        {
+            file->data = (const unsigned char*)data;
+            file->size = (VmbUint64_t)status.st_size;
+        }
+    }
+
+    if (file->data == NULL)
+    {
+        close(file->fileDescriptor);
+        return 0;
+    }
+#endif
+
+    return 1;
+}
+
+static void UnmapFile(MappedFile* file)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(file->data);
+    CloseHandle(file->fileHandle);
+#else
+    munmap((void*)file->data, (size_t)file->size);
+    close(file->fileDescriptor);
+#endif
+}
+
+/**
+ * \brief Load the number of frames written with acquire semantics
+ *
+ * Pairs with the atomic store of the writer, so the rows of all frames counted are complete, even if the file is
+ * still written.
+ */
+static VmbUint64_t LoadFrameCount(const ChunkLogHeader* header)
+{
+#ifdef __STDC_NO_ATOMICS__
+    // the atomic_load replacement needs write access to the read only mapping; volatile reads of aligned 64 bit
+    // values are atomic and have acquire semantics with MSVC
+    return *(const volatile VmbUint64_t*)&header->frameCount;
+#else
+    return atomic_load_explicit((const volatile atomic_ullong*)&header->frameCount, memory_order_acquire);
+#endif
+}
+
+/**
+ * \brief Check the header and make sure all frames it reports are located inside of the file
+ *
+ * \param[in]  file        the mapped file
+ * \param[out] frameCount  the number of frames written when the header was checked; later frames are ignored
+ */
+static const ChunkLogHeader* ValidateHeader(const MappedFile* file, VmbUint64_t* frameCount)
+{
+    if (file->size < CHUNK_LOG_HEADER_SIZE)
+    {
+        printf("The file is too small to be a chunk log\n");
+        return NULL;
+    }
+
+    const ChunkLogHeader* header = (const ChunkLogHeader*)file->data;
+
+    if (memcmp(header->magic, CHUNK_LOG_MAGIC, sizeof(header->magic)) != 0)
+    {
+        printf("The file is not a chunk log\n");
+        return NULL;
+    }
+    if (header->version != CHUNK_LOG_VERSION || header->byteOrderMark != CHUNK_LOG_BYTE_ORDER_MARK)
+    {
+        printf("Unsupported version or byte order\n");
+        return NULL;
+    }
+    if (header->columnCount == 0 || header->columnCount > CHUNK_LOG_MAX_COLUMNS
+        || header->validityColumn >= header->columnCount || header->extentFrames == 0)
+    {
+        printf("Invalid header\n");
+        return NULL;
+    }
+
+    VmbUint64_t const extentSize = header->columnCount * header->extentFrames * CHUNK_LOG_VALUE_SIZE;
+    *frameCount = LoadFrameCount(header);
+    VmbUint64_t const extentCount = (*frameCount + header->extentFrames - 1) / header->extentFrames;
+    if (CHUNK_LOG_HEADER_SIZE + extentCount * extentSize > file->size)
+    {
+        printf("The file is truncated\n");
+        return NULL;
+    }
+
+    return header;
+}
+
+static double ToDouble(const unsigned char* value, VmbUint8_t type)
+{
+    switch (type)
+    {
+    case ChunkLogColumnTypeUInt64:
+    {
+        VmbUint64_t result;
+        memcpy(&result, value, sizeof(result));
+        return (double)result;
+    }
+    case ChunkLogColumnTypeInt64:
+    {
+        VmbInt64_t result;
+        memcpy(&result, value, sizeof(result));
+        return (double)result;
+    }
+    default:
+    {
+        double result;
+        memcpy(&result, value, sizeof(result));
+        return result;
+    }
+    }
+}
+
+/**
+ * \brief Scan a single column extent by extent
+ */
+static void ComputeColumnStatistics(const unsigned char* data, const ChunkLogHeader* header, VmbUint64_t frameCount, VmbUint32_t columnIndex, ColumnStatistics* stats)
+{
+    const ChunkLogColumnInfo* column = &header->columns[columnIndex];
+    VmbUint64_t const extentFrames = header->extentFrames;
+    VmbUint64_t const columnSize = extentFrames * CHUNK_LOG_VALUE_SIZE;
+    VmbUint64_t const extentSize = header->columnCount * columnSize;
+    VmbBool_t const monotonic = (column->flags & ChunkLogColumnFlagsMonotonic) != 0;
+    VmbUint64_t const validityMask = (column->validityBit == CHUNK_LOG_ALWAYS_VALID) ? 0 : ((VmbUint64_t)1 << column->validityBit);
+
+    VmbUint64_t const start = GetMonotonicTimeNs();
+
+    memset(stats, 0, sizeof(ColumnStatistics));
+
+    // sums of the differences to the first value; avoids the loss of precision of large values like timestamps
+    double reference = 0.0;
+    double sum = 0.0;
+    double sumOfSquares = 0.0;
+    double deltaSum = 0.0;
+    double previous = 0.0;
+
+    for (VmbUint64_t first = 0; first < frameCount; first += extentFrames)
+    {
+        const unsigned char* extent = data + CHUNK_LOG_HEADER_SIZE + (first / extentFrames) * extentSize;
+        const unsigned char* values = extent + columnIndex * columnSize;
+        const unsigned char* validity = extent + header->validityColumn * columnSize;
+        VmbUint64_t const frames = (frameCount - first < extentFrames) ? (frameCount - first) : extentFrames;
+
+        for (VmbUint64_t i = 0; i < frames; ++i)
+        {
+            if (validityMask != 0)
+            {
+                VmbUint64_t fields;
+                memcpy(&fields, validity + i * CHUNK_LOG_VALUE_SIZE, sizeof(fields));
+                if ((fields & validityMask) == 0)
+                {
+                    continue;
+                }
+            }
+
+            double const value = ToDouble(values + i * CHUNK_LOG_VALUE_SIZE, column->type);
+
+            if (stats->count == 0)
+            {
+                reference = value;
+                stats->min = value;
+                stats->max = value;
+            }
+            else
+            {
+                stats->min = (value < stats->min) ? value : stats->min;
+                stats->max = (value > stats->max) ? value : stats->max;
+
+                if (monotonic)
+                {
+                    double const delta = value - previous;
+                    if (stats->deltaCount == 0)
+                    {
+                        stats->deltaMin = delta;
+                        stats->deltaMax = delta;
+                    }
+                    stats->deltaMin = (delta < stats->deltaMin) ? delta : stats->deltaMin;
+                    stats->deltaMax = (delta > stats->deltaMax) ? delta : stats->deltaMax;
+                    stats->decreases += (delta < 0.0) ? 1 : 0;
+                    deltaSum += delta;
+                    ++stats->deltaCount;
+                }
+            }
+
+            double const shifted = value - reference;
+            sum += shifted;
+            sumOfSquares += shifted * shifted;
+            previous = value;
+            ++stats->count;
+        }
+    }
+
+    if (stats->count != 0)
+    {
+        double const shiftedMean = sum / (double)stats->count;
+        double const variance = sumOfSquares / (double)stats->count - shiftedMean * shiftedMean;
+        stats->mean = reference + shiftedMean;
+        stats->stdDev = (variance > 0.0) ? sqrt(variance) : 0.0;
+    }
+    if (stats->deltaCount != 0)
+    {
+        stats->deltaMean = deltaSum / (double)stats->deltaCount;
+    }
+
+    stats->scanTimeNs = GetMonotonicTimeNs() - start;
+}
+
+static void PrintColumnStatistics(VmbUint64_t frameCount, const ChunkLogColumnInfo* column, const ColumnStatistics* stats)
+{
+    printf("%s\n", column->name);
+    printf("  Values   : %llu of %llu frames\n", stats->count, frameCount);
+    if (stats->count != 0)
+    {
+        printf("  Min      : %.17g\n", stats->min);
+        printf("  Max      : %.17g\n", stats->max);
+        printf("  Mean     : %.17g\n", stats->mean);
+        printf("  StdDev   : %.17g\n", stats->stdDev);
+    }
+    if (stats->deltaCount != 0)
+    {
+        printf("  Delta min: %.17g\n", stats->deltaMin);
+        printf("  Delta max: %.17g\n", stats->deltaMax);
+        printf("  Delta avg: %.17g\n", stats->deltaMean);
+        printf("  Decreases: %llu\n", stats->decreases);
+    }
+
+    double const seconds = (double)stats->scanTimeNs / 1e9;
+    double const megaBytes = (double)frameCount * CHUNK_LOG_VALUE_SIZE / (1024.0 * 1024.0);
+    printf("  Scanned in %.3f ms (%.0f MB/s)\n\n", seconds * 1000.0, seconds > 0.0 ? megaBytes / seconds : 0.0);
+}
+
+int main(int argc, char* argv[])
+{
+    printf("////////////////////////////////////////\n");
+    printf("/// Vmb API Chunk Log Reader Example ///\n");
+    printf("////////////////////////////////////////\n\n");
+
+    const char* path = NULL;
+    const char* columnName = NULL;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], VMB_PARAM_COLUMN) && (i + 1) < argc)
+        {
+            columnName = argv[++i];
+        }
+        else if (path == NULL && 0 != strcmp(argv[i], VMB_PARAM_PRINT_HELP))
+        {
+            path = argv[i];
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (path == NULL)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    MappedFile file;
+    if (!MapFile(&file, path))
+    {
+        printf("Could not open %s\n", path);
+        return 1;
+    }
+
+    int result = 1;
+    VmbUint64_t frameCount = 0;
+    const ChunkLogHeader* header = ValidateHeader(&file, &frameCount);
+    if (header != NULL)
+    {
+        printf("Frames: %llu\n\n", frameCount);
+
+        for (VmbUint32_t i = 0; i < header->columnCount; ++i)
+        {
+            const ChunkLogColumnInfo* column = &header->columns[i];
+            if (columnName == NULL || strncmp(column->name, columnName, sizeof(column->name)) == 0)
+            {
+                ColumnStatistics stats;
+                ComputeColumnStatistics(file.data, header, frameCount, i, &stats);
+                PrintColumnStatistics(frameCount, column, &stats);
+                result = 0;
+            }
+        }
+
+        if (result != 0)
+        {
+            printf("Unknown column: %s\n", columnName);
+        }
+    }
+
+    UnmapFile(&file);
+    return result;
+}
@@ -4,19 +4,82 @@
 =============================================================================*/
 
 #include <stdio.h>
+#include <string.h>
 
 #include "ChunkAccessProg.h"
 
+#define VMB_PARAM_BENCHMARK "/b"
+#define VMB_PARAM_LOG "/l"
+#define VMB_PARAM_FILTER "/f"
+#define VMB_PARAM_TRANSPORT_LAYERS "/tl"
+#define VMB_PARAM_PRINT_HELP "/h"
+
+void PrintUsage(void)
+{
+    printf("Usage: ChunkAccess [/b] [/l <file>] [/f <condition>]... [/tl <filter>] [/h]\n"
+           "Parameters:   %s              Compare the time needed to extract the chunk values from the frame buffer\n"
+           "                              with the time needed by VmbChunkDataAccess\n"
+           "              %s <file>       Log the metadata of all frames to a file until <enter> is pressed;\n"
+           "                              use ChunkLogReader to evaluate the file\n"
+           "              %s <condition>  Only process frames fulfilling the condition; may be specified multiple times:\n"
+           "                              exposure=<min>:<max>  exposure time in us within the range\n"
+           "                              line=<bit>            line status bit set\n"
+           "                              nth=<n>               frame id is a multiple of n\n"
+           "              %s <filter>    Load only the transport layers of a comma separated list of types and paths,\n"
+           "                              e.g. GigE,USB or /opt/VimbaX/cti/VimbaUSBTL.cti\n"
+           "              %s              Print out help\n",
+           VMB_PARAM_BENCHMARK,
+           VMB_PARAM_LOG,
+           VMB_PARAM_FILTER,
+           VMB_PARAM_TRANSPORT_LAYERS,
+           VMB_PARAM_PRINT_HELP);
+}
+
 int main( int argc, char* argv[] )
 {
     printf( "////////////////////////////////////\n" );
     printf( "/// Vmb API Chunk Access Example ///\n" );
     printf( "////////////////////////////////////\n\n" );
 
-    if ( 1 < argc )
+    ChunkAccessOptions options;
+    options.benchmark = VmbBoolFalse;
+    options.logFile = NULL;
+    options.transportLayerFilter = NULL;
+    FramePredicateInit( &options.framePredicate );
+
+    for ( int i = 1; i < argc; ++i )
     {
-        printf( "No parameters expected. Execution will not be affected by the provided parameter(s).\n\n" );
+        if ( 0 == strcmp( argv[i], VMB_PARAM_BENCHMARK ) )
+        {
+            options.benchmark = VmbBoolTrue;
+        }
+        else if ( 0 == strcmp( argv[i], VMB_PARAM_LOG ) && ( i + 1 ) < argc )
+        {
+            options.logFile = argv[++i];
+        }
+        else if ( 0 == strcmp( argv[i], VMB_PARAM_TRANSPORT_LAYERS ) && ( i + 1 ) < argc )
+        {
+            options.transportLayerFilter = argv[++i];
+        }
+        else if ( 0 == strcmp( argv[i], VMB_PARAM_FILTER ) && ( i + 1 ) < argc )
+        {
+            if ( VmbErrorSuccess != FramePredicateAddCondition( &options.framePredicate, argv[++i] ) )
+            {
+                printf( "Invalid filter condition: %s\n\n", argv[i] );
+                PrintUsage();
+                return 1;
+            }
+        }
+        else
+        {
+            if ( 0 != strcmp( argv[i], VMB_PARAM_PRINT_HELP ) )
+            {
+                printf( "Unknown parameter: %s\n\n", argv[i] );
+            }
+            PrintUsage();
+            return 1;
+        }
     }
 
-    return ChunkAccessProg();
+    return ChunkAccessProg( &options );
 }
@@ -0,0 +1,60 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stddef.h>
+
+#include "include/VmbCExamplesCommon/CameraClock.h"
+#include "include/VmbCExamplesCommon/MonotonicTime.h"
+
+#include <VmbC/VmbC.h>
+
+VmbUint64_t GetTimestampFrequency(const VmbHandle_t cameraHandle)
+{
+    VmbInt64_t frequency = 0;
+    if (VmbErrorSuccess != VmbFeatureIntGet(cameraHandle, "GevTimestampTickFrequency", &frequency)
+        && VmbErrorSuccess != VmbFeatureIntGet(cameraHandle, "DeviceTimestampFrequency", &frequency))
+    {
+        frequency = 0;
+    }
+    return (frequency > 0) ? (VmbUint64_t)frequency : 0;
+}
+
+double GetTimestampNsPerTick(const VmbHandle_t cameraHandle)
+{
+    VmbUint64_t const frequency = GetTimestampFrequency(cameraHandle);
+    return (frequency != 0) ? 1e9 / (double)frequency : 1.0;
+}
+
+VmbError_t LatchCameraTime(const VmbHandle_t cameraHandle, VmbUint64_t* const pTicks, VmbUint64_t* const pHostNs, VmbUint64_t* const pUncertaintyNs)
+{
+    // SFNC feature names first, followed by the GigE Vision specific ones
+    const char* const latchCommands[] = { "TimestampLatch", "GevTimestampControlLatch" };
+    const char* const latchValues[] = { "TimestampLatchValue", "GevTimestampValue" };
+
+    VmbError_t error = VmbErrorNotFound;
+    for (size_t i = 0; i < sizeof(latchCommands) / sizeof(latchCommands[0]); i++)
+    {
+        VmbUint64_t const before = GetMonotonicTimeNs();
+        error = VmbFeatureCommandRun(cameraHandle, latchCommands[i]);
+        VmbUint64_t const after = GetMonotonicTimeNs();
+
+        VmbInt64_t ticks = 0;
+        if (error == VmbErrorSuccess)
+        {
+            error = VmbFeatureIntGet(cameraHandle, latchValues[i], &ticks);
+        }
+        if (error == VmbErrorSuccess)
+        {
+            *pTicks = (VmbUint64_t)ticks;
+            *pHostNs = before + (after - before) / 2;
+            if (pUncertaintyNs != NULL)
+            {
+                *pUncertaintyNs = (after - before + 1) / 2;
+            }
+            return error;
+        }
+    }
+    return error;
+}
@@ -0,0 +1,523 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/VmbCExamplesCommon/CameraInventory.h"
+
+#include "include/VmbCExamplesCommon/ArrayAlloc.h"
+#include "include/VmbCExamplesCommon/HandleIndex.h"
+#include "include/VmbCExamplesCommon/MonotonicTime.h"
+
+#include <VmbC/VmbC.h>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef _WIN32
+    #define CAMERA_INVENTORY_SEGMENT_NAME   "Local\\VmbCExamplesCameraInventory"
+#else
+    #define CAMERA_INVENTORY_SEGMENT_NAME   "/VmbCExamplesCameraInventory"
+#endif
+
+#define CAMERA_INVENTORY_MAGIC              0x31564e49424d56ull     // "VMBINV1"
+#define CAMERA_INVENTORY_READ_ATTEMPTS      100
+#define CAMERA_INVENTORY_RETRY_DELAY_NS     50000ull
+#define CAMERA_INVENTORY_CREATE_RETRY_NS    10000000ull     // time between the checks of a segment being set up
+
+/**
+ * \brief Order the accesses to the data relative to the accesses to the sequence
+ */
+static void InventoryFence(void)
+{
+#ifdef __STDC_NO_ATOMICS__
+    MemoryBarrier();
+#else
+    atomic_thread_fence(memory_order_seq_cst);
+#endif
+}
+
+static VmbBool_t IsCompatible(CameraInventorySegment const* segment)
+{
+    return segment->magic == CAMERA_INVENTORY_MAGIC
+        && segment->version == CAMERA_INVENTORY_VERSION
+        && segment->size == (VmbUint32_t)sizeof(CameraInventorySegment);
+}
+
+static VmbBool_t HasHeartbeat(CameraInventorySegment* segment)
+{
+    VmbUint64_t const heartbeatNs = atomic_load(&segment->heartbeatNs);
+    VmbUint64_t const now = GetMonotonicTimeNs();
+    return (now <= heartbeatNs || now - heartbeatNs <= CAMERA_INVENTORY_STALE_NS) ? VmbBoolTrue : VmbBoolFalse;
+}
+
+#ifndef _WIN32
+/**
+ * \brief Check, if the existing segment belongs to a running daemon
+ *
+ * A segment that is not compatible yet may still be set up by a daemon started at the same time, so it is checked
+ * again until it becomes compatible or the stale period passes. Only a segment without a heartbeat for the stale
+ * period is considered to be left behind.
+ */
+static VmbBool_t HasRunningWriter(void)
+{
+    VmbUint64_t const deadlineNs = GetMonotonicTimeNs() + CAMERA_INVENTORY_STALE_NS;
+    for (;;)
+    {
+        CameraInventoryMapping existing;
+        VmbError_t const err = CameraInventoryOpen(&existing);
+        if (err == VmbErrorSuccess)
+        {
+            VmbBool_t const running = HasHeartbeat(existing.segment);
+            CameraInventoryClose(&existing);
+            return running;
+        }
+        if (err == VmbErrorNotFound || GetMonotonicTimeNs() >= deadlineNs)
+        {
+            return VmbBoolFalse;
+        }
+        SleepUntilMonotonicNs(GetMonotonicTimeNs() + CAMERA_INVENTORY_CREATE_RETRY_NS);
+    }
+}
+#endif
+
+/**
+ * \brief Copy a string reported by the API, truncating it, if necessary
+ */
+static void CopyInventoryString(char* destination, size_t size, const char* source)
+{
+    if (source != NULL)
+    {
+        strncpy(destination, source, size - 1);
+    }
+}
+
+VmbError_t CameraInventoryOpen(CameraInventoryMapping* mapping)
+{
+    memset(mapping, 0, sizeof(CameraInventoryMapping));
+
+#ifdef _WIN32
+    // the atomic loads of VmbStdatomic_Windows are implemented as compare-exchange, which requires write access
+    HANDLE const fileMapping = OpenFileMappingA(FILE_MAP_READ | FILE_MAP_WRITE, FALSE, CAMERA_INVENTORY_SEGMENT_NAME);
+    if (fileMapping == NULL)
+    {
+        return VmbErrorNotFound;
+    }
+
+    CameraInventorySegment* const segment = (CameraInventorySegment*)MapViewOfFile(fileMapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, 0);
+    if (segment == NULL)
+    {
+        CloseHandle(fileMapping);
+        return VmbErrorResources;
+    }
+
+    // the view covers at least one page, so the header can be checked before relying on the size
+    if (!IsCompatible(segment))
+    {
+        UnmapViewOfFile(segment);
+        CloseHandle(fileMapping);
+        return VmbErrorNotAvailable;
+    }
+    mapping->fileMapping = fileMapping;
+#else
+    int const fd = shm_open(CAMERA_INVENTORY_SEGMENT_NAME, O_RDONLY, 0);
+    if (fd == -1)
+    {
+        return VmbErrorNotFound;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(CameraInventorySegment))
+    {
+        close(fd);
+        return VmbErrorNotAvailable;
+    }
+
+    void* const address = mmap(NULL, sizeof(CameraInventorySegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        return VmbErrorResources;
+    }
+
+    CameraInventorySegment* const segment = (CameraInventorySegment*)address;
+    if (!IsCompatible(segment))
+    {
+        munmap(address, sizeof(CameraInventorySegment));
+        return VmbErrorNotAvailable;
+    }
+#endif
+
+    mapping->segment = segment;
+    return VmbErrorSuccess;
+}
+
+VmbError_t CameraInventoryCreate(CameraInventoryMapping* mapping)
+{
+    memset(mapping, 0, sizeof(CameraInventoryMapping));
+
+#ifdef _WIN32
+    HANDLE const fileMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)sizeof(CameraInventorySegment),
+                                                  CAMERA_INVENTORY_SEGMENT_NAME);
+    if (fileMapping == NULL)
+    {
+        return VmbErrorResources;
+    }
+    VmbBool_t const existed = (GetLastError() == ERROR_ALREADY_EXISTS) ? VmbBoolTrue : VmbBoolFalse;
+
+    CameraInventorySegment* const segment = (CameraInventorySegment*)MapViewOfFile(fileMapping, FILE_MAP_ALL_ACCESS, 0, 0,
+                                                                                  sizeof(CameraInventorySegment));
+    if (segment == NULL)
+    {
+        CloseHandle(fileMapping);
+        return VmbErrorResources;
+    }
+
+    // the segment is destroyed with the last handle, so an existing one is only taken over, if its writer stopped;
+    // a segment not compatible yet may still be set up by a daemon started at the same time
+    VmbUint64_t const deadlineNs = GetMonotonicTimeNs() + CAMERA_INVENTORY_STALE_NS;
+    while (existed && !IsCompatible(segment) && GetMonotonicTimeNs() < deadlineNs)
+    {
+        SleepUntilMonotonicNs(GetMonotonicTimeNs() + CAMERA_INVENTORY_CREATE_RETRY_NS);
+    }
+    if (existed && IsCompatible(segment) && HasHeartbeat(segment))
+    {
+        UnmapViewOfFile(segment);
+        CloseHandle(fileMapping);
+        return VmbErrorAlready;
+    }
+    mapping->fileMapping = fileMapping;
+#else
+    int fd = shm_open(CAMERA_INVENTORY_SEGMENT_NAME, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd == -1 && errno == EEXIST)
+    {
+        // a daemon that was killed leaves its segment behind
+        if (HasRunningWriter())
+        {
+            return VmbErrorAlready;
+        }
+        shm_unlink(CAMERA_INVENTORY_SEGMENT_NAME);
+        fd = shm_open(CAMERA_INVENTORY_SEGMENT_NAME, O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd == -1)
+    {
+        // another daemon replaced the stale segment first
+        return (errno == EEXIST) ? VmbErrorAlready : VmbErrorResources;
+    }
+
+    if (ftruncate(fd, (off_t)sizeof(CameraInventorySegment)) != 0)
+    {
+        close(fd);
+        shm_unlink(CAMERA_INVENTORY_SEGMENT_NAME);
+        return VmbErrorResources;
+    }
+
+    void* const address = mmap(NULL, sizeof(CameraInventorySegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        shm_unlink(CAMERA_INVENTORY_SEGMENT_NAME);
+        return VmbErrorResources;
+    }
+    CameraInventorySegment* const segment = (CameraInventorySegment*)address;
+#endif
+
+    // readers ignore the segment until the magic value is written
+    segment->magic = 0;
+    InventoryFence();
+    memset(&segment->data, 0, sizeof(CameraInventoryData));
+    segment->version = CAMERA_INVENTORY_VERSION;
+    segment->size = (VmbUint32_t)sizeof(CameraInventorySegment);
+    atomic_store(&segment->sequence, 0);
+    atomic_store(&segment->heartbeatNs, GetMonotonicTimeNs());
+    InventoryFence();
+    segment->magic = CAMERA_INVENTORY_MAGIC;
+
+    mapping->segment = segment;
+    mapping->owner = VmbBoolTrue;
+    return VmbErrorSuccess;
+}
+
+void CameraInventoryClose(CameraInventoryMapping* mapping)
+{
+    if (mapping->segment == NULL)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(mapping->segment);
+    CloseHandle((HANDLE)mapping->fileMapping);
+#else
+    munmap(mapping->segment, sizeof(CameraInventorySegment));
+    if (mapping->owner)
+    {
+        shm_unlink(CAMERA_INVENTORY_SEGMENT_NAME);
+    }
+#endif
+    memset(mapping, 0, sizeof(CameraInventoryMapping));
+}
+
+void CameraInventoryPublish(CameraInventoryMapping* mapping, CameraInventoryData* data)
+{
+    CameraInventorySegment* const segment = mapping->segment;
+
+    data->updateCount = segment->data.updateCount + 1;
+    data->updateTimeNs = GetMonotonicTimeNs();
+
+    VmbUint64_t const sequence = atomic_load(&segment->sequence);
+    atomic_store(&segment->sequence, sequence + 1);
+    InventoryFence();
+    memcpy(&segment->data, data, sizeof(CameraInventoryData));
+    InventoryFence();
+    atomic_store(&segment->sequence, sequence + 2);
+
+    atomic_store(&segment->heartbeatNs, data->updateTimeNs);
+}
+
+void CameraInventoryHeartbeat(CameraInventoryMapping* mapping)
+{
+    atomic_store(&mapping->segment->heartbeatNs, GetMonotonicTimeNs());
+}
+
+VmbError_t CameraInventoryRead(CameraInventoryMapping const* mapping, CameraInventoryData* data)
+{
+    CameraInventorySegment* const segment = mapping->segment;
+    if (!HasHeartbeat(segment))
+    {
+        return VmbErrorNotAvailable;
+    }
+
+    for (int attempt = 0; attempt < CAMERA_INVENTORY_READ_ATTEMPTS; attempt++)
+    {
+        VmbUint64_t const sequenceBefore = atomic_load(&segment->sequence);
+        if ((sequenceBefore & 1) == 0)
+        {
+            // the copy may be torn; the unchanged sequence proves it is not
+            memcpy(data, &segment->data, sizeof(CameraInventoryData));
+            InventoryFence();
+            if (atomic_load(&segment->sequence) == sequenceBefore)
+            {
+                // the segment is created before the daemon collected its first inventory
+                return (data->updateCount != 0) ? VmbErrorSuccess : VmbErrorNotAvailable;
+            }
+        }
+        SleepUntilMonotonicNs(GetMonotonicTimeNs() + CAMERA_INVENTORY_RETRY_DELAY_NS);
+    }
+    return VmbErrorRetriesExceeded;
+}
+
+VmbError_t CameraInventoryReadOnce(CameraInventoryData* data)
+{
+    CameraInventoryMapping mapping;
+    VmbError_t err = CameraInventoryOpen(&mapping);
+    if (err == VmbErrorSuccess)
+    {
+        err = CameraInventoryRead(&mapping, data);
+        CameraInventoryClose(&mapping);
+    }
+    return err;
+}
+
+/**
+ * \brief Index of a record found in a handle index, computed from its address
+ */
+static VmbUint32_t ParentIndex(HandleIndex const* index, VmbHandle_t handle, void const* records, size_t recordSize)
+{
+    char const* const record = (char const*)HandleIndexFind(index, handle);
+    return (record == NULL) ? CAMERA_INVENTORY_NO_INDEX : (VmbUint32_t)((size_t)(record - (char const*)records) / recordSize);
+}
+
+static VmbError_t CollectTransportLayers(CameraInventoryData* data, HandleIndex* transportLayerIndex)
+{
+    VmbUint32_t count = 0;
+    VmbError_t err = VmbTransportLayersList(NULL, 0, &count, sizeof(VmbTransportLayerInfo_t));
+    if (err != VmbErrorSuccess || count == 0)
+    {
+        return err;
+    }
+
+    VmbTransportLayerInfo_t* const transportLayers = VMB_MALLOC_ARRAY(VmbTransportLayerInfo_t, count);
+    if (transportLayers == NULL)
+    {
+        return VmbErrorResources;
+    }
+
+    VmbUint32_t found = 0;
+    err = VmbTransportLayersList(transportLayers, count, &found, sizeof(VmbTransportLayerInfo_t));
+    if (err == VmbErrorMoreData)
+    {
+        data->truncated = VmbBoolTrue;
+        err = VmbErrorSuccess;
+    }
+    if (err == VmbErrorSuccess)
+    {
+        found = (found < count) ? found : count;
+        for (VmbUint32_t i = 0; i < found && err == VmbErrorSuccess; i++)
+        {
+            if (data->transportLayerCount == CAMERA_INVENTORY_MAX_TRANSPORT_LAYERS)
+            {
+                data->truncated = VmbBoolTrue;
+                break;
+            }
+
+            VmbTransportLayerInfo_t const* const info = &transportLayers[i];
+            InventoryTransportLayer* const record = &data->transportLayers[data->transportLayerCount++];
+            CopyInventoryString(record->id, sizeof(record->id), info->transportLayerIdString);
+            CopyInventoryString(record->name, sizeof(record->name), info->transportLayerName);
+            CopyInventoryString(record->modelName, sizeof(record->modelName), info->transportLayerModelName);
+            CopyInventoryString(record->vendor, sizeof(record->vendor), info->transportLayerVendor);
+            CopyInventoryString(record->version, sizeof(record->version), info->transportLayerVersion);
+            CopyInventoryString(record->path, sizeof(record->path), info->transportLayerPath);
+            record->type = (VmbUint32_t)info->transportLayerType;
+            err = HandleIndexInsert(transportLayerIndex, info->transportLayerHandle, record);
+        }
+    }
+
+    free(transportLayers);
+    return err;
+}
+
+static VmbError_t CollectInterfaces(CameraInventoryData* data, HandleIndex const* transportLayerIndex, HandleIndex* interfaceIndex)
+{
+    VmbUint32_t count = 0;
+    VmbError_t err = VmbInterfacesList(NULL, 0, &count, sizeof(VmbInterfaceInfo_t));
+    if (err != VmbErrorSuccess || count == 0)
+    {
+        return err;
+    }
+
+    VmbInterfaceInfo_t* const interfaces = VMB_MALLOC_ARRAY(VmbInterfaceInfo_t, count);
+    if (interfaces == NULL)
+    {
+        return VmbErrorResources;
+    }
+
+    VmbUint32_t found = 0;
+    err = VmbInterfacesList(interfaces, count, &found, sizeof(VmbInterfaceInfo_t));
+    if (err == VmbErrorMoreData)
+    {
+        data->truncated = VmbBoolTrue;
+        err = VmbErrorSuccess;
+    }
+    if (err == VmbErrorSuccess)
+    {
+        found = (found < count) ? found : count;
+        for (VmbUint32_t i = 0; i < found && err == VmbErrorSuccess; i++)
+        {
+            if (data->interfaceCount == CAMERA_INVENTORY_MAX_INTERFACES)
+            {
+                data->truncated = VmbBoolTrue;
+                break;
+            }
+
+            VmbInterfaceInfo_t const* const info = &interfaces[i];
+            InventoryInterface* const record = &data->interfaces[data->interfaceCount++];
+            CopyInventoryString(record->id, sizeof(record->id), info->interfaceIdString);
+            CopyInventoryString(record->name, sizeof(record->name), info->interfaceName);
+            record->type = (VmbUint32_t)info->interfaceType;
+            record->transportLayerIndex = ParentIndex(transportLayerIndex, info->transportLayerHandle, data->transportLayers, sizeof(InventoryTransportLayer));
+            err = HandleIndexInsert(interfaceIndex, info->interfaceHandle, record);
+        }
+    }
+
+    free(interfaces);
+    return err;
+}
+
+static VmbError_t CollectCameras(CameraInventoryData* data, HandleIndex const* transportLayerIndex, HandleIndex const* interfaceIndex)
+{
+    VmbUint32_t count = 0;
+    VmbError_t err = VmbCamerasList(NULL, 0, &count, sizeof(VmbCameraInfo_t));
+    if (err != VmbErrorSuccess || count == 0)
+    {
+        return err;
+    }
+
+    VmbCameraInfo_t* const cameras = VMB_MALLOC_ARRAY(VmbCameraInfo_t, count);
+    if (cameras == NULL)
+    {
+        return VmbErrorResources;
+    }
+
+    VmbUint32_t found = 0;
+    err = VmbCamerasList(cameras, count, &found, sizeof(VmbCameraInfo_t));
+    if (err == VmbErrorMoreData)
+    {
+        // cameras were discovered between the calls; they are part of the next inventory
+        err = VmbErrorSuccess;
+    }
+    if (err == VmbErrorSuccess)
+    {
+        found = (found < count) ? found : count;
+        for (VmbUint32_t i = 0; i < found; i++)
+        {
+            if (data->cameraCount == CAMERA_INVENTORY_MAX_CAMERAS)
+            {
+                data->truncated = VmbBoolTrue;
+                break;
+            }
+
+            VmbCameraInfo_t const* const info = &cameras[i];
+            InventoryCamera* const record = &data->cameras[data->cameraCount++];
+            CopyInventoryString(record->id, sizeof(record->id), info->cameraIdString);
+            CopyInventoryString(record->idExtended, sizeof(record->idExtended), info->cameraIdExtended);
+            CopyInventoryString(record->name, sizeof(record->name), info->cameraName);
+            CopyInventoryString(record->modelName, sizeof(record->modelName), info->modelName);
+            CopyInventoryString(record->serial, sizeof(record->serial), info->serialString);
+            record->permittedAccess = (VmbUint32_t)info->permittedAccess;
+            record->interfaceIndex = ParentIndex(interfaceIndex, info->interfaceHandle, data->interfaces, sizeof(InventoryInterface));
+            record->transportLayerIndex = ParentIndex(transportLayerIndex, info->transportLayerHandle, data->transportLayers, sizeof(InventoryTransportLayer));
+        }
+    }
+
+    free(cameras);
+    return err;
+}
+
+VmbError_t CameraInventoryCollect(CameraInventoryData* data)
+{
+    memset(data, 0, sizeof(CameraInventoryData));
+
+    // the records of the parent modules by handle, one index per module type; the handles themselves are
+    // meaningless to other processes
+    HandleIndex transportLayerIndex;
+    HandleIndex interfaceIndex;
+    VmbError_t err = HandleIndexInit(&transportLayerIndex, CAMERA_INVENTORY_MAX_TRANSPORT_LAYERS);
+    if (err == VmbErrorSuccess)
+    {
+        err = HandleIndexInit(&interfaceIndex, CAMERA_INVENTORY_MAX_INTERFACES);
+        if (err != VmbErrorSuccess)
+        {
+            HandleIndexFree(&transportLayerIndex);
+        }
+    }
+    if (err != VmbErrorSuccess)
+    {
+        return err;
+    }
+
+    err = CollectTransportLayers(data, &transportLayerIndex);
+    if (err == VmbErrorSuccess)
+    {
+        err = CollectInterfaces(data, &transportLayerIndex, &interfaceIndex);
+    }
+    if (err == VmbErrorSuccess)
+    {
+        err = CollectCameras(data, &transportLayerIndex, &interfaceIndex);
+    }
+
+    HandleIndexFree(&interfaceIndex);
+    HandleIndexFree(&transportLayerIndex);
+    return err;
+}
@@ -0,0 +1,631 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "include/VmbCExamplesCommon/ChunkDecoder.h"
+
+#include <VmbC/VmbC.h>
+
+#define CHUNK_DECODER_MAX_SCANNED_LENGTH    4096    // larger chunks, e.g. the image data, are not searched for values
+#define CHUNK_DECODER_VERIFY_INTERVAL       1000    // compare decoded values with VmbChunkDataAccess every n frames
+
+typedef struct ChunkFieldInfo
+{
+    const char* featureName;
+    const char* chunkSelector;  // value of ChunkSelector enabling the chunk
+    VmbBool_t   isFloat;
+    size_t      valueOffset;    // offset of the value in ChunkValues
+} ChunkFieldInfo;
+
+static const ChunkFieldInfo ChunkFieldInfos[ChunkFieldCount] =
+{
+    { "ChunkTimestamp",     "Timestamp",     VmbBoolFalse,   offsetof(ChunkValues, timestamp) },
+    { "ChunkWidth",         "Width",         VmbBoolFalse,   offsetof(ChunkValues, width) },
+    { "ChunkHeight",        "Height",        VmbBoolFalse,   offsetof(ChunkValues, height) },
+    { "ChunkExposureTime",  "ExposureTime",  VmbBoolTrue,    offsetof(ChunkValues, exposureTime) },
+    { "ChunkGain",          "Gain",          VmbBoolTrue,    offsetof(ChunkValues, gain) },
+    { "ChunkFrameID",       "FrameID",       VmbBoolFalse,   offsetof(ChunkValues, frameId) },
+    { "ChunkLineStatusAll", "LineStatusAll", VmbBoolFalse,   offsetof(ChunkValues, lineStatusAll) },
+};
+
+/**
+ * \brief Chunk layout of a single frame
+ */
+typedef struct ChunkList
+{
+    VmbUint32_t count;
+    VmbUint32_t ids[CHUNK_DECODER_MAX_CHUNKS];
+    VmbUint32_t lengths[CHUNK_DECODER_MAX_CHUNKS];
+    VmbUint32_t dataOffsets[CHUNK_DECODER_MAX_CHUNKS];
+} ChunkList;
+
+const char* ChunkFieldFeatureName(ChunkField field)
+{
+    return (field >= 0 && field < ChunkFieldCount) ? ChunkFieldInfos[field].featureName : NULL;
+}
+
+static VmbInt64_t* IntValue(ChunkValues* values, ChunkField field)
+{
+    return (VmbInt64_t*)(((char*)values) + ChunkFieldInfos[field].valueOffset);
+}
+
+static double* FloatValue(ChunkValues* values, ChunkField field)
+{
+    return (double*)(((char*)values) + ChunkFieldInfos[field].valueOffset);
+}
+
+static VmbUint64_t ReadUnsigned(const unsigned char* data, VmbUint8_t size, VmbBool_t bigEndian)
+{
+    VmbUint64_t result = 0;
+    for (VmbUint8_t i = 0; i < size; ++i)
+    {
+        result |= ((VmbUint64_t)data[bigEndian ? i : (size - 1 - i)]) << (8 * (size - 1 - i));
+    }
+    return result;
+}
+
+/**
+ * \brief Read a value stored at a given location converting it to the type used in ChunkValues
+ */
+static void ReadValue(const unsigned char* data, const ChunkValueLocation* location, VmbInt64_t* intValue, double* floatValue)
+{
+    VmbUint64_t const raw = ReadUnsigned(data, location->size, location->bigEndian);
+    if (location->isFloat)
+    {
+        if (location->size == 8)
+        {
+            memcpy(floatValue, &raw, sizeof(double));
+        }
+        else
+        {
+            VmbUint32_t const raw32 = (VmbUint32_t)raw;
+            float value;
+            memcpy(&value, &raw32, sizeof(float));
+            *floatValue = value;
+        }
+    }
+    else
+    {
+        *intValue = (location->size == 8) ? (VmbInt64_t)raw : (VmbInt64_t)(VmbUint32_t)raw;
+    }
+}
+
+/**
+ * \brief Walk the chunk trailers starting at the end of the payload
+ *
+ * \return true, if the chunks exactly cover the payload
+ */
+static VmbBool_t ParseChunkList(const unsigned char* payload, VmbUint32_t payloadSize, VmbBool_t bigEndian, ChunkList* chunks)
+{
+    VmbUint32_t end = payloadSize;
+    chunks->count = 0;
+
+    while (end != 0)
+    {
+        if (end < 8 || chunks->count == CHUNK_DECODER_MAX_CHUNKS)
+        {
+            return VmbBoolFalse;
+        }
+
+        VmbUint32_t const id = (VmbUint32_t)ReadUnsigned(payload + end - 8, 4, bigEndian);
+        VmbUint32_t const length = (VmbUint32_t)ReadUnsigned(payload + end - 4, 4, bigEndian);
+        if (length > end - 8)
+        {
+            return VmbBoolFalse;
+        }
+
+        end -= 8 + length;
+        chunks->ids[chunks->count] = id;
+        chunks->lengths[chunks->count] = length;
+        chunks->dataOffsets[chunks->count] = end;
+        ++chunks->count;
+    }
+
+    return chunks->count != 0;
+}
+
+static VmbBool_t LayoutMatches(const ChunkDecoder* decoder, const ChunkList* chunks)
+{
+    if (chunks->count != decoder->chunkCount)
+    {
+        return VmbBoolFalse;
+    }
+
+    for (VmbUint32_t i = 0; i < chunks->count; ++i)
+    {
+        if (chunks->ids[i] != decoder->chunkIds[i] || chunks->lengths[i] != decoder->chunkLengths[i])
+        {
+            return VmbBoolFalse;
+        }
+    }
+    return VmbBoolTrue;
+}
+
+static VmbBool_t ValueMatches(const unsigned char* payload, const ChunkList* chunks, const ChunkValueLocation* location, ChunkValues* expected, ChunkField field)
+{
+    VmbInt64_t intValue = 0;
+    double floatValue = 0.0;
+    ReadValue(payload + chunks->dataOffsets[location->chunkIndex] + location->offset, location, &intValue, &floatValue);
+
+    return location->isFloat ? (floatValue == *FloatValue(expected, field)) : (intValue == *IntValue(expected, field));
+}
+
+/**
+ * \brief Search all small chunks for locations storing the value of a field
+ *
+ * If more locations match than fit into the candidate list, the field is marked in ChunkDecoder::candidateOverflow,
+ * since the true location may have been dropped.
+ */
+static void FindCandidates(ChunkDecoder* decoder, const unsigned char* payload, const ChunkList* chunks, ChunkValues* expected, ChunkField field)
+{
+    static const VmbUint8_t sizes[] = { 8, 4 };
+
+    decoder->candidateCounts[field] = 0;
+    decoder->candidateOverflow &= ~CHUNK_FIELD_BIT(field);
+
+    for (VmbUint32_t chunkIndex = 0; chunkIndex < chunks->count; ++chunkIndex)
+    {
+        VmbUint32_t const length = chunks->lengths[chunkIndex];
+        if (length > CHUNK_DECODER_MAX_SCANNED_LENGTH)
+        {
+            continue;
+        }
+
+        for (VmbUint32_t offset = 0; offset + 4 <= length; offset += 4)
+        {
+            for (size_t sizeIndex = 0; sizeIndex < sizeof(sizes) / sizeof(sizes[0]); ++sizeIndex)
+            {
+                for (int bigEndian = 0; bigEndian < 2; ++bigEndian)
+                {
+                    ChunkValueLocation const location =
+                    {
+                        chunkIndex, offset, sizes[sizeIndex], bigEndian ? VmbBoolTrue : VmbBoolFalse, ChunkFieldInfos[field].isFloat
+                    };
+
+                    if (offset + location.size <= length
+                        && ValueMatches(payload, chunks, &location, expected, field))
+                    {
+                        if (decoder->candidateCounts[field] < CHUNK_DECODER_MAX_CANDIDATES)
+                        {
+                            decoder->candidates[field][decoder->candidateCounts[field]++] = location;
+                        }
+                        else
+                        {
+                            decoder->candidateOverflow |= CHUNK_FIELD_BIT(field);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \brief Remove the candidates not matching the values of the current frame
+ */
+static void FilterCandidates(ChunkDecoder* decoder, const unsigned char* payload, const ChunkList* chunks, ChunkValues* expected, ChunkField field)
+{
+    VmbUint32_t kept = 0;
+    for (VmbUint32_t i = 0; i < decoder->candidateCounts[field]; ++i)
+    {
+        if (ValueMatches(payload, chunks, &decoder->candidates[field][i], expected, field))
+        {
+            decoder->candidates[field][kept++] = decoder->candidates[field][i];
+        }
+    }
+    decoder->candidateCounts[field] = kept;
+}
+
+/**
+ * \brief Narrow down the candidates of fields using the values of another frame
+ *
+ * Fields whose last search exceeded the candidate limit are searched again instead.
+ */
+static void UpdateCandidates(ChunkDecoder* decoder, const unsigned char* payload, const ChunkList* chunks, ChunkValues* expected, VmbUint32_t fields)
+{
+    for (int field = 0; field < ChunkFieldCount; ++field)
+    {
+        if ((fields & CHUNK_FIELD_BIT(field)) && (expected->validFields & CHUNK_FIELD_BIT(field)))
+        {
+            if (decoder->candidateOverflow & CHUNK_FIELD_BIT(field))
+            {
+                FindCandidates(decoder, payload, chunks, expected, (ChunkField)field);
+            }
+            else
+            {
+                FilterCandidates(decoder, payload, chunks, expected, (ChunkField)field);
+            }
+        }
+    }
+}
+
+/**
+ * \brief Check, if two locations read the same bytes and differ in size only
+ *
+ * A 4 byte value followed by zeros in little endian order (or preceded by zeros in big endian order) matches as
+ * 4 and 8 byte value; both locations yield the same value as long as the additional bytes stay zero.
+ */
+static VmbBool_t LocationsNested(const ChunkValueLocation* a, const ChunkValueLocation* b)
+{
+    if (a->size == b->size || a->chunkIndex != b->chunkIndex || a->bigEndian != b->bigEndian || a->isFloat)
+    {
+        return VmbBoolFalse;
+    }
+
+    const ChunkValueLocation* wide = (a->size > b->size) ? a : b;
+    const ChunkValueLocation* narrow = (a->size > b->size) ? b : a;
+    return narrow->offset == wide->offset + (wide->bigEndian ? (VmbUint32_t)(wide->size - narrow->size) : 0u);
+}
+
+/**
+ * \brief Check, if the candidates of a field determine its location
+ */
+static VmbBool_t LocationResolved(const ChunkDecoder* decoder, ChunkField field)
+{
+    if (decoder->candidateOverflow & CHUNK_FIELD_BIT(field))
+    {
+        return VmbBoolFalse;
+    }
+
+    switch (decoder->candidateCounts[field])
+    {
+    case 1:
+        return VmbBoolTrue;
+    case 2:
+        return LocationsNested(&decoder->candidates[field][0], &decoder->candidates[field][1]);
+    default:
+        return VmbBoolFalse;
+    }
+}
+
+/**
+ * \brief Decode the fields with a unique location from the buffer
+ *
+ * Fields matching several locations, e.g. the width and height of a square image or two values staying equal, are
+ * read via VmbChunkDataAccess until the values of a frame rule out all but one location. Fields without candidates
+ * are stored in a way the decoder does not support; fields with too many candidates may have lost their true
+ * location. Both are read via VmbChunkDataAccess as well.
+ */
+static void ResolveCandidates(ChunkDecoder* decoder)
+{
+    VmbUint32_t const fields = decoder->decodedFields | decoder->chunkAccessFields;
+    decoder->decodedFields = 0;
+    decoder->chunkAccessFields = 0;
+
+    for (int field = 0; field < ChunkFieldCount; ++field)
+    {
+        VmbUint32_t const bit = CHUNK_FIELD_BIT(field);
+        if (fields & bit)
+        {
+            if (LocationResolved(decoder, (ChunkField)field))
+            {
+                decoder->decodedFields |= bit;
+            }
+            else
+            {
+                decoder->chunkAccessFields |= bit;
+            }
+        }
+    }
+}
+
+/**
+ * \brief Use a frame the values were read for via VmbChunkDataAccess to learn the chunk layout and the possible
+ *        locations of the values
+ *
+ * Only fields with a unique location are decoded from the buffer afterwards; the others are narrowed down further
+ * with every frame they are read via VmbChunkDataAccess for.
+ */
+static void LearnLayout(ChunkDecoder* decoder, const VmbFrame_t* frame, ChunkValues* expected)
+{
+    const unsigned char* payload = (const unsigned char*)frame->buffer;
+    ChunkList chunks;
+
+    // the byte order of the trailers is unknown until a frame was parsed successfully
+    VmbBool_t bigEndian = decoder->trailerBigEndian;
+    VmbBool_t parsed = ParseChunkList(payload, decoder->payloadSize, bigEndian, &chunks);
+    if (!parsed)
+    {
+        bigEndian = !bigEndian;
+        parsed = ParseChunkList(payload, decoder->payloadSize, bigEndian, &chunks);
+    }
+
+    if (!parsed)
+    {
+        // try again with the next frame
+        return;
+    }
+
+    decoder->trailerBigEndian = bigEndian;
+    decoder->chunkCount = chunks.count;
+    memcpy(decoder->chunkIds, chunks.ids, sizeof(chunks.ids));
+    memcpy(decoder->chunkLengths, chunks.lengths, sizeof(chunks.lengths));
+    decoder->decodedFields = 0;
+    decoder->chunkAccessFields = expected->validFields & decoder->requestedFields;
+    decoder->candidateOverflow = 0;
+
+    VmbBool_t located = VmbBoolFalse;
+    for (int field = 0; field < ChunkFieldCount; ++field)
+    {
+        if (decoder->chunkAccessFields & CHUNK_FIELD_BIT(field))
+        {
+            FindCandidates(decoder, payload, &chunks, expected, (ChunkField)field);
+            located |= (decoder->candidateCounts[field] != 0 || (decoder->candidateOverflow & CHUNK_FIELD_BIT(field)));
+        }
+    }
+
+    if (!located)
+    {
+        // none of the values is stored in a way the decoder supports
+        decoder->learningFailed = VmbBoolTrue;
+        return;
+    }
+
+    ResolveCandidates(decoder);
+    decoder->layoutKnown = VmbBoolTrue;
+    decoder->framesSinceVerification = 0;
+}
+
+static VmbBool_t ValuesEqual(const ChunkValues* a, const ChunkValues* b, VmbUint32_t fields)
+{
+    for (int field = 0; field < ChunkFieldCount; ++field)
+    {
+        if (fields & CHUNK_FIELD_BIT(field))
+        {
+            if (ChunkFieldInfos[field].isFloat
+                ? (*FloatValue((ChunkValues*)a, (ChunkField)field) != *FloatValue((ChunkValues*)b, (ChunkField)field))
+                : (*IntValue((ChunkValues*)a, (ChunkField)field) != *IntValue((ChunkValues*)b, (ChunkField)field)))
+            {
+                return VmbBoolFalse;
+            }
+        }
+    }
+    return VmbBoolTrue;
+}
+
+typedef struct ChunkAccessContext
+{
+    VmbUint32_t     requestedFields;
+    ChunkValues*    values;
+} ChunkAccessContext;
+
+static VmbError_t VMB_CALL ChunkAccessCallback(VmbHandle_t featureAccessHandle, void* userContext)
+{
+    ChunkAccessContext* context = (ChunkAccessContext*)userContext;
+
+    for (int field = 0; field < ChunkFieldCount; ++field)
+    {
+        if (context->requestedFields & CHUNK_FIELD_BIT(field))
+        {
+            VmbError_t const err = ChunkFieldInfos[field].isFloat
+                ? VmbFeatureFloatGet(featureAccessHandle, ChunkFieldInfos[field].featureName, FloatValue(context->values, (ChunkField)field))
+                : VmbFeatureIntGet(featureAccessHandle, ChunkFieldInfos[field].featureName, IntValue(context->values, (ChunkField)field));
+            if (err == VmbErrorSuccess)
+            {
+                context->values->validFields |= CHUNK_FIELD_BIT(field);
+            }
+        }
+    }
+
+    return VmbErrorSuccess;
+}
+
+VmbError_t ChunkDecoderEnableChunks(VmbHandle_t cameraHandle, VmbUint32_t fields)
+{
+    // chunks can only be enabled while the chunk mode is inactive on some cameras
+    VmbFeatureBoolSet(cameraHandle, "ChunkModeActive", VmbBoolFalse);
+
+    VmbError_t enableErr = VmbErrorSuccess;
+    for (int field = 0; field < ChunkFieldCount; ++field)
+    {
+        if ((fields & CHUNK_FIELD_BIT(field))
+            && VmbFeatureEnumSet(cameraHandle, "ChunkSelector", ChunkFieldInfos[field].chunkSelector) == VmbErrorSuccess)
+        {
+            VmbError_t const err = VmbFeatureBoolSet(cameraHandle, "ChunkEnable", VmbBoolTrue);
+            if (enableErr == VmbErrorSuccess)
+            {
+                enableErr = err;
+            }
+        }
+    }
+
+    VmbError_t const err = VmbFeatureBoolSet(cameraHandle, "ChunkModeActive", VmbBoolTrue);
+    return (err != VmbErrorSuccess) ? err : enableErr;
+}
+
+VmbError_t ChunkDecoderReadWithChunkAccess(const VmbFrame_t* frame, VmbUint32_t requestedFields, ChunkValues* values)
+{
+    memset(values, 0, sizeof(ChunkValues));
+
+    if (!frame->chunkDataPresent)
+    {
+        return VmbErrorNoChunkData;
+    }
+
+    ChunkAccessContext context = { requestedFields, values };
+    VmbError_t err = VmbChunkDataAccess(frame, ChunkAccessCallback, &context);
+    if (err == VmbErrorSuccess && values->validFields == 0)
+    {
+        err = VmbErrorNotAvailable;
+    }
+    return err;
+}
+
+void ChunkDecoderInit(ChunkDecoder* decoder, VmbUint32_t payloadSize, VmbUint32_t requestedFields)
+{
+    memset(decoder, 0, sizeof(ChunkDecoder));
+    decoder->requestedFields = requestedFields;
+    decoder->payloadSize = payloadSize;
+    decoder->trailerBigEndian = VmbBoolTrue; // GigE Vision uses network byte order; tried first
+}
+
+/**
+ * \brief Extract the values with a unique location from the buffer using the learned layout
+ *
+ * A field may still have two nested candidates; these are only used, if they agree on the value.
+ *
+ * \return the fields whose candidates disagree; these are not set in values
+ */
+static VmbUint32_t DecodeWithLayout(const ChunkDecoder* decoder, const unsigned char* payload, const ChunkList* chunks, ChunkValues* values)
+{
+    VmbUint32_t ambiguousFields = 0;
+
+    for (int field = 0; field < ChunkFieldCount; ++field)
+    {
+        if (decoder->decodedFields & CHUNK_FIELD_BIT(field))
+        {
+            VmbInt64_t intValue = 0;
+            double floatValue = 0.0;
+
+            for (VmbUint32_t i = 0; i < decoder->candidateCounts[field]; ++i)
+            {
+                const ChunkValueLocation* location = &decoder->candidates[field][i];
+                VmbInt64_t candidateInt = 0;
+                double candidateFloat = 0.0;
+                ReadValue(payload + chunks->dataOffsets[location->chunkIndex] + location->offset, location, &candidateInt, &candidateFloat);
+
+                if (i == 0)
+                {
+                    intValue = candidateInt;
+                    floatValue = candidateFloat;
+                }
+                else if (ChunkFieldInfos[field].isFloat ? (candidateFloat != floatValue) : (candidateInt != intValue))
+                {
+                    ambiguousFields |= CHUNK_FIELD_BIT(field);
+                    break;
+                }
+            }
+
+            if (ChunkFieldInfos[field].isFloat)
+            {
+                *FloatValue(values, (ChunkField)field) = floatValue;
+            }
+            else
+            {
+                *IntValue(values, (ChunkField)field) = intValue;
+            }
+        }
+    }
+
+    values->validFields = decoder->decodedFields & ~ambiguousFields;
+    return ambiguousFields;
+}
+
+/**
+ * \brief Copy the given fields available in source to values
+ */
+static void MergeValues(ChunkValues* values, ChunkValues* source, VmbUint32_t fields)
+{
+    for (int field = 0; field < ChunkFieldCount; ++field)
+    {
+        VmbUint32_t const bit = CHUNK_FIELD_BIT(field);
+        if ((fields & bit) && (source->validFields & bit))
+        {
+            if (ChunkFieldInfos[field].isFloat)
+            {
+                *FloatValue(values, (ChunkField)field) = *FloatValue(source, (ChunkField)field);
+            }
+            else
+            {
+                *IntValue(values, (ChunkField)field) = *IntValue(source, (ChunkField)field);
+            }
+            values->validFields |= bit;
+        }
+    }
+}
+
+/**
+ * \brief Extract the values of a frame using the learned layout
+ *
+ * Values the buffer does not determine are read via VmbChunkDataAccess and used for narrowing down the candidates.
+ *
+ * \return false, if the frame does not use the learned layout or the decoded values failed the periodic verification
+ */
+static VmbBool_t DecodeWithLearnedLayout(ChunkDecoder* decoder, const VmbFrame_t* frame, ChunkValues* values)
+{
+    const unsigned char* payload = (const unsigned char*)frame->buffer;
+    ChunkList chunks;
+
+    if (!ParseChunkList(payload, decoder->payloadSize, decoder->trailerBigEndian, &chunks)
+        || !LayoutMatches(decoder, &chunks))
+    {
+        return VmbBoolFalse;
+    }
+
+    VmbUint32_t const ambiguousFields = DecodeWithLayout(decoder, payload, &chunks, values);
+    VmbUint32_t const chunkAccessFields = decoder->chunkAccessFields | ambiguousFields;
+
+    // make sure a location not storing the value did not produce the correct values by chance so far
+    VmbBool_t const verify = (++decoder->framesSinceVerification >= CHUNK_DECODER_VERIFY_INTERVAL);
+    if (!verify && chunkAccessFields == 0)
+    {
+        ++decoder->framesDecoded;
+        return VmbBoolTrue;
+    }
+
+    ChunkValues accessed;
+    VmbError_t const err = ChunkDecoderReadWithChunkAccess(frame, verify ? decoder->requestedFields : chunkAccessFields, &accessed);
+    if (verify)
+    {
+        VmbUint32_t const verifiedFields = decoder->decodedFields & ~ambiguousFields;
+        decoder->framesSinceVerification = 0;
+        if (err != VmbErrorSuccess
+            || (accessed.validFields & verifiedFields) != verifiedFields
+            || !ValuesEqual(values, &accessed, verifiedFields))
+        {
+            return VmbBoolFalse;
+        }
+    }
+
+    if (chunkAccessFields == 0)
+    {
+        ++decoder->framesDecoded;
+        return VmbBoolTrue;
+    }
+
+    ++decoder->framesChunkAccess;
+    MergeValues(values, &accessed, chunkAccessFields);
+    if (err == VmbErrorSuccess)
+    {
+        UpdateCandidates(decoder, payload, &chunks, &accessed, chunkAccessFields);
+        ResolveCandidates(decoder);
+    }
+    return VmbBoolTrue;
+}
+
+VmbError_t ChunkDecoderDecode(ChunkDecoder* decoder, const VmbFrame_t* frame, ChunkValues* values)
+{
+    memset(values, 0, sizeof(ChunkValues));
+
+    if (!frame->chunkDataPresent)
+    {
+        return VmbErrorNoChunkData;
+    }
+
+    VmbBool_t const payloadUsable = (frame->buffer != NULL && decoder->payloadSize != 0 && decoder->payloadSize <= frame->bufferSize);
+
+    if (payloadUsable && decoder->layoutKnown)
+    {
+        if (DecodeWithLearnedLayout(decoder, frame, values))
+        {
+            return (values->validFields != 0) ? VmbErrorSuccess : VmbErrorNotAvailable;
+        }
+
+        // layout changed: fall back to VmbChunkDataAccess and learn the new layout
+        memset(values, 0, sizeof(ChunkValues));
+        ++decoder->layoutChanges;
+        decoder->layoutKnown = VmbBoolFalse;
+    }
+
+    ++decoder->framesChunkAccess;
+    VmbError_t const err = ChunkDecoderReadWithChunkAccess(frame, decoder->requestedFields, values);
+    if (err == VmbErrorSuccess && payloadUsable && !decoder->layoutKnown && !decoder->learningFailed)
+    {
+        LearnLayout(decoder, frame, values);
+    }
+    return err;
+}
@@ -0,0 +1,199 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/VmbCExamplesCommon/ClockDriftEstimator.h"
+
+#define FIT_INTERVAL            8           // number of samples added between two fits once the model is valid
+#define OUTLIER_THRESHOLD       3.0         // number of scaled median absolute deviations a residual may differ from the median
+#define MAD_TO_STD_DEV          1.4826      // scale factor of the median absolute deviation for normally distributed values
+#define MIN_OUTLIER_DISTANCE_NS 1000.0      // residuals closer to the median are never rejected, even if most residuals are identical
+
+void ClockDriftEstimatorInit(ClockDriftEstimator* estimator, VmbUint64_t tickFrequency)
+{
+    memset(estimator, 0, sizeof(ClockDriftEstimator));
+    estimator->nominalNsPerTick = (tickFrequency == 0) ? 1.0 : 1e9 / (double)tickFrequency;
+}
+
+static int CompareDoubles(const void* a, const void* b)
+{
+    double const lhs = *(const double*)a;
+    double const rhs = *(const double*)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static double Median(double* values, VmbUint32_t count)
+{
+    qsort(values, count, sizeof(double), CompareDoubles);
+    return (count % 2 != 0) ? values[count / 2] : 0.5 * (values[count / 2 - 1] + values[count / 2]);
+}
+
+/**
+ * \brief Least squares fit of the samples selected by the mask
+ *
+ * Uses coordinates relative to the oldest sample, so the large absolute timestamps do not reduce the precision.
+ *
+ * \return false, if the selected samples do not allow a fit
+ */
+static VmbBool_t FitLine(const ClockDriftEstimator* estimator, const VmbBool_t* inliers, double* intercept, double* slope)
+{
+    VmbUint32_t const oldest = (estimator->nextSample + CLOCK_DRIFT_ESTIMATOR_WINDOW - estimator->sampleCount) % CLOCK_DRIFT_ESTIMATOR_WINDOW;
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumXX = 0.0;
+    double sumXY = 0.0;
+    VmbUint32_t count = 0;
+
+    for (VmbUint32_t i = 0; i < estimator->sampleCount; ++i)
+    {
+        VmbUint32_t const index = (oldest + i) % CLOCK_DRIFT_ESTIMATOR_WINDOW;
+        if (inliers == NULL || inliers[index])
+        {
+            double const x = (double)(estimator->cameraTicks[index] - estimator->cameraTicks[oldest]);
+            double const y = (double)(VmbInt64_t)(estimator->hostNs[index] - estimator->hostNs[oldest]);
+            sumX += x;
+            sumY += y;
+            sumXX += x * x;
+            sumXY += x * y;
+            ++count;
+        }
+    }
+
+    if (count < 2)
+    {
+        return VmbBoolFalse;
+    }
+
+    double const meanX = sumX / count;
+    double const meanY = sumY / count;
+    double const varianceX = sumXX / count - meanX * meanX;
+    if (varianceX <= 0.0)
+    {
+        return VmbBoolFalse;
+    }
+
+    *slope = (sumXY / count - meanX * meanY) / varianceX;
+    *intercept = meanY - *slope * meanX;
+    return VmbBoolTrue;
+}
+
+static void Fit(ClockDriftEstimator* estimator)
+{
+    VmbUint32_t const oldest = (estimator->nextSample + CLOCK_DRIFT_ESTIMATOR_WINDOW - estimator->sampleCount) % CLOCK_DRIFT_ESTIMATOR_WINDOW;
+    double intercept;
+    double slope;
+
+    if (!FitLine(estimator, NULL, &intercept, &slope))
+    {
+        return;
+    }
+
+    // reject samples far away from the first fit using the median absolute deviation of the residuals
+    for (VmbUint32_t i = 0; i < estimator->sampleCount; ++i)
+    {
+        VmbUint32_t const index = (oldest + i) % CLOCK_DRIFT_ESTIMATOR_WINDOW;
+        double const x = (double)(estimator->cameraTicks[index] - estimator->cameraTicks[oldest]);
+        double const y = (double)(VmbInt64_t)(estimator->hostNs[index] - estimator->hostNs[oldest]);
+        estimator->residuals[index] = y - (intercept + slope * x);
+    }
+
+    memcpy(estimator->sortedResiduals, estimator->residuals, sizeof(estimator->residuals));
+    double const median = Median(estimator->sortedResiduals, estimator->sampleCount);
+
+    for (VmbUint32_t i = 0; i < estimator->sampleCount; ++i)
+    {
+        estimator->sortedResiduals[i] = fabs(estimator->residuals[(oldest + i) % CLOCK_DRIFT_ESTIMATOR_WINDOW] - median);
+    }
+    double const mad = Median(estimator->sortedResiduals, estimator->sampleCount);
+    double threshold = OUTLIER_THRESHOLD * MAD_TO_STD_DEV * mad;
+    threshold = (threshold < MIN_OUTLIER_DISTANCE_NS) ? MIN_OUTLIER_DISTANCE_NS : threshold;
+
+    VmbBool_t inliers[CLOCK_DRIFT_ESTIMATOR_WINDOW];
+    VmbUint32_t inlierCount = 0;
+    for (VmbUint32_t i = 0; i < estimator->sampleCount; ++i)
+    {
+        VmbUint32_t const index = (oldest + i) % CLOCK_DRIFT_ESTIMATOR_WINDOW;
+        inliers[index] = fabs(estimator->residuals[index] - median) <= threshold;
+        inlierCount += inliers[index] ? 1 : 0;
+    }
+
+    if (inlierCount < CLOCK_DRIFT_ESTIMATOR_MIN_SAMPLES / 2 || !FitLine(estimator, inliers, &intercept, &slope))
+    {
+        return;
+    }
+
+    double sumOfSquares = 0.0;
+    for (VmbUint32_t i = 0; i < estimator->sampleCount; ++i)
+    {
+        VmbUint32_t const index = (oldest + i) % CLOCK_DRIFT_ESTIMATOR_WINDOW;
+        if (inliers[index])
+        {
+            double const x = (double)(estimator->cameraTicks[index] - estimator->cameraTicks[oldest]);
+            double const y = (double)(VmbInt64_t)(estimator->hostNs[index] - estimator->hostNs[oldest]);
+            double const residual = y - (intercept + slope * x);
+            sumOfSquares += residual * residual;
+        }
+    }
+
+    estimator->modelValid = VmbBoolTrue;
+    estimator->referenceTicks = estimator->cameraTicks[oldest];
+    estimator->referenceHostNs = estimator->hostNs[oldest];
+    estimator->interceptNs = intercept;
+    estimator->slope = slope;
+    estimator->residualStdDevNs = sqrt(sumOfSquares / inlierCount);
+    estimator->inlierCount = inlierCount;
+}
+
+void ClockDriftEstimatorAddSample(ClockDriftEstimator* estimator, VmbUint64_t cameraTicks, VmbUint64_t hostNs)
+{
+    if (estimator->sampleCount != 0)
+    {
+        VmbUint32_t const newest = (estimator->nextSample + CLOCK_DRIFT_ESTIMATOR_WINDOW - 1) % CLOCK_DRIFT_ESTIMATOR_WINDOW;
+        if (cameraTicks <= estimator->cameraTicks[newest])
+        {
+            // the camera clock was reset, e.g. by GevTimestampControlReset; the old samples are useless
+            estimator->sampleCount = 0;
+            estimator->nextSample = 0;
+            estimator->modelValid = VmbBoolFalse;
+            ++estimator->resets;
+        }
+    }
+
+    estimator->cameraTicks[estimator->nextSample] = cameraTicks;
+    estimator->hostNs[estimator->nextSample] = hostNs;
+    estimator->nextSample = (estimator->nextSample + 1) % CLOCK_DRIFT_ESTIMATOR_WINDOW;
+    if (estimator->sampleCount < CLOCK_DRIFT_ESTIMATOR_WINDOW)
+    {
+        ++estimator->sampleCount;
+    }
+
+    ++estimator->samplesSinceFit;
+    if (estimator->sampleCount >= CLOCK_DRIFT_ESTIMATOR_MIN_SAMPLES
+        && (!estimator->modelValid || estimator->samplesSinceFit >= FIT_INTERVAL))
+    {
+        Fit(estimator);
+        estimator->samplesSinceFit = 0;
+    }
+}
+
+VmbBool_t ClockDriftEstimatorToHostNs(const ClockDriftEstimator* estimator, VmbUint64_t cameraTicks, VmbUint64_t* hostNs)
+{
+    if (!estimator->modelValid)
+    {
+        return VmbBoolFalse;
+    }
+
+    double const x = (double)(VmbInt64_t)(cameraTicks - estimator->referenceTicks);
+    *hostNs = estimator->referenceHostNs + (VmbUint64_t)(VmbInt64_t)llround(estimator->interceptNs + estimator->slope * x);
+    return VmbBoolTrue;
+}
+
+double ClockDriftEstimatorDriftPpm(const ClockDriftEstimator* estimator)
+{
+    return estimator->modelValid ? (estimator->slope / estimator->nominalNsPerTick - 1.0) * 1e6 : 0.0;
+}
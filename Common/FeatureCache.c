@@ -0,0 +1,284 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <string.h>
+
+#include "include/VmbCExamplesCommon/FeatureCache.h"
+
+#include <VmbC/VmbC.h>
+
+#define FEATURE_CACHE_MASK (FEATURE_CACHE_CAPACITY - 1)
+
+/**
+ * \brief FNV-1a hash of a feature name
+ */
+static VmbUint32_t HashName(const char* name)
+{
+    VmbUint32_t hash = 2166136261u;
+    for (; *name != '\0'; ++name)
+    {
+        hash = (hash ^ (unsigned char)*name) * 16777619u;
+    }
+    return hash;
+}
+
+static void VMB_CALL FeatureInvalidated(const VmbHandle_t handle, const char* name, void* userContext)
+{
+    FeatureCacheEntry* const entry = (FeatureCacheEntry*)userContext;
+    atomic_fetch_add(&entry->generation, 1);
+    atomic_fetch_add(&entry->cache->invalidations, 1);
+}
+
+VmbError_t FeatureCacheInit(FeatureCache* cache, VmbHandle_t handle)
+{
+    memset(cache, 0, sizeof(FeatureCache));
+    cache->handle = handle;
+    for (VmbUint32_t i = 0; i < FEATURE_CACHE_CAPACITY; i++)
+    {
+        atomic_store(&cache->entries[i].generation, 0);
+        cache->entries[i].cache = cache;
+    }
+    atomic_store(&cache->invalidations, 0);
+    return (mtx_init(&cache->mutex, mtx_plain) == thrd_success) ? VmbErrorSuccess : VmbErrorResources;
+}
+
+void FeatureCacheDestroy(FeatureCache* cache)
+{
+    for (VmbUint32_t i = 0; i < FEATURE_CACHE_CAPACITY; i++)
+    {
+        FeatureCacheEntry* const entry = &cache->entries[i];
+        if (entry->used && entry->cached)
+        {
+            VmbFeatureInvalidationUnregister(cache->handle, cache->namePool + entry->nameOffset, FeatureInvalidated);
+        }
+    }
+    mtx_destroy(&cache->mutex);
+}
+
+/**
+ * \brief Find the entry of a feature; the mutex must be locked
+ *
+ * \param[out] freeIndex    receives the slot a new entry of the feature is stored in
+ *
+ * \return NULL, if there is no entry for the feature
+ */
+static FeatureCacheEntry* FindEntry(FeatureCache* cache, const char* name, VmbUint32_t hash, VmbUint32_t* freeIndex)
+{
+    VmbUint32_t index = hash & FEATURE_CACHE_MASK;
+    for (VmbUint32_t probe = 0; probe < FEATURE_CACHE_CAPACITY; probe++, index = (index + 1) & FEATURE_CACHE_MASK)
+    {
+        FeatureCacheEntry* const entry = &cache->entries[index];
+        if (!entry->used)
+        {
+            break;
+        }
+        if (entry->hash == hash && strcmp(cache->namePool + entry->nameOffset, name) == 0)
+        {
+            return entry;
+        }
+    }
+    *freeIndex = index;
+    return NULL;
+}
+
+/**
+ * \brief Find the entry of a feature or create it and register its invalidation callback; the mutex must be locked
+ *
+ * \return NULL, if the table or the name pool is full or the feature does not exist
+ */
+static FeatureCacheEntry* FindOrAddEntry(FeatureCache* cache, const char* name, VmbError_t* error)
+{
+    VmbUint32_t const hash = HashName(name);
+    VmbUint32_t index = 0;
+    FeatureCacheEntry* const existing = FindEntry(cache, name, hash, &index);
+    if (existing != NULL)
+    {
+        return existing;
+    }
+
+    // keep a quarter of the slots free, so probing stays short
+    size_t const nameSize = strlen(name) + 1;
+    if (cache->entryCount >= FEATURE_CACHE_CAPACITY - FEATURE_CACHE_CAPACITY / 4
+        || cache->namePoolUsed + nameSize > FEATURE_CACHE_NAME_POOL)
+    {
+        *error = VmbErrorResources;
+        return NULL;
+    }
+
+    VmbFeatureInfo_t info;
+    *error = VmbFeatureInfoQuery(cache->handle, name, &info, sizeof(info));
+    if (*error != VmbErrorSuccess)
+    {
+        return NULL;
+    }
+
+    FeatureCacheEntry* const entry = &cache->entries[index];
+    entry->used = VmbBoolTrue;
+    entry->hash = hash;
+    entry->nameOffset = cache->namePoolUsed;
+    entry->type = info.featureDataType;
+    memcpy(cache->namePool + cache->namePoolUsed, name, nameSize);
+    cache->namePoolUsed += (VmbUint32_t)nameSize;
+    ++cache->entryCount;
+
+    entry->cached = !(info.featureFlags & VmbFeatureFlagsVolatile)
+        && VmbFeatureInvalidationRegister(cache->handle, cache->namePool + entry->nameOffset, FeatureInvalidated, entry) == VmbErrorSuccess;
+    return entry;
+}
+
+/**
+ * \brief Read the value of an entry from the module
+ */
+static VmbError_t ReadEntry(FeatureCache* cache, FeatureCacheEntry* entry)
+{
+    const char* const name = cache->namePool + entry->nameOffset;
+    switch (entry->type)
+    {
+    case VmbFeatureDataInt:
+        return VmbFeatureIntGet(cache->handle, name, &entry->intValue);
+    case VmbFeatureDataFloat:
+        return VmbFeatureFloatGet(cache->handle, name, &entry->floatValue);
+    case VmbFeatureDataEnum:
+        return VmbFeatureEnumGet(cache->handle, name, &entry->enumValue);
+    case VmbFeatureDataBool:
+    {
+        VmbBool_t value = VmbBoolFalse;
+        VmbError_t const error = VmbFeatureBoolGet(cache->handle, name, &value);
+        entry->intValue = value;
+        return error;
+    }
+    default:
+        return VmbErrorWrongType;
+    }
+}
+
+/**
+ * \brief Get an up to date entry of the requested type
+ *
+ * \return the locked entry or NULL and the unlocked mutex in case of an error
+ */
+static FeatureCacheEntry* GetEntry(FeatureCache* cache, const char* name, VmbFeatureData_t type, VmbError_t* error)
+{
+    mtx_lock(&cache->mutex);
+
+    FeatureCacheEntry* const entry = FindOrAddEntry(cache, name, error);
+    if (entry == NULL || entry->type != type)
+    {
+        *error = (entry == NULL) ? *error : VmbErrorWrongType;
+        mtx_unlock(&cache->mutex);
+        return NULL;
+    }
+
+    VmbUint64_t const generation = atomic_load(&entry->generation);
+    if (entry->cached && entry->hasValue && entry->valueGeneration == generation)
+    {
+        ++cache->hits;
+        *error = VmbErrorSuccess;
+        return entry;
+    }
+
+    if (entry->cached)
+    {
+        ++cache->misses;
+    }
+    else
+    {
+        ++cache->uncached;
+    }
+
+    // an invalidation during the read increments the generation again, so the value is read once more next time
+    *error = ReadEntry(cache, entry);
+    entry->hasValue = (*error == VmbErrorSuccess);
+    entry->valueGeneration = generation;
+    if (*error != VmbErrorSuccess)
+    {
+        mtx_unlock(&cache->mutex);
+        return NULL;
+    }
+    return entry;
+}
+
+VmbError_t FeatureCacheGetInt(FeatureCache* cache, const char* name, VmbInt64_t* value)
+{
+    VmbError_t error = VmbErrorSuccess;
+    FeatureCacheEntry* const entry = GetEntry(cache, name, VmbFeatureDataInt, &error);
+    if (entry != NULL)
+    {
+        *value = entry->intValue;
+        mtx_unlock(&cache->mutex);
+    }
+    return error;
+}
+
+VmbError_t FeatureCacheGetFloat(FeatureCache* cache, const char* name, double* value)
+{
+    VmbError_t error = VmbErrorSuccess;
+    FeatureCacheEntry* const entry = GetEntry(cache, name, VmbFeatureDataFloat, &error);
+    if (entry != NULL)
+    {
+        *value = entry->floatValue;
+        mtx_unlock(&cache->mutex);
+    }
+    return error;
+}
+
+VmbError_t FeatureCacheGetBool(FeatureCache* cache, const char* name, VmbBool_t* value)
+{
+    VmbError_t error = VmbErrorSuccess;
+    FeatureCacheEntry* const entry = GetEntry(cache, name, VmbFeatureDataBool, &error);
+    if (entry != NULL)
+    {
+        *value = entry->intValue ? VmbBoolTrue : VmbBoolFalse;
+        mtx_unlock(&cache->mutex);
+    }
+    return error;
+}
+
+VmbError_t FeatureCacheGetEnum(FeatureCache* cache, const char* name, const char** value)
+{
+    VmbError_t error = VmbErrorSuccess;
+    FeatureCacheEntry* const entry = GetEntry(cache, name, VmbFeatureDataEnum, &error);
+    if (entry != NULL)
+    {
+        *value = entry->enumValue;
+        mtx_unlock(&cache->mutex);
+    }
+    return error;
+}
+
+VmbError_t FeatureCacheWatch(FeatureCache* cache, const char* name, VmbBool_t* invalidated)
+{
+    mtx_lock(&cache->mutex);
+    VmbError_t error = VmbErrorSuccess;
+    FeatureCacheEntry* const entry = FindOrAddEntry(cache, name, &error);
+    if (entry != NULL && invalidated != NULL)
+    {
+        *invalidated = entry->cached;
+    }
+    mtx_unlock(&cache->mutex);
+    return error;
+}
+
+VmbBool_t FeatureCacheIsStale(FeatureCache* cache, const char* name)
+{
+    mtx_lock(&cache->mutex);
+    VmbUint32_t index = 0;
+    FeatureCacheEntry* const entry = FindEntry(cache, name, HashName(name), &index);
+    VmbBool_t const stale = (entry == NULL) || !entry->cached || !entry->hasValue
+        || entry->valueGeneration != atomic_load(&entry->generation);
+    mtx_unlock(&cache->mutex);
+    return stale;
+}
+
+void FeatureCacheGetStats(FeatureCache* cache, FeatureCacheStats* stats)
+{
+    mtx_lock(&cache->mutex);
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->uncached = cache->uncached;
+    stats->invalidations = atomic_load(&cache->invalidations);
+    stats->featureCount = cache->entryCount;
+    mtx_unlock(&cache->mutex);
+}
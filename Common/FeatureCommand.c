@@ -0,0 +1,115 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <time.h>
+
+#include "include/VmbCExamplesCommon/FeatureCommand.h"
+#include "include/VmbCExamplesCommon/MonotonicTime.h"
+#include "include/VmbCExamplesCommon/VmbThreads.h"
+
+#include <VmbC/VmbC.h>
+
+#define INITIAL_BACKOFF_NS  1000ull
+#define MAX_BACKOFF_NS      10000000ull
+
+/**
+ * \brief State shared with the invalidation callback
+ */
+typedef struct CommandCompletion
+{
+    mtx_t       mutex;
+    cnd_t       condition;
+    VmbBool_t   invalidated;    //!< Set by the callback, reset before checking the completion
+} CommandCompletion;
+
+static void VMB_CALL CommandInvalidated(const VmbHandle_t handle, const char* name, void* userContext)
+{
+    CommandCompletion* const completion = (CommandCompletion*)userContext;
+
+    mtx_lock(&completion->mutex);
+    completion->invalidated = VmbBoolTrue;
+    cnd_signal(&completion->condition);
+    mtx_unlock(&completion->mutex);
+}
+
+/**
+ * \brief Wait until the feature is invalidated or the time elapsed
+ */
+static void WaitForInvalidation(CommandCompletion* completion, VmbUint64_t durationNs)
+{
+    struct timespec timePoint;
+    timespec_get(&timePoint, TIME_UTC);
+    VmbUint64_t const nanoseconds = (VmbUint64_t)timePoint.tv_nsec + durationNs;
+    timePoint.tv_sec += (time_t)(nanoseconds / 1000000000ull);
+    timePoint.tv_nsec = (long)(nanoseconds % 1000000000ull);
+
+    mtx_lock(&completion->mutex);
+    while (!completion->invalidated)
+    {
+        if (cnd_timedwait(&completion->condition, &completion->mutex, &timePoint) != thrd_success)
+        {
+            break;
+        }
+    }
+    completion->invalidated = VmbBoolFalse;
+    mtx_unlock(&completion->mutex);
+}
+
+VmbError_t RunFeatureCommand(VmbHandle_t handle, const char* name, VmbUint32_t timeoutMs, VmbUint64_t* latencyNs)
+{
+    CommandCompletion completion;
+    completion.invalidated = VmbBoolFalse;
+    if (mtx_init(&completion.mutex, mtx_plain) != thrd_success)
+    {
+        return VmbErrorResources;
+    }
+    if (cnd_init(&completion.condition) != thrd_success)
+    {
+        mtx_destroy(&completion.mutex);
+        return VmbErrorResources;
+    }
+
+    // Not every transport layer invalidates command features on completion; the backoff covers those
+    VmbBool_t const registered = (VmbFeatureInvalidationRegister(handle, name, CommandInvalidated, &completion) == VmbErrorSuccess);
+
+    VmbUint64_t const start = GetMonotonicTimeNs();
+    VmbUint64_t const deadline = start + (VmbUint64_t)timeoutMs * 1000000ull;
+    VmbUint64_t backoffNs = INITIAL_BACKOFF_NS;
+
+    VmbError_t error = VmbFeatureCommandRun(handle, name);
+    while (error == VmbErrorSuccess)
+    {
+        VmbBool_t done = VmbBoolFalse;
+        error = VmbFeatureCommandIsDone(handle, name, &done);
+        if (error != VmbErrorSuccess || done)
+        {
+            break;
+        }
+
+        VmbUint64_t const now = GetMonotonicTimeNs();
+        if (now >= deadline)
+        {
+            error = VmbErrorTimeout;
+            break;
+        }
+
+        WaitForInvalidation(&completion, (deadline - now < backoffNs) ? deadline - now : backoffNs);
+        backoffNs = (backoffNs * 2 < MAX_BACKOFF_NS) ? backoffNs * 2 : MAX_BACKOFF_NS;
+    }
+
+    if (latencyNs != NULL)
+    {
+        *latencyNs = GetMonotonicTimeNs() - start;
+    }
+
+    if (registered)
+    {
+        VmbFeatureInvalidationUnregister(handle, name, CommandInvalidated);
+    }
+    cnd_destroy(&completion.condition);
+    mtx_destroy(&completion.mutex);
+
+    return error;
+}
@@ -0,0 +1,135 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/VmbCExamplesCommon/FramePredicate.h"
+
+#define EXPOSURE_PREFIX "exposure="
+#define LINE_PREFIX     "line="
+#define NTH_PREFIX      "nth="
+
+void FramePredicateInit(FramePredicate* predicate)
+{
+    memset(predicate, 0, sizeof(FramePredicate));
+}
+
+/**
+ * \brief Parse an optional bound of a range
+ *
+ * \return the position after the number or text, if the bound is empty
+ */
+static const char* ParseBound(const char* text, double* value, VmbBool_t* specified)
+{
+    char* end = NULL;
+    *value = strtod(text, &end);
+    *specified = (end != text);
+    return end;
+}
+
+static VmbError_t ParseExposureRange(const char* text, FrameCondition* condition)
+{
+    VmbBool_t minSpecified;
+    VmbBool_t maxSpecified;
+
+    text = ParseBound(text, &condition->minExposure, &minSpecified);
+    if (*text != ':')
+    {
+        return VmbErrorBadParameter;
+    }
+    text = ParseBound(text + 1, &condition->maxExposure, &maxSpecified);
+    if (*text != '\0' || (!minSpecified && !maxSpecified))
+    {
+        return VmbErrorBadParameter;
+    }
+
+    condition->minExposure = minSpecified ? condition->minExposure : -1e300;
+    condition->maxExposure = maxSpecified ? condition->maxExposure : 1e300;
+    return (condition->minExposure <= condition->maxExposure) ? VmbErrorSuccess : VmbErrorBadParameter;
+}
+
+static VmbError_t ParseUnsigned(const char* text, VmbUint64_t* value)
+{
+    char* end = NULL;
+    *value = strtoull(text, &end, 10);
+    return (end != text && *end == '\0' && *text != '-') ? VmbErrorSuccess : VmbErrorBadParameter;
+}
+
+VmbError_t FramePredicateAddCondition(FramePredicate* predicate, const char* text)
+{
+    if (predicate->conditionCount == FRAME_PREDICATE_MAX_CONDITIONS)
+    {
+        return VmbErrorResources;
+    }
+
+    FrameCondition condition;
+    memset(&condition, 0, sizeof(condition));
+
+    VmbError_t err = VmbErrorBadParameter;
+    VmbUint64_t number = 0;
+
+    if (strncmp(text, EXPOSURE_PREFIX, strlen(EXPOSURE_PREFIX)) == 0)
+    {
+        condition.type = FrameConditionExposureRange;
+        err = ParseExposureRange(text + strlen(EXPOSURE_PREFIX), &condition);
+        predicate->requiredChunkFields |= (err == VmbErrorSuccess) ? CHUNK_FIELD_BIT(ChunkFieldExposureTime) : 0;
+    }
+    else if (strncmp(text, LINE_PREFIX, strlen(LINE_PREFIX)) == 0)
+    {
+        condition.type = FrameConditionLineStatusBit;
+        err = ParseUnsigned(text + strlen(LINE_PREFIX), &number);
+        err = (err == VmbErrorSuccess && number < 64) ? VmbErrorSuccess : VmbErrorBadParameter;
+        condition.lineStatusBit = (VmbUint32_t)number;
+        predicate->requiredChunkFields |= (err == VmbErrorSuccess) ? CHUNK_FIELD_BIT(ChunkFieldLineStatusAll) : 0;
+    }
+    else if (strncmp(text, NTH_PREFIX, strlen(NTH_PREFIX)) == 0)
+    {
+        condition.type = FrameConditionFrameIdInterval;
+        err = ParseUnsigned(text + strlen(NTH_PREFIX), &number);
+        err = (err == VmbErrorSuccess && number != 0) ? VmbErrorSuccess : VmbErrorBadParameter;
+        condition.frameIdInterval = number;
+    }
+
+    if (err == VmbErrorSuccess)
+    {
+        predicate->conditions[predicate->conditionCount++] = condition;
+    }
+    return err;
+}
+
+static VmbBool_t ConditionFulfilled(const FrameCondition* condition, const VmbFrame_t* frame, const ChunkValues* values)
+{
+    switch (condition->type)
+    {
+    case FrameConditionExposureRange:
+        return values != NULL
+            && (values->validFields & CHUNK_FIELD_BIT(ChunkFieldExposureTime))
+            && values->exposureTime >= condition->minExposure
+            && values->exposureTime <= condition->maxExposure;
+    case FrameConditionLineStatusBit:
+        return values != NULL
+            && (values->validFields & CHUNK_FIELD_BIT(ChunkFieldLineStatusAll))
+            && ((((VmbUint64_t)values->lineStatusAll) >> condition->lineStatusBit) & 1) != 0;
+    case FrameConditionFrameIdInterval:
+        return (frame->receiveFlags & VmbFrameFlagsFrameID) && (frame->frameID % condition->frameIdInterval) == 0;
+    default:
+        return VmbBoolFalse;
+    }
+}
+
+VmbBool_t FramePredicateEvaluate(FramePredicate* predicate, const VmbFrame_t* frame, const ChunkValues* values)
+{
+    for (VmbUint32_t i = 0; i < predicate->conditionCount; ++i)
+    {
+        if (!ConditionFulfilled(&predicate->conditions[i], frame, values))
+        {
+            ++predicate->framesRejected;
+            return VmbBoolFalse;
+        }
+    }
+    ++predicate->framesAccepted;
+    return VmbBoolTrue;
+}
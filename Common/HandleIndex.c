@@ -0,0 +1,130 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "include/VmbCExamplesCommon/HandleIndex.h"
+
+#define HANDLE_INDEX_MIN_CAPACITY 16
+
+/**
+ * \brief Mix the bits of a handle, since handles are usually aligned pointers with constant low bits
+ */
+static VmbUint32_t HashHandle(VmbHandle_t handle)
+{
+    VmbUint64_t hash = (VmbUint64_t)(uintptr_t)handle;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return (VmbUint32_t)hash;
+}
+
+static HandleIndexEntry* FindSlot(HandleIndexEntry* entries, VmbUint32_t capacity, VmbHandle_t handle)
+{
+    VmbUint32_t const mask = capacity - 1;
+    VmbUint32_t slot = HashHandle(handle) & mask;
+    while (entries[slot].handle != NULL && entries[slot].handle != handle)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return &entries[slot];
+}
+
+static VmbError_t Resize(HandleIndex* index, VmbUint32_t capacity)
+{
+    HandleIndexEntry* const entries = calloc(capacity, sizeof(HandleIndexEntry));
+    if (entries == NULL)
+    {
+        return VmbErrorResources;
+    }
+    for (VmbUint32_t i = 0; i < index->capacity; i++)
+    {
+        if (index->entries[i].handle != NULL)
+        {
+            *FindSlot(entries, capacity, index->entries[i].handle) = index->entries[i];
+        }
+    }
+    free(index->entries);
+    index->entries = entries;
+    index->capacity = capacity;
+    return VmbErrorSuccess;
+}
+
+VmbError_t HandleIndexInit(HandleIndex* index, VmbUint32_t expectedCount)
+{
+    index->entries = NULL;
+    index->capacity = 0;
+    index->count = 0;
+
+    VmbUint32_t capacity = HANDLE_INDEX_MIN_CAPACITY;
+    while (capacity < 2 * (VmbUint64_t)expectedCount)
+    {
+        capacity *= 2;
+    }
+    return Resize(index, capacity);
+}
+
+VmbError_t HandleIndexInsert(HandleIndex* index, VmbHandle_t handle, void* value)
+{
+    if (handle == NULL)
+    {
+        return VmbErrorBadParameter;
+    }
+    if (2 * (index->count + 1) > index->capacity)
+    {
+        VmbError_t const err = Resize(index, (index->capacity != 0) ? 2 * index->capacity : HANDLE_INDEX_MIN_CAPACITY);
+        if (err != VmbErrorSuccess)
+        {
+            return err;
+        }
+    }
+
+    HandleIndexEntry* const entry = FindSlot(index->entries, index->capacity, handle);
+    if (entry->handle == NULL)
+    {
+        entry->handle = handle;
+        ++index->count;
+    }
+    entry->value = value;
+    return VmbErrorSuccess;
+}
+
+void* HandleIndexFind(HandleIndex const* index, VmbHandle_t handle)
+{
+    if (handle == NULL || index->capacity == 0)
+    {
+        return NULL;
+    }
+    return FindSlot(index->entries, index->capacity, handle)->value;
+}
+
+VmbError_t HandleIndexAddTransportLayers(HandleIndex* index, VmbTransportLayerInfo_t* transportLayers, VmbUint32_t count)
+{
+    VmbError_t err = VmbErrorSuccess;
+    for (VmbUint32_t i = 0; i < count && err == VmbErrorSuccess; i++)
+    {
+        err = HandleIndexInsert(index, transportLayers[i].transportLayerHandle, &transportLayers[i]);
+    }
+    return err;
+}
+
+VmbError_t HandleIndexAddInterfaces(HandleIndex* index, VmbInterfaceInfo_t* interfaces, VmbUint32_t count)
+{
+    VmbError_t err = VmbErrorSuccess;
+    for (VmbUint32_t i = 0; i < count && err == VmbErrorSuccess; i++)
+    {
+        err = HandleIndexInsert(index, interfaces[i].interfaceHandle, &interfaces[i]);
+    }
+    return err;
+}
+
+void HandleIndexFree(HandleIndex* index)
+{
+    free(index->entries);
+    index->entries = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
@@ -0,0 +1,164 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "include/VmbCExamplesCommon/Histogram.h"
+
+#define BAR_WIDTH 50 // number of characters of the bar of the fullest bucket
+#define BAR       "##################################################"
+
+static double Mean(VmbUint64_t count, double sum)
+{
+    return (count == 0) ? 0.0 : sum / count;
+}
+
+static double StdDev(VmbUint64_t count, double sum, double sumOfSquares)
+{
+    if (count < 2)
+    {
+        return 0.0;
+    }
+    double const mean = Mean(count, sum);
+    double const variance = (sumOfSquares - count * mean * mean) / (count - 1);
+    return (variance > 0.0) ? sqrt(variance) : 0.0;
+}
+
+void RunningStatisticsInit(RunningStatistics* statistics)
+{
+    memset(statistics, 0, sizeof(RunningStatistics));
+}
+
+void RunningStatisticsAdd(RunningStatistics* statistics, double value)
+{
+    statistics->min = (statistics->count == 0 || value < statistics->min) ? value : statistics->min;
+    statistics->max = (statistics->count == 0 || value > statistics->max) ? value : statistics->max;
+    statistics->sum += value;
+    statistics->sumOfSquares += value * value;
+    ++statistics->count;
+}
+
+double RunningStatisticsMean(const RunningStatistics* statistics)
+{
+    return Mean(statistics->count, statistics->sum);
+}
+
+double RunningStatisticsStdDev(const RunningStatistics* statistics)
+{
+    return StdDev(statistics->count, statistics->sum, statistics->sumOfSquares);
+}
+
+void HistogramInit(Histogram* histogram, double lowerBound, double upperBound, VmbUint32_t bucketCount)
+{
+    memset(histogram, 0, sizeof(Histogram));
+
+    bucketCount = (bucketCount == 0) ? 1 : bucketCount;
+    bucketCount = (bucketCount > HISTOGRAM_MAX_BUCKETS) ? HISTOGRAM_MAX_BUCKETS : bucketCount;
+    upperBound = (upperBound > lowerBound) ? upperBound : lowerBound + 1.0;
+
+    histogram->lowerBound = lowerBound;
+    histogram->bucketWidth = (upperBound - lowerBound) / bucketCount;
+    histogram->bucketCount = bucketCount;
+}
+
+void HistogramAdd(Histogram* histogram, double value)
+{
+    double const bucket = floor((value - histogram->lowerBound) / histogram->bucketWidth);
+    if (bucket < 0.0)
+    {
+        ++histogram->underflow;
+    }
+    else if (bucket >= (double)histogram->bucketCount)
+    {
+        ++histogram->overflow;
+    }
+    else
+    {
+        ++histogram->buckets[(VmbUint32_t)bucket];
+    }
+
+    histogram->min = (histogram->count == 0 || value < histogram->min) ? value : histogram->min;
+    histogram->max = (histogram->count == 0 || value > histogram->max) ? value : histogram->max;
+    histogram->sum += value;
+    histogram->sumOfSquares += value * value;
+    ++histogram->count;
+}
+
+double HistogramMean(const Histogram* histogram)
+{
+    return Mean(histogram->count, histogram->sum);
+}
+
+double HistogramStdDev(const Histogram* histogram)
+{
+    return StdDev(histogram->count, histogram->sum, histogram->sumOfSquares);
+}
+
+double HistogramPercentile(const Histogram* histogram, double percentile)
+{
+    if (histogram->count == 0)
+    {
+        return 0.0;
+    }
+
+    double const rank = percentile / 100.0 * histogram->count;
+    double counted = (double)histogram->underflow;
+    if (rank <= counted)
+    {
+        return histogram->min;
+    }
+
+    for (VmbUint32_t i = 0; i < histogram->bucketCount; ++i)
+    {
+        double const inBucket = (double)histogram->buckets[i];
+        if (inBucket > 0.0 && rank <= counted + inBucket)
+        {
+            return histogram->lowerBound + histogram->bucketWidth * (i + (rank - counted) / inBucket);
+        }
+        counted += inBucket;
+    }
+    return histogram->max;
+}
+
+void HistogramPrint(const Histogram* histogram, const char* unit)
+{
+    printf("Samples: %llu, mean %.3f %s, std dev %.3f %s, min %.3f %s, max %.3f %s\n",
+           histogram->count,
+           HistogramMean(histogram), unit,
+           HistogramStdDev(histogram), unit,
+           histogram->min, unit,
+           histogram->max, unit);
+    printf("Percentiles: 50%% %.3f %s, 90%% %.3f %s, 99%% %.3f %s\n",
+           HistogramPercentile(histogram, 50.0), unit,
+           HistogramPercentile(histogram, 90.0), unit,
+           HistogramPercentile(histogram, 99.0), unit);
+
+    VmbUint64_t fullest = 1;
+    for (VmbUint32_t i = 0; i < histogram->bucketCount; ++i)
+    {
+        fullest = (histogram->buckets[i] > fullest) ? histogram->buckets[i] : fullest;
+    }
+
+    char label[64];
+    if (histogram->underflow != 0)
+    {
+        snprintf(label, sizeof(label), "< %.3f %s", histogram->lowerBound, unit);
+        printf("%32s %8llu\n", label, histogram->underflow);
+    }
+    for (VmbUint32_t i = 0; i < histogram->bucketCount; ++i)
+    {
+        double const lower = histogram->lowerBound + i * histogram->bucketWidth;
+        int const barLength = (int)(histogram->buckets[i] * BAR_WIDTH / fullest);
+        snprintf(label, sizeof(label), "[%.3f, %.3f) %s", lower, lower + histogram->bucketWidth, unit);
+        printf("%32s %8llu %.*s\n", label, histogram->buckets[i], barLength, BAR);
+    }
+    if (histogram->overflow != 0)
+    {
+        snprintf(label, sizeof(label), ">= %.3f %s", histogram->lowerBound + histogram->bucketCount * histogram->bucketWidth, unit);
+        printf("%32s %8llu\n", label, histogram->overflow);
+    }
+}
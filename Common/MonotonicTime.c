@@ -0,0 +1,76 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include "include/VmbCExamplesCommon/MonotonicTime.h"
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <errno.h>
+    #include <time.h>
+#endif
+
+VmbUint64_t GetMonotonicTimeNs(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = { 0 };
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+
+    // split the conversion to avoid overflowing the multiplication
+    VmbUint64_t const seconds = (VmbUint64_t)(counter.QuadPart / frequency.QuadPart);
+    VmbUint64_t const remainder = (VmbUint64_t)(counter.QuadPart % frequency.QuadPart);
+    return seconds * 1000000000ull + remainder * 1000000000ull / (VmbUint64_t)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (VmbUint64_t)now.tv_sec * 1000000000ull + (VmbUint64_t)now.tv_nsec;
+#endif
+}
+
+void SleepUntilMonotonicNs(VmbUint64_t wakeUpNs)
+{
+#if defined(_WIN32)
+    // Sleep has a resolution of one scheduler tick; wait for the remaining time actively
+    VmbUint64_t now = GetMonotonicTimeNs();
+    while (now < wakeUpNs)
+    {
+        VmbUint64_t const remainingMs = (wakeUpNs - now) / 1000000;
+        if (remainingMs > 2)
+        {
+            Sleep((DWORD)(remainingMs - 2));
+        }
+        else
+        {
+            SwitchToThread();
+        }
+        now = GetMonotonicTimeNs();
+    }
+#elif defined(__APPLE__)
+    // no clock_nanosleep on macOS
+    VmbUint64_t const now = GetMonotonicTimeNs();
+    if (now < wakeUpNs)
+    {
+        struct timespec duration;
+        duration.tv_sec = (time_t)((wakeUpNs - now) / 1000000000ull);
+        duration.tv_nsec = (long)((wakeUpNs - now) % 1000000000ull);
+        while (nanosleep(&duration, &duration) == -1 && errno == EINTR)
+        {
+        }
+    }
+#else
+    // an absolute wake up time does not accumulate the delays of consecutive calls
+    struct timespec wakeUpTime;
+    wakeUpTime.tv_sec = (time_t)(wakeUpNs / 1000000000ull);
+    wakeUpTime.tv_nsec = (long)(wakeUpNs % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeUpTime, NULL) == EINTR)
+    {
+    }
+#endif
+}
@@ -0,0 +1,489 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "include/VmbCExamplesCommon/TimedStartup.h"
+
+#include "include/VmbCExamplesCommon/CameraInventory.h"
+#include "include/VmbCExamplesCommon/MonotonicTime.h"
+#include "include/VmbCExamplesCommon/TransportLayerTypeToString.h"
+
+#include <VmbC/VmbC.h>
+
+#ifdef _WIN32
+    #include <Windows.h>
+
+    #define STARTUP_PATH_SEPARATOR  ';'
+#else
+    #include <dirent.h>
+
+    #define STARTUP_PATH_SEPARATOR  ':'
+#endif
+
+#define STARTUP_FILE_PATH_LENGTH    1024
+
+/**
+ * \brief A name of a transport layer type
+ */
+typedef struct TransportLayerTypeName
+{
+    const char*             name;
+    VmbTransportLayerType_t type;
+} TransportLayerTypeName;
+
+static const TransportLayerTypeName ShortTypeNames[] =
+{
+    { "GigE", VmbTransportLayerTypeGEV },
+    { "GEV",  VmbTransportLayerTypeGEV },
+    { "USB",  VmbTransportLayerTypeU3V },
+    { "U3V",  VmbTransportLayerTypeU3V },
+    { "CL",   VmbTransportLayerTypeCL },
+    { "CLHS", VmbTransportLayerTypeCLHS },
+    { "CXP",  VmbTransportLayerTypeCXP },
+    { "UVC",  VmbTransportLayerTypeUVC },
+    { "IIDC", VmbTransportLayerTypeIIDC },
+    { "PCI",  VmbTransportLayerTypePCI },
+};
+
+/**
+ * \brief Parts of the usual file names of the .cti files of a transport layer type
+ */
+static const TransportLayerTypeName FileNameParts[] =
+{
+    { "gige",       VmbTransportLayerTypeGEV },
+    { "gev",        VmbTransportLayerTypeGEV },
+    { "usb",        VmbTransportLayerTypeU3V },
+    { "u3v",        VmbTransportLayerTypeU3V },
+    { "cameralink", VmbTransportLayerTypeCL },
+    { "clhs",       VmbTransportLayerTypeCLHS },
+    { "cxp",        VmbTransportLayerTypeCXP },
+    { "coaxpress",  VmbTransportLayerTypeCXP },
+    { "uvc",        VmbTransportLayerTypeUVC },
+    { "iidc",       VmbTransportLayerTypeIIDC },
+    { "1394",       VmbTransportLayerTypeIIDC },
+    { "pci",        VmbTransportLayerTypePCI },
+};
+
+#define ARRAY_LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+
+/**
+ * \brief The path argument of VmbStartup under construction
+ */
+typedef struct StartupPathBuilder
+{
+    char*       buffer;
+    size_t      size;
+    size_t      length;
+    VmbUint32_t count;
+} StartupPathBuilder;
+
+static VmbBool_t EqualsIgnoreCase(const char* a, const char* b)
+{
+    for (; *a != '\0' && *b != '\0'; ++a, ++b)
+    {
+        if (tolower((unsigned char)*a) != tolower((unsigned char)*b))
+        {
+            return VmbBoolFalse;
+        }
+    }
+    return (*a == *b) ? VmbBoolTrue : VmbBoolFalse;
+}
+
+static VmbBool_t ContainsIgnoreCase(const char* text, const char* part)
+{
+    size_t const partLength = strlen(part);
+    for (; *text != '\0'; ++text)
+    {
+        size_t i = 0;
+        while (i < partLength && text[i] != '\0' && tolower((unsigned char)text[i]) == tolower((unsigned char)part[i]))
+        {
+            ++i;
+        }
+        if (i == partLength)
+        {
+            return VmbBoolTrue;
+        }
+    }
+    return VmbBoolFalse;
+}
+
+static VmbBool_t IsTransportLayerFile(const char* fileName)
+{
+    size_t const length = strlen(fileName);
+    return (length > 4 && EqualsIgnoreCase(fileName + length - 4, ".cti")) ? VmbBoolTrue : VmbBoolFalse;
+}
+
+static VmbBool_t FileNameMatchesType(const char* fileName, VmbTransportLayerType_t type)
+{
+    for (size_t i = 0; i < ARRAY_LENGTH(FileNameParts); i++)
+    {
+        if (FileNameParts[i].type == type && ContainsIgnoreCase(fileName, FileNameParts[i].name))
+        {
+            return VmbBoolTrue;
+        }
+    }
+    return VmbBoolFalse;
+}
+
+static VmbBool_t ParseTransportLayerType(const char* name, VmbTransportLayerType_t* type)
+{
+    for (size_t i = 0; i < ARRAY_LENGTH(ShortTypeNames); i++)
+    {
+        if (EqualsIgnoreCase(name, ShortTypeNames[i].name))
+        {
+            *type = ShortTypeNames[i].type;
+            return VmbBoolTrue;
+        }
+    }
+    for (VmbTransportLayerType_t candidate = VmbTransportLayerTypeGEV; candidate <= VmbTransportLayerTypeMixed; candidate++)
+    {
+        if (EqualsIgnoreCase(name, TransportLayerTypeToString(candidate)))
+        {
+            *type = candidate;
+            return VmbBoolTrue;
+        }
+    }
+    return VmbBoolFalse;
+}
+
+VmbError_t ParseTransportLayerFilter(char* filterString, TransportLayerFilter* filter)
+{
+    memset(filter, 0, sizeof(TransportLayerFilter));
+
+    char* entry = filterString;
+    while (entry != NULL)
+    {
+        char* const separator = strchr(entry, ',');
+        if (separator != NULL)
+        {
+            *separator = '\0';
+        }
+
+        // trim the entry, so lists like "GigE, USB" work
+        while (isspace((unsigned char)*entry))
+        {
+            ++entry;
+        }
+        size_t length = strlen(entry);
+        while (length > 0 && isspace((unsigned char)entry[length - 1]))
+        {
+            entry[--length] = '\0';
+        }
+
+        if (length != 0)
+        {
+            // types first, since "PCI / PCIe" looks like a path
+            VmbTransportLayerType_t type;
+            if (ParseTransportLayerType(entry, &type))
+            {
+                if (filter->typeCount == TRANSPORT_LAYER_FILTER_MAX_ENTRIES)
+                {
+                    return VmbErrorBadParameter;
+                }
+                filter->types[filter->typeCount++] = type;
+            }
+            else if (strchr(entry, '/') != NULL || strchr(entry, '\\') != NULL || IsTransportLayerFile(entry))
+            {
+                if (filter->pathCount == TRANSPORT_LAYER_FILTER_MAX_ENTRIES)
+                {
+                    return VmbErrorBadParameter;
+                }
+                filter->paths[filter->pathCount++] = entry;
+            }
+            else
+            {
+                printf("\"%s\" is neither a transport layer type nor the path of a transport layer\n", entry);
+                return VmbErrorBadParameter;
+            }
+        }
+
+        entry = (separator != NULL) ? separator + 1 : NULL;
+    }
+    return VmbErrorSuccess;
+}
+
+/**
+ * \brief Add an entry to the path, unless it is part of the path already
+ */
+static VmbError_t AppendStartupPath(StartupPathBuilder* builder, const char* entry)
+{
+    size_t const entryLength = strlen(entry);
+
+    const char* existing = builder->buffer;
+    for (VmbUint32_t i = 0; i < builder->count; i++)
+    {
+        const char* const end = strchr(existing, STARTUP_PATH_SEPARATOR);
+        size_t const existingLength = (end != NULL) ? (size_t)(end - existing) : strlen(existing);
+        if (existingLength == entryLength && strncmp(existing, entry, entryLength) == 0)
+        {
+            return VmbErrorSuccess;
+        }
+        existing = (end != NULL) ? end + 1 : existing + existingLength;
+    }
+
+    size_t const required = builder->length + ((builder->count != 0) ? 1 : 0) + entryLength + 1;
+    if (required > builder->size)
+    {
+        printf("the path of the transport layers exceeds %zu characters\n", builder->size - 1);
+        return VmbErrorMoreData;
+    }
+
+    if (builder->count != 0)
+    {
+        builder->buffer[builder->length++] = STARTUP_PATH_SEPARATOR;
+    }
+    memcpy(builder->buffer + builder->length, entry, entryLength + 1);
+    builder->length += entryLength;
+    ++builder->count;
+    return VmbErrorSuccess;
+}
+
+/**
+ * \brief Add the .cti files of a directory, whose names suggest the transport layer type
+ */
+static VmbError_t AppendFilesOfType(StartupPathBuilder* builder, const char* directory, VmbTransportLayerType_t type, VmbBool_t* found)
+{
+    VmbError_t err = VmbErrorSuccess;
+    char filePath[STARTUP_FILE_PATH_LENGTH];
+
+#ifdef _WIN32
+    snprintf(filePath, sizeof(filePath), "%s\\*.cti", directory);
+    WIN32_FIND_DATAA fileData;
+    HANDLE const search = FindFirstFileA(filePath, &fileData);
+    if (search == INVALID_HANDLE_VALUE)
+    {
+        return VmbErrorSuccess;
+    }
+    do
+    {
+        if (FileNameMatchesType(fileData.cFileName, type))
+        {
+            snprintf(filePath, sizeof(filePath), "%s\\%s", directory, fileData.cFileName);
+            err = AppendStartupPath(builder, filePath);
+            *found = VmbBoolTrue;
+        }
+    } while (err == VmbErrorSuccess && FindNextFileA(search, &fileData));
+    FindClose(search);
+#else
+    DIR* const dir = opendir(directory);
+    if (dir == NULL)
+    {
+        return VmbErrorSuccess;
+    }
+    struct dirent* fileEntry;
+    while (err == VmbErrorSuccess && (fileEntry = readdir(dir)) != NULL)
+    {
+        if (IsTransportLayerFile(fileEntry->d_name) && FileNameMatchesType(fileEntry->d_name, type))
+        {
+            snprintf(filePath, sizeof(filePath), "%s/%s", directory, fileEntry->d_name);
+            err = AppendStartupPath(builder, filePath);
+            *found = VmbBoolTrue;
+        }
+    }
+    closedir(dir);
+#endif
+
+    return err;
+}
+
+/**
+ * \brief Add the .cti files of a transport layer type found in the GenTL search path of the environment
+ */
+static VmbError_t AppendEnvironmentFilesOfType(StartupPathBuilder* builder, VmbTransportLayerType_t type, VmbBool_t* found)
+{
+    const char* const variable = (sizeof(void*) == 8) ? "GENICAM_GENTL64_PATH" : "GENICAM_GENTL32_PATH";
+    const char* directories = getenv(variable);
+    if (directories == NULL)
+    {
+        return VmbErrorSuccess;
+    }
+
+    VmbError_t err = VmbErrorSuccess;
+    while (err == VmbErrorSuccess && *directories != '\0')
+    {
+        const char* const end = strchr(directories, STARTUP_PATH_SEPARATOR);
+        size_t const length = (end != NULL) ? (size_t)(end - directories) : strlen(directories);
+        if (length != 0 && length < STARTUP_FILE_PATH_LENGTH)
+        {
+            char directory[STARTUP_FILE_PATH_LENGTH];
+            memcpy(directory, directories, length);
+            directory[length] = '\0';
+            err = AppendFilesOfType(builder, directory, type, found);
+        }
+        directories += (end != NULL) ? length + 1 : length;
+    }
+    return err;
+}
+
+VmbError_t BuildStartupPath(TransportLayerFilter const* filter, char* path, size_t pathSize, VmbUint32_t* pathCount)
+{
+    StartupPathBuilder builder = { path, pathSize, 0, 0 };
+    if (pathSize == 0)
+    {
+        return VmbErrorBadParameter;
+    }
+    path[0] = '\0';
+
+    VmbError_t err = VmbErrorSuccess;
+    for (VmbUint32_t i = 0; i < filter->pathCount && err == VmbErrorSuccess; i++)
+    {
+        err = AppendStartupPath(&builder, filter->paths[i]);
+    }
+
+    // the daemon knows the actual types of the transport layers
+    CameraInventoryData* inventory = NULL;
+    if (filter->typeCount != 0)
+    {
+        inventory = (CameraInventoryData*)malloc(sizeof(CameraInventoryData));
+        if (inventory != NULL && CameraInventoryReadOnce(inventory) != VmbErrorSuccess)
+        {
+            free(inventory);
+            inventory = NULL;
+        }
+    }
+
+    for (VmbUint32_t i = 0; i < filter->typeCount && err == VmbErrorSuccess; i++)
+    {
+        VmbBool_t found = VmbBoolFalse;
+        if (inventory != NULL)
+        {
+            for (VmbUint32_t tl = 0; tl < inventory->transportLayerCount && err == VmbErrorSuccess; tl++)
+            {
+                if (inventory->transportLayers[tl].type == filter->types[i])
+                {
+                    err = AppendStartupPath(&builder, inventory->transportLayers[tl].path);
+                    found = VmbBoolTrue;
+                }
+            }
+        }
+
+        // without a daemon, or if the daemon has not seen a transport layer of the type, e.g. because it was
+        // installed after the daemon started, the files found via the environment are inspected
+        if (err == VmbErrorSuccess && !found)
+        {
+            err = AppendEnvironmentFilesOfType(&builder, filter->types[i], &found);
+        }
+
+        if (err == VmbErrorSuccess && !found)
+        {
+            printf("no transport layer of the type %s found, pass the path of its .cti file instead\n",
+                   TransportLayerTypeToString(filter->types[i]));
+            err = VmbErrorNotFound;
+        }
+    }
+
+    free(inventory);
+    *pathCount = builder.count;
+    return err;
+}
+
+VmbError_t TimedStartup(const char* transportLayerFilter, StartupTimings* timings)
+{
+    StartupTimings localTimings;
+    if (timings == NULL)
+    {
+        timings = &localTimings;
+    }
+    memset(timings, 0, sizeof(StartupTimings));
+
+    VmbError_t err = VmbErrorSuccess;
+    VmbFilePathChar_t const* startupPath = NULL;
+    char path[STARTUP_PATH_LENGTH];
+#ifdef _WIN32
+    wchar_t widePath[STARTUP_PATH_LENGTH];
+#endif
+
+    if (transportLayerFilter != NULL && transportLayerFilter[0] != '\0')
+    {
+        VmbUint64_t const resolveStartNs = GetMonotonicTimeNs();
+
+        // the filter refers to parts of the string it is parsed from
+        size_t const filterLength = strlen(transportLayerFilter);
+        char* const filterString = (char*)malloc(filterLength + 1);
+        if (filterString == NULL)
+        {
+            return VmbErrorResources;
+        }
+        memcpy(filterString, transportLayerFilter, filterLength + 1);
+
+        TransportLayerFilter filter;
+        err = ParseTransportLayerFilter(filterString, &filter);
+        if (err == VmbErrorSuccess)
+        {
+            err = BuildStartupPath(&filter, path, sizeof(path), &timings->pathCount);
+        }
+        free(filterString);
+        timings->resolveNs = GetMonotonicTimeNs() - resolveStartNs;
+
+        if (err != VmbErrorSuccess)
+        {
+            return err;
+        }
+
+        // an empty filter loads all transport layers
+        if (timings->pathCount != 0)
+        {
+            printf("Loading the transport layers %s\n", path);
+#ifdef _WIN32
+            if (mbstowcs(widePath, path, STARTUP_PATH_LENGTH) == (size_t)-1)
+            {
+                return VmbErrorBadParameter;
+            }
+            startupPath = widePath;
+#else
+            startupPath = path;
+#endif
+        }
+    }
+
+    VmbUint64_t phaseStartNs = GetMonotonicTimeNs();
+    err = VmbStartup(startupPath);
+    timings->loadNs = GetMonotonicTimeNs() - phaseStartNs;
+    if (err != VmbErrorSuccess)
+    {
+        return err;
+    }
+
+    err = VmbTransportLayersList(NULL, 0, &timings->transportLayerCount, sizeof(VmbTransportLayerInfo_t));
+
+    if (err == VmbErrorSuccess)
+    {
+        phaseStartNs = GetMonotonicTimeNs();
+        err = VmbInterfacesList(NULL, 0, &timings->interfaceCount, sizeof(VmbInterfaceInfo_t));
+        timings->interfacesNs = GetMonotonicTimeNs() - phaseStartNs;
+    }
+
+    if (err == VmbErrorSuccess)
+    {
+        phaseStartNs = GetMonotonicTimeNs();
+        err = VmbCamerasList(NULL, 0, &timings->cameraCount, sizeof(VmbCameraInfo_t));
+        timings->camerasNs = GetMonotonicTimeNs() - phaseStartNs;
+    }
+
+    if (err != VmbErrorSuccess)
+    {
+        VmbShutdown();
+    }
+    return err;
+}
+
+void PrintStartupTimings(StartupTimings const* timings)
+{
+    VmbUint64_t const totalNs = timings->resolveNs + timings->loadNs + timings->interfacesNs + timings->camerasNs;
+
+    printf("Startup phases:\n");
+    if (timings->pathCount != 0)
+    {
+        printf("  Resolve transport layers : %10.1f ms (%u paths)\n", (double)timings->resolveNs / 1e6, timings->pathCount);
+    }
+    printf("  Load transport layers    : %10.1f ms (%u transport layers)\n", (double)timings->loadNs / 1e6, timings->transportLayerCount);
+    printf("  Enumerate interfaces     : %10.1f ms (%u interfaces)\n", (double)timings->interfacesNs / 1e6, timings->interfaceCount);
+    printf("  Enumerate cameras        : %10.1f ms (%u cameras)\n", (double)timings->camerasNs / 1e6, timings->cameraCount);
+    printf("  Total                    : %10.1f ms\n\n", (double)totalNs / 1e6);
+}
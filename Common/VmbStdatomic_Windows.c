@@ -17,4 +17,31 @@ void atomic_flag_clear(volatile atomic_flag* obj)
     InterlockedExchange(&obj->value, (LONG)false);
 }
 
+unsigned long long atomic_load(volatile atomic_ullong* obj)
+{
+    // plain 64 bit reads are not atomic on 32 bit systems
+    return (unsigned long long)InterlockedCompareExchange64(&obj->value, 0, 0);
+}
+
+void atomic_store(volatile atomic_ullong* obj, unsigned long long desired)
+{
+    InterlockedExchange64(&obj->value, (LONG64)desired);
+}
+
+unsigned long long atomic_fetch_add(volatile atomic_ullong* obj, unsigned long long arg)
+{
+    return (unsigned long long)InterlockedExchangeAdd64(&obj->value, (LONG64)arg);
+}
+
+_Bool atomic_compare_exchange_strong(volatile atomic_ullong* obj, unsigned long long* expected, unsigned long long desired)
+{
+    LONG64 const previous = InterlockedCompareExchange64(&obj->value, (LONG64)desired, (LONG64)*expected);
+    if (previous == (LONG64)*expected)
+    {
+        return true;
+    }
+    *expected = (unsigned long long)previous;
+    return false;
+}
+
 #endif
@@ -7,6 +7,10 @@
 
 #ifdef __STDC_NO_THREADS__
 
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+
 int mtx_init(mtx_t* mutex, int type)
 {
     if (mutex == NULL)
@@ -75,4 +79,117 @@ void mtx_destroy(mtx_t* mutex)
     }
 }
 
+int cnd_init(cnd_t* condition)
+{
+    if (condition == NULL)
+    {
+        return thrd_error;
+    }
+    return pthread_cond_init(&condition->condition, NULL) ? thrd_error : thrd_success;
+}
+
+int cnd_signal(cnd_t* condition)
+{
+    if (condition == NULL)
+    {
+        return thrd_error;
+    }
+    return pthread_cond_signal(&condition->condition) ? thrd_error : thrd_success;
+}
+
+int cnd_broadcast(cnd_t* condition)
+{
+    if (condition == NULL)
+    {
+        return thrd_error;
+    }
+    return pthread_cond_broadcast(&condition->condition) ? thrd_error : thrd_success;
+}
+
+int cnd_wait(cnd_t* condition, mtx_t* mutex)
+{
+    if (condition == NULL || mutex == NULL)
+    {
+        return thrd_error;
+    }
+    return pthread_cond_wait(&condition->condition, &mutex->mutex) ? thrd_error : thrd_success;
+}
+
+int cnd_timedwait(cnd_t* condition, mtx_t* mutex, const struct timespec* timePoint)
+{
+    if (condition == NULL || mutex == NULL || timePoint == NULL)
+    {
+        return thrd_error;
+    }
+
+    // the default clock of pthread condition variables is CLOCK_REALTIME, which is the clock used for TIME_UTC
+    int const result = pthread_cond_timedwait(&condition->condition, &mutex->mutex, timePoint);
+    if (result == ETIMEDOUT)
+    {
+        return thrd_timedout;
+    }
+    return result ? thrd_error : thrd_success;
+}
+
+void cnd_destroy(cnd_t* condition)
+{
+    if (condition != NULL)
+    {
+        pthread_cond_destroy(&condition->condition);
+    }
+}
+
+/**
+ * \brief Function and argument passed to a new thread; freed by the thread
+ */
+typedef struct ThreadStartInfo
+{
+    thrd_start_t    func;
+    void*           arg;
+} ThreadStartInfo;
+
+static void* ThreadStart(void* arg)
+{
+    ThreadStartInfo info = *((ThreadStartInfo*)arg);
+    free(arg);
+    return (void*)(intptr_t)info.func(info.arg);
+}
+
+int thrd_create(thrd_t* thread, thrd_start_t func, void* arg)
+{
+    if (thread == NULL || func == NULL)
+    {
+        return thrd_error;
+    }
+
+    ThreadStartInfo* info = (ThreadStartInfo*)malloc(sizeof(ThreadStartInfo));
+    if (info == NULL)
+    {
+        return thrd_nomem;
+    }
+    info->func = func;
+    info->arg = arg;
+
+    if (pthread_create(&thread->thread, NULL, ThreadStart, info))
+    {
+        free(info);
+        return thrd_error;
+    }
+    return thrd_success;
+}
+
+int thrd_join(thrd_t thread, int* result)
+{
+    void* threadResult = NULL;
+    if (pthread_join(thread.thread, &threadResult))
+    {
+        return thrd_error;
+    }
+    if (result != NULL)
+    {
+        *result = (int)(intptr_t)threadResult;
+    }
+    return thrd_success;
+}
+
 #endif
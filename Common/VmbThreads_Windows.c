@@ -7,6 +7,8 @@
 
 #ifdef __STDC_NO_THREADS__
 
+#include <stdlib.h>
+
 int mtx_init(mtx_t* mutex, int type)
 {
     if (mutex == NULL)
@@ -17,15 +19,9 @@ int mtx_init(mtx_t* mutex, int type)
     {
     case mtx_plain:
     case mtx_recursive:
-    {
-        HANDLE h = CreateMutex(NULL, FALSE, NULL);
-        if (h != NULL)
-        {
-            mutex->handle = h;
-            return thrd_success;
-        }
-        break;
-    }
+        // critical sections are always recursive; unlike mutex handles they can be used with condition variables
+        InitializeCriticalSection(&mutex->criticalSection);
+        return thrd_success;
     // other mutex types not implemented yet
     }
     return thrd_error;
@@ -35,10 +31,8 @@ int mtx_lock(mtx_t* mutex)
 {
     if (mutex != NULL)
     {
-        if (WAIT_OBJECT_0 == WaitForSingleObject(mutex->handle, INFINITE))
-        {
-            return thrd_success;
-        }
+        EnterCriticalSection(&mutex->criticalSection);
+        return thrd_success;
     }
     return thrd_error;
 }
@@ -47,10 +41,8 @@ int mtx_unlock(mtx_t* mutex)
 {
     if (mutex != NULL)
     {
-        if (ReleaseMutex(mutex->handle))
-        {
-            return thrd_success;
-        }
+        LeaveCriticalSection(&mutex->criticalSection);
+        return thrd_success;
     }
     return thrd_error;
 }
@@ -59,8 +51,129 @@ void mtx_destroy(mtx_t* mutex)
 {
     if (mutex != NULL)
     {
-        CloseHandle(mutex->handle);
+        DeleteCriticalSection(&mutex->criticalSection);
+    }
+}
+
+int cnd_init(cnd_t* condition)
+{
+    if (condition == NULL)
+    {
+        return thrd_error;
+    }
+    InitializeConditionVariable(&condition->conditionVariable);
+    return thrd_success;
+}
+
+int cnd_signal(cnd_t* condition)
+{
+    if (condition == NULL)
+    {
+        return thrd_error;
+    }
+    WakeConditionVariable(&condition->conditionVariable);
+    return thrd_success;
+}
+
+int cnd_broadcast(cnd_t* condition)
+{
+    if (condition == NULL)
+    {
+        return thrd_error;
+    }
+    WakeAllConditionVariable(&condition->conditionVariable);
+    return thrd_success;
+}
+
+int cnd_wait(cnd_t* condition, mtx_t* mutex)
+{
+    if (condition == NULL || mutex == NULL)
+    {
+        return thrd_error;
+    }
+    return SleepConditionVariableCS(&condition->conditionVariable, &mutex->criticalSection, INFINITE) ? thrd_success : thrd_error;
+}
+
+int cnd_timedwait(cnd_t* condition, mtx_t* mutex, const struct timespec* timePoint)
+{
+    if (condition == NULL || mutex == NULL || timePoint == NULL)
+    {
+        return thrd_error;
+    }
+
+    // convert the absolute TIME_UTC time point to a relative timeout rounded up to full milliseconds
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    long long const remainingNs = (long long)(timePoint->tv_sec - now.tv_sec) * 1000000000ll + (timePoint->tv_nsec - now.tv_nsec);
+    DWORD const timeoutMs = (remainingNs > 0) ? (DWORD)((remainingNs + 999999) / 1000000) : 0;
+
+    if (SleepConditionVariableCS(&condition->conditionVariable, &mutex->criticalSection, timeoutMs))
+    {
+        return thrd_success;
+    }
+    return (GetLastError() == ERROR_TIMEOUT) ? thrd_timedout : thrd_error;
+}
+
+void cnd_destroy(cnd_t* condition)
+{
+    // Windows condition variables do not need to be destroyed
+    (void)condition;
+}
+
+/**
+ * \brief Function and argument passed to a new thread; freed by the thread
+ */
+typedef struct ThreadStartInfo
+{
+    thrd_start_t    func;
+    void*           arg;
+} ThreadStartInfo;
+
+static DWORD WINAPI ThreadStart(LPVOID arg)
+{
+    ThreadStartInfo info = *((ThreadStartInfo*)arg);
+    free(arg);
+    return (DWORD)info.func(info.arg);
+}
+
+int thrd_create(thrd_t* thread, thrd_start_t func, void* arg)
+{
+    if (thread == NULL || func == NULL)
+    {
+        return thrd_error;
+    }
+
+    ThreadStartInfo* info = (ThreadStartInfo*)malloc(sizeof(ThreadStartInfo));
+    if (info == NULL)
+    {
+        return thrd_nomem;
+    }
+    info->func = func;
+    info->arg = arg;
+
+    thread->handle = CreateThread(NULL, 0, ThreadStart, info, 0, NULL);
+    if (thread->handle == NULL)
+    {
+        free(info);
+        return thrd_error;
+    }
+    return thrd_success;
+}
+
+int thrd_join(thrd_t thread, int* result)
+{
+    DWORD exitCode = 0;
+    if (WAIT_OBJECT_0 != WaitForSingleObject(thread.handle, INFINITE)
+        || !GetExitCodeThread(thread.handle, &exitCode))
+    {
+        return thrd_error;
+    }
+    CloseHandle(thread.handle);
+    if (result != NULL)
+    {
+        *result = (int)exitCode;
     }
+    return thrd_success;
 }
 
 #endif
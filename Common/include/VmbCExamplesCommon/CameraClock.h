@@ -0,0 +1,45 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef CAMERA_CLOCK_H_
+#define CAMERA_CLOCK_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+/**
+ * \brief Read the frequency of the timestamps of a camera
+ *
+ * The SFNC feature DeviceTimestampFrequency is used, if the GigE Vision specific GevTimestampTickFrequency is not available.
+ *
+ * \param[in] cameraHandle  Handle of the already opened camera
+ *
+ * \return the frequency in Hz; 0 if the camera does not provide it, i.e. the timestamps are assumed to be in ns
+ */
+VmbUint64_t GetTimestampFrequency(const VmbHandle_t cameraHandle);
+
+/**
+ * \brief Read the duration of a tick of the timestamps of a camera
+ *
+ * \param[in] cameraHandle  Handle of the already opened camera
+ *
+ * \return the duration of a tick in ns; 1 if the camera does not provide the frequency
+ */
+double GetTimestampNsPerTick(const VmbHandle_t cameraHandle);
+
+/**
+ * \brief Read the current time of the camera clock
+ *
+ * The SFNC latch features are used, if available, followed by the GigE Vision specific ones.
+ *
+ * \param[in]  cameraHandle     Handle of the already opened camera
+ * \param[out] pTicks           The latched camera time
+ * \param[out] pHostNs          The host time in the middle of latching the camera time (time base of GetMonotonicTimeNs)
+ * \param[out] pUncertaintyNs   Half the time latching took, i.e. the maximum error of pHostNs; may be NULL
+ *
+ * \return An error code indicating success or the type of error that occurred.
+ */
+VmbError_t LatchCameraTime(const VmbHandle_t cameraHandle, VmbUint64_t* const pTicks, VmbUint64_t* const pHostNs, VmbUint64_t* const pUncertaintyNs);
+
+#endif
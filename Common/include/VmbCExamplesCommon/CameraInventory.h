@@ -0,0 +1,183 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef CAMERA_INVENTORY_H_
+#define CAMERA_INVENTORY_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#include "VmbStdatomic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CAMERA_INVENTORY_VERSION                1
+
+#define CAMERA_INVENTORY_MAX_TRANSPORT_LAYERS   16
+#define CAMERA_INVENTORY_MAX_INTERFACES         64
+#define CAMERA_INVENTORY_MAX_CAMERAS            128
+
+#define CAMERA_INVENTORY_ID_LENGTH              256
+#define CAMERA_INVENTORY_NAME_LENGTH            128
+#define CAMERA_INVENTORY_PATH_LENGTH            512
+
+#define CAMERA_INVENTORY_NO_INDEX               0xFFFFFFFFu
+
+/**
+ * \brief Time without a heartbeat of the daemon after which the inventory is considered stale
+ */
+#define CAMERA_INVENTORY_STALE_NS               5000000000ull
+
+/**
+ * \brief The information of a transport layer stored in the inventory
+ */
+typedef struct InventoryTransportLayer
+{
+    char                    id[CAMERA_INVENTORY_ID_LENGTH];
+    char                    name[CAMERA_INVENTORY_NAME_LENGTH];
+    char                    modelName[CAMERA_INVENTORY_NAME_LENGTH];
+    char                    vendor[CAMERA_INVENTORY_NAME_LENGTH];
+    char                    version[CAMERA_INVENTORY_NAME_LENGTH];
+    char                    path[CAMERA_INVENTORY_PATH_LENGTH];
+    VmbUint32_t             type;                   //!< A ::VmbTransportLayerType value
+} InventoryTransportLayer;
+
+/**
+ * \brief The information of an interface stored in the inventory
+ */
+typedef struct InventoryInterface
+{
+    char                    id[CAMERA_INVENTORY_ID_LENGTH];
+    char                    name[CAMERA_INVENTORY_NAME_LENGTH];
+    VmbUint32_t             type;                   //!< A ::VmbTransportLayerType value
+    VmbUint32_t             transportLayerIndex;    //!< Index in the transport layers or ::CAMERA_INVENTORY_NO_INDEX
+} InventoryInterface;
+
+/**
+ * \brief The information of a camera stored in the inventory; the strings of ::VmbCameraInfo_t by value
+ */
+typedef struct InventoryCamera
+{
+    char                    id[CAMERA_INVENTORY_ID_LENGTH];
+    char                    idExtended[CAMERA_INVENTORY_ID_LENGTH];
+    char                    name[CAMERA_INVENTORY_NAME_LENGTH];
+    char                    modelName[CAMERA_INVENTORY_NAME_LENGTH];
+    char                    serial[CAMERA_INVENTORY_NAME_LENGTH];
+    VmbUint32_t             permittedAccess;        //!< ::VmbAccessModeType flags
+    VmbUint32_t             interfaceIndex;         //!< Index in the interfaces or ::CAMERA_INVENTORY_NO_INDEX
+    VmbUint32_t             transportLayerIndex;    //!< Index in the transport layers or ::CAMERA_INVENTORY_NO_INDEX
+} InventoryCamera;
+
+/**
+ * \brief The modules of a system at one point in time
+ *
+ * Handles are only valid in the process that received them, so the records reference their parent modules by index.
+ * Unused records and the unused parts of the strings are zero, so two inventories can be compared using memcmp.
+ */
+typedef struct CameraInventoryData
+{
+    VmbUint64_t             updateCount;            //!< Incremented by the daemon for every change of the content
+    VmbUint64_t             updateTimeNs;           //!< Time of the last change in the time base of GetMonotonicTimeNs
+    VmbUint32_t             transportLayerCount;
+    VmbUint32_t             interfaceCount;
+    VmbUint32_t             cameraCount;
+    VmbBool_t               truncated;              //!< More modules were found than the inventory can hold
+    InventoryTransportLayer transportLayers[CAMERA_INVENTORY_MAX_TRANSPORT_LAYERS];
+    InventoryInterface      interfaces[CAMERA_INVENTORY_MAX_INTERFACES];
+    InventoryCamera         cameras[CAMERA_INVENTORY_MAX_CAMERAS];
+} CameraInventoryData;
+
+/**
+ * \brief The layout of the shared memory segment
+ *
+ * The data is protected by a sequence lock: the writer makes the sequence odd before changing the data and even
+ * again afterwards. A reader copies the data and retries, if the sequence was odd or changed during the copy, so
+ * neither side ever blocks the other. The heartbeat is updated outside of the lock, since it is a single value.
+ */
+typedef struct CameraInventorySegment
+{
+    VmbUint64_t             magic;
+    VmbUint32_t             version;                //!< ::CAMERA_INVENTORY_VERSION of the writer
+    VmbUint32_t             size;                   //!< sizeof(CameraInventorySegment) of the writer
+    atomic_ullong           sequence;
+    atomic_ullong           heartbeatNs;            //!< Last sign of life of the daemon, see GetMonotonicTimeNs
+    CameraInventoryData     data;
+} CameraInventorySegment;
+
+/**
+ * \brief A mapping of the shared memory segment into the current process
+ */
+typedef struct CameraInventoryMapping
+{
+    CameraInventorySegment* segment;
+    VmbBool_t               owner;                  //!< The mapping was created by the daemon
+#ifdef _WIN32
+    void*                   fileMapping;            //!< The HANDLE of the file mapping object
+#endif
+} CameraInventoryMapping;
+
+/**
+ * \brief Create the shared memory segment; used by the discovery daemon
+ *
+ * A segment left behind by a daemon without a heartbeat is replaced. A segment that is not compatible yet may be
+ * set up by another daemon, so it is checked again and only replaced, if it does not become compatible within
+ * CAMERA_INVENTORY_STALE_NS.
+ *
+ * \return ::VmbErrorAlready, if another daemon is running, or an error code indicating success or the type of error
+ */
+VmbError_t CameraInventoryCreate(CameraInventoryMapping* mapping);
+
+/**
+ * \brief Map the segment of a running daemon for reading
+ *
+ * \return ::VmbErrorNotFound, if no daemon published an inventory, ::VmbErrorNotAvailable, if the segment was
+ *         written by an incompatible version, or an error code indicating success or the type of error
+ */
+VmbError_t CameraInventoryOpen(CameraInventoryMapping* mapping);
+
+/**
+ * \brief Unmap the segment; the daemon also removes it, so readers fall back to enumerating the modules themselves
+ */
+void CameraInventoryClose(CameraInventoryMapping* mapping);
+
+/**
+ * \brief Publish a new inventory and update the heartbeat
+ *
+ * The update count and time of the data are assigned before it is copied to the segment.
+ */
+void CameraInventoryPublish(CameraInventoryMapping* mapping, CameraInventoryData* data);
+
+/**
+ * \brief Tell the readers the daemon is still running without changing the inventory
+ */
+void CameraInventoryHeartbeat(CameraInventoryMapping* mapping);
+
+/**
+ * \brief Copy a consistent inventory out of the segment
+ *
+ * \return ::VmbErrorNotAvailable, if the heartbeat of the daemon is missing or nothing was published yet,
+ *         ::VmbErrorRetriesExceeded, if the writer kept changing the data, or an error code indicating success or
+ *         the type of error
+ */
+VmbError_t CameraInventoryRead(CameraInventoryMapping const* mapping, CameraInventoryData* data);
+
+/**
+ * \brief Open the segment of the daemon, read the inventory and close the segment again
+ */
+VmbError_t CameraInventoryReadOnce(CameraInventoryData* data);
+
+/**
+ * \brief Enumerate the transport layers, interfaces and cameras of the started API into an inventory
+ *
+ * The data is zeroed first; the update count and time are left for CameraInventoryPublish.
+ */
+VmbError_t CameraInventoryCollect(CameraInventoryData* data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef CHUNK_DECODER_H_
+#define CHUNK_DECODER_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+/**
+ * \brief The chunk values the decoder is able to extract
+ */
+typedef enum ChunkField
+{
+    ChunkFieldTimestamp,        //!< ChunkTimestamp
+    ChunkFieldWidth,            //!< ChunkWidth
+    ChunkFieldHeight,           //!< ChunkHeight
+    ChunkFieldExposureTime,     //!< ChunkExposureTime
+    ChunkFieldGain,             //!< ChunkGain
+    ChunkFieldFrameId,          //!< ChunkFrameID
+    ChunkFieldLineStatusAll,    //!< ChunkLineStatusAll
+    ChunkFieldCount
+} ChunkField;
+
+/**
+ * \brief Get the bit used for a field in ChunkValues::validFields and the field masks
+ */
+#define CHUNK_FIELD_BIT(field) (((VmbUint32_t)1) << (field))
+
+/**
+ * \brief Chunk values of a single frame
+ */
+typedef struct ChunkValues
+{
+    VmbUint32_t validFields;    //!< Bit mask of the fields available; see ::CHUNK_FIELD_BIT
+    VmbInt64_t  timestamp;
+    VmbInt64_t  width;
+    VmbInt64_t  height;
+    double      exposureTime;
+    double      gain;
+    VmbInt64_t  frameId;
+    VmbInt64_t  lineStatusAll;
+} ChunkValues;
+
+#define CHUNK_DECODER_MAX_CHUNKS        16  //!< Maximum number of chunks in a frame the decoder is able to handle
+#define CHUNK_DECODER_MAX_CANDIDATES    8   //!< Maximum number of possible locations tracked per field
+
+/**
+ * \brief The location and encoding of a chunk value inside of the chunk data of a frame
+ */
+typedef struct ChunkValueLocation
+{
+    VmbUint32_t chunkIndex;     //!< Index of the chunk counting from the end of the buffer
+    VmbUint32_t offset;         //!< Offset of the value from the start of the chunk data
+    VmbUint8_t  size;           //!< Size of the value in bytes (4 or 8)
+    VmbBool_t   bigEndian;      //!< True, if the value is stored in big endian byte order
+    VmbBool_t   isFloat;        //!< True, if the value is stored as IEEE 754 floating point number
+} ChunkValueLocation;
+
+/**
+ * \brief Decoder extracting chunk values directly from the frame buffer
+ *
+ * VmbC stores chunks as a sequence of (data, chunk id, data length) triples; the length and id following the data
+ * allow to walk the chunks starting at the end of the payload. The decoder learns the chunk layout from the first
+ * frame of an acquisition and searches its chunks for the values reported via VmbChunkDataAccess. A value is read
+ * from the buffer directly only once a single location matches it and as long as the chunk ids and lengths match
+ * the learned layout; if the layout changes, VmbChunkDataAccess is used and the layout is learned again.
+ *
+ * A value may match several locations, e.g. the width and height of a square image or a gain staying equal to the
+ * exposure time. Such a layout is ambiguous: the value is read via VmbChunkDataAccess for every frame, which also
+ * rules out the locations not matching it, until a single location is left. Values the decoder cannot locate at all
+ * are always read via VmbChunkDataAccess.
+ *
+ * A decoder must not be used concurrently; use one decoder per stream.
+ */
+typedef struct ChunkDecoder
+{
+    VmbUint32_t         requestedFields;    //!< The fields to extract
+    VmbUint32_t         payloadSize;        //!< The size of the payload including the chunk data
+
+    VmbBool_t           layoutKnown;        //!< True, if the chunk layout was learned and the candidates were searched
+    VmbBool_t           learningFailed;     //!< True, if no value could be located; VmbChunkDataAccess is used for all frames
+    VmbUint32_t         decodedFields;      //!< The fields extracted from the buffer at their unique location
+    VmbUint32_t         chunkAccessFields;  //!< The fields read via VmbChunkDataAccess, since their location is not supported or still ambiguous
+    VmbBool_t           trailerBigEndian;   //!< Byte order of the chunk ids and lengths
+    VmbUint32_t         chunkCount;
+    VmbUint32_t         chunkIds[CHUNK_DECODER_MAX_CHUNKS];
+    VmbUint32_t         chunkLengths[CHUNK_DECODER_MAX_CHUNKS];
+
+    VmbUint32_t         framesSinceVerification;                                //!< Number of frames decoded since the last comparison with VmbChunkDataAccess
+    VmbUint32_t         candidateCounts[ChunkFieldCount];                       //!< Number of remaining candidates per field
+    VmbUint32_t         candidateOverflow;                                      //!< Fields with more matching locations than candidates in the last search
+    ChunkValueLocation  candidates[ChunkFieldCount][CHUNK_DECODER_MAX_CANDIDATES];
+
+    VmbUint64_t         framesDecoded;      //!< Number of frames all values were extracted from the buffer for
+    VmbUint64_t         framesChunkAccess;  //!< Number of frames VmbChunkDataAccess was used for
+    VmbUint64_t         layoutChanges;      //!< Number of times a learned layout did not match a frame
+} ChunkDecoder;
+
+/**
+ * \brief Get the name of the chunk feature providing a field
+ */
+const char* ChunkFieldFeatureName(ChunkField field);
+
+/**
+ * \brief Initialize a decoder at the start of the acquisition
+ *
+ * \param[out] decoder          the decoder to initialize
+ * \param[in]  payloadSize      the payload size of the stream as reported by VmbPayloadSizeGet
+ * \param[in]  requestedFields  the fields to extract; a combination of ::CHUNK_FIELD_BIT values
+ */
+void ChunkDecoderInit(ChunkDecoder* decoder, VmbUint32_t payloadSize, VmbUint32_t requestedFields);
+
+/**
+ * \brief Extract the chunk values of a frame
+ *
+ * Uses the learned layout, if possible, and VmbChunkDataAccess otherwise.
+ *
+ * \param[in,out] decoder   the decoder
+ * \param[in]     frame     the frame received from VmbC
+ * \param[out]    values    the values extracted
+ *
+ * \return ::VmbErrorSuccess, if at least one requested value is available; an error code otherwise
+ */
+VmbError_t ChunkDecoderDecode(ChunkDecoder* decoder, const VmbFrame_t* frame, ChunkValues* values);
+
+/**
+ * \brief Enable the chunks providing the given fields and activate the chunk mode of a camera
+ *
+ * Chunks not supported by the camera are skipped. Must be called before the payload size is queried.
+ *
+ * \param[in] cameraHandle handle of the camera
+ * \param[in] fields       the fields to enable the chunks for; a combination of ::CHUNK_FIELD_BIT values
+ *
+ * \return the error of activating the chunk mode, if any, or else the first error of enabling a supported chunk
+ */
+VmbError_t ChunkDecoderEnableChunks(VmbHandle_t cameraHandle, VmbUint32_t fields);
+
+/**
+ * \brief Read the chunk values of a frame using VmbChunkDataAccess only
+ *
+ * \param[in]  frame            the frame received from VmbC
+ * \param[in]  requestedFields  the fields to read; a combination of ::CHUNK_FIELD_BIT values
+ * \param[out] values           the values read
+ */
+VmbError_t ChunkDecoderReadWithChunkAccess(const VmbFrame_t* frame, VmbUint32_t requestedFields, ChunkValues* values);
+
+#endif
@@ -0,0 +1,83 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef CLOCK_DRIFT_ESTIMATOR_H_
+#define CLOCK_DRIFT_ESTIMATOR_H_
+
+#include <VmbC/VmbCommonTypes.h>
+
+#define CLOCK_DRIFT_ESTIMATOR_WINDOW        256 //!< Number of most recent samples the model is fitted to
+#define CLOCK_DRIFT_ESTIMATOR_MIN_SAMPLES   16  //!< Number of samples required before timestamps can be converted
+
+/**
+ * \brief Online estimator mapping camera timestamps to the host clock used by GetMonotonicTimeNs
+ *
+ * The estimator is fed with pairs of camera timestamps and the host times the frames arrived at and fits
+ * hostTime = offset + slope * cameraTicks over a sliding window. Samples delayed by the transport or the
+ * scheduling of the frame callback more than 3 scaled median absolute deviations are rejected before the final
+ * fit. The offset includes the typical latency between exposure and callback, i.e. converted timestamps tell when
+ * a frame would typically have been received.
+ *
+ * Use one estimator per camera. The functions must not be called concurrently for the same estimator.
+ */
+typedef struct ClockDriftEstimator
+{
+    double      nominalNsPerTick;                           //!< Duration of a camera tick according to the camera
+
+    VmbUint64_t cameraTicks[CLOCK_DRIFT_ESTIMATOR_WINDOW];  //!< Ring buffer of the camera timestamps
+    VmbUint64_t hostNs[CLOCK_DRIFT_ESTIMATOR_WINDOW];       //!< Ring buffer of the matching host times
+    VmbUint32_t sampleCount;                                //!< Number of samples in the ring buffer
+    VmbUint32_t nextSample;                                 //!< Index the next sample is written to
+    VmbUint32_t samplesSinceFit;
+
+    double      residuals[CLOCK_DRIFT_ESTIMATOR_WINDOW];    //!< Scratch memory used while fitting
+    double      sortedResiduals[CLOCK_DRIFT_ESTIMATOR_WINDOW];
+
+    VmbBool_t   modelValid;         //!< True, if the members below describe a fitted model
+    VmbUint64_t referenceTicks;     //!< Camera timestamp the model is relative to
+    VmbUint64_t referenceHostNs;    //!< Host time the model is relative to
+    double      interceptNs;        //!< Host time at referenceTicks relative to referenceHostNs
+    double      slope;              //!< Host nanoseconds per camera tick
+    double      residualStdDevNs;   //!< Standard deviation of the inliers from the model
+    VmbUint32_t inlierCount;        //!< Number of samples used for the last fit; the other samples of the window were rejected as outliers
+
+    VmbUint64_t resets;             //!< Number of times the camera clock jumped backwards and the window was cleared
+} ClockDriftEstimator;
+
+/**
+ * \brief Initialize an estimator
+ *
+ * \param[out] estimator        the estimator to initialize
+ * \param[in]  tickFrequency    the nominal frequency of the camera timestamps in Hz, e.g. the value of
+ *                              GevTimestampTickFrequency; 0 for nanosecond timestamps
+ */
+void ClockDriftEstimatorInit(ClockDriftEstimator* estimator, VmbUint64_t tickFrequency);
+
+/**
+ * \brief Add a camera timestamp and the host time the frame was received at
+ *
+ * The model is refitted every few samples.
+ */
+void ClockDriftEstimatorAddSample(ClockDriftEstimator* estimator, VmbUint64_t cameraTicks, VmbUint64_t hostNs);
+
+/**
+ * \brief Convert a camera timestamp to host time
+ *
+ * \param[in]  estimator    the estimator
+ * \param[in]  cameraTicks  the camera timestamp to convert
+ * \param[out] hostNs       the estimated host time in the time base of GetMonotonicTimeNs
+ *
+ * \return true, if enough samples were available for fitting the model
+ */
+VmbBool_t ClockDriftEstimatorToHostNs(const ClockDriftEstimator* estimator, VmbUint64_t cameraTicks, VmbUint64_t* hostNs);
+
+/**
+ * \brief Get the deviation of the camera clock from its nominal frequency relative to the host clock
+ *
+ * \return the drift in ppm; positive values mean the camera clock runs slower than the host clock
+ */
+double ClockDriftEstimatorDriftPpm(const ClockDriftEstimator* estimator);
+
+#endif
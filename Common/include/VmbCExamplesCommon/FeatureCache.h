@@ -0,0 +1,135 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FEATURE_CACHE_H_
+#define FEATURE_CACHE_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#include "VmbStdatomic.h"
+#include "VmbThreads.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FEATURE_CACHE_CAPACITY      1024    //!< Number of slots of the hash table; a power of 2
+#define FEATURE_CACHE_NAME_POOL     32768   //!< Size of the memory holding the interned feature names
+
+struct FeatureCache;
+
+/**
+ * \brief A slot of the hash table of a cache
+ */
+typedef struct FeatureCacheEntry
+{
+    VmbUint32_t             hash;
+    VmbUint32_t             nameOffset;         //!< Position of the interned name in the name pool of the cache
+    VmbBool_t               used;
+    VmbBool_t               cached;             //!< The value is kept; false for volatile features or if the invalidation cannot be observed
+    VmbFeatureData_t        type;
+    atomic_ullong           generation;         //!< Incremented by the invalidation callback
+    VmbUint64_t             valueGeneration;    //!< Generation the stored value was read at
+    VmbBool_t               hasValue;
+    VmbInt64_t              intValue;           //!< Value of int and bool features
+    double                  floatValue;
+    const char*             enumValue;          //!< Valid as long as the module is open
+    struct FeatureCache*    cache;
+} FeatureCacheEntry;
+
+/**
+ * \brief Counters of a cache
+ */
+typedef struct FeatureCacheStats
+{
+    VmbUint64_t hits;           //!< Reads served from the cache
+    VmbUint64_t misses;         //!< Reads of stale or not yet read values
+    VmbUint64_t uncached;       //!< Reads of features that are never cached
+    VmbUint64_t invalidations;  //!< Notifications of changed features
+    VmbUint32_t featureCount;   //!< Number of features in the hash table
+} FeatureCacheStats;
+
+/**
+ * \brief Typed feature values of a module, read from the module only if they changed
+ *
+ * On the first access of a feature its name is interned into a name pool and an entry of an open addressing hash
+ * table is created. An invalidation callback is registered for the feature, which only marks the entry as stale by
+ * incrementing its generation, so no work is done in the notification thread of the API. The value is read again
+ * on the next access of a stale entry. Volatile features, e.g. temperatures, change without being invalidated and
+ * are always read from the module.
+ *
+ * All functions may be called from multiple threads. The cache must not be moved in memory while it is
+ * initialized, since the entries are passed to the invalidation callbacks. String features are not supported. The
+ * getters return VmbErrorResources for features not fitting into a full cache.
+ */
+typedef struct FeatureCache
+{
+    VmbHandle_t         handle;
+    mtx_t               mutex;
+    FeatureCacheEntry   entries[FEATURE_CACHE_CAPACITY];
+    VmbUint32_t         entryCount;
+    char                namePool[FEATURE_CACHE_NAME_POOL];
+    VmbUint32_t         namePoolUsed;
+
+    VmbUint64_t         hits;
+    VmbUint64_t         misses;
+    VmbUint64_t         uncached;
+    atomic_ullong       invalidations;
+} FeatureCache;
+
+/**
+ * \brief Initialize an empty cache for the features of a module
+ *
+ * \param[out] cache    the cache to initialize
+ * \param[in]  handle   the handle of the module, e.g. of a camera or a stream
+ */
+VmbError_t FeatureCacheInit(FeatureCache* cache, VmbHandle_t handle);
+
+/**
+ * \brief Unregister the invalidation callbacks and free the resources of the cache
+ */
+void FeatureCacheDestroy(FeatureCache* cache);
+
+VmbError_t FeatureCacheGetInt(FeatureCache* cache, const char* name, VmbInt64_t* value);
+
+VmbError_t FeatureCacheGetFloat(FeatureCache* cache, const char* name, double* value);
+
+VmbError_t FeatureCacheGetBool(FeatureCache* cache, const char* name, VmbBool_t* value);
+
+/**
+ * \brief Get the value of an enum feature
+ *
+ * \param[out] value    the value; valid as long as the module is open
+ */
+VmbError_t FeatureCacheGetEnum(FeatureCache* cache, const char* name, const char** value);
+
+/**
+ * \brief Add a feature to the cache and register its invalidation callback without reading its value
+ *
+ * The getters do the same on the first access of a feature.
+ *
+ * \param[out] invalidated  receives, if changes of the feature are observed via invalidations; features that are
+ *                          never invalidated, e.g. volatile ones, are always read from the module. May be NULL.
+ *
+ * \return VmbErrorResources, if the feature does not fit into the cache, or the error of the feature info query
+ */
+VmbError_t FeatureCacheWatch(FeatureCache* cache, const char* name, VmbBool_t* invalidated);
+
+/**
+ * \brief Check, if the value of a feature was invalidated since it was last read through the cache
+ *
+ * Only looks up the feature; it is neither added to the cache nor is an invalidation callback registered.
+ *
+ * \return true, if the feature was not added via FeatureCacheWatch or a getter, was not read yet or is never cached
+ */
+VmbBool_t FeatureCacheIsStale(FeatureCache* cache, const char* name);
+
+void FeatureCacheGetStats(FeatureCache* cache, FeatureCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
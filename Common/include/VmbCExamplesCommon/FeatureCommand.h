@@ -0,0 +1,46 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FEATURE_COMMAND_H_
+#define FEATURE_COMMAND_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FEATURE_COMMAND_DEFAULT_TIMEOUT_MS 1000
+
+/**
+ * \brief Timeout for GVSPAdjustPacketSize, which tries packet sizes until one passes the network; this takes several
+ *        seconds on some networks
+ */
+#define FEATURE_COMMAND_ADJUST_PACKET_SIZE_TIMEOUT_MS 60000
+
+/**
+ * \brief Run a command feature and wait for its completion
+ *
+ * The completion is checked whenever the feature is invalidated, e.g. because the transport layer reported the
+ * completion, and otherwise with intervals starting at 1 us and doubling up to 10 ms. Commands completing
+ * immediately therefore do not cause any delay and long running commands do not keep a core busy.
+ *
+ * The function must not be called concurrently for the same feature.
+ *
+ * \param[in]  handle       the handle of the module providing the command
+ * \param[in]  name         the name of the command feature
+ * \param[in]  timeoutMs    the maximum time to wait for the completion
+ * \param[out] latencyNs    the time between running the command and detecting its completion; may be NULL
+ *
+ * \return ::VmbErrorTimeout, if the command was not done within the timeout; the error of running the command or
+ *         querying the completion otherwise
+ */
+VmbError_t RunFeatureCommand(VmbHandle_t handle, const char* name, VmbUint32_t timeoutMs, VmbUint64_t* latencyNs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FRAME_PREDICATE_H_
+#define FRAME_PREDICATE_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#include "ChunkDecoder.h"
+
+#define FRAME_PREDICATE_MAX_CONDITIONS 8
+
+/**
+ * \brief The kinds of conditions a frame can be checked for
+ */
+typedef enum FrameConditionType
+{
+    FrameConditionExposureRange,    //!< ChunkExposureTime is in [minExposure, maxExposure]
+    FrameConditionLineStatusBit,    //!< Bit lineStatusBit of ChunkLineStatusAll is set
+    FrameConditionFrameIdInterval   //!< The frame id is a multiple of frameIdInterval
+} FrameConditionType;
+
+typedef struct FrameCondition
+{
+    FrameConditionType  type;
+    double              minExposure;
+    double              maxExposure;
+    VmbUint32_t         lineStatusBit;
+    VmbUint64_t         frameIdInterval;
+} FrameCondition;
+
+/**
+ * \brief A conjunction of conditions deciding from the frame metadata only, if a frame is processed further
+ *
+ * Conditions are specified as text:
+ * - exposure=<min>:<max>   exposure time in us within the range; an empty bound is not checked
+ * - line=<bit>             the line status bit is set
+ * - nth=<n>                every n-th frame id
+ *
+ * Conditions requiring chunk values fail for frames without the chunk.
+ */
+typedef struct FramePredicate
+{
+    VmbUint32_t     conditionCount;
+    FrameCondition  conditions[FRAME_PREDICATE_MAX_CONDITIONS];
+    VmbUint32_t     requiredChunkFields;    //!< The chunk fields needed for evaluating the conditions; see ::CHUNK_FIELD_BIT
+
+    VmbUint64_t     framesAccepted;
+    VmbUint64_t     framesRejected;
+} FramePredicate;
+
+/**
+ * \brief Initialize a predicate accepting all frames
+ */
+void FramePredicateInit(FramePredicate* predicate);
+
+/**
+ * \brief Parse a condition and add it to the predicate
+ *
+ * \param[in,out] predicate the predicate to add the condition to
+ * \param[in]     text      the condition in one of the forms listed in the description of ::FramePredicate
+ *
+ * \return ::VmbErrorBadParameter, if the text is not a valid condition; ::VmbErrorResources, if too many conditions were added
+ */
+VmbError_t FramePredicateAddCondition(FramePredicate* predicate, const char* text);
+
+/**
+ * \brief Check, if a frame fulfills all conditions and update the frame counts
+ *
+ * \param[in,out] predicate the predicate
+ * \param[in]     frame     the frame received
+ * \param[in]     values    the chunk values of the frame; may be NULL, if requiredChunkFields is 0 or no chunk data is available
+ */
+VmbBool_t FramePredicateEvaluate(FramePredicate* predicate, const VmbFrame_t* frame, const ChunkValues* values);
+
+#endif
@@ -0,0 +1,72 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef HANDLE_INDEX_H_
+#define HANDLE_INDEX_H_
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief A slot of the hash table of an index
+ */
+typedef struct HandleIndexEntry
+{
+    VmbHandle_t handle;     //!< NULL for an empty slot
+    void*       value;
+} HandleIndexEntry;
+
+/**
+ * \brief Maps the handles of modules to data of the caller, e.g. the infos of transport layers or interfaces
+ *
+ * The index is an open addressing hash table with linear probing, so matching the cameras of a system to their
+ * interfaces and transport layers takes constant time per camera instead of a search of all modules. The table
+ * grows as needed, keeping at least half of the slots free. NULL handles cannot be stored.
+ */
+typedef struct HandleIndex
+{
+    HandleIndexEntry*   entries;
+    VmbUint32_t         capacity;   //!< Number of slots; a power of 2
+    VmbUint32_t         count;
+} HandleIndex;
+
+/**
+ * \brief Initialize an empty index
+ *
+ * \param[out] index            the index to initialize
+ * \param[in]  expectedCount    the number of handles expected to be added; avoids growing the table
+ */
+VmbError_t HandleIndexInit(HandleIndex* index, VmbUint32_t expectedCount);
+
+/**
+ * \brief Add a handle or replace the value of a handle already present
+ */
+VmbError_t HandleIndexInsert(HandleIndex* index, VmbHandle_t handle, void* value);
+
+/**
+ * \return the value stored for the handle or NULL, if the handle is not part of the index
+ */
+void* HandleIndexFind(HandleIndex const* index, VmbHandle_t handle);
+
+/**
+ * \brief Add the transport layers with their infos as values
+ */
+VmbError_t HandleIndexAddTransportLayers(HandleIndex* index, VmbTransportLayerInfo_t* transportLayers, VmbUint32_t count);
+
+/**
+ * \brief Add the interfaces with their infos as values
+ */
+VmbError_t HandleIndexAddInterfaces(HandleIndex* index, VmbInterfaceInfo_t* interfaces, VmbUint32_t count);
+
+void HandleIndexFree(HandleIndex* index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+#include <VmbC/VmbCommonTypes.h>
+
+#define HISTOGRAM_MAX_BUCKETS 64
+
+/**
+ * \brief Count, extremes, mean and standard deviation of a series of values without storing them
+ */
+typedef struct RunningStatistics
+{
+    VmbUint64_t count;
+    double      min;
+    double      max;
+    double      sum;
+    double      sumOfSquares;
+} RunningStatistics;
+
+/**
+ * \brief Initialize empty statistics
+ */
+void RunningStatisticsInit(RunningStatistics* statistics);
+
+/**
+ * \brief Add a value to the statistics
+ */
+void RunningStatisticsAdd(RunningStatistics* statistics, double value);
+
+double RunningStatisticsMean(const RunningStatistics* statistics);
+
+double RunningStatisticsStdDev(const RunningStatistics* statistics);
+
+/**
+ * \brief Histogram with equally sized buckets over a fixed range
+ *
+ * Values outside of the range are counted as underflow or overflow, but are included in the summary statistics.
+ */
+typedef struct Histogram
+{
+    double      lowerBound;
+    double      bucketWidth;
+    VmbUint32_t bucketCount;
+    VmbUint64_t buckets[HISTOGRAM_MAX_BUCKETS];
+    VmbUint64_t underflow;  //!< Number of values less than lowerBound
+    VmbUint64_t overflow;   //!< Number of values greater than or equal to the upper bound
+
+    VmbUint64_t count;
+    double      min;
+    double      max;
+    double      sum;
+    double      sumOfSquares;
+} Histogram;
+
+/**
+ * \brief Initialize an empty histogram
+ *
+ * \param[out] histogram    the histogram to initialize
+ * \param[in]  lowerBound   the lower bound of the first bucket
+ * \param[in]  upperBound   the upper bound of the last bucket; increased, if it is not greater than lowerBound
+ * \param[in]  bucketCount  the number of buckets; limited to ::HISTOGRAM_MAX_BUCKETS
+ */
+void HistogramInit(Histogram* histogram, double lowerBound, double upperBound, VmbUint32_t bucketCount);
+
+/**
+ * \brief Add a value to the histogram
+ */
+void HistogramAdd(Histogram* histogram, double value);
+
+double HistogramMean(const Histogram* histogram);
+
+double HistogramStdDev(const Histogram* histogram);
+
+/**
+ * \brief Estimate a percentile by interpolating within the bucket containing it
+ *
+ * \param[in] histogram     the histogram
+ * \param[in] percentile    the percentile in [0, 100]
+ */
+double HistogramPercentile(const Histogram* histogram, double percentile);
+
+/**
+ * \brief Print the summary statistics and one bar per bucket
+ *
+ * \param[in] histogram the histogram to print
+ * \param[in] unit      the unit of the values printed after each number
+ */
+void HistogramPrint(const Histogram* histogram, const char* unit);
+
+#endif
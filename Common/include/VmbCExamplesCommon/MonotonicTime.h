@@ -0,0 +1,28 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef MONOTONIC_TIME_H_
+#define MONOTONIC_TIME_H_
+
+#include <VmbC/VmbCommonTypes.h>
+
+/**
+ * \brief Get the current time of a monotonic host clock
+ *
+ * The clock is not affected by changes of the system time, but its starting point is unspecified.
+ * Use it for measuring durations only.
+ *
+ * \return the time in nanoseconds
+ */
+VmbUint64_t GetMonotonicTimeNs(void);
+
+/**
+ * \brief Suspend the execution of the current thread until the given time
+ *
+ * \param[in] wakeUpNs  Time in the time base of GetMonotonicTimeNs
+ */
+void SleepUntilMonotonicNs(VmbUint64_t wakeUpNs);
+
+#endif
@@ -0,0 +1,92 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef TIMED_STARTUP_H_
+#define TIMED_STARTUP_H_
+
+#include <stddef.h>
+
+#include <VmbC/VmbCTypeDefinitions.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRANSPORT_LAYER_FILTER_MAX_ENTRIES  16
+#define STARTUP_PATH_LENGTH                 4096
+
+/**
+ * \brief The transport layers to load, parsed from the command line
+ */
+typedef struct TransportLayerFilter
+{
+    VmbTransportLayerType_t types[TRANSPORT_LAYER_FILTER_MAX_ENTRIES];
+    VmbUint32_t             typeCount;
+    const char*             paths[TRANSPORT_LAYER_FILTER_MAX_ENTRIES];  //!< .cti files or directories containing them
+    VmbUint32_t             pathCount;
+} TransportLayerFilter;
+
+/**
+ * \brief The durations of the phases of the startup
+ */
+typedef struct StartupTimings
+{
+    VmbUint64_t resolveNs;              //!< Finding the .cti files of the filter
+    VmbUint64_t loadNs;                 //!< VmbStartup loading the transport layers
+    VmbUint64_t interfacesNs;           //!< Enumerating the interfaces
+    VmbUint64_t camerasNs;              //!< Enumerating the cameras, including their discovery
+    VmbUint32_t pathCount;              //!< Number of entries of the path passed to VmbStartup; 0 for the default
+    VmbUint32_t transportLayerCount;
+    VmbUint32_t interfaceCount;
+    VmbUint32_t cameraCount;
+} StartupTimings;
+
+/**
+ * \brief Parse a comma separated list of transport layer types and paths
+ *
+ * A type is given either as the string of TransportLayerTypeToString, e.g. "GigE Vision", or as a short name:
+ * GigE, GEV, USB, U3V, CL, CLHS, CXP, UVC, IIDC, PCI. Other entries containing a path separator or ending in ".cti"
+ * are paths. The paths of the filter point into the string, which is modified.
+ *
+ * \return ::VmbErrorBadParameter, if an entry is neither a known type nor a path
+ */
+VmbError_t ParseTransportLayerFilter(char* filterString, TransportLayerFilter* filter);
+
+/**
+ * \brief Build the path argument of VmbStartup selecting the transport layers of the filter
+ *
+ * The paths of the filter are used as they are. The transport layers of the requested types are taken from the
+ * inventory of a running DiscoveryDaemon, if available. For types without a transport layer in the inventory, or
+ * without a daemon, the .cti files in the directories of the GENICAM_GENTL64_PATH (GENICAM_GENTL32_PATH for 32 bit
+ * processes) environment variable are matched by the usual names of their transport layer types, since the type of
+ * a transport layer is only known after loading it.
+ *
+ * \param[out] pathCount  the number of entries of the path
+ *
+ * \return ::VmbErrorNotFound, if no transport layer of a requested type was found, or an error code indicating
+ *         success or the type of error
+ */
+VmbError_t BuildStartupPath(TransportLayerFilter const* filter, char* path, size_t pathSize, VmbUint32_t* pathCount);
+
+/**
+ * \brief Start the API with the transport layers of the filter and enumerate the modules, timing every phase
+ *
+ * \param[in]  transportLayerFilter  a filter for ParseTransportLayerFilter; NULL or empty for all transport layers
+ * \param[out] timings               the durations of the phases; may be NULL
+ *
+ * \return an error code indicating success or the type of error; the API is started only on success
+ */
+VmbError_t TimedStartup(const char* transportLayerFilter, StartupTimings* timings);
+
+/**
+ * \brief Print the durations of the startup phases
+ */
+void PrintStartupTimings(StartupTimings const* timings);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
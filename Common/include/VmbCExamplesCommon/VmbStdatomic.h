@@ -22,6 +22,18 @@
     _Bool atomic_flag_test_and_set(volatile atomic_flag* obj);
 
     void atomic_flag_clear(volatile atomic_flag* obj);
+
+    // only the 64 bit type is supported by the generic functions
+    struct atomic_ullong;
+    typedef struct atomic_ullong atomic_ullong;
+
+    unsigned long long atomic_load(volatile atomic_ullong* obj);
+
+    void atomic_store(volatile atomic_ullong* obj, unsigned long long desired);
+
+    unsigned long long atomic_fetch_add(volatile atomic_ullong* obj, unsigned long long arg);
+
+    _Bool atomic_compare_exchange_strong(volatile atomic_ullong* obj, unsigned long long* expected, unsigned long long desired);
 #else
 #   include <stdatomic.h>
 #endif
@@ -17,4 +17,9 @@ struct atomic_flag
 
 #define ATOMIC_FLAG_INIT {.value=false}
 
+struct atomic_ullong
+{
+    LONG64 value;
+};
+
 #endif
@@ -11,6 +11,7 @@
 #endif
 
 #ifdef __STDC_NO_THREADS__
+#    include <time.h>
 #    ifdef _WIN32
 #       include "VmbThreads_Windows.h"
 #    elif __linux__
@@ -28,6 +29,24 @@
     int mtx_unlock(mtx_t* mutex);
 
     void mtx_destroy(mtx_t* mutex);
+
+    int cnd_init(cnd_t* condition);
+
+    int cnd_signal(cnd_t* condition);
+
+    int cnd_broadcast(cnd_t* condition);
+
+    int cnd_wait(cnd_t* condition, mtx_t* mutex);
+
+    int cnd_timedwait(cnd_t* condition, mtx_t* mutex, const struct timespec* timePoint);
+
+    void cnd_destroy(cnd_t* condition);
+
+    typedef int (*thrd_start_t)(void*);
+
+    int thrd_create(thrd_t* thread, thrd_start_t func, void* arg);
+
+    int thrd_join(thrd_t thread, int* result);
 #else
 #   include <threads.h>
 #endif // __STDC_NO_THREADS__
@@ -29,5 +29,15 @@ typedef struct VmbMtx
     pthread_mutex_t mutex;
 } mtx_t;
 
+typedef struct VmbCnd
+{
+    pthread_cond_t condition;
+} cnd_t;
+
+typedef struct VmbThrd
+{
+    pthread_t thread;
+} thrd_t;
+
 
 #endif
@@ -26,8 +26,18 @@ enum
 
 typedef struct VmbMtx
 {
-    HANDLE handle;
+    CRITICAL_SECTION criticalSection;
 } mtx_t;
 
+typedef struct VmbCnd
+{
+    CONDITION_VARIABLE conditionVariable;
+} cnd_t;
+
+typedef struct VmbThrd
+{
+    HANDLE handle;
+} thrd_t;
+
 
 #endif
@@ -0,0 +1,292 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "DiscoveryDaemon.h"
+
+#include <VmbC/VmbC.h>
+
+#include <VmbCExamplesCommon/CameraInventory.h>
+#include <VmbCExamplesCommon/ErrorCodeToMessage.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/PrintVmbVersion.h>
+#include <VmbCExamplesCommon/TimedStartup.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#define HEARTBEAT_PERIOD_NS     1000000000ull   // well below CAMERA_INVENTORY_STALE_NS
+#define DISCOVERY_SETTLE_NS     200000000ull    // the events of a camera being plugged in arrive in a burst
+
+static const char* const DiscoveryEvents[] = { "EventCameraDiscovery", "EventInterfaceDiscovery" };
+
+#define DISCOVERY_EVENT_COUNT   (sizeof(DiscoveryEvents) / sizeof(DiscoveryEvents[0]))
+
+static volatile sig_atomic_t g_stopRequested = 0;
+
+static void StopHandler(int signalNumber)
+{
+    (void)signalNumber;
+    g_stopRequested = 1;
+}
+
+/**
+* \brief Passes the discovery events from the notification thread of the API to the main loop
+*/
+typedef struct DiscoveryNotification
+{
+    mtx_t       mutex;
+    cnd_t       condition;
+    VmbBool_t   pending;
+} DiscoveryNotification;
+
+static void VMB_CALL DiscoveryCallback(const VmbHandle_t handle, const char* name, void* context)
+{
+    (void)handle;
+    (void)name;
+
+    DiscoveryNotification* const notification = (DiscoveryNotification*)context;
+    mtx_lock(&notification->mutex);
+    notification->pending = VmbBoolTrue;
+    cnd_signal(&notification->condition);
+    mtx_unlock(&notification->mutex);
+}
+
+/**
+* \brief Wait until a discovery event arrives or the time elapsed
+*
+* \return true, if discovery events arrived since the last call
+*/
+static VmbBool_t WaitForDiscovery(DiscoveryNotification* notification, VmbUint64_t durationNs)
+{
+    struct timespec timePoint;
+    timespec_get(&timePoint, TIME_UTC);
+    VmbUint64_t const nanoseconds = (VmbUint64_t)timePoint.tv_nsec + durationNs;
+    timePoint.tv_sec += (time_t)(nanoseconds / 1000000000ull);
+    timePoint.tv_nsec = (long)(nanoseconds % 1000000000ull);
+
+    mtx_lock(&notification->mutex);
+    while (!notification->pending)
+    {
+        if (cnd_timedwait(&notification->condition, &notification->mutex, &timePoint) != thrd_success)
+        {
+            break;
+        }
+    }
+    VmbBool_t const pending = notification->pending;
+    notification->pending = VmbBoolFalse;
+    mtx_unlock(&notification->mutex);
+    return pending;
+}
+
+/**
+* \brief Compare the modules of two inventories, ignoring the update count and time
+*/
+static VmbBool_t InventoryChanged(CameraInventoryData const* previous, CameraInventoryData const* current)
+{
+    size_t const offset = offsetof(CameraInventoryData, transportLayerCount);
+    return memcmp((char const*)previous + offset, (char const*)current + offset, sizeof(CameraInventoryData) - offset) != 0
+        ? VmbBoolTrue : VmbBoolFalse;
+}
+
+static InventoryCamera const* FindInventoryCamera(CameraInventoryData const* inventory, const char* id)
+{
+    for (VmbUint32_t i = 0; i < inventory->cameraCount; i++)
+    {
+        if (strcmp(inventory->cameras[i].id, id) == 0)
+        {
+            return &inventory->cameras[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+* \brief Print the cameras added to and removed from the inventory
+*/
+static void PrintInventoryChanges(CameraInventoryData const* previous, CameraInventoryData const* current, double timeS)
+{
+    for (VmbUint32_t i = 0; i < current->cameraCount; i++)
+    {
+        InventoryCamera const* const camera = &current->cameras[i];
+        if (FindInventoryCamera(previous, camera->id) == NULL)
+        {
+            printf("[%9.3f s] + %s (%s, %s)\n", timeS, camera->id, camera->modelName, camera->serial);
+        }
+    }
+    for (VmbUint32_t i = 0; i < previous->cameraCount; i++)
+    {
+        InventoryCamera const* const camera = &previous->cameras[i];
+        if (FindInventoryCamera(current, camera->id) == NULL)
+        {
+            printf("[%9.3f s] - %s (%s, %s)\n", timeS, camera->id, camera->modelName, camera->serial);
+        }
+    }
+    printf("[%9.3f s] inventory: %u transport layers, %u interfaces, %u cameras%s\n", timeS,
+           current->transportLayerCount, current->interfaceCount, current->cameraCount,
+           current->truncated ? " (truncated)" : "");
+}
+
+/**
+* \brief Register for the discovery events of the API; without them the inventory is only updated by the rescans
+*/
+static void RegisterDiscoveryEvents(DiscoveryNotification* notification, VmbBool_t* registered)
+{
+    for (size_t i = 0; i < DISCOVERY_EVENT_COUNT; i++)
+    {
+        VmbError_t const err = VmbFeatureInvalidationRegister(gVmbHandle, DiscoveryEvents[i], DiscoveryCallback, notification);
+        registered[i] = (err == VmbErrorSuccess) ? VmbBoolTrue : VmbBoolFalse;
+        if (err != VmbErrorSuccess)
+        {
+            printf("Could not register for %s, relying on the rescans: %s\n", DiscoveryEvents[i], ErrorCodeToMessage(err));
+        }
+    }
+}
+
+static void UnregisterDiscoveryEvents(VmbBool_t const* registered)
+{
+    for (size_t i = 0; i < DISCOVERY_EVENT_COUNT; i++)
+    {
+        if (registered[i])
+        {
+            VmbFeatureInvalidationUnregister(gVmbHandle, DiscoveryEvents[i], DiscoveryCallback);
+        }
+    }
+}
+
+/**
+* \brief Collect and publish the inventory until the daemon is stopped
+*
+* \param[in] inventories  Two zeroed inventories; the published one and the one collected next
+*/
+static void ServeInventory(CameraInventoryMapping* mapping, DiscoveryNotification* notification,
+                           CameraInventoryData* inventories, const DiscoveryDaemonOptions* options)
+{
+    CameraInventoryData* published = &inventories[0];
+    CameraInventoryData* collected = &inventories[1];
+
+    VmbUint64_t const startNs = GetMonotonicTimeNs();
+    VmbUint64_t const endNs = (options->durationS != 0) ? startNs + (VmbUint64_t)options->durationS * 1000000000ull : UINT64_MAX;
+    VmbUint64_t const rescanIntervalNs = (VmbUint64_t)options->rescanIntervalS * 1000000000ull;
+    VmbUint64_t nextRescanNs = startNs;
+
+    for (;;)
+    {
+        VmbUint64_t now = GetMonotonicTimeNs();
+        if (g_stopRequested || now >= endNs)
+        {
+            break;
+        }
+
+        VmbBool_t discovered = VmbBoolFalse;
+        if (now < nextRescanNs)
+        {
+            // wake up for the heartbeat even if nothing happens
+            VmbUint64_t const waitNs = nextRescanNs - now;
+            discovered = WaitForDiscovery(notification, (waitNs < HEARTBEAT_PERIOD_NS) ? waitNs : HEARTBEAT_PERIOD_NS);
+            if (discovered)
+            {
+                // collect once for the whole burst of events
+                SleepUntilMonotonicNs(GetMonotonicTimeNs() + DISCOVERY_SETTLE_NS);
+                WaitForDiscovery(notification, 0);
+            }
+            now = GetMonotonicTimeNs();
+        }
+
+        if (discovered || now >= nextRescanNs)
+        {
+            double const timeS = (double)(now - startNs) / 1e9;
+            VmbError_t const err = CameraInventoryCollect(collected);
+            if (err != VmbErrorSuccess)
+            {
+                printf("[%9.3f s] Could not collect the inventory, keeping the previous one: %s\n", timeS, ErrorCodeToMessage(err));
+            }
+            else if (published->updateCount == 0 || InventoryChanged(published, collected))
+            {
+                PrintInventoryChanges(published, collected, timeS);
+                CameraInventoryPublish(mapping, collected);
+
+                CameraInventoryData* const previous = published;
+                published = collected;
+                collected = previous;
+            }
+            nextRescanNs = GetMonotonicTimeNs() + rescanIntervalNs;
+        }
+
+        CameraInventoryHeartbeat(mapping);
+    }
+}
+
+int RunDiscoveryDaemon(const DiscoveryDaemonOptions* options)
+{
+    PrintVmbVersion();
+
+    StartupTimings timings;
+    VmbError_t err = TimedStartup(options->transportLayerFilter, &timings);
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not start api: %s\n", ErrorCodeToMessage(err));
+        return 1;
+    }
+    PrintStartupTimings(&timings);
+
+    DiscoveryNotification notification;
+    notification.pending = VmbBoolFalse;
+    CameraInventoryData* inventories = (CameraInventoryData*)calloc(2, sizeof(CameraInventoryData));
+    CameraInventoryMapping mapping;
+
+    if (inventories == NULL)
+    {
+        err = VmbErrorResources;
+    }
+    else if (mtx_init(&notification.mutex, mtx_plain) != thrd_success)
+    {
+        err = VmbErrorResources;
+    }
+    else
+    {
+        if (cnd_init(&notification.condition) != thrd_success)
+        {
+            err = VmbErrorResources;
+        }
+        else
+        {
+            err = CameraInventoryCreate(&mapping);
+            if (err == VmbErrorSuccess)
+            {
+                VmbBool_t registered[DISCOVERY_EVENT_COUNT];
+                RegisterDiscoveryEvents(&notification, registered);
+
+                signal(SIGINT, StopHandler);
+                signal(SIGTERM, StopHandler);
+                printf("Publishing the inventory, press <ctrl>+<c> to stop\n\n");
+
+                ServeInventory(&mapping, &notification, inventories, options);
+
+                UnregisterDiscoveryEvents(registered);
+                CameraInventoryClose(&mapping);
+            }
+            else if (err == VmbErrorAlready)
+            {
+                printf("Another discovery daemon is running\n");
+            }
+            else if (err != VmbErrorSuccess)
+            {
+                printf("Could not create the shared memory of the inventory: %s\n", ErrorCodeToMessage(err));
+            }
+            cnd_destroy(&notification.condition);
+        }
+        mtx_destroy(&notification.mutex);
+    }
+    VmbShutdown();
+
+    free(inventories);
+    return err == VmbErrorSuccess ? 0 : 1;
+}
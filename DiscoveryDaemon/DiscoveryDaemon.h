@@ -0,0 +1,29 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef DISCOVERYDAEMON_H
+#define DISCOVERYDAEMON_H
+
+#include <VmbC/VmbCommonTypes.h>
+
+/**
+* \brief Options of the daemon
+*/
+typedef struct DiscoveryDaemonOptions
+{
+    VmbUint32_t rescanIntervalS;        //!< Enumerate the modules at least this often, even without discovery events
+    VmbUint32_t durationS;              //!< Stop after this time; 0 for running until interrupted
+    const char* transportLayerFilter;   //!< The transport layers to load, see ParseTransportLayerFilter; NULL for all
+} DiscoveryDaemonOptions;
+
+/**
+* \brief Keep the API started and publish the transport layers, interfaces and cameras in shared memory
+*
+* The inventory is collected again whenever the API reports the discovery of a camera or an interface and at the
+* rescan interval, which also catches modules vanishing without an event. Readers use CameraInventoryRead.
+*/
+int RunDiscoveryDaemon(const DiscoveryDaemonOptions* options);
+
+#endif // DISCOVERYDAEMON_H
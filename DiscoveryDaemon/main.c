@@ -0,0 +1,99 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DiscoveryDaemon.h"
+
+#define DEFAULT_RESCAN_INTERVAL_S   10
+
+/**
+ * \brief Print the usage of the example
+ */
+static void PrintUsage(void)
+{
+    printf("Usage: DiscoveryDaemon [/r <s>] [/t <s>] [/tl <filter>]\n\n");
+    printf("Parameters:   /r <s>          Enumerate the modules at least every <s> seconds, even without discovery\n");
+    printf("                              events (default %d s)\n", DEFAULT_RESCAN_INTERVAL_S);
+    printf("              /t <s>          Stop after <s> seconds (running until interrupted if not specified)\n");
+    printf("              /tl <filter>    Load only the transport layers of a comma separated list of types and paths,\n");
+    printf("                              e.g. GigE,USB or /opt/VimbaX/cti/VimbaUSBTL.cti\n\n");
+    printf("ListCameras and the other tools reading the inventory fall back to enumerating the modules themselves,\n");
+    printf("if the daemon is not running.\n");
+}
+
+/**
+ * \brief Parse a positive number of seconds
+ *
+ * \return false, if the parameter is not a positive number
+ */
+static VmbBool_t ParseSeconds(const char* parameter, VmbUint32_t* seconds)
+{
+    char* end = NULL;
+    long const value = strtol(parameter, &end, 10);
+    if (end == parameter || *end != '\0' || value <= 0)
+    {
+        return VmbBoolFalse;
+    }
+    *seconds = (VmbUint32_t)value;
+    return VmbBoolTrue;
+}
+
+/**
+ * \brief Parse the command line parameters
+ *
+ * \return false, if the parameters are invalid
+ */
+static VmbBool_t ParseCommandLineParameters(int argc, char* argv[], DiscoveryDaemonOptions* options)
+{
+    options->rescanIntervalS = DEFAULT_RESCAN_INTERVAL_S;
+    options->durationS = 0;
+    options->transportLayerFilter = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "/r") == 0 && i + 1 < argc)
+        {
+            if (!ParseSeconds(argv[++i], &options->rescanIntervalS))
+            {
+                return VmbBoolFalse;
+            }
+        }
+        else if (strcmp(argv[i], "/t") == 0 && i + 1 < argc)
+        {
+            if (!ParseSeconds(argv[++i], &options->durationS))
+            {
+                return VmbBoolFalse;
+            }
+        }
+        else if (strcmp(argv[i], "/tl") == 0 && i + 1 < argc)
+        {
+            options->transportLayerFilter = argv[++i];
+        }
+        else
+        {
+            return VmbBoolFalse;
+        }
+    }
+    return VmbBoolTrue;
+}
+
+int main(int argc, char* argv[])
+{
+    printf("///////////////////////////////////////\n");
+    printf("/// VmbC Camera Discovery Daemon    ///\n");
+    printf("///////////////////////////////////////\n\n");
+
+    DiscoveryDaemonOptions options;
+    if (!ParseCommandLineParameters(argc, argv, &options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    return RunDiscoveryDaemon(&options);
+}
@@ -0,0 +1,221 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "EventBenchmark.h"
+
+#include <VmbCExamplesCommon/MonotonicTime.h>
+
+#define LATENCY_HISTOGRAM_MAX_US    2000.0
+#define LATENCY_HISTOGRAM_BUCKETS   64
+
+#define STUB_NOTIFICATION_DELAY_NS  200000ull   // simulated time between an event and its notification
+#define STUB_EVENT_SPACING_NS       10000ull    // simulated time between the events of a frame
+
+VmbErrorType EventBenchmarkInit(EventBenchmark* benchmark, VmbUint32_t typeCount, VmbUint64_t tickFrequency)
+{
+    if (typeCount == 0 || typeCount > BENCHMARK_MAX_EVENT_TYPES)
+    {
+        return VmbErrorBadParameter;
+    }
+
+    memset(benchmark, 0, sizeof(EventBenchmark));
+    benchmark->typeCount = typeCount;
+    benchmark->nsPerTick = (tickFrequency != 0) ? 1e9 / (double)tickFrequency : 1.0;
+    for (VmbUint32_t i = 0; i < typeCount; i++)
+    {
+        HistogramInit(&benchmark->types[i].notificationUs, 0.0, LATENCY_HISTOGRAM_MAX_US, LATENCY_HISTOGRAM_BUCKETS);
+        HistogramInit(&benchmark->types[i].handlingUs, 0.0, LATENCY_HISTOGRAM_MAX_US, LATENCY_HISTOGRAM_BUCKETS);
+    }
+    benchmark->startNs = GetMonotonicTimeNs();
+
+    return (mtx_init(&benchmark->mutex, mtx_plain) == thrd_success) ? VmbErrorSuccess : VmbErrorResources;
+}
+
+void EventBenchmarkAddType(EventBenchmark* benchmark, VmbUint32_t typeIndex, const char* name, VmbBool_t perFrame)
+{
+    if (typeIndex < benchmark->typeCount)
+    {
+        benchmark->types[typeIndex].name = name;
+        benchmark->types[typeIndex].perFrame = perFrame;
+        benchmark->types[typeIndex].active = VmbBoolTrue;
+    }
+}
+
+void EventBenchmarkSetClockReference(EventBenchmark* benchmark, VmbUint64_t ticks, VmbUint64_t hostNs)
+{
+    mtx_lock(&benchmark->mutex);
+    benchmark->referenceTicks = ticks;
+    benchmark->referenceHostNs = hostNs;
+    benchmark->referenceValid = VmbBoolTrue;
+    mtx_unlock(&benchmark->mutex);
+}
+
+void EventBenchmarkAddEvents(EventBenchmark* benchmark, const CameraEvent* events, VmbUint32_t count, VmbUint64_t handledNs)
+{
+    mtx_lock(&benchmark->mutex);
+    for (VmbUint32_t i = 0; i < count; i++)
+    {
+        const CameraEvent* const event = &events[i];
+        if (event->eventIndex >= benchmark->typeCount)
+        {
+            continue;
+        }
+
+        BenchmarkEventType* const type = &benchmark->types[event->eventIndex];
+        ++type->received;
+        HistogramAdd(&type->handlingUs, (double)(handledNs - event->arrivalNs) / 1000.0);
+
+        if (event->hasTimestamp && benchmark->referenceValid)
+        {
+            double const eventHostNs = (double)benchmark->referenceHostNs
+                                     + (double)(VmbInt64_t)(event->timestamp - benchmark->referenceTicks) * benchmark->nsPerTick;
+            HistogramAdd(&type->notificationUs, ((double)event->arrivalNs - eventHostNs) / 1000.0);
+        }
+    }
+    mtx_unlock(&benchmark->mutex);
+}
+
+void EventBenchmarkAddFrame(EventBenchmark* benchmark, VmbUint64_t frameId)
+{
+    mtx_lock(&benchmark->mutex);
+    if (benchmark->frames == 0 || frameId < benchmark->firstFrameId)
+    {
+        benchmark->firstFrameId = frameId;
+    }
+    if (benchmark->frames == 0 || frameId > benchmark->lastFrameId)
+    {
+        benchmark->lastFrameId = frameId;
+    }
+    ++benchmark->frames;
+    mtx_unlock(&benchmark->mutex);
+}
+
+void EventBenchmarkRunStub(EventBenchmark* benchmark, EventDispatcher* dispatcher, double frameRateHz, VmbUint32_t durationS)
+{
+    VmbUint64_t const periodNs = (VmbUint64_t)(1e9 / frameRateHz);
+    VmbUint64_t const startNs = GetMonotonicTimeNs();
+    VmbUint64_t const endNs = startNs + (VmbUint64_t)durationS * 1000000000ull;
+
+    VmbUint64_t eventsPerFrame = 0;
+    for (VmbUint32_t i = 0; i < benchmark->typeCount; i++)
+    {
+        eventsPerFrame += (benchmark->types[i].active && benchmark->types[i].perFrame) ? 1 : 0;
+    }
+    // the notifications of a frame are posted together once its last event is due
+    VmbUint64_t const frameDelayNs = STUB_NOTIFICATION_DELAY_NS + ((eventsPerFrame != 0) ? (eventsPerFrame - 1) * STUB_EVENT_SPACING_NS : 0);
+
+    // the simulated camera clock is the host clock
+    EventBenchmarkSetClockReference(benchmark, 0, 0);
+
+    VmbUint64_t frameId = 0;
+    VmbUint64_t maxLagNs = 0;
+    while (startNs + frameId * periodNs < endNs)
+    {
+        // Sleeping per event or per frame cannot keep up with high rates, so the posts are paced against absolute
+        // deadlines: after waking up, every frame that is due is posted, in a burst if the thread fell behind.
+        SleepUntilMonotonicNs(startNs + frameId * periodNs + frameDelayNs);
+        VmbUint64_t const nowNs = GetMonotonicTimeNs();
+
+        for (VmbUint64_t frameNs = startNs + frameId * periodNs;
+             frameNs < endNs && frameNs + frameDelayNs <= nowNs;
+             frameNs = startNs + frameId * periodNs)
+        {
+            VmbUint64_t const lagNs = nowNs - (frameNs + frameDelayNs);
+            maxLagNs = (lagNs > maxLagNs) ? lagNs : maxLagNs;
+
+            VmbUint64_t offsetNs = 0;
+            for (VmbUint32_t i = 0; i < benchmark->typeCount; i++)
+            {
+                if (!benchmark->types[i].active || !benchmark->types[i].perFrame)
+                {
+                    continue;
+                }
+
+                CameraEvent event;
+                event.eventIndex = i;
+                event.hasTimestamp = VmbBoolTrue;
+                event.timestamp = frameNs + offsetNs;
+                event.hasFrameId = VmbBoolTrue;
+                event.frameId = frameId;
+                event.arrivalNs = nowNs;
+                EventDispatcherPost(dispatcher, &event);
+
+                offsetNs += STUB_EVENT_SPACING_NS;
+            }
+            EventBenchmarkAddFrame(benchmark, frameId);
+            ++frameId;
+        }
+    }
+
+    double const elapsedS = (double)(GetMonotonicTimeNs() - startNs) / 1e9;
+    double const achievedHz = (elapsedS > 0.0) ? (double)frameId / elapsedS : 0.0;
+    printf("Simulated %llu frames at %.1f Hz (%.1f Hz requested), %.1f events/s posted, posts up to %.1f us late\n",
+           frameId, achievedHz, frameRateHz, achievedHz * (double)eventsPerFrame, (double)maxLagNs / 1000.0);
+}
+
+void EventBenchmarkPrint(EventBenchmark* benchmark, EventDispatcher* dispatcher)
+{
+    mtx_lock(&benchmark->mutex);
+
+    double const durationS = (double)(GetMonotonicTimeNs() - benchmark->startNs) / 1e9;
+    VmbUint64_t const expected = (benchmark->frames != 0) ? benchmark->lastFrameId - benchmark->firstFrameId + 1 : 0;
+
+    printf("\n%llu frames acquired (%llu expected from the frame IDs) in %.2f s\n", benchmark->frames, expected, durationS);
+    printf("%llu events posted, %llu dropped by the full queue, at most %llu events waiting for a handler\n\n",
+           atomic_load(&dispatcher->posted),
+           atomic_load(&dispatcher->dropped),
+           atomic_load(&dispatcher->maxBacklog));
+
+    printf("%-20s %10s %10s %10s %8s | %-28s | %-28s\n", "Event", "Rate [Hz]", "Received", "Expected", "Lost [%]",
+           "Notification p50/p99/max us", "Handling p50/p99/max us");
+    for (VmbUint32_t i = 0; i < benchmark->typeCount; i++)
+    {
+        const BenchmarkEventType* const type = &benchmark->types[i];
+        if (!type->active)
+        {
+            continue;
+        }
+
+        printf("%-20s %10.1f %10llu ", type->name, (durationS > 0.0) ? (double)type->received / durationS : 0.0, type->received);
+        if (type->perFrame && expected != 0)
+        {
+            VmbUint64_t const lost = (expected > type->received) ? expected - type->received : 0;
+            printf("%10llu %8.2f", expected, 100.0 * (double)lost / (double)expected);
+        }
+        else
+        {
+            printf("%10s %8s", "-", "-");
+        }
+
+        if (type->notificationUs.count != 0)
+        {
+            printf(" | %8.1f %8.1f %10.1f", HistogramPercentile(&type->notificationUs, 50.0),
+                   HistogramPercentile(&type->notificationUs, 99.0), type->notificationUs.max);
+        }
+        else
+        {
+            printf(" | %-28s", "-");
+        }
+        if (type->handlingUs.count != 0)
+        {
+            printf(" | %8.1f %8.1f %10.1f\n", HistogramPercentile(&type->handlingUs, 50.0),
+                   HistogramPercentile(&type->handlingUs, 99.0), type->handlingUs.max);
+        }
+        else
+        {
+            printf(" | -\n");
+        }
+    }
+
+    mtx_unlock(&benchmark->mutex);
+}
+
+void EventBenchmarkDestroy(EventBenchmark* benchmark)
+{
+    mtx_destroy(&benchmark->mutex);
+}
@@ -0,0 +1,111 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef EVENTBENCHMARK_H
+#define EVENTBENCHMARK_H
+
+#include <VmbC/VmbCommonTypes.h>
+
+#include <VmbCExamplesCommon/Histogram.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#include "EventDispatcher.h"
+
+#define BENCHMARK_MAX_EVENT_TYPES   16
+
+/**
+* \brief The counters and latencies of one event type
+*/
+typedef struct BenchmarkEventType
+{
+    const char* name;
+    VmbBool_t   active;             //!< The notifications of the event are enabled
+    VmbBool_t   perFrame;           //!< The camera sends the event once for every frame
+    VmbUint64_t received;
+    Histogram   notificationUs;     //!< Notification callback - event timestamp mapped to the host clock
+    Histogram   handlingUs;         //!< Handler - notification callback
+} BenchmarkEventType;
+
+/**
+* \brief Counts the event notifications and measures their latencies
+*
+* The expected number of events sent once per frame is the number of frames acquired, counted from the range of
+* the frame IDs received, so frames lost by the stream are still expected to cause events.
+*
+* The notification latency needs the camera timestamps on the host clock. The camera time is latched regularly
+* and the timestamps are converted relative to the latest latched value using the nominal tick frequency.
+*/
+typedef struct EventBenchmark
+{
+    mtx_t               mutex;
+    BenchmarkEventType  types[BENCHMARK_MAX_EVENT_TYPES];
+    VmbUint32_t         typeCount;
+
+    double              nsPerTick;
+    VmbBool_t           referenceValid;
+    VmbUint64_t         referenceTicks;     //!< Latched camera time
+    VmbUint64_t         referenceHostNs;    //!< Host time the camera time was latched at
+
+    VmbUint64_t         frames;
+    VmbUint64_t         firstFrameId;
+    VmbUint64_t         lastFrameId;
+    VmbUint64_t         startNs;
+} EventBenchmark;
+
+/**
+* \brief Initialize the benchmark
+*
+* \param[out] benchmark     The benchmark to initialize
+* \param[in]  typeCount     Number of event types; the types are passed to the other functions by index
+* \param[in]  tickFrequency Frequency of the camera timestamps in Hz; 0 for timestamps in ns
+*
+* \return An error code indicating success or the type of error that occurred.
+*/
+VmbErrorType EventBenchmarkInit(EventBenchmark* benchmark, VmbUint32_t typeCount, VmbUint64_t tickFrequency);
+
+/**
+* \brief Enable the counting of an event type
+*/
+void EventBenchmarkAddType(EventBenchmark* benchmark, VmbUint32_t typeIndex, const char* name, VmbBool_t perFrame);
+
+/**
+* \brief Set the latest latched camera time used for converting the event timestamps
+*/
+void EventBenchmarkSetClockReference(EventBenchmark* benchmark, VmbUint64_t ticks, VmbUint64_t hostNs);
+
+/**
+* \brief Count a batch of events; the event index is the type index
+*/
+void EventBenchmarkAddEvents(EventBenchmark* benchmark, const CameraEvent* events, VmbUint32_t count, VmbUint64_t handledNs);
+
+/**
+* \brief Count an acquired frame
+*/
+void EventBenchmarkAddFrame(EventBenchmark* benchmark, VmbUint64_t frameId);
+
+/**
+* \brief Simulate a camera sending the events of the active per frame types at the given frame rate
+*
+* The events are posted to the dispatcher from the calling thread with a fixed simulated transport delay, so the
+* dispatcher and the handler are measured as they would be with a camera. The posts are paced against absolute
+* deadlines; frames that are due when the thread wakes up are posted in a burst, so the sleep granularity of the
+* host does not lower the simulated rate. The rate actually achieved and the worst lateness of the posts are
+* printed. The simulated camera clock counts nanoseconds in the time base of GetMonotonicTimeNs.
+*
+* \param[in] benchmark      The benchmark counting the simulated frames
+* \param[in] dispatcher     The started dispatcher the events are posted to
+* \param[in] frameRateHz    Number of simulated frames per second
+* \param[in] durationS      Duration of the simulation
+*/
+void EventBenchmarkRunStub(EventBenchmark* benchmark, EventDispatcher* dispatcher, double frameRateHz, VmbUint32_t durationS);
+
+/**
+* \brief Print the counts, losses and latencies of the active event types
+*/
+void EventBenchmarkPrint(EventBenchmark* benchmark, EventDispatcher* dispatcher);
+
+void EventBenchmarkDestroy(EventBenchmark* benchmark);
+
+#endif // EVENTBENCHMARK_H
@@ -0,0 +1,367 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <string.h>
+
+#include "EventCorrelator.h"
+
+#define HISTOGRAM_BUCKETS           16
+#define DELIVERY_HISTOGRAM_MAX_US   20000.0
+
+VmbErrorType EventCorrelatorInit(EventCorrelator* correlator, const char* const* typeNames, VmbUint32_t typeCount,
+                                 VmbUint64_t tickFrequency, VmbUint32_t windowUs, VmbUint32_t timeoutMs, const char* csvPath)
+{
+    if (typeCount == 0 || typeCount > CORRELATOR_MAX_EVENT_TYPES || windowUs == 0)
+    {
+        return VmbErrorBadParameter;
+    }
+
+    memset(correlator, 0, sizeof(EventCorrelator));
+    correlator->typeCount = typeCount;
+    correlator->nsPerTick = (tickFrequency != 0) ? 1e9 / (double)tickFrequency : 1.0;
+    correlator->windowTicks = (VmbUint64_t)(windowUs * 1000.0 / correlator->nsPerTick);
+    correlator->timeoutNs = (VmbUint64_t)timeoutMs * 1000000ull;
+    ClockDriftEstimatorInit(&correlator->eventClock, tickFrequency);
+
+    for (VmbUint32_t i = 0; i < typeCount; i++)
+    {
+        CorrelatorEventType* const type = &correlator->types[i];
+        type->name = typeNames[i];
+        HistogramInit(&type->toFrameUs, -(double)windowUs, (double)windowUs, HISTOGRAM_BUCKETS);
+        HistogramInit(&type->toDeliveryUs, 0.0, DELIVERY_HISTOGRAM_MAX_US, HISTOGRAM_BUCKETS);
+    }
+
+    if (csvPath != NULL)
+    {
+        correlator->csvFile = fopen(csvPath, "w");
+        if (correlator->csvFile == NULL)
+        {
+            printf("Could not open \"%s\" for writing\n", csvPath);
+            return VmbErrorBadParameter;
+        }
+
+        fprintf(correlator->csvFile, "frame_id,frame_timestamp,received_ns");
+        for (VmbUint32_t i = 0; i < typeCount; i++)
+        {
+            fprintf(correlator->csvFile, ",%s_timestamp,%s_to_frame_us,%s_to_delivery_us", typeNames[i], typeNames[i], typeNames[i]);
+        }
+        fprintf(correlator->csvFile, "\n");
+    }
+
+    if (mtx_init(&correlator->mutex, mtx_plain) != thrd_success)
+    {
+        if (correlator->csvFile != NULL)
+        {
+            fclose(correlator->csvFile);
+        }
+        return VmbErrorResources;
+    }
+    return VmbErrorSuccess;
+}
+
+/**
+* \brief Get the event at an offset from the oldest event of the type
+*/
+static CorrelatorEvent* EventAt(CorrelatorEventType* type, VmbUint32_t offset)
+{
+    return &type->history[(type->historyHead + offset) % CORRELATOR_EVENT_HISTORY];
+}
+
+/**
+* \brief Find the event of a type belonging to the frame
+*
+* Slides the cursor of the type to the first event within the window of the frame and looks at the events up to the
+* end of the window only. An event carrying the id of the frame is preferred; events carrying the id of another
+* frame are skipped. Otherwise the event without a frame id closest to the frame timestamp is used.
+*
+* \return NULL, if no event of the type belongs to the frame
+*/
+static const CorrelatorEvent* FindFrameEvent(const EventCorrelator* correlator, CorrelatorEventType* type, const CorrelatorFrame* frame)
+{
+    VmbUint64_t const windowStart = (frame->timestamp > correlator->windowTicks) ? frame->timestamp - correlator->windowTicks : 0;
+    VmbUint64_t const windowEnd = frame->timestamp + correlator->windowTicks;
+
+    // The cursor only moves back, if the frame is older than the previous one, e.g. after a reset of the camera clock
+    while (type->cursor > 0 && EventAt(type, type->cursor - 1)->timestamp >= windowStart)
+    {
+        --type->cursor;
+    }
+    while (type->cursor < type->historyCount && EventAt(type, type->cursor)->timestamp < windowStart)
+    {
+        ++type->cursor;
+    }
+
+    const CorrelatorEvent* closest = NULL;
+    VmbUint64_t closestDistance = correlator->windowTicks + 1;
+    for (VmbUint32_t i = type->cursor; i < type->historyCount; i++)
+    {
+        const CorrelatorEvent* const event = EventAt(type, i);
+        if (event->timestamp > windowEnd)
+        {
+            break;
+        }
+        if (event->hasFrameId)
+        {
+            if (event->frameId == frame->frameId)
+            {
+                return event;
+            }
+            continue;
+        }
+
+        VmbUint64_t const distance = (event->timestamp > frame->timestamp) ? event->timestamp - frame->timestamp : frame->timestamp - event->timestamp;
+        if (distance < closestDistance)
+        {
+            closest = event;
+            closestDistance = distance;
+        }
+    }
+    return closest;
+}
+
+/**
+* \brief Join the oldest waiting frame with its events and remove it
+*/
+static void CorrelateOldestFrame(EventCorrelator* correlator)
+{
+    const CorrelatorFrame frame = correlator->pending[correlator->pendingHead];
+    correlator->pendingHead = (correlator->pendingHead + 1) % CORRELATOR_MAX_PENDING_FRAMES;
+    --correlator->pendingCount;
+    ++correlator->framesCorrelated;
+
+    if (correlator->csvFile != NULL)
+    {
+        fprintf(correlator->csvFile, "%llu,%llu,%llu", frame.frameId, frame.timestamp, frame.receivedNs);
+    }
+
+    for (VmbUint32_t i = 0; i < correlator->typeCount; i++)
+    {
+        CorrelatorEventType* const type = &correlator->types[i];
+        const CorrelatorEvent* const event = FindFrameEvent(correlator, type, &frame);
+        if (event == NULL)
+        {
+            if (correlator->csvFile != NULL)
+            {
+                fprintf(correlator->csvFile, ",,,");
+            }
+            continue;
+        }
+
+        double const toFrameUs = (double)(VmbInt64_t)(frame.timestamp - event->timestamp) * correlator->nsPerTick / 1000.0;
+        HistogramAdd(&type->toFrameUs, toFrameUs);
+        ++type->matchedFrames;
+
+        VmbUint64_t eventHostNs = 0;
+        VmbBool_t const mapped = ClockDriftEstimatorToHostNs(&correlator->eventClock, event->timestamp, &eventHostNs);
+        double const toDeliveryUs = (double)(VmbInt64_t)(frame.receivedNs - eventHostNs) / 1000.0;
+        if (mapped)
+        {
+            HistogramAdd(&type->toDeliveryUs, toDeliveryUs);
+        }
+
+        if (correlator->csvFile != NULL)
+        {
+            fprintf(correlator->csvFile, ",%llu,%.3f,", event->timestamp, toFrameUs);
+            if (mapped)
+            {
+                fprintf(correlator->csvFile, "%.3f", toDeliveryUs);
+            }
+        }
+    }
+
+    if (correlator->csvFile != NULL)
+    {
+        fprintf(correlator->csvFile, "\n");
+    }
+}
+
+/**
+* \brief Correlate the waiting frames whose events all arrived or which waited for longer than the timeout
+*/
+static void CorrelateCompleteFrames(EventCorrelator* correlator, VmbUint64_t nowNs)
+{
+    while (correlator->pendingCount != 0)
+    {
+        const CorrelatorFrame* const frame = &correlator->pending[correlator->pendingHead];
+        VmbUint64_t const windowEnd = frame->timestamp + correlator->windowTicks;
+
+        // The window of the frame is closed once every active event type passed its end. Types without an event
+        // within the timeout, e.g. AcquisitionStart, are not waited for.
+        VmbBool_t complete = VmbBoolTrue;
+        for (VmbUint32_t i = 0; i < correlator->typeCount && complete; i++)
+        {
+            const CorrelatorEventType* const type = &correlator->types[i];
+            complete = !type->seen
+                || type->latestTimestamp > windowEnd
+                || type->latestArrivalNs + correlator->timeoutNs < nowNs;
+        }
+
+        if (!complete)
+        {
+            if (nowNs < frame->receivedNs + correlator->timeoutNs)
+            {
+                return;
+            }
+            ++correlator->framesTimedOut;
+        }
+        CorrelateOldestFrame(correlator);
+    }
+}
+
+/**
+* \brief Insert an event into the history of its type keeping the history ordered by timestamp
+*
+* The events are mostly added in the order of their timestamps, so the position is searched from the newest event.
+* If the history is full, the oldest event is dropped.
+*/
+static void InsertEvent(CorrelatorEventType* type, const CorrelatorEvent* event)
+{
+    VmbUint32_t position = type->historyCount;
+    while (position > 0 && EventAt(type, position - 1)->timestamp > event->timestamp)
+    {
+        --position;
+    }
+
+    if (type->historyCount == CORRELATOR_EVENT_HISTORY)
+    {
+        if (position == 0)
+        {
+            // older than every event kept
+            return;
+        }
+        type->historyHead = (type->historyHead + 1) % CORRELATOR_EVENT_HISTORY;
+        --type->historyCount;
+        --position;
+        if (type->cursor > 0)
+        {
+            --type->cursor;
+        }
+    }
+
+    for (VmbUint32_t i = type->historyCount; i > position; i--)
+    {
+        *EventAt(type, i) = *EventAt(type, i - 1);
+    }
+    *EventAt(type, position) = *event;
+    ++type->historyCount;
+
+    if (position < type->cursor)
+    {
+        ++type->cursor;
+    }
+}
+
+void EventCorrelatorAddEvent(EventCorrelator* correlator, VmbUint32_t typeIndex, VmbUint64_t timestamp,
+                             VmbBool_t hasFrameId, VmbUint64_t frameId, VmbUint64_t arrivalNs)
+{
+    if (typeIndex >= correlator->typeCount)
+    {
+        return;
+    }
+
+    mtx_lock(&correlator->mutex);
+
+    CorrelatorEventType* const type = &correlator->types[typeIndex];
+    CorrelatorEvent event;
+    event.timestamp = timestamp;
+    event.hasFrameId = hasFrameId;
+    event.frameId = hasFrameId ? frameId : 0;
+    event.arrivalNs = arrivalNs;
+    InsertEvent(type, &event);
+    type->latestTimestamp = (!type->seen || timestamp > type->latestTimestamp) ? timestamp : type->latestTimestamp;
+    type->latestArrivalNs = (arrivalNs > type->latestArrivalNs) ? arrivalNs : type->latestArrivalNs;
+    type->seen = VmbBoolTrue;
+
+    CorrelateCompleteFrames(correlator, arrivalNs);
+    mtx_unlock(&correlator->mutex);
+}
+
+void EventCorrelatorAddClockSample(EventCorrelator* correlator, VmbUint64_t ticks, VmbUint64_t hostNs)
+{
+    mtx_lock(&correlator->mutex);
+
+    // The estimator treats older timestamps as a reset of the camera clock; a late sample is simply skipped.
+    if (ticks > correlator->latestClockSample)
+    {
+        ClockDriftEstimatorAddSample(&correlator->eventClock, ticks, hostNs);
+        correlator->latestClockSample = ticks;
+    }
+
+    mtx_unlock(&correlator->mutex);
+}
+
+void EventCorrelatorAddFrame(EventCorrelator* correlator, VmbUint64_t frameId, VmbUint64_t timestamp, VmbUint64_t receivedNs)
+{
+    mtx_lock(&correlator->mutex);
+
+    if (correlator->pendingCount == CORRELATOR_MAX_PENDING_FRAMES)
+    {
+        // bound the memory; the events of the oldest frame are overdue anyway
+        ++correlator->framesDropped;
+        correlator->pendingHead = (correlator->pendingHead + 1) % CORRELATOR_MAX_PENDING_FRAMES;
+        --correlator->pendingCount;
+    }
+
+    CorrelatorFrame* const frame = &correlator->pending[(correlator->pendingHead + correlator->pendingCount) % CORRELATOR_MAX_PENDING_FRAMES];
+    frame->frameId = frameId;
+    frame->timestamp = timestamp;
+    frame->receivedNs = receivedNs;
+    ++correlator->pendingCount;
+
+    CorrelateCompleteFrames(correlator, receivedNs);
+    mtx_unlock(&correlator->mutex);
+}
+
+void EventCorrelatorFlush(EventCorrelator* correlator)
+{
+    mtx_lock(&correlator->mutex);
+    while (correlator->pendingCount != 0)
+    {
+        CorrelateOldestFrame(correlator);
+    }
+    if (correlator->csvFile != NULL)
+    {
+        fflush(correlator->csvFile);
+    }
+    mtx_unlock(&correlator->mutex);
+}
+
+void EventCorrelatorPrint(EventCorrelator* correlator)
+{
+    mtx_lock(&correlator->mutex);
+
+    printf("\n%llu frames correlated (%llu after the timeout), %llu dropped\n",
+           correlator->framesCorrelated, correlator->framesTimedOut, correlator->framesDropped);
+
+    for (VmbUint32_t i = 0; i < correlator->typeCount; i++)
+    {
+        const CorrelatorEventType* const type = &correlator->types[i];
+        if (type->matchedFrames == 0)
+        {
+            continue;
+        }
+
+        printf("\n%s: matched to %llu frames\n", type->name, type->matchedFrames);
+        printf("Frame timestamp - event timestamp:\n");
+        HistogramPrint(&type->toFrameUs, "us");
+        if (type->toDeliveryUs.count != 0)
+        {
+            printf("Frame delivery - event:\n");
+            HistogramPrint(&type->toDeliveryUs, "us");
+        }
+    }
+
+    mtx_unlock(&correlator->mutex);
+}
+
+void EventCorrelatorDestroy(EventCorrelator* correlator)
+{
+    if (correlator->csvFile != NULL)
+    {
+        fclose(correlator->csvFile);
+        correlator->csvFile = NULL;
+    }
+    mtx_destroy(&correlator->mutex);
+}
@@ -0,0 +1,162 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef EVENTCORRELATOR_H
+#define EVENTCORRELATOR_H
+
+#include <stdio.h>
+
+#include <VmbC/VmbCommonTypes.h>
+
+#include <VmbCExamplesCommon/ClockDriftEstimator.h>
+#include <VmbCExamplesCommon/Histogram.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#define CORRELATOR_MAX_EVENT_TYPES      16
+#define CORRELATOR_EVENT_HISTORY        256     //!< Number of most recent events kept per event type
+#define CORRELATOR_MAX_PENDING_FRAMES   64      //!< Number of frames waiting for their events
+
+/**
+* \brief An event kept for matching it to the frames
+*/
+typedef struct CorrelatorEvent
+{
+    VmbUint64_t timestamp;      //!< Camera timestamp of the event
+    VmbBool_t   hasFrameId;     //!< True, if the event carries the id of the frame it belongs to
+    VmbUint64_t frameId;
+    VmbUint64_t arrivalNs;      //!< Time the notification arrived at in the time base of GetMonotonicTimeNs
+} CorrelatorEvent;
+
+/**
+* \brief The recent events and the latency statistics of one event type
+*/
+typedef struct CorrelatorEventType
+{
+    const char*     name;
+    CorrelatorEvent history[CORRELATOR_EVENT_HISTORY];     //!< Ring buffer ordered by the event timestamps
+    VmbUint32_t     historyHead;                            //!< Index of the oldest event
+    VmbUint32_t     historyCount;
+    VmbUint32_t     cursor;         //!< Offset from historyHead of the first event not older than the window of the last correlated frame
+    VmbBool_t       seen;
+    VmbUint64_t     latestTimestamp;
+    VmbUint64_t     latestArrivalNs;
+
+    VmbUint64_t     matchedFrames;
+    Histogram       toFrameUs;      //!< Frame timestamp - event timestamp on the camera clock
+    Histogram       toDeliveryUs;   //!< Frame callback - event on the host clock
+} CorrelatorEventType;
+
+/**
+* \brief A received frame waiting for the events belonging to it
+*/
+typedef struct CorrelatorFrame
+{
+    VmbUint64_t frameId;
+    VmbUint64_t timestamp;
+    VmbUint64_t receivedNs;
+} CorrelatorFrame;
+
+/**
+* \brief Joins camera events and frames on the camera clock
+*
+* Events and frames are passed in as they arrive. Since the events of a type arrive in the order of their
+* timestamps, the oldest waiting frame is complete as soon as every event type occurring within the timeout delivered
+* an event with a timestamp after the end of the frame's matching window, or the frame waited for longer than the
+* timeout (e.g. because an event was lost). The frame is then joined with the event of every type within the window
+* carrying the id of the frame. Events without a frame id are joined by the timestamp closest to the frame timestamp.
+*
+* The events of every type are kept ordered by their timestamps. Since the frames are correlated in the order of their
+* timestamps, a cursor per type slides over the events and only the events within the window of a frame are looked at.
+*
+* The host time of an event is estimated by mapping its timestamp to the host clock with a ClockDriftEstimator fed
+* with camera times latched via EventCorrelatorAddClockSample. Fitting the estimator to the notification arrivals
+* instead would build the notification latency into the offset and hide it from the delivery latency. Without clock
+* samples, only the latencies on the camera clock are reported.
+*
+* All functions may be called from multiple threads.
+*/
+typedef struct EventCorrelator
+{
+    mtx_t               mutex;
+
+    CorrelatorEventType types[CORRELATOR_MAX_EVENT_TYPES];
+    VmbUint32_t         typeCount;
+
+    CorrelatorFrame     pending[CORRELATOR_MAX_PENDING_FRAMES];    //!< Ring buffer of the waiting frames
+    VmbUint32_t         pendingHead;
+    VmbUint32_t         pendingCount;
+
+    double              nsPerTick;
+    VmbUint64_t         windowTicks;
+    VmbUint64_t         timeoutNs;
+    ClockDriftEstimator eventClock;     //!< Maps event timestamps to the host clock; fitted to the latched camera times
+    VmbUint64_t         latestClockSample;  //!< Camera time of the latest clock sample
+
+    FILE*               csvFile;        //!< NULL, if no CSV is written
+
+    VmbUint64_t         framesCorrelated;
+    VmbUint64_t         framesDropped;  //!< Frames not correlated, because too many frames were waiting
+    VmbUint64_t         framesTimedOut; //!< Frames correlated after the timeout instead of after all events arrived
+} EventCorrelator;
+
+/**
+* \brief Initialize the correlator
+*
+* \param[out] correlator        The correlator to initialize
+* \param[in]  typeNames         Names of the event types; the event types are passed to EventCorrelatorAddEvent by index
+* \param[in]  typeCount         Number of event types; at most CORRELATOR_MAX_EVENT_TYPES
+* \param[in]  tickFrequency     Frequency of the camera timestamps in Hz; 0 for timestamps in ns
+* \param[in]  windowUs          Maximum difference between the timestamps of a frame and its events
+* \param[in]  timeoutMs         Maximum time a frame waits for its events
+* \param[in]  csvPath           File a line per frame is written to; NULL for no CSV
+*
+* \return An error code indicating success or the type of error that occurred.
+*/
+VmbErrorType EventCorrelatorInit(EventCorrelator* correlator, const char* const* typeNames, VmbUint32_t typeCount,
+                                 VmbUint64_t tickFrequency, VmbUint32_t windowUs, VmbUint32_t timeoutMs, const char* csvPath);
+
+/**
+* \brief Add an event of the given type
+*
+* \param[in] correlator    The correlator
+* \param[in] typeIndex     Index of the event type
+* \param[in] timestamp     Camera timestamp of the event
+* \param[in] hasFrameId    True, if the event carries the id of the frame it belongs to
+* \param[in] frameId       The frame id of the event; ignored if hasFrameId is false
+* \param[in] arrivalNs     Time the notification arrived at in the time base of GetMonotonicTimeNs
+*/
+void EventCorrelatorAddEvent(EventCorrelator* correlator, VmbUint32_t typeIndex, VmbUint64_t timestamp,
+                             VmbBool_t hasFrameId, VmbUint64_t frameId, VmbUint64_t arrivalNs);
+
+/**
+* \brief Add a camera time latched together with the host time, e.g. via LatchCameraTime
+*
+* \param[in] correlator    The correlator
+* \param[in] ticks         The latched camera time
+* \param[in] hostNs        The host time the camera time was latched at in the time base of GetMonotonicTimeNs
+*/
+void EventCorrelatorAddClockSample(EventCorrelator* correlator, VmbUint64_t ticks, VmbUint64_t hostNs);
+
+/**
+* \brief Add a received frame
+*/
+void EventCorrelatorAddFrame(EventCorrelator* correlator, VmbUint64_t frameId, VmbUint64_t timestamp, VmbUint64_t receivedNs);
+
+/**
+* \brief Correlate all waiting frames, e.g. after the acquisition was stopped
+*/
+void EventCorrelatorFlush(EventCorrelator* correlator);
+
+/**
+* \brief Print the latency histograms of all event types
+*/
+void EventCorrelatorPrint(EventCorrelator* correlator);
+
+/**
+* \brief Close the CSV file and free the resources of the correlator
+*/
+void EventCorrelatorDestroy(EventCorrelator* correlator);
+
+#endif // EVENTCORRELATOR_H
@@ -0,0 +1,231 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <string.h>
+#include <time.h>
+
+#include "EventDispatcher.h"
+
+#define EVENT_QUEUE_MASK        (EVENT_QUEUE_SIZE - 1)
+#define HANDLER_WAIT_TIMEOUT_NS 10000000L   // idle handlers check for events at least this often
+
+/**
+ * \brief Remove up to maxCount events from the queue without blocking
+ *
+ * \return the number of events removed
+ */
+static VmbUint32_t DequeueBatch(EventDispatcher* dispatcher, CameraEvent* events, VmbUint32_t maxCount)
+{
+    VmbUint32_t count = 0;
+    while (count < maxCount)
+    {
+        unsigned long long position = atomic_load(&dispatcher->dequeuePosition);
+        EventQueueCell* cell = NULL;
+        for (;;)
+        {
+            cell = &dispatcher->cells[position & EVENT_QUEUE_MASK];
+            long long const difference = (long long)(atomic_load(&cell->sequence) - (position + 1));
+            if (difference == 0)
+            {
+                // the cell is filled; claim it
+                if (atomic_compare_exchange_strong(&dispatcher->dequeuePosition, &position, position + 1))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // the queue is empty
+                return count;
+            }
+            else
+            {
+                // another handler claimed the cell
+                position = atomic_load(&dispatcher->dequeuePosition);
+            }
+        }
+
+        events[count++] = cell->event;
+
+        // free the cell for the producer of the next round
+        atomic_store(&cell->sequence, position + EVENT_QUEUE_SIZE);
+    }
+    return count;
+}
+
+/**
+ * \brief Wait until an event was posted, the timeout elapsed or the dispatcher is stopped
+ *
+ * \return false, if the dispatcher is stopped
+ */
+static VmbBool_t WaitForEvents(EventDispatcher* dispatcher)
+{
+    struct timespec deadline;
+    timespec_get(&deadline, TIME_UTC);
+    deadline.tv_nsec += HANDLER_WAIT_TIMEOUT_NS;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_nsec -= 1000000000L;
+        ++deadline.tv_sec;
+    }
+
+    mtx_lock(&dispatcher->mutex);
+    atomic_fetch_add(&dispatcher->waitingHandlers, 1);
+
+    // an event posted before the handler was registered as waiting would not signal the condition
+    unsigned long long const position = atomic_load(&dispatcher->dequeuePosition);
+    VmbBool_t const empty = (atomic_load(&dispatcher->cells[position & EVENT_QUEUE_MASK].sequence) != position + 1);
+    if (empty && !dispatcher->stop)
+    {
+        cnd_timedwait(&dispatcher->condition, &dispatcher->mutex, &deadline);
+    }
+
+    atomic_fetch_add(&dispatcher->waitingHandlers, (unsigned long long)-1);
+    VmbBool_t const running = !dispatcher->stop;
+    mtx_unlock(&dispatcher->mutex);
+    return running;
+}
+
+/**
+ * \brief Handler thread passing the events to the handler in batches
+ */
+static int HandlerThread(void* arg)
+{
+    EventDispatcher* const dispatcher = (EventDispatcher*)arg;
+    CameraEvent events[EVENT_BATCH_SIZE];
+
+    for (;;)
+    {
+        VmbUint32_t const count = DequeueBatch(dispatcher, events, EVENT_BATCH_SIZE);
+        if (count != 0)
+        {
+            dispatcher->handler(events, count, dispatcher->context);
+            atomic_fetch_add(&dispatcher->handled, count);
+        }
+        else if (!WaitForEvents(dispatcher))
+        {
+            // handle the events posted before stopping
+            VmbUint32_t remaining = 0;
+            while ((remaining = DequeueBatch(dispatcher, events, EVENT_BATCH_SIZE)) != 0)
+            {
+                dispatcher->handler(events, remaining, dispatcher->context);
+                atomic_fetch_add(&dispatcher->handled, remaining);
+            }
+            return 0;
+        }
+    }
+}
+
+VmbErrorType EventDispatcherStart(EventDispatcher* dispatcher, VmbUint32_t threadCount, EventBatchHandler handler, void* context)
+{
+    if (threadCount == 0 || threadCount > EVENT_MAX_HANDLER_THREADS || handler == NULL)
+    {
+        return VmbErrorBadParameter;
+    }
+
+    memset(dispatcher, 0, sizeof(EventDispatcher));
+    for (unsigned long long i = 0; i < EVENT_QUEUE_SIZE; i++)
+    {
+        atomic_store(&dispatcher->cells[i].sequence, i);
+    }
+    atomic_store(&dispatcher->enqueuePosition, 0);
+    atomic_store(&dispatcher->dequeuePosition, 0);
+    atomic_store(&dispatcher->posted, 0);
+    atomic_store(&dispatcher->dropped, 0);
+    atomic_store(&dispatcher->handled, 0);
+    atomic_store(&dispatcher->maxBacklog, 0);
+    atomic_store(&dispatcher->waitingHandlers, 0);
+    dispatcher->handler = handler;
+    dispatcher->context = context;
+
+    if (mtx_init(&dispatcher->mutex, mtx_plain) != thrd_success)
+    {
+        return VmbErrorResources;
+    }
+    if (cnd_init(&dispatcher->condition) != thrd_success)
+    {
+        mtx_destroy(&dispatcher->mutex);
+        return VmbErrorResources;
+    }
+
+    while (dispatcher->threadCount < threadCount
+           && thrd_create(&dispatcher->threads[dispatcher->threadCount], HandlerThread, dispatcher) == thrd_success)
+    {
+        ++dispatcher->threadCount;
+    }
+    if (dispatcher->threadCount != threadCount)
+    {
+        EventDispatcherStop(dispatcher);
+        return VmbErrorResources;
+    }
+    return VmbErrorSuccess;
+}
+
+VmbBool_t EventDispatcherPost(EventDispatcher* dispatcher, const CameraEvent* event)
+{
+    unsigned long long position = atomic_load(&dispatcher->enqueuePosition);
+    EventQueueCell* cell = NULL;
+    for (;;)
+    {
+        cell = &dispatcher->cells[position & EVENT_QUEUE_MASK];
+        long long const difference = (long long)(atomic_load(&cell->sequence) - position);
+        if (difference == 0)
+        {
+            // the cell is free; claim it
+            if (atomic_compare_exchange_strong(&dispatcher->enqueuePosition, &position, position + 1))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // the queue is full
+            atomic_fetch_add(&dispatcher->dropped, 1);
+            return VmbBoolFalse;
+        }
+        else
+        {
+            // another producer claimed the cell
+            position = atomic_load(&dispatcher->enqueuePosition);
+        }
+    }
+
+    cell->event = *event;
+    atomic_store(&cell->sequence, position + 1);
+    atomic_fetch_add(&dispatcher->posted, 1);
+
+    // the backlog is only an estimate, since the handlers continue concurrently
+    unsigned long long const dequeued = atomic_load(&dispatcher->dequeuePosition);
+    unsigned long long const backlog = (position + 1 > dequeued) ? position + 1 - dequeued : 0;
+    unsigned long long maxBacklog = atomic_load(&dispatcher->maxBacklog);
+    while (backlog > maxBacklog && !atomic_compare_exchange_strong(&dispatcher->maxBacklog, &maxBacklog, backlog))
+    {
+    }
+
+    if (atomic_load(&dispatcher->waitingHandlers) != 0)
+    {
+        mtx_lock(&dispatcher->mutex);
+        cnd_signal(&dispatcher->condition);
+        mtx_unlock(&dispatcher->mutex);
+    }
+    return VmbBoolTrue;
+}
+
+void EventDispatcherStop(EventDispatcher* dispatcher)
+{
+    mtx_lock(&dispatcher->mutex);
+    dispatcher->stop = VmbBoolTrue;
+    cnd_broadcast(&dispatcher->condition);
+    mtx_unlock(&dispatcher->mutex);
+
+    for (VmbUint32_t i = 0; i < dispatcher->threadCount; i++)
+    {
+        thrd_join(dispatcher->threads[i], NULL);
+    }
+    dispatcher->threadCount = 0;
+
+    cnd_destroy(&dispatcher->condition);
+    mtx_destroy(&dispatcher->mutex);
+}
@@ -0,0 +1,104 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef EVENTDISPATCHER_H
+#define EVENTDISPATCHER_H
+
+#include <VmbC/VmbCommonTypes.h>
+
+#include <VmbCExamplesCommon/VmbStdatomic.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#define EVENT_QUEUE_SIZE            1024    //!< Number of events the queue can hold; a power of 2
+#define EVENT_BATCH_SIZE            32      //!< Maximum number of events passed to the handler at once
+#define EVENT_MAX_HANDLER_THREADS   8
+
+/**
+ * \brief A camera event as recorded by the notification callback
+ */
+typedef struct CameraEvent
+{
+    VmbUint32_t     eventIndex;         //!< Index of the event in the table of registered events
+    VmbBool_t       hasTimestamp;
+    VmbUint64_t     timestamp;          //!< Value of the Event<Name>Timestamp feature in camera ticks
+    VmbBool_t       hasFrameId;
+    VmbUint64_t     frameId;            //!< Value of the Event<Name>FrameID feature, if available
+    VmbUint64_t     arrivalNs;          //!< Time the callback was entered at in the time base of GetMonotonicTimeNs
+} CameraEvent;
+
+/**
+ * \brief Function called by the handler threads with a batch of events in the order they were posted
+ */
+typedef void (*EventBatchHandler)(const CameraEvent* events, VmbUint32_t count, void* context);
+
+/**
+ * \brief A cell of the event queue; the sequence tells producers and consumers whether the cell is free or filled
+ */
+typedef struct EventQueueCell
+{
+    atomic_ullong   sequence;
+    CameraEvent     event;
+} EventQueueCell;
+
+/**
+ * \brief Passes the events from the notification callbacks to handler threads
+ *
+ * The events are stored in a bounded lock-free queue (D. Vyukov's bounded MPMC queue), so posting an event never
+ * blocks the notification thread of the API. If the handlers fall behind and the queue is full, the event is dropped
+ * and counted instead. Idle handler threads wait on a condition variable, which the producers only signal if a
+ * handler is actually waiting.
+ */
+typedef struct EventDispatcher
+{
+    EventQueueCell      cells[EVENT_QUEUE_SIZE];
+
+    // producer and consumer positions are kept on different cache lines
+    char                padding0[64];
+    atomic_ullong       enqueuePosition;
+    char                padding1[64];
+    atomic_ullong       dequeuePosition;
+    char                padding2[64];
+
+    atomic_ullong       posted;
+    atomic_ullong       dropped;
+    atomic_ullong       handled;
+    atomic_ullong       maxBacklog;             //!< Maximum number of events waiting in the queue
+    atomic_ullong       waitingHandlers;
+
+    mtx_t               mutex;                  // only used for waiting for events
+    cnd_t               condition;
+    VmbBool_t           stop;                   // protected by mutex
+
+    EventBatchHandler   handler;
+    void*               context;
+    thrd_t              threads[EVENT_MAX_HANDLER_THREADS];
+    VmbUint32_t         threadCount;
+} EventDispatcher;
+
+/**
+ * \brief Initialize the queue and start the handler threads
+ *
+ * \param[out] dispatcher   The dispatcher to start
+ * \param[in]  threadCount  Number of handler threads; at most EVENT_MAX_HANDLER_THREADS
+ * \param[in]  handler      The function called with the events
+ * \param[in]  context      Passed to the handler
+ *
+ * \return An error code indicating success or the type of error that occurred.
+ */
+VmbErrorType EventDispatcherStart(EventDispatcher* dispatcher, VmbUint32_t threadCount, EventBatchHandler handler, void* context);
+
+/**
+ * \brief Add an event to the queue without blocking; may be called by multiple threads concurrently
+ *
+ * \return false, if the queue was full and the event was dropped
+ */
+VmbBool_t EventDispatcherPost(EventDispatcher* dispatcher, const CameraEvent* event);
+
+/**
+ * \brief Pass the remaining events to the handler and stop the handler threads
+ */
+void EventDispatcherStop(EventDispatcher* dispatcher);
+
+#endif // EVENTDISPATCHER_H
@@ -5,26 +5,475 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "EventHandling.h"
+#include "EventBenchmark.h"
+#include "EventCorrelator.h"
+#include "EventDispatcher.h"
 
 #include <VmbC/VmbC.h>
+#include <VmbCExamplesCommon/CameraClock.h>
 #include <VmbCExamplesCommon/ListCameras.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/TimedStartup.h>
+
+#define EVENT_HANDLER_THREAD_COUNT  2
+#define MAX_FEATURE_NAME_LENGTH     64
+#define FRAME_BUFFER_COUNT          10
+#define CORRELATION_TIMEOUT_MS      1000
+#define CLOCK_LATCH_INTERVAL_NS     500000000ull
+#define CORRELATION_LATCH_INTERVAL_NS 100000000ull // the clock model of the correlator needs several samples
+#define EVENT_LINE_LENGTH           160
+
+/**
+* \brief A camera event the example tries to register for
+*/
+typedef struct RegisteredEvent
+{
+    const char* name;                                       //!< Entry of the EventSelector enumeration
+    VmbBool_t   perFrame;                                   //!< The camera sends the event once for every frame
+    char        notificationFeature[MAX_FEATURE_NAME_LENGTH];   //!< Feature invalidated whenever the event occurs
+    char        timestampFeature[MAX_FEATURE_NAME_LENGTH];
+    char        frameIdFeature[MAX_FEATURE_NAME_LENGTH];
+    VmbBool_t   hasFrameId;
+    VmbBool_t   registered;
+} RegisteredEvent;
+
+/**
+* \brief The events registered if the camera supports them
+*/
+static RegisteredEvent g_events[] =
+{
+    { "AcquisitionStart" },
+    { "AcquisitionEnd" },
+    { "FrameTrigger", VmbBoolTrue },
+    { "FrameTriggerMissed" },
+    { "ExposureStart", VmbBoolTrue },
+    { "ExposureEnd", VmbBoolTrue },
+    { "Line0RisingEdge" },
+    { "Line0FallingEdge" },
+    { "Line1RisingEdge" },
+    { "Line1FallingEdge" },
+    { "Line2RisingEdge" },
+    { "Line2FallingEdge" },
+    { "Line3RisingEdge" },
+    { "Line3FallingEdge" },
+};
+
+#define EVENT_COUNT (sizeof(g_events) / sizeof(g_events[0]))
+
+static EventDispatcher  g_dispatcher;
+static VmbUint64_t      g_startNs = 0;
+
+static VmbFrame_t       g_frames[FRAME_BUFFER_COUNT];
+static EventCorrelator  g_correlator;
+static VmbBool_t        g_correlating = VmbBoolFalse;    // the events are passed to the correlator instead of being printed
+static thrd_t           g_clockThread;                   // feeds the latched camera times to the correlator
+static VmbBool_t        g_clockThreadStarted = VmbBoolFalse;
+static atomic_ullong    g_stopClockThread;
+static EventBenchmark   g_benchmark;
+static VmbBool_t        g_benchmarking = VmbBoolFalse;   // the events are only counted
 
 /**
 * \brief This function will be called when the specified camera feature has changed
+*
+* It only records the event, since any time spent here delays the notifications of all other events.
 */
 void VMB_CALL EventCB(VmbHandle_t handle, const char* name, void* context)
 {
-    // Here an action can be perform based on the event that has occured
-     printf("\nEvent %s has occured.\n", name);
+    const RegisteredEvent* const registeredEvent = (const RegisteredEvent*)context;
+
+    CameraEvent event;
+    event.arrivalNs = GetMonotonicTimeNs();
+    event.eventIndex = (VmbUint32_t)(registeredEvent - g_events);
+
+    VmbInt64_t value = 0;
+    event.hasTimestamp = (VmbFeatureIntGet(handle, registeredEvent->timestampFeature, &value) == VmbErrorSuccess);
+    event.timestamp = (VmbUint64_t)value;
+
+    value = 0;
+    event.hasFrameId = registeredEvent->hasFrameId && (VmbFeatureIntGet(handle, registeredEvent->frameIdFeature, &value) == VmbErrorSuccess);
+    event.frameId = (VmbUint64_t)value;
+
+    EventDispatcherPost(&g_dispatcher, &event);
+}
+
+/**
+* \brief Handler printing the events; runs in the handler threads of the dispatcher
+*
+* Every line is written with a single call, so the lines of both handler threads do not interleave.
+*/
+static void PrintEvents(const CameraEvent* events, VmbUint32_t count, void* context)
+{
+    VmbUint64_t const handledNs = GetMonotonicTimeNs();
+
+    for (VmbUint32_t i = 0; i < count; i++)
+    {
+        const CameraEvent* const event = &events[i];
+        char line[EVENT_LINE_LENGTH];
+        int length = snprintf(line, sizeof(line), "Event %-20s at %10.3f ms (handled %8.1f us later)", g_events[event->eventIndex].name,
+                              (event->arrivalNs - g_startNs) / 1e6,
+                              (handledNs - event->arrivalNs) / 1e3);
+        if (event->hasTimestamp && length < (int)sizeof(line))
+        {
+            length += snprintf(line + length, sizeof(line) - length, ", timestamp %llu", event->timestamp);
+        }
+        if (event->hasFrameId && length < (int)sizeof(line))
+        {
+            length += snprintf(line + length, sizeof(line) - length, ", frame id %llu", event->frameId);
+        }
+        printf("%s\n", line);
+    }
+}
+
+/**
+* \brief Handler passing the events to the correlator; runs in the handler threads of the dispatcher
+*/
+static void CorrelateEvents(const CameraEvent* events, VmbUint32_t count, void* context)
+{
+    for (VmbUint32_t i = 0; i < count; i++)
+    {
+        if (events[i].hasTimestamp)
+        {
+            EventCorrelatorAddEvent(&g_correlator, events[i].eventIndex, events[i].timestamp,
+                                    events[i].hasFrameId, events[i].frameId, events[i].arrivalNs);
+        }
+    }
+}
+
+/**
+* \brief Handler counting the events for the benchmark; runs in the handler threads of the dispatcher
+*/
+static void BenchmarkEvents(const CameraEvent* events, VmbUint32_t count, void* context)
+{
+    EventBenchmarkAddEvents(&g_benchmark, events, count, GetMonotonicTimeNs());
+}
+
+/**
+* \brief Passes every frame to the correlator or the benchmark and queues it again
+*/
+static void VMB_CALL FrameCallback(const VmbHandle_t cameraHandle, const VmbHandle_t streamHandle, VmbFrame_t* frame)
+{
+    VmbUint64_t const receivedNs = GetMonotonicTimeNs();
+    if (g_benchmarking)
+    {
+        // incomplete frames were triggered nevertheless
+        if (frame->receiveFlags & VmbFrameFlagsFrameID)
+        {
+            EventBenchmarkAddFrame(&g_benchmark, frame->frameID);
+        }
+    }
+    else if (frame->receiveStatus == VmbFrameStatusComplete && (frame->receiveFlags & VmbFrameFlagsTimestamp))
+    {
+        EventCorrelatorAddFrame(&g_correlator, frame->frameID, frame->timestamp, receivedNs);
+    }
+    VmbCaptureFrameQueue(cameraHandle, frame, FrameCallback);
+}
+
+/**
+* \brief Announce and queue the frame buffers; the acquisition is started separately
+*/
+static VmbError_t StartCapture(VmbHandle_t cameraHandle)
+{
+    VmbUint32_t payloadSize = 0;
+    VmbError_t err = VmbPayloadSizeGet(cameraHandle, &payloadSize);
+    for (VmbUint32_t i = 0; i < FRAME_BUFFER_COUNT && err == VmbErrorSuccess; i++)
+    {
+        g_frames[i].buffer = malloc((size_t)payloadSize);
+        g_frames[i].bufferSize = payloadSize;
+        err = (g_frames[i].buffer != NULL) ? VmbFrameAnnounce(cameraHandle, &g_frames[i], (VmbUint32_t)sizeof(VmbFrame_t)) : VmbErrorResources;
+    }
+
+    if (err == VmbErrorSuccess)
+    {
+        err = VmbCaptureStart(cameraHandle);
+    }
+    for (VmbUint32_t i = 0; i < FRAME_BUFFER_COUNT && err == VmbErrorSuccess; i++)
+    {
+        err = VmbCaptureFrameQueue(cameraHandle, &g_frames[i], FrameCallback);
+    }
+
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not prepare the frame buffers. Error code: %d\n", err);
+    }
+    return err;
+}
+
+/**
+* \brief Revert the steps of StartCapture after the acquisition was stopped
+*/
+static void StopCapture(VmbHandle_t cameraHandle)
+{
+    VmbCaptureEnd(cameraHandle);
+    VmbCaptureQueueFlush(cameraHandle);
+    while (VmbFrameRevokeAll(cameraHandle) == VmbErrorInUse)
+    {
+    }
+
+    for (VmbUint32_t i = 0; i < FRAME_BUFFER_COUNT; i++)
+    {
+        free(g_frames[i].buffer);
+        g_frames[i].buffer = NULL;
+    }
+}
+
+/**
+* \brief Latch the camera time periodically for mapping the event timestamps to the host clock of the correlator
+*/
+static int CorrelationClockThread(void* arg)
+{
+    VmbHandle_t const cameraHandle = (VmbHandle_t)arg;
+
+    VmbUint64_t nextLatchNs = GetMonotonicTimeNs();
+    while (atomic_load(&g_stopClockThread) == 0)
+    {
+        VmbUint64_t ticks = 0;
+        VmbUint64_t hostNs = 0;
+        if (LatchCameraTime(cameraHandle, &ticks, &hostNs, NULL) != VmbErrorSuccess)
+        {
+            printf("The camera time cannot be latched, the delivery latency of the events is not measured.\n");
+            break;
+        }
+        EventCorrelatorAddClockSample(&g_correlator, ticks, hostNs);
+        nextLatchNs += CORRELATION_LATCH_INTERVAL_NS;
+        SleepUntilMonotonicNs(nextLatchNs);
+    }
+    return 0;
+}
+
+/**
+* \brief Start the correlation of the events with the frames of the camera
+*/
+static VmbError_t StartCorrelation(VmbHandle_t cameraHandle, const EventHandlingOptions* options)
+{
+    const char* eventNames[EVENT_COUNT];
+    for (VmbUint32_t i = 0; i < EVENT_COUNT; i++)
+    {
+        eventNames[i] = g_events[i].name;
+    }
+
+    VmbError_t err = EventCorrelatorInit(&g_correlator, eventNames, EVENT_COUNT, GetTimestampFrequency(cameraHandle),
+                                         options->windowUs, CORRELATION_TIMEOUT_MS, options->csvPath);
+    if (err != VmbErrorSuccess)
+    {
+        return err;
+    }
+
+    err = StartCapture(cameraHandle);
+    if (err != VmbErrorSuccess)
+    {
+        StopCapture(cameraHandle);
+        EventCorrelatorDestroy(&g_correlator);
+        return err;
+    }
+    g_correlating = VmbBoolTrue;
+
+    atomic_store(&g_stopClockThread, 0);
+    g_clockThreadStarted = (thrd_create(&g_clockThread, CorrelationClockThread, cameraHandle) == thrd_success);
+    if (!g_clockThreadStarted)
+    {
+        printf("Could not start latching the camera time, the delivery latency of the events is not measured.\n");
+    }
+    return err;
+}
+
+/**
+* \brief Stop the correlation and print its results
+*/
+static void StopCorrelation(VmbHandle_t cameraHandle)
+{
+    if (g_clockThreadStarted)
+    {
+        atomic_store(&g_stopClockThread, 1);
+        thrd_join(g_clockThread, NULL);
+        g_clockThreadStarted = VmbBoolFalse;
+    }
+
+    StopCapture(cameraHandle);
+    EventCorrelatorFlush(&g_correlator);
+    EventCorrelatorPrint(&g_correlator);
+    EventCorrelatorDestroy(&g_correlator);
+    g_correlating = VmbBoolFalse;
+}
+
+/**
+* \brief Check, if an event is in the comma separated list of events selected by the user
+*/
+static VmbBool_t IsEventSelected(const EventHandlingOptions* options, const char* name)
+{
+    if (options->eventNames == NULL)
+    {
+        return VmbBoolTrue;
+    }
+
+    size_t const length = strlen(name);
+    for (const char* entry = options->eventNames; entry != NULL; entry = strchr(entry, ','))
+    {
+        entry += (*entry == ',') ? 1 : 0;
+        if (strncmp(entry, name, length) == 0 && (entry[length] == ',' || entry[length] == '\0'))
+        {
+            return VmbBoolTrue;
+        }
+    }
+    return VmbBoolFalse;
+}
+
+/**
+* \brief Start the benchmark; the frames are acquired for counting the expected events
+*/
+static VmbError_t StartBenchmark(VmbHandle_t cameraHandle)
+{
+    VmbError_t err = EventBenchmarkInit(&g_benchmark, EVENT_COUNT, GetTimestampFrequency(cameraHandle));
+    if (err != VmbErrorSuccess)
+    {
+        return err;
+    }
+
+    g_benchmarking = VmbBoolTrue;
+    err = StartCapture(cameraHandle);
+    if (err != VmbErrorSuccess)
+    {
+        StopCapture(cameraHandle);
+        EventBenchmarkDestroy(&g_benchmark);
+        g_benchmarking = VmbBoolFalse;
+    }
+    return err;
+}
+
+/**
+* \brief Let the benchmark run for the given duration while keeping the camera time reference up to date
+*/
+static void RunBenchmark(VmbHandle_t cameraHandle, VmbUint32_t durationS)
+{
+    VmbUint64_t const endNs = GetMonotonicTimeNs() + (VmbUint64_t)durationS * 1000000000ull;
+    VmbBool_t latchSupported = VmbBoolTrue;
+
+    printf("Running the benchmark for %u s...\n", durationS);
+    for (VmbUint64_t nowNs = GetMonotonicTimeNs(); nowNs < endNs; nowNs = GetMonotonicTimeNs())
+    {
+        VmbUint64_t ticks = 0;
+        VmbUint64_t hostNs = 0;
+        if (latchSupported && LatchCameraTime(cameraHandle, &ticks, &hostNs, NULL) == VmbErrorSuccess)
+        {
+            EventBenchmarkSetClockReference(&g_benchmark, ticks, hostNs);
+        }
+        else if (latchSupported)
+        {
+            printf("The camera time cannot be latched, the notification latency is not measured.\n");
+            latchSupported = VmbBoolFalse;
+        }
+
+        VmbUint64_t const wakeUpNs = nowNs + CLOCK_LATCH_INTERVAL_NS;
+        SleepUntilMonotonicNs(wakeUpNs < endNs ? wakeUpNs : endNs);
+    }
 }
 
+/**
+* \brief Run the benchmark with a simulated camera instead of the API
+*/
+static int RunStubBenchmark(const EventHandlingOptions* options)
+{
+    VmbError_t err = EventBenchmarkInit(&g_benchmark, EVENT_COUNT, 0);
+    if (err == VmbErrorSuccess)
+    {
+        // the simulated camera only sends the events occurring once per frame
+        for (VmbUint32_t i = 0; i < EVENT_COUNT; i++)
+        {
+            if (g_events[i].perFrame && IsEventSelected(options, g_events[i].name))
+            {
+                EventBenchmarkAddType(&g_benchmark, i, g_events[i].name, VmbBoolTrue);
+            }
+        }
+
+        err = EventDispatcherStart(&g_dispatcher, EVENT_HANDLER_THREAD_COUNT, BenchmarkEvents, NULL);
+        if (err == VmbErrorSuccess)
+        {
+            printf("Simulating %.1f frames per second for %u s...\n", options->stubFrameRateHz, options->benchmarkDurationS);
+            EventBenchmarkRunStub(&g_benchmark, &g_dispatcher, options->stubFrameRateHz, options->benchmarkDurationS);
+            EventDispatcherStop(&g_dispatcher);
+            EventBenchmarkPrint(&g_benchmark, &g_dispatcher);
+        }
+        EventBenchmarkDestroy(&g_benchmark);
+    }
+
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not start the benchmark. Error code: %d\n", err);
+    }
+    return (err == VmbErrorSuccess ? 0 : 1);
+}
+
+/**
+* \brief Activate the notifications and register the callbacks of all selected events supported by the camera
+*
+* \return the number of registered events
+*/
+static VmbUint32_t RegisterEvents(VmbHandle_t cameraHandle, const EventHandlingOptions* options)
+{
+    VmbUint32_t registeredCount = 0;
+    for (VmbUint32_t i = 0; i < EVENT_COUNT; i++)
+    {
+        RegisteredEvent* const event = &g_events[i];
+        if (!IsEventSelected(options, event->name))
+        {
+            continue;
+        }
+        snprintf(event->notificationFeature, MAX_FEATURE_NAME_LENGTH, "Event%s", event->name);
+        snprintf(event->timestampFeature, MAX_FEATURE_NAME_LENGTH, "Event%sTimestamp", event->name);
+        snprintf(event->frameIdFeature, MAX_FEATURE_NAME_LENGTH, "Event%sFrameID", event->name);
+
+        VmbBool_t available = VmbBoolFalse;
+        if (VmbFeatureEnumIsAvailable(cameraHandle, "EventSelector", event->name, &available) != VmbErrorSuccess || !available)
+        {
+            continue;
+        }
+
+        VmbFeatureInfo_t info;
+        event->hasFrameId = (VmbFeatureInfoQuery(cameraHandle, event->frameIdFeature, &info, sizeof(info)) == VmbErrorSuccess);
+
+        if (ActivateNotification(cameraHandle, event->name) == VmbErrorSuccess
+            && RegisterEventCallback(cameraHandle, i) == VmbErrorSuccess)
+        {
+            event->registered = VmbBoolTrue;
+            ++registeredCount;
+            if (g_benchmarking)
+            {
+                EventBenchmarkAddType(&g_benchmark, i, event->name, event->perFrame);
+            }
+        }
+    }
+    return registeredCount;
+}
+
+/**
+* \brief Unregister the callbacks of all registered events
+*/
+static void UnregisterEvents(VmbHandle_t cameraHandle)
+{
+    for (VmbUint32_t i = 0; i < EVENT_COUNT; i++)
+    {
+        if (g_events[i].registered)
+        {
+            VmbFeatureInvalidationUnregister(cameraHandle, g_events[i].notificationFeature, EventCB);
+            g_events[i].registered = VmbBoolFalse;
+        }
+    }
+}
+
+
+int CameraEventDemo(const EventHandlingOptions* options)
+{
+    char const* const cameraId = options->cameraId;
+
+    if (options->stubFrameRateHz > 0.0)
+    {
+        return RunStubBenchmark(options);
+    }
 
-int CameraEventDemo(char const* cameraId)
-{         
     // Initialize the Vmb API
-    VmbError_t err = VmbStartup(NULL);
+    VmbError_t err = TimedStartup(options->transportLayerFilter, NULL);
     if (err == VmbErrorSuccess)
     {
         VmbHandle_t cameraHandle = NULL;
@@ -41,7 +490,7 @@ int CameraEventDemo(char const* cameraId)
             {
                 // Use the first camera found in the list
                 VmbCameraInfo_t* selectedCamera = cameras;
-                
+
                 // Open the camera
                 err = VmbCameraOpen(selectedCamera->cameraIdString, VmbAccessModeFull, &cameraHandle);
             }
@@ -57,23 +506,82 @@ int CameraEventDemo(char const* cameraId)
         else
         {
             // Open the specified camera
-            err = VmbCameraOpen(cameraId, VmbAccessModeFull, &cameraHandle); 
+            err = VmbCameraOpen(cameraId, VmbAccessModeFull, &cameraHandle);
         }
 
         if (err == VmbErrorSuccess && cameraHandle != NULL)
         {
-            // Activate the notification for the desired camera event
-            err = ActivateNotification(cameraHandle);
+            // The events are handled by separate threads, so slow handlers never block the notifications
+            EventBatchHandler handler = PrintEvents;
+            if (options->correlateFrames)
+            {
+                err = StartCorrelation(cameraHandle, options);
+                handler = CorrelateEvents;
+            }
+            else if (options->benchmarkDurationS != 0)
+            {
+                err = StartBenchmark(cameraHandle);
+                handler = BenchmarkEvents;
+            }
             if (err == VmbErrorSuccess)
             {
-                // Register the event callback function
-                err = RegisterEventCallback(cameraHandle);
-                if (err == VmbErrorSuccess)
+                err = EventDispatcherStart(&g_dispatcher, EVENT_HANDLER_THREAD_COUNT, handler, NULL);
+            }
+            if (err == VmbErrorSuccess)
+            {
+                g_startNs = GetMonotonicTimeNs();
+
+                // Activate the notifications and register the event callback function for all supported events
+                if (RegisterEvents(cameraHandle, options) != 0)
                 {
-                    // Start acquisition on the camera to trigger the event
-                    printf("Starting acquisition to trigger event...\n");
+                    // Start acquisition on the camera to trigger the events
+                    printf("Starting acquisition to trigger events%s...\n", g_correlating ? " and correlating them with the frames" : "");
                     err = VmbFeatureCommandRun(cameraHandle, "AcquisitionStart");
+                    if (err == VmbErrorSuccess && g_benchmarking)
+                    {
+                        RunBenchmark(cameraHandle, options->benchmarkDurationS);
+                    }
+                    else if (err == VmbErrorSuccess)
+                    {
+                        printf("Press <enter> to stop acquisition...\n");
+                        ((void)getchar());
+                    }
+                }
+                else
+                {
+                    printf("The camera does not support any of the events.\n");
+                    err = VmbErrorNotSupported;
+                }
+
+                // Stop acquisition
+                VmbFeatureCommandRun(cameraHandle, "AcquisitionStop");
+
+                UnregisterEvents(cameraHandle);
+                EventDispatcherStop(&g_dispatcher);
+
+                if (g_benchmarking)
+                {
+                    EventBenchmarkPrint(&g_benchmark, &g_dispatcher);
                 }
+                printf("\n%llu events handled, %llu dropped, at most %llu events waiting for a handler\n",
+                       atomic_load(&g_dispatcher.handled),
+                       atomic_load(&g_dispatcher.dropped),
+                       atomic_load(&g_dispatcher.maxBacklog));
+            }
+            else
+            {
+                printf("Could not start the event handling. Error code: %d\n", err);
+            }
+
+            if (g_correlating)
+            {
+                StopCorrelation(cameraHandle);
+            }
+            if (g_benchmarking)
+            {
+                StopCapture(cameraHandle);
+                EventBenchmarkDestroy(&g_benchmark);
+                g_benchmarking = VmbBoolFalse;
             }
         }
         else
@@ -81,9 +589,6 @@ int CameraEventDemo(char const* cameraId)
             printf("Could not open camera or no camera available. Error code: %d\n", err);
         }
 
-        // Stop acquisition
-        VmbFeatureCommandRun(cameraHandle, "AcquisitionStop");
-
         // Close Vmb
         VmbShutdown();
     }
@@ -96,13 +601,12 @@ int CameraEventDemo(char const* cameraId)
 }
 
 
-VmbErrorType ActivateNotification(VmbHandle_t cameraHandle)
+VmbErrorType ActivateNotification(VmbHandle_t cameraHandle, const char* eventName)
 {
-    printf("Activating notifications for 'AcquisitionStart' events.\n");
+    printf("Activating notifications for '%s' events.\n", eventName);
 
     // EventSelector is used to specify the particular Event to control
-    // Configure the AcquisitionStart camera event. 
-    VmbErrorType err = VmbFeatureEnumSet(cameraHandle, "EventSelector", "AcquisitionStart");
+    VmbErrorType err = VmbFeatureEnumSet(cameraHandle, "EventSelector", eventName);
 
     if (err == VmbErrorSuccess)
     {
@@ -110,24 +614,30 @@ VmbErrorType ActivateNotification(VmbHandle_t cameraHandle)
         err = VmbFeatureEnumSet(cameraHandle, "EventNotification", "On");
     }
 
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not activate the notifications. Error code: %d\n", err);
+    }
+
     return err;
 }
 
 
-VmbErrorType RegisterEventCallback(VmbHandle_t cameraHandle)
+VmbErrorType RegisterEventCallback(VmbHandle_t cameraHandle, VmbUint32_t eventIndex)
 {
-    printf("Registering observer for 'EventAcquisitionStart' feature.\n");
+    RegisteredEvent* const event = &g_events[eventIndex];
+    printf("Registering observer for '%s' feature.\n", event->notificationFeature);
 
-    // Each of the events listed in the EventSelector enumeration will have a corresponding event identifier feature. 
-    // This feature will be used as a unique identifier of the event to register the callback function. 
+    // Each of the events listed in the EventSelector enumeration will have a corresponding event identifier feature.
+    // This feature will be used as a unique identifier of the event to register the callback function.
 
     // Register a callback function to be notified that the event happened
-    VmbErrorType err = VmbFeatureInvalidationRegister(cameraHandle, "EventAcquisitionStart", EventCB, NULL);
+    VmbErrorType err = VmbFeatureInvalidationRegister(cameraHandle, event->notificationFeature, EventCB, event);
 
     if (err != VmbErrorSuccess)
     {
         printf("Could not register observer. Error code: %d\n", err);
-    } 
+    }
 
     return err;
 }
\ No newline at end of file
@@ -8,19 +8,36 @@
 
 #include <VmbC/VmbCommonTypes.h>
 
+/**
+* \brief Options of the example
+*/
+typedef struct EventHandlingOptions
+{
+    const char* cameraId;           //!< ID of the camera to use; the first camera, if NULL or empty
+    VmbBool_t   correlateFrames;    //!< Stream frames and correlate them with the events instead of printing the events
+    const char* csvPath;            //!< File the correlation of every frame is written to; NULL for no CSV
+    VmbUint32_t windowUs;           //!< Maximum difference between the timestamps of a frame and its events
+    const char* eventNames;         //!< Comma separated list of the events to register; NULL for all supported events
+    VmbUint32_t benchmarkDurationS; //!< Count the events for this duration instead of printing them; 0 for no benchmark
+    double      stubFrameRateHz;    //!< Run the benchmark with a simulated camera with this frame rate; 0 for the camera
+    const char* transportLayerFilter; //!< Transport layers to load, see ParseTransportLayerFilter; NULL for all
+} EventHandlingOptions;
+
 /**
 * \brief Demonstrate the camera event functionality of VmbC
 */
-int CameraEventDemo(char const* cameraId);
+int CameraEventDemo(const EventHandlingOptions* options);
 
 /**
-* \brief Helper function to activate camera event notifications
+* \brief Helper function to activate the notifications of a camera event
+*
+* \param[in] eventName  Entry of the EventSelector enumeration
 */
-VmbErrorType ActivateNotification(VmbHandle_t cameraHandle);
+VmbErrorType ActivateNotification(VmbHandle_t cameraHandle, const char* eventName);
 
 /**
-* \brief Helper function to register an event callback function
+* \brief Helper function to register the event callback function for an event of the event table
 */
-VmbErrorType RegisterEventCallback(VmbHandle_t cameraHandle);
+VmbErrorType RegisterEventCallback(VmbHandle_t cameraHandle, VmbUint32_t eventIndex);
 
 #endif // EVENTHANDLING_H
\ No newline at end of file
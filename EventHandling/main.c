@@ -4,25 +4,126 @@
 =============================================================================*/
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "EventHandling.h"
 
+#define DEFAULT_WINDOW_US   10000
+
+/**
+ * \brief Print the usage of the example
+ */
+static void PrintUsage(void)
+{
+    printf("Usage: EventHandling [CameraID] [/e <events>] [/f] [/c <csv file>] [/w <us>] [/b <s> [/stub <fps>]] [/tl <filter>]\n\n");
+    printf("Parameters:   CameraID        ID of the camera to use (using first camera if not specified)\n");
+    printf("              /e <events>     Comma separated list of the events to register, e.g. ExposureStart,ExposureEnd\n");
+    printf("                              (all supported events if not specified)\n");
+    printf("              /f              Stream frames and correlate the events with them on the camera clock\n");
+    printf("              /c <csv file>   Write the events matched to every frame to a CSV file (implies /f)\n");
+    printf("              /w <us>         Maximum difference between the timestamps of a frame and its events\n");
+    printf("                              (default %d us)\n", DEFAULT_WINDOW_US);
+    printf("              /b <s>          Benchmark: count the events for the given number of seconds and report the\n");
+    printf("                              losses against the acquired frames and the notification latencies\n");
+    printf("              /stub <fps>     Run the benchmark with a simulated camera sending its events at the given\n");
+    printf("                              frame rate instead of a camera (requires /b)\n");
+    printf("              /tl <filter>    Load only the transport layers of a comma separated list of types and paths,\n");
+    printf("                              e.g. GigE,USB or /opt/VimbaX/cti/VimbaUSBTL.cti\n");
+}
+
+/**
+ * \brief Parse the command line parameters
+ *
+ * \return false, if the parameters are invalid
+ */
+static VmbBool_t ParseCommandLineParameters(int argc, char* argv[], EventHandlingOptions* options)
+{
+    options->cameraId = "";
+    options->correlateFrames = VmbBoolFalse;
+    options->csvPath = NULL;
+    options->windowUs = DEFAULT_WINDOW_US;
+    options->eventNames = NULL;
+    options->benchmarkDurationS = 0;
+    options->stubFrameRateHz = 0.0;
+    options->transportLayerFilter = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "/f") == 0)
+        {
+            options->correlateFrames = VmbBoolTrue;
+        }
+        else if (strcmp(argv[i], "/c") == 0 && i + 1 < argc)
+        {
+            options->correlateFrames = VmbBoolTrue;
+            options->csvPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "/w") == 0 && i + 1 < argc)
+        {
+            long const windowUs = strtol(argv[++i], NULL, 10);
+            if (windowUs <= 0)
+            {
+                return VmbBoolFalse;
+            }
+            options->windowUs = (VmbUint32_t)windowUs;
+        }
+        else if (strcmp(argv[i], "/e") == 0 && i + 1 < argc)
+        {
+            options->eventNames = argv[++i];
+        }
+        else if (strcmp(argv[i], "/b") == 0 && i + 1 < argc)
+        {
+            long const durationS = strtol(argv[++i], NULL, 10);
+            if (durationS <= 0)
+            {
+                return VmbBoolFalse;
+            }
+            options->benchmarkDurationS = (VmbUint32_t)durationS;
+        }
+        else if (strcmp(argv[i], "/stub") == 0 && i + 1 < argc)
+        {
+            options->stubFrameRateHz = strtod(argv[++i], NULL);
+            if (options->stubFrameRateHz <= 0.0)
+            {
+                return VmbBoolFalse;
+            }
+        }
+        else if (strcmp(argv[i], "/tl") == 0 && i + 1 < argc)
+        {
+            options->transportLayerFilter = argv[++i];
+        }
+        else if (argv[i][0] != '/' && options->cameraId[0] == '\0')
+        {
+            options->cameraId = argv[i];
+        }
+        else
+        {
+            return VmbBoolFalse;
+        }
+    }
+
+    // the benchmark and the correlation handle the events differently, so only one of them can be used
+    if ((options->benchmarkDurationS != 0 && options->correlateFrames)
+        || (options->stubFrameRateHz > 0.0 && options->benchmarkDurationS == 0))
+    {
+        return VmbBoolFalse;
+    }
+    return VmbBoolTrue;
+}
+
 int main(int argc, char* argv[])
 {
     printf("////////////////////////////////////\n");
     printf("/// VmbC Event Handling Example ///\n");
     printf("////////////////////////////////////\n\n");
 
-    if (2 < argc)
+    EventHandlingOptions options;
+    if (!ParseCommandLineParameters(argc, argv, &options))
     {
-        printf("Usage: EventHandling [CameraID]\n\n");
-        printf("Parameters:   CameraID    ID of the camera to use (using first camera if not specified)\n");
-    }
-    else if (2 == argc)
-    {        
-        return CameraEventDemo(argv[1]);
-    }
-    else
-    {
-        return CameraEventDemo("");
+        PrintUsage();
+        return 1;
     }
+
+    return CameraEventDemo(&options);
 }
@@ -9,6 +9,7 @@
 
 #define _CRT_SECURE_NO_WARNINGS // disable sscanf warning for Windows
 
+#include "ForceIp.h"
 #include "ForceIpProg.h"
 
 #include <stdio.h>
@@ -20,7 +21,6 @@
 #else
 #include <unistd.h>
 #include <arpa/inet.h>
-#include <time.h>
 #endif
 
 #include <VmbC/VmbC.h>
@@ -28,10 +28,21 @@
 #include <VmbCExamplesCommon/AccessModeToString.h>
 #include <VmbCExamplesCommon/ArrayAlloc.h>
 #include <VmbCExamplesCommon/ErrorCodeToMessage.h>
+#include <VmbCExamplesCommon/FeatureCommand.h>
+#include <VmbCExamplesCommon/HandleIndex.h>
 #include <VmbCExamplesCommon/ListCameras.h>
 #include <VmbCExamplesCommon/ListInterfaces.h>
 #include <VmbCExamplesCommon/ListTransportLayers.h>
 #include <VmbCExamplesCommon/IpAddressToHostByteOrderedInt.h>
+#include <VmbCExamplesCommon/VmbStdatomic.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+// Maximum time to wait for the completion of the force ip command
+#define FORCE_IP_TIMEOUT_MS 2500
+
+// The transport layer names used for Vimba X and Vimba transport layers
+#define VIMBA_X_TL_NAME "AVT GigE Transport Layer"
+#define VIMBA_TL_NAME   "Vimba GigE Transport Layer"
 
 
 
@@ -105,6 +116,44 @@ typedef struct InterfaceSearchResult
     VmbInt64_t          deviceSelector; //!< The configured DeviceSelector the camera was found with
 } InterfaceSearchResult;
 
+/**
+ * \brief Helper struct used to store the MAC address of a device found by an interface
+ */
+typedef struct DeviceMacEntry
+{
+    VmbInt64_t  mac;            //!< The MAC address of the device
+    VmbUint32_t interfaceIndex; //!< Index of the interface in the list of interfaces the device was found with
+    VmbInt64_t  deviceSelector; //!< The DeviceSelector value of the device
+} DeviceMacEntry;
+
+/**
+ * \brief Helper struct used to pass the search of an interface to a worker thread and return its result
+ */
+typedef struct InterfaceSweep
+{
+    const VmbInterfaceInfo_t*   interfaceInfo;  //!< The interface to search
+    VmbUint32_t                 interfaceIndex; //!< Index of the interface in the list of interfaces
+    VmbInt64_t                  searchedMac;    //!< The MAC address searched for; 0 to record every device
+    atomic_ullong*              found;          //!< Set, once a worker of the same transport layer found the MAC address; NULL, if every device is recorded
+    DeviceMacEntry*             devices;        //!< The recorded devices
+    VmbUint32_t                 deviceCount;    //!< The number of recorded devices
+    char*                       cameraId;       //!< Camera ID of the searched device, if found
+    VmbError_t                  error;          //!< Error preventing the search
+} InterfaceSweep;
+
+/**
+ * \brief Helper struct used to cache the devices of all interfaces for the session
+ */
+typedef struct DeviceCache
+{
+    VmbInterfaceInfo_t* interfaces;     //!< The interfaces the devices were found with
+    VmbUint32_t         interfaceCount; //!< The number of interfaces
+    DeviceMacEntry*     devices;        //!< The devices sorted by MAC address; NULL, if no cache was built
+    VmbUint32_t         deviceCount;    //!< The number of devices
+} DeviceCache;
+
+static DeviceCache g_deviceCache = { 0 };
+
 /**
  * \brief Helper struct used to store information about a found transport layer
  */
@@ -147,18 +196,50 @@ VmbError_t ForceIpViaInterface(const VmbInt64_t macValue, const VmbInt64_t ipVal
 VmbError_t ForceIpViaTl(const VmbInt64_t macValue, const VmbInt64_t ipValue, const VmbInt64_t subnetMaskValue, const VmbInt64_t gatewayValue);
 
 /**
- * \brief Search for interfaces to which a camera with the given mac address is connected
+ * \brief Search for interfaces to which a camera with the given mac address is connected.
+ * The device cache is used, if available; otherwise the camera lists of the transport layers are updated and the
+ * interfaces are searched, keeping one interface per transport layer.
  *
  * \param[in] mac                          The camera's mac address
  * \param[out] interfaceSearchResults      The interfaces to which the camera is connected.
- *                                         The first one will be an interface of a Vimba X transport layer, if available,
- *                                         and the second one that of a Vimba one, if available
+ *                                         The interfaces of Vimba X transport layers come first, followed by those of the
+ *                                         other transport layers, e.g. Vimba, in the order of the interfaces
  * \param[out] interfaceSearchResultsCount The number of interfaces to which the camera is connected
  *
  * \return Result of the operation
 */
 VmbError_t SearchCamerasInterface(const VmbInt64_t mac, InterfaceSearchResult** interfaceSearchResults, VmbUint32_t* interfaceSearchResultsCount);
 
+/**
+ * \brief Search the GigE Vision interfaces in parallel, using one worker thread per interface.
+ * If a MAC address is given, the search of the interfaces of a transport layer stops as soon as one of them found it.
+ * The interfaces of the other transport layers are searched on, since they may enumerate the same physical interface.
+ *
+ * \param[in]  interfaces     The available interfaces
+ * \param[in]  interfaceCount The number of available interfaces
+ * \param[in]  mac            The camera's mac address; 0 to record the devices of all interfaces
+ * \param[out] sweeps         The results of the searched interfaces. Must be freed using FreeInterfaceSweeps
+ * \param[out] sweepCount     The number of searched interfaces
+ *
+ * \return Result of the operation
+*/
+VmbError_t SweepInterfaces(const VmbInterfaceInfo_t* const interfaces, const VmbUint32_t interfaceCount, const VmbInt64_t mac, InterfaceSweep** sweeps, VmbUint32_t* sweepCount);
+
+/**
+ * \brief Free the results of SweepInterfaces
+*/
+void FreeInterfaceSweeps(InterfaceSweep* sweeps, const VmbUint32_t sweepCount);
+
+/**
+ * \brief Move the interfaces of Vimba X transport layers to the front of the search results.
+ * The transport layer of every interface is looked up in an index of the transport layers by handle.
+ * The order of the search results is kept otherwise.
+ *
+ * \param[in,out] interfaceSearchResults      The interfaces to which the camera is connected
+ * \param[in]     interfaceSearchResultsCount The number of interfaces to which the camera is connected
+*/
+void SortInterfacesByTransportLayer(InterfaceSearchResult* interfaceSearchResults, const VmbUint32_t interfaceSearchResultsCount);
+
 /**
  * \brief Search for transport layers to which a camera with the given mac address is connected
  *
@@ -252,17 +333,6 @@ VmbError_t ForceIp(const char* const mac, const char* const ip, const char* cons
 
 VmbError_t ForceIpViaInterface(const VmbInt64_t macValue, const VmbInt64_t ipValue, const VmbInt64_t subnetMaskValue, const VmbInt64_t gatewayValue)
 {
-    /*
-     * Get a list of currently connected cameras.
-     * Forces the used transport layers to update their internal camera lists.
-     */
-    {
-        VmbCameraInfo_t* cameras = 0;
-        VmbUint32_t cameraCount = 0;
-        RETURN_ON_ERROR(ListCameras(&cameras, &cameraCount));
-        free(cameras);
-    }
-
     /*
      * Get the interfaces to which the camera is connected.
      */
@@ -289,6 +359,12 @@ VmbError_t ForceIpViaInterface(const VmbInt64_t macValue, const VmbInt64_t ipVal
         }
     }
 
+    for (VmbUint32_t interfaceSearchResultsIndex = 0; interfaceSearchResultsIndex < interfaceSearchResultsCount; interfaceSearchResultsIndex++)
+    {
+        free(interfaceSearchResults[interfaceSearchResultsIndex].cameraId);
+    }
+    free(interfaceSearchResults);
+
     return error;
 }
 
@@ -379,20 +455,108 @@ VmbError_t QueryDeviceIdFeature(const VmbHandle_t interfaceHandle, char** device
     return error;
 }
 
-VmbError_t SearchCamerasInterface(const VmbInt64_t mac, InterfaceSearchResult** interfaceSearchResults, VmbUint32_t* interfaceSearchResultsCount)
+/**
+ * \brief Sweep the DeviceSelector of one interface on a worker thread
+ *
+ * \param[in,out] context The InterfaceSweep of the interface
+ *
+ * \return always 0; the result is stored in the sweep
+*/
+static int SweepInterface(void* context)
 {
+    InterfaceSweep* const sweep = (InterfaceSweep*)context;
+    const VmbHandle_t interfaceHandle = sweep->interfaceInfo->interfaceHandle;
+
     /*
-     * Get a list of all available interfaces.
+     * Get the number of cameras connected to the interface.
+     * The feature DeviceSelector is not available if no camera is connected to the interface.
+     * A reported range [0;0] means that only a single camera is connected to the interface.
      */
-    VmbInterfaceInfo_t* interfaces = 0;
-    VmbUint32_t         interfaceCount = 0;
-    RETURN_AND_PRINT_ON_ERROR(ListInterfaces(&interfaces, &interfaceCount));
+    VmbInt64_t deviceSelectorMin;
+    VmbInt64_t deviceSelectorMax;
+    if (VmbFeatureIntRangeQuery(interfaceHandle, "DeviceSelector", &deviceSelectorMin, &deviceSelectorMax) != VmbErrorSuccess)
+    {
+        return 0;
+    }
+
+    sweep->devices = VMB_MALLOC_ARRAY(DeviceMacEntry, (deviceSelectorMax + 1));
+    if (sweep->devices == NULL)
+    {
+        sweep->error = VmbErrorResources;
+        return 0;
+    }
+
+    for (VmbInt64_t deviceIndex = 0; deviceIndex <= deviceSelectorMax; deviceIndex++)
+    {
+        /*
+         * Stop as soon as the camera was found on another interface
+         */
+        if ((sweep->found != NULL) && (atomic_load(sweep->found) != 0))
+        {
+            break;
+        }
+
+        CONTINUE_AND_PRINT_ON_ERROR(VmbFeatureIntSet(interfaceHandle, "DeviceSelector", deviceIndex));
+
+        VmbInt64_t currentMAC = 0;
+        CONTINUE_AND_PRINT_ON_ERROR(VmbFeatureIntGet(interfaceHandle, "GevDeviceMACAddress", &currentMAC));
+
+        if ((sweep->searchedMac == 0) || (currentMAC == sweep->searchedMac))
+        {
+            DeviceMacEntry* const device = sweep->devices + sweep->deviceCount;
+            device->mac = currentMAC;
+            device->interfaceIndex = sweep->interfaceIndex;
+            device->deviceSelector = deviceIndex;
+            ++sweep->deviceCount;
+        }
+
+        if ((sweep->searchedMac != 0) && (currentMAC == sweep->searchedMac))
+        {
+            /*
+             * The device ID is related to the DeviceSelector, so it is queried before the selector changes.
+             */
+            if (QueryDeviceIdFeature(interfaceHandle, &sweep->cameraId) == VmbErrorSuccess)
+            {
+                atomic_store(sweep->found, 1);
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+VmbError_t SweepInterfaces(const VmbInterfaceInfo_t* const interfaces, const VmbUint32_t interfaceCount, const VmbInt64_t mac, InterfaceSweep** sweeps, VmbUint32_t* sweepCount)
+{
+    *sweeps = VMB_MALLOC_ARRAY(InterfaceSweep, interfaceCount);
+    thrd_t* const threads = VMB_MALLOC_ARRAY(thrd_t, interfaceCount);
+    VmbBool_t* const threadStarted = VMB_MALLOC_ARRAY(VmbBool_t, interfaceCount);
+    if ((*sweeps == NULL) || (threads == NULL) || (threadStarted == NULL))
+    {
+        free(*sweeps);
+        free(threads);
+        free(threadStarted);
+        *sweeps = NULL;
+        return VmbErrorResources;
+    }
 
     /*
-     * Count the interfaces to which the camera is connected.
-     * Multiple transport layers can enumerate the same physical interface.
+     * One flag per transport layer, stored at the first sweep of the transport layer
      */
-    *interfaceSearchResultsCount = 0;
+    atomic_ullong* const found = VMB_MALLOC_ARRAY(atomic_ullong, interfaceCount);
+    if (found == NULL)
+    {
+        free(*sweeps);
+        free(threads);
+        free(threadStarted);
+        *sweeps = NULL;
+        return VmbErrorResources;
+    }
+
+    /*
+     * Start one worker per GigE Vision interface; the interfaces are independent of each other.
+     */
+    *sweepCount = 0;
     for (VmbUint32_t interfaceIndex = 0; interfaceIndex < interfaceCount; interfaceIndex++)
     {
         const VmbInterfaceInfo_t* const currentInterface = (interfaces + interfaceIndex);
@@ -406,97 +570,391 @@ VmbError_t SearchCamerasInterface(const VmbInt64_t mac, InterfaceSearchResult**
             continue;
         }
 
-        const VmbHandle_t currentInterfaceHandle = currentInterface->interfaceHandle;
+        if (mac != 0)
+        {
+            VMB_PRINT("Searching for camera on interface %s\n", currentInterface->interfaceName);
+        }
 
-        /*
-         * Get the number of cameras connected to the interface.
-         * The feature DeviceSelector is not available if no camera is connected to the interface.
-         * A reported range [0;0] means that only a single camera is connected to the interface.
-         */
-        VmbInt64_t deviceSelectorMin;
-        VmbInt64_t deviceSelectorMax;
-        CONTINUE_ON_ERROR(VmbFeatureIntRangeQuery(currentInterfaceHandle, "DeviceSelector", &deviceSelectorMin, &deviceSelectorMax));
+        InterfaceSweep* const sweep = *sweeps + *sweepCount;
+        memset(sweep, 0, sizeof(InterfaceSweep));
+        sweep->interfaceInfo = currentInterface;
+        sweep->interfaceIndex = interfaceIndex;
+        sweep->searchedMac = mac;
+        sweep->found = NULL;
+        sweep->error = VmbErrorSuccess;
+        if (mac != 0)
+        {
+            /*
+             * Share the flag of the first sweep of the transport layer; ends at the current sweep at the latest
+             */
+            VmbUint32_t tlSweepIndex = 0;
+            while ((*sweeps)[tlSweepIndex].interfaceInfo->transportLayerHandle != currentInterface->transportLayerHandle)
+            {
+                ++tlSweepIndex;
+            }
+            if (tlSweepIndex == *sweepCount)
+            {
+                atomic_store(&found[tlSweepIndex], 0);
+            }
+            sweep->found = &found[tlSweepIndex];
+        }
 
-        /*
-         * Check based on the mac if the desired camera is connected to the current interface
-         */
-        for (VmbInt64_t deviceIndex = 0; deviceIndex <= deviceSelectorMax; deviceIndex++)
+        threadStarted[*sweepCount] = (thrd_create(&threads[*sweepCount], SweepInterface, sweep) == thrd_success);
+        if (!threadStarted[*sweepCount])
+        {
+            /*
+             * Search the interface on the calling thread instead
+             */
+            SweepInterface(sweep);
+        }
+        ++(*sweepCount);
+    }
+
+    for (VmbUint32_t sweepIndex = 0; sweepIndex < *sweepCount; sweepIndex++)
+    {
+        if (threadStarted[sweepIndex])
         {
-            CONTINUE_AND_PRINT_ON_ERROR(VmbFeatureIntSet(currentInterfaceHandle, "DeviceSelector", deviceIndex));
+            thrd_join(threads[sweepIndex], NULL);
+        }
+    }
 
-            VmbInt64_t currentMAC = 0;
-            CONTINUE_AND_PRINT_ON_ERROR(VmbFeatureIntGet(currentInterfaceHandle, "GevDeviceMACAddress", &currentMAC));
+    free(threads);
+    free(threadStarted);
+    free(found);
 
-            if (currentMAC == mac)
-            {
-                /*
-                 * Camera is connected, add the interface.
-                 */
-                ++(*interfaceSearchResultsCount);
-            }
+    VmbError_t error = VmbErrorSuccess;
+    for (VmbUint32_t sweepIndex = 0; sweepIndex < *sweepCount; sweepIndex++)
+    {
+        if ((*sweeps)[sweepIndex].error != VmbErrorSuccess)
+        {
+            error = (*sweeps)[sweepIndex].error;
         }
     }
+    if (error != VmbErrorSuccess)
+    {
+        FreeInterfaceSweeps(*sweeps, *sweepCount);
+        *sweeps = NULL;
+        *sweepCount = 0;
+    }
+    return error;
+}
+
+void FreeInterfaceSweeps(InterfaceSweep* sweeps, const VmbUint32_t sweepCount)
+{
+    if (sweeps == NULL)
+    {
+        return;
+    }
+    for (VmbUint32_t sweepIndex = 0; sweepIndex < sweepCount; sweepIndex++)
+    {
+        free(sweeps[sweepIndex].devices);
+        free(sweeps[sweepIndex].cameraId);
+    }
+    free(sweeps);
+}
+
+/**
+ * \brief Order the cached devices by MAC address, keeping the order of the interfaces for equal addresses
+*/
+static int CompareDeviceMacEntries(const void* lhs, const void* rhs)
+{
+    const DeviceMacEntry* const a = (const DeviceMacEntry*)lhs;
+    const DeviceMacEntry* const b = (const DeviceMacEntry*)rhs;
+    if (a->mac != b->mac)
+    {
+        return (a->mac < b->mac) ? -1 : 1;
+    }
+    if (a->interfaceIndex != b->interfaceIndex)
+    {
+        return (a->interfaceIndex < b->interfaceIndex) ? -1 : 1;
+    }
+    return (a->deviceSelector < b->deviceSelector) ? -1 : (a->deviceSelector > b->deviceSelector);
+}
 
-    *interfaceSearchResults = VMB_MALLOC_ARRAY(InterfaceSearchResult, *interfaceSearchResultsCount);
+VmbError_t ForceIpCacheDevices(VmbUint32_t* deviceCount)
+{
+    ForceIpClearDeviceCache();
 
-    VmbError_t error = VmbErrorNotFound;
+    VmbInterfaceInfo_t* interfaces = 0;
+    VmbUint32_t         interfaceCount = 0;
+    RETURN_AND_PRINT_ON_ERROR(ListInterfaces(&interfaces, &interfaceCount));
 
     /*
-     * Store the interfaces to which the camera is connected.
+     * The interface infos are kept with the cache, since the devices refer to them by index
      */
-    VmbUint32_t interfaceSearchResultIndex = 0;
-    for (VmbUint32_t interfaceIndex = 0; interfaceIndex < interfaceCount; interfaceIndex++)
+    InterfaceSweep* sweeps = 0;
+    VmbUint32_t sweepCount = 0;
+    const VmbError_t sweepError = SweepInterfaces(interfaces, interfaceCount, 0, &sweeps, &sweepCount);
+    if (sweepError != VmbErrorSuccess)
     {
-        const VmbInterfaceInfo_t* const currentInterface = (interfaces + interfaceIndex);
+        VMB_PRINT("Searching the interfaces failed. %s Error code: %d.\n", ErrorCodeToMessage(sweepError), sweepError);
+        free(interfaces);
+        return sweepError;
+    }
 
-        const VmbBool_t ignoreInterface = (currentInterface->interfaceType != VmbTransportLayerTypeGEV);
-        if (ignoreInterface)
+    /*
+     * Merge the devices of all interfaces into a single table sorted by MAC address
+     */
+    VmbUint32_t totalCount = 0;
+    for (VmbUint32_t sweepIndex = 0; sweepIndex < sweepCount; sweepIndex++)
+    {
+        totalCount += sweeps[sweepIndex].deviceCount;
+    }
+
+    DeviceMacEntry* const devices = VMB_MALLOC_ARRAY(DeviceMacEntry, (totalCount + 1));
+    if (devices == NULL)
+    {
+        FreeInterfaceSweeps(sweeps, sweepCount);
+        free(interfaces);
+        return VmbErrorResources;
+    }
+
+    VmbUint32_t deviceIndex = 0;
+    for (VmbUint32_t sweepIndex = 0; sweepIndex < sweepCount; sweepIndex++)
+    {
+        memcpy(devices + deviceIndex, sweeps[sweepIndex].devices, sweeps[sweepIndex].deviceCount * sizeof(DeviceMacEntry));
+        deviceIndex += sweeps[sweepIndex].deviceCount;
+    }
+    FreeInterfaceSweeps(sweeps, sweepCount);
+
+    qsort(devices, totalCount, sizeof(DeviceMacEntry), CompareDeviceMacEntries);
+
+    g_deviceCache.interfaces = interfaces;
+    g_deviceCache.interfaceCount = interfaceCount;
+    g_deviceCache.devices = devices;
+    g_deviceCache.deviceCount = totalCount;
+
+    if (deviceCount != NULL)
+    {
+        *deviceCount = totalCount;
+    }
+    return VmbErrorSuccess;
+}
+
+void ForceIpClearDeviceCache(void)
+{
+    free(g_deviceCache.interfaces);
+    free(g_deviceCache.devices);
+    memset(&g_deviceCache, 0, sizeof(DeviceCache));
+}
+
+/**
+ * \brief Get the interfaces of a camera from the device cache.
+ * Every cached device is checked to still have the MAC address, since the DeviceSelector of an interface changes with the connected cameras.
+ *
+ * \param[in]  mac                          The camera's mac address
+ * \param[out] interfaceSearchResults       The interfaces to which the camera is connected
+ * \param[out] interfaceSearchResultsCount  The number of interfaces to which the camera is connected
+ *
+ * \return VmbErrorNotFound, if the cache contains no valid entry for the camera
+*/
+static VmbError_t LookUpCachedDevice(const VmbInt64_t mac, InterfaceSearchResult** interfaceSearchResults, VmbUint32_t* interfaceSearchResultsCount)
+{
+    /*
+     * Find the first entry of the MAC address
+     */
+    VmbUint32_t first = 0;
+    VmbUint32_t last = g_deviceCache.deviceCount;
+    while (first < last)
+    {
+        const VmbUint32_t middle = first + (last - first) / 2;
+        if (g_deviceCache.devices[middle].mac < mac)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+
+    VmbUint32_t end = first;
+    while ((end < g_deviceCache.deviceCount) && (g_deviceCache.devices[end].mac == mac))
+    {
+        ++end;
+    }
+
+    *interfaceSearchResultsCount = 0;
+    if (first == end)
+    {
+        return VmbErrorNotFound;
+    }
+
+    *interfaceSearchResults = VMB_MALLOC_ARRAY(InterfaceSearchResult, (end - first));
+    if (*interfaceSearchResults == NULL)
+    {
+        return VmbErrorResources;
+    }
+
+    for (VmbUint32_t deviceIndex = first; deviceIndex < end; deviceIndex++)
+    {
+        const DeviceMacEntry* const device = g_deviceCache.devices + deviceIndex;
+        const VmbInterfaceInfo_t* const currentInterface = g_deviceCache.interfaces + device->interfaceIndex;
+
+        CONTINUE_ON_ERROR(VmbFeatureIntSet(currentInterface->interfaceHandle, "DeviceSelector", device->deviceSelector));
+
+        VmbInt64_t currentMAC = 0;
+        CONTINUE_ON_ERROR(VmbFeatureIntGet(currentInterface->interfaceHandle, "GevDeviceMACAddress", &currentMAC));
+        if (currentMAC != mac)
         {
             continue;
         }
 
-        const VmbHandle_t currentInterfaceHandle = currentInterface->interfaceHandle;
+        char* cameraId = NULL;
+        CONTINUE_ON_ERROR(QueryDeviceIdFeature(currentInterface->interfaceHandle, &cameraId));
+
+        InterfaceSearchResult* const result = *interfaceSearchResults + *interfaceSearchResultsCount;
+        result->cameraId = cameraId;
+        result->info = *currentInterface;
+        result->deviceSelector = device->deviceSelector;
+        ++(*interfaceSearchResultsCount);
+        VMB_PRINT("Camera found on interface %s using the device cache\n", currentInterface->interfaceName);
+    }
 
-        VMB_PRINT("Searching for camera on interface %s\n", currentInterface->interfaceName);
+    if (*interfaceSearchResultsCount == 0)
+    {
+        free(*interfaceSearchResults);
+        *interfaceSearchResults = NULL;
+        return VmbErrorNotFound;
+    }
+
+    SortInterfacesByTransportLayer(*interfaceSearchResults, *interfaceSearchResultsCount);
+
+    return VmbErrorSuccess;
+}
 
-        VmbInt64_t deviceSelectorMin;
-        VmbInt64_t deviceSelectorMax;
-        CONTINUE_ON_ERROR(VmbFeatureIntRangeQuery(currentInterfaceHandle, "DeviceSelector", &deviceSelectorMin, &deviceSelectorMax));
+VmbError_t SearchCamerasInterface(const VmbInt64_t mac, InterfaceSearchResult** interfaceSearchResults, VmbUint32_t* interfaceSearchResultsCount)
+{
+    *interfaceSearchResults = NULL;
+    *interfaceSearchResultsCount = 0;
 
-        for (VmbInt64_t deviceIndex = 0; deviceIndex <= deviceSelectorMax; deviceIndex++)
+    /*
+     * Use the device cache, if available; cameras connected after the cache was built are searched for below.
+     */
+    if (g_deviceCache.devices != NULL)
+    {
+        const VmbError_t cacheError = LookUpCachedDevice(mac, interfaceSearchResults, interfaceSearchResultsCount);
+        if (cacheError != VmbErrorNotFound)
         {
-            CONTINUE_AND_PRINT_ON_ERROR(VmbFeatureIntSet(currentInterfaceHandle, "DeviceSelector", deviceIndex));
+            return cacheError;
+        }
+    }
 
-            VmbInt64_t currentMAC = 0;
-            CONTINUE_AND_PRINT_ON_ERROR(VmbFeatureIntGet(currentInterfaceHandle, "GevDeviceMACAddress", &currentMAC));
+    /*
+     * Get a list of currently connected cameras.
+     * Forces the used transport layers to update their internal camera lists.
+     */
+    {
+        VmbCameraInfo_t* cameras = 0;
+        VmbUint32_t cameraCount = 0;
+        RETURN_ON_ERROR(ListCameras(&cameras, &cameraCount));
+        free(cameras);
+    }
 
-            if (currentMAC == mac)
-            {
-                char* cameraId = NULL;
-                CONTINUE_ON_ERROR(QueryDeviceIdFeature(currentInterfaceHandle, &cameraId));
-
-                (*interfaceSearchResults)[interfaceSearchResultIndex].cameraId = cameraId;
-                (*interfaceSearchResults)[interfaceSearchResultIndex].info = *currentInterface;
-                (*interfaceSearchResults)[interfaceSearchResultIndex].deviceSelector = deviceIndex;
-                ++interfaceSearchResultIndex;
-                error = VmbErrorSuccess;
-                VMB_PRINT("Camera found on interface %s\n", currentInterface->interfaceName);
-            }
+    /*
+     * Get a list of all available interfaces.
+     */
+    VmbInterfaceInfo_t* interfaces = 0;
+    VmbUint32_t         interfaceCount = 0;
+    RETURN_AND_PRINT_ON_ERROR(ListInterfaces(&interfaces, &interfaceCount));
+
+    /*
+     * Search all interfaces in parallel, until the camera is found by every transport layer it is connected to.
+     * Multiple transport layers can enumerate the same physical interface, so one interface per transport layer
+     * is kept to fall back to, if sending the command via the interfaces of the preferred transport layer fails.
+     */
+    InterfaceSweep* sweeps = 0;
+    VmbUint32_t sweepCount = 0;
+    const VmbError_t sweepError = SweepInterfaces(interfaces, interfaceCount, mac, &sweeps, &sweepCount);
+    if (sweepError != VmbErrorSuccess)
+    {
+        VMB_PRINT("Searching the interfaces failed. %s Error code: %d.\n", ErrorCodeToMessage(sweepError), sweepError);
+        free(interfaces);
+        return sweepError;
+    }
+
+    VmbUint32_t foundCount = 0;
+    for (VmbUint32_t sweepIndex = 0; sweepIndex < sweepCount; sweepIndex++)
+    {
+        foundCount += (sweeps[sweepIndex].cameraId != NULL) ? 1 : 0;
+    }
+
+    VmbError_t error = VmbErrorNotFound;
+    if (foundCount != 0)
+    {
+        *interfaceSearchResults = VMB_MALLOC_ARRAY(InterfaceSearchResult, foundCount);
+        if (*interfaceSearchResults == NULL)
+        {
+            error = VmbErrorResources;
+            foundCount = 0;
         }
     }
 
+    /*
+     * Store the interfaces to which the camera is connected.
+     */
+    for (VmbUint32_t sweepIndex = 0; (sweepIndex < sweepCount) && (*interfaceSearchResultsCount < foundCount); sweepIndex++)
+    {
+        InterfaceSweep* const sweep = sweeps + sweepIndex;
+        if (sweep->cameraId == NULL)
+        {
+            continue;
+        }
+
+        InterfaceSearchResult* const result = *interfaceSearchResults + *interfaceSearchResultsCount;
+        result->cameraId = sweep->cameraId;
+        result->info = *sweep->interfaceInfo;
+        result->deviceSelector = sweep->devices[sweep->deviceCount - 1].deviceSelector;
+        sweep->cameraId = NULL; // owned by the search result now
+        ++(*interfaceSearchResultsCount);
+        error = VmbErrorSuccess;
+        VMB_PRINT("Camera found on interface %s\n", sweep->interfaceInfo->interfaceName);
+    }
+
+    FreeInterfaceSweeps(sweeps, sweepCount);
     free(interfaces);
 
+    SortInterfacesByTransportLayer(*interfaceSearchResults, *interfaceSearchResultsCount);
+
     return error;
 }
 
+void SortInterfacesByTransportLayer(InterfaceSearchResult* interfaceSearchResults, const VmbUint32_t interfaceSearchResultsCount)
+{
+    VmbTransportLayerInfo_t* tls = 0;
+    VmbUint32_t              tlCount = 0;
+    if (interfaceSearchResultsCount < 2 || ListTransportLayers(&tls, &tlCount) != VmbErrorSuccess)
+    {
+        return;
+    }
+
+    HandleIndex tlIndex;
+    if ((HandleIndexInit(&tlIndex, tlCount) == VmbErrorSuccess) && (HandleIndexAddTransportLayers(&tlIndex, tls, tlCount) == VmbErrorSuccess))
+    {
+        VmbUint32_t insertPosition = 0;
+        for (VmbUint32_t interfaceSearchResultIndex = 0; interfaceSearchResultIndex < interfaceSearchResultsCount; interfaceSearchResultIndex++)
+        {
+            const VmbTransportLayerInfo_t* const tl = HandleIndexFind(&tlIndex, interfaceSearchResults[interfaceSearchResultIndex].info.transportLayerHandle);
+            if ((tl != NULL) && (tl->transportLayerName != NULL) && (strcmp(tl->transportLayerName, VIMBA_X_TL_NAME) == 0))
+            {
+                /*
+                 * Shift the results in between by one to keep their order.
+                 */
+                const InterfaceSearchResult result = interfaceSearchResults[interfaceSearchResultIndex];
+                memmove(interfaceSearchResults + insertPosition + 1, interfaceSearchResults + insertPosition, (interfaceSearchResultIndex - insertPosition) * sizeof(InterfaceSearchResult));
+                interfaceSearchResults[insertPosition++] = result;
+            }
+        }
+    }
+
+    HandleIndexFree(&tlIndex);
+    free(tls);
+}
+
 VmbError_t GetRelatedTls( const VmbTransportLayerInfo_t* const tls, const VmbUint32_t tlCount, TlSearchResult** tlVimbaXSearchResult, VmbUint32_t* tlVimbaXSearchResultsCount, TlSearchResult** tlVimbaSearchResult, VmbUint32_t* tlVimbaSearchResultsCount)
 {
-    /*
-     * The transport layer names used for Vimba X and Vimba transport layers
-     */
-    const char vimbaXTlName[] = "AVT GigE Transport Layer";
-    const char vimbaTlName[] = "Vimba GigE Transport Layer";
+    const char vimbaXTlName[] = VIMBA_X_TL_NAME;
+    const char vimbaTlName[] = VIMBA_TL_NAME;
 
     /*
      * Count the Vimba X and Vimba transport layers to which the camera is connected.
@@ -602,21 +1060,6 @@ VmbError_t SendForceIpViaTl(const VmbHandle_t tlHandle, const VmbInt64_t mac, co
     return VmbErrorSuccess;
 }
 
-/**
- * \brief Suspend the execution of the current thread for 100 milliseconds
- */
-void Sleep100Ms(void)
-{
-#ifdef WIN32
-    Sleep(100);
-#else
-    struct timespec duration;
-    duration.tv_sec  = 0;
-    duration.tv_nsec = 100000000;
-    nanosleep(&duration, NULL);
-#endif
-}
-
 VmbError_t SendForceIp(const VmbHandle_t handle, const VmbInt64_t ip, const VmbInt64_t subnetMask, const VmbInt64_t gateway)
 {
     /*
@@ -625,27 +1068,22 @@ VmbError_t SendForceIp(const VmbHandle_t handle, const VmbInt64_t ip, const VmbI
     RETURN_AND_PRINT_ON_ERROR(VmbFeatureIntSet(handle, "GevDeviceForceIPAddress", ip));
     RETURN_AND_PRINT_ON_ERROR(VmbFeatureIntSet(handle, "GevDeviceForceSubnetMask", subnetMask));
     RETURN_AND_PRINT_ON_ERROR(VmbFeatureIntSet(handle, "GevDeviceForceGateway", gateway));
-    RETURN_AND_PRINT_ON_ERROR(VmbFeatureCommandRun(handle, "GevDeviceForceIP"));
 
-    VMB_PRINT("Force ip command sent. Waiting for completion...\n");
+    VMB_PRINT("Sending force ip command. Waiting for completion...\n");
 
     /*
-     * Wait for the force ip command to be completed
+     * Send the force ip command and wait for its completion
      */
-    VmbBool_t  completedForceIp = VmbBoolFalse;
-    VmbInt16_t retriesLeft      = 25;
-    do
+    VmbUint64_t latencyNs = 0;
+    const VmbError_t commandError = RunFeatureCommand(handle, "GevDeviceForceIP", FORCE_IP_TIMEOUT_MS, &latencyNs);
+    if (commandError == VmbErrorTimeout)
     {
-        BREAK_AND_PRINT_ON_ERROR(VmbFeatureCommandIsDone(handle, "GevDeviceForceIP", &completedForceIp));
-        if (!completedForceIp)
-        {
-            Sleep100Ms();
-            retriesLeft -= 1;
-        }
-    } while ((!completedForceIp) && (retriesLeft > 0));
+        VMB_PRINT("Force ip command not completed.\n");
+        return VmbErrorRetriesExceeded;
+    }
+    RETURN_AND_PRINT_ON_ERROR(commandError);
 
-    const char* const commandStatus = (completedForceIp) ? "completed" : "not completed";
-    VMB_PRINT("Force ip command %s.\n", commandStatus);
+    VMB_PRINT("Force ip command completed after %.1f ms.\n", latencyNs / 1e6);
 
-    return completedForceIp ? VmbErrorSuccess : VmbErrorRetriesExceeded;
+    return VmbErrorSuccess;
 }
@@ -32,4 +32,23 @@
 */
 VmbError_t ForceIp(const char* const mac, const char* const ip, const char* const subnet, const char* const gateway);
 
+/**
+ * \brief builds a cache of the MAC addresses of all devices found by the GigE Vision interfaces
+ *
+ * The DeviceSelector of every interface is swept once, with the interfaces searched in parallel.
+ * The following calls of ForceIp look the camera up in the cache instead of searching all interfaces again,
+ * which pays off when configuring several cameras. Cameras missing from the cache are still searched for.
+ * The cache has to be cleared before shutting down the VmbC API.
+ *
+ * \param[out] deviceCount The number of cached devices. Optional, can be 0.
+ *
+ * \return error code reporting the success of the operation
+*/
+VmbError_t ForceIpCacheDevices(VmbUint32_t* deviceCount);
+
+/**
+ * \brief clears the cache built by ForceIpCacheDevices
+*/
+void ForceIpClearDeviceCache(void);
+
 #endif // FORCE_IP_H_
@@ -16,13 +16,15 @@
 
 #include <VmbCExamplesCommon/PrintVmbVersion.h>
 #include <VmbCExamplesCommon/ErrorCodeToMessage.h>
+#include <VmbCExamplesCommon/TimedStartup.h>
 
-int ForceIpProg(const char* const strMAC, const char* const strIP, const char* const strSubnet, const char* const strGateway)
+int ForceIpProg(const char* const strMAC, const char* const strIP, const char* const strSubnet, const char* const strGateway,
+                const char* const transportLayerFilter)
 {
     /*
      * Initialize the VmbC API
      */
-    VmbError_t err = VmbStartup(NULL);
+    VmbError_t err = TimedStartup(transportLayerFilter, NULL);
     const VmbBool_t apiStartFailed = (VmbErrorSuccess != err);
     if (apiStartFailed)
     {
@@ -38,3 +40,47 @@ int ForceIpProg(const char* const strMAC, const char* const strIP, const char* c
 
     return (err == VmbErrorSuccess) ? 0 : 1;
 }
+
+int ForceIpBatchProg(const int configurationCount, char* const* const configurations, const char* const transportLayerFilter)
+{
+    /*
+     * Initialize the VmbC API
+     */
+    VmbError_t err = TimedStartup(transportLayerFilter, NULL);
+    const VmbBool_t apiStartFailed = (VmbErrorSuccess != err);
+    if (apiStartFailed)
+    {
+        printf("VmbStartup failed. %s Error code: %d.", ErrorCodeToMessage(err), err);
+        return 1;
+    }
+
+    PrintVmbVersion();
+
+    /*
+     * Find all devices once instead of searching the interfaces for every camera
+     */
+    VmbUint32_t deviceCount = 0;
+    err = ForceIpCacheDevices(&deviceCount);
+    if (err == VmbErrorSuccess)
+    {
+        printf("%u device(s) found on the GigE Vision interfaces\n\n", deviceCount);
+    }
+
+    int failedCount = 0;
+    for (int configurationIndex = 0; configurationIndex < configurationCount; configurationIndex++)
+    {
+        char* const* const configuration = configurations + 4 * configurationIndex;
+        printf("Configuring camera %s\n", configuration[0]);
+        if (ForceIp(configuration[0], configuration[1], configuration[2], configuration[3]) != VmbErrorSuccess)
+        {
+            ++failedCount;
+        }
+        printf("\n");
+    }
+
+    ForceIpClearDeviceCache();
+
+    VmbShutdown();
+
+    return (failedCount == 0) ? 0 : 1;
+}
@@ -22,9 +22,26 @@
  * \param[in] strIP        The desired ip address
  * \param[in] strSubnet    The desired subnet mask
  * \param[in] strGateway   The desired gateway. Optional, can be 0.
+ * \param[in] transportLayerFilter   The transport layers to load, see ParseTransportLayerFilter. Optional, can be 0.
  *
  * \return a code to return from main()
 */
-int ForceIpProg(const char* const strMAC, const char* const strIP, const char* const strSubnet, const char* const strGateway);
+int ForceIpProg(const char* const strMAC, const char* const strIP, const char* const strSubnet, const char* const strGateway,
+                const char* const transportLayerFilter);
+
+/**
+ * \brief modifies the IP configurations of several cameras identified by their mac addresses
+ *
+ * The MAC addresses of the devices of all GigE Vision interfaces are collected in a single parallel sweep first,
+ * so every camera is found without searching the interfaces again.
+ *
+ * \param[in] configurationCount  The number of configurations
+ * \param[in] configurations      The configurations as groups of four strings: MAC, IP, subnet mask and gateway;
+ *                                a gateway of 0.0.0.0 configures no gateway
+ * \param[in] transportLayerFilter The transport layers to load, see ParseTransportLayerFilter. Optional, can be 0.
+ *
+ * \return a code to return from main()
+*/
+int ForceIpBatchProg(const int configurationCount, char* const* const configurations, const char* const transportLayerFilter);
 
 #endif // FORCE_IP_PROG_H_
@@ -8,6 +8,9 @@
  */
 
 #include <stdio.h>
+#include <string.h>
+
+#include <VmbC/VmbCommonTypes.h>
 
 #include "ForceIpProg.h"
 
@@ -17,22 +20,45 @@ int main( int argc, char* argv[] )
     printf("/// VmbC API Force IP Example ///\n");
     printf("/////////////////////////////////\n\n");
 
-    if (4 > argc
+    // the transport layer filter precedes the other parameters
+    const char* transportLayerFilter = NULL;
+    if ((argc > 2) && (strcmp(argv[1], "/tl") == 0))
+    {
+        transportLayerFilter = argv[2];
+        argv += 2;
+        argc -= 2;
+    }
+
+    const VmbBool_t batch = (argc > 1) && (strcmp(argv[1], "/c") == 0);
+    if (batch
+        && (argc - 2) > 0
+        && (argc - 2) % 4 == 0)
+    {
+        return ForceIpBatchProg((argc - 2) / 4, argv + 2, transportLayerFilter);
+    }
+
+    if (batch
+        || 4 > argc
         || 5 < argc)
     {
-        printf("Usage: ForceIp_VmbC <MAC> <IP> <Subnet> [<Gateway>]\n\n");
+        printf("Usage: ForceIp_VmbC [/tl <filter>] <MAC> <IP> <Subnet> [<Gateway>]\n");
+        printf("       ForceIp_VmbC [/tl <filter>] /c <MAC> <IP> <Subnet> <Gateway> [<MAC> <IP> <Subnet> <Gateway> ...]\n\n");
         printf("Parameters:\n");
         printf("<MAC>      The MAC address of the camera whose IP address shall be changed.\n");
         printf("           Either hexadecimal with preceding 0x or decimal.\n");
         printf("<IP>       The new IPv4 address of the camera in numbers and dots notation.\n");
         printf("<Subnet>   The new network mask of the camera in numbers and dots notation.\n");
         printf("<Gateway>  The address of a possible gateway if the camera is not connected\n");
-        printf("           to the host PC directly.\n\n");
+        printf("           to the host PC directly.\n");
+        printf("/c         Configure several cameras, collecting the MAC addresses of all devices\n");
+        printf("           in a single sweep of the interfaces. Use the gateway 0.0.0.0 for none.\n");
+        printf("/tl        Load only the transport layers of a comma separated list of types and paths,\n");
+        printf("           e.g. GigE or /opt/VimbaX/cti/VimbaGigETL.cti\n\n");
         printf("For example to change the IP address of a camera with the MAC address 0x0F3101D540\nto 169.254.1.1 in a class B network call:\n\n");
         printf("ForceIp_VmbC 0x0F3101D540 169.254.1.1 255.255.0.0\n\n");
 
         return 1;
     }
 
-    return ForceIpProg(argv[1], argv[2], argv[3], (argc == 5) ? argv[4] : NULL);
+    return ForceIpProg(argv[1], argv[2], argv[3], (argc == 5) ? argv[4] : NULL, transportLayerFilter);
 }
@@ -12,10 +12,14 @@
 #include <VmbC/VmbC.h>
 
 #include <VmbCExamplesCommon/ArrayAlloc.h>
+#include <VmbCExamplesCommon/CameraInventory.h>
+#include <VmbCExamplesCommon/HandleIndex.h>
 #include <VmbCExamplesCommon/ListCameras.h>
 #include <VmbCExamplesCommon/ListInterfaces.h>
 #include <VmbCExamplesCommon/ListTransportLayers.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
 #include <VmbCExamplesCommon/PrintVmbVersion.h>
+#include <VmbCExamplesCommon/TimedStartup.h>
 
 void printAccessModes(VmbAccessMode_t accessMode)
 {
@@ -60,13 +64,83 @@ void printAccessModes(VmbAccessMode_t accessMode)
     printf("\n");
 }
 
-int ListCamerasProg(void)
+/**
+ * Print the cameras of the inventory in the same format as the cameras listed by the API
+ */
+void printInventory(CameraInventoryData const* inventory)
+{
+    VmbUint64_t const now = GetMonotonicTimeNs();
+    double const ageS = (now > inventory->updateTimeNs) ? (double)(now - inventory->updateTimeNs) / 1e9 : 0.0;
+
+    printf("Inventory of the DiscoveryDaemon, last changed %.1f s ago%s\n", ageS,
+           inventory->truncated ? " (truncated)" : "");
+    printf("TransportLayers found: %u\n", inventory->transportLayerCount);
+    printf("Interfaces found: %u\n", inventory->interfaceCount);
+    printf("Cameras found: %u\n\n", inventory->cameraCount);
+
+    for (VmbUint32_t i = 0; i < inventory->cameraCount; ++i)
+    {
+        InventoryCamera const* const cam = &inventory->cameras[i];
+        printf("/// Camera Name            : %s\n"
+               "/// Model Name             : %s\n"
+               "/// Camera ID              : %s\n"
+               "/// Serial Number          : %s\n",
+               cam->name,
+               cam->modelName,
+               cam->id,
+               cam->serial
+        );
+
+        printf("/// Permitted Access Modes : ");
+        printAccessModes((VmbAccessMode_t)cam->permittedAccess);
+
+        if (cam->interfaceIndex >= inventory->interfaceCount)
+        {
+            printf("corresponding interface not found\n");
+        }
+        else
+        {
+            printf("/// @ Interface ID         : %s\n", inventory->interfaces[cam->interfaceIndex].id);
+        }
+
+        if (cam->transportLayerIndex >= inventory->transportLayerCount)
+        {
+            printf("corresponding transport layer not found\n");
+        }
+        else
+        {
+            InventoryTransportLayer const* const tl = &inventory->transportLayers[cam->transportLayerIndex];
+            printf("/// @ Transport Layer ID   : %s\n", tl->id);
+            printf("/// @ Transport Layer Path : %s\n\n\n", tl->path);
+        }
+    }
+}
+
+int ListCamerasProg(bool useInventory, const char* transportLayerFilter)
 {
     PrintVmbVersion();
-    VmbError_t err = VmbStartup(NULL);
+
+    if (useInventory)
+    {
+        CameraInventoryData* const inventory = (CameraInventoryData*)malloc(sizeof(CameraInventoryData));
+        if (inventory != NULL && CameraInventoryReadOnce(inventory) == VmbErrorSuccess)
+        {
+            printInventory(inventory);
+            free(inventory);
+            return 0;
+        }
+        // no daemon running; enumerate the modules directly
+        free(inventory);
+    }
+
+    // time the startup, so the phases taking the time are visible
+    StartupTimings timings;
+    VmbError_t err = TimedStartup(transportLayerFilter, &timings);
 
     if (VmbErrorSuccess == err)
     {
+        PrintStartupTimings(&timings);
+
         VmbCameraInfo_t* cameras = NULL;
         VmbUint32_t cameraCount;
         VmbInterfaceInfo_t* interfaces = NULL;
@@ -80,13 +154,31 @@ int ListCamerasProg(void)
         if (err == VmbErrorSuccess) printf("Interfaces found: %u\n", interfaceCount);
         err |= ListCameras(&cameras, &cameraCount);
 
+        // index the parent modules by handle, so every camera is matched in constant time; one index per module
+        // type, so a handle is never taken for a module of the other type
+        HandleIndex transportLayerIndex;
+        HandleIndex interfaceIndex;
+        if (err == VmbErrorSuccess)
+        {
+            err = HandleIndexInit(&transportLayerIndex, transportLayerCount);
+            err |= HandleIndexInit(&interfaceIndex, interfaceCount);
+            if (err == VmbErrorSuccess)
+            {
+                err = HandleIndexAddTransportLayers(&transportLayerIndex, transportLayers, transportLayerCount);
+                err |= HandleIndexAddInterfaces(&interfaceIndex, interfaces, interfaceCount);
+            }
+            if (err != VmbErrorSuccess)
+            {
+                HandleIndexFree(&transportLayerIndex);
+                HandleIndexFree(&interfaceIndex);
+            }
+        }
+
         if (err == VmbErrorSuccess)
         {
             printf("Cameras found: %u\n\n", cameraCount);
 
             VmbCameraInfo_t* const camerasEnd = cameras + cameraCount;
-            VmbInterfaceInfo_t* const interfacesEnd = interfaces + interfaceCount;
-            VmbTransportLayerInfo_t* const tlsEnd = transportLayers + transportLayerCount;
 
             for (VmbCameraInfo_t* cam = cameras; cam != camerasEnd; ++cam)
             {
@@ -104,14 +196,7 @@ int ListCamerasProg(void)
                 printAccessModes(cam->permittedAccess);
 
                 // find corresponding interface
-                VmbInterfaceInfo_t* foundIFace = NULL;
-                for (VmbInterfaceInfo_t* iFace = interfaces; foundIFace == NULL && iFace != interfacesEnd; ++iFace)
-                {
-                    if (cam->interfaceHandle == iFace->interfaceHandle)
-                    {
-                        foundIFace = iFace;
-                    }
-                }
+                VmbInterfaceInfo_t const* const foundIFace = (VmbInterfaceInfo_t const*)HandleIndexFind(&interfaceIndex, cam->interfaceHandle);
 
                 if (foundIFace == NULL)
                 {
@@ -123,14 +208,7 @@ int ListCamerasProg(void)
                 }
 
                 // find corresponding transport layer
-                VmbTransportLayerInfo_t* foundTl = NULL;
-                for (VmbTransportLayerInfo_t* tl = transportLayers; foundTl == NULL && tl != tlsEnd; ++tl)
-                {
-                    if (cam->transportLayerHandle == tl->transportLayerHandle)
-                    {
-                        foundTl = tl;
-                    }
-                }
+                VmbTransportLayerInfo_t const* const foundTl = (VmbTransportLayerInfo_t const*)HandleIndexFind(&transportLayerIndex, cam->transportLayerHandle);
 
                 if (foundTl == NULL)
                 {
@@ -142,6 +220,9 @@ int ListCamerasProg(void)
                     printf("/// @ Transport Layer Path : %s\n\n\n", foundTl->transportLayerPath);
                 }
             }
+
+            HandleIndexFree(&transportLayerIndex);
+            HandleIndexFree(&interfaceIndex);
         }
         else
         {
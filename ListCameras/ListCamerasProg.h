@@ -6,10 +6,16 @@
 #ifndef LIST_CAMERAS_PROG_H_
 #define LIST_CAMERAS_PROG_H_
 
+#include <stdbool.h>
+
 /**
  * Starts Vmb, gets all connected cameras, and prints out information about the camera name,
  * model name, serial number, ID and the corresponding interface and transport layer IDs
+ *
+ * \param[in] useInventory          print the inventory published by a running DiscoveryDaemon instead, if available;
+ *                                  this avoids loading the transport layers and waiting for the discovery of the cameras
+ * \param[in] transportLayerFilter  the transport layers to load, see ParseTransportLayerFilter; NULL for all of them
  */
-int ListCamerasProg(void);
+int ListCamerasProg(bool useInventory, const char* transportLayerFilter);
 
 #endif
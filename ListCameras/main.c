@@ -4,6 +4,7 @@
 =============================================================================*/
 
 #include <stdio.h>
+#include <string.h>
 
 #include "ListCamerasProg.h"
 
@@ -13,10 +14,32 @@ int main( int argc, char* argv[] )
     printf( "/// Vmb API List Cameras Example ///\n" );
     printf( "////////////////////////////////////\n\n" );
 
-    if ( 1 < argc )
+    bool useInventory = true;
+    const char* transportLayerFilter = NULL;
+    for ( int i = 1; i < argc; ++i )
     {
-        printf( "No parameters expected. Execution will not be affected by the provided parameter(s).\n\n" );
+        if ( 0 == strcmp( argv[i], "/e" ) )
+        {
+            useInventory = false;
+        }
+        else if ( 0 == strcmp( argv[i], "/tl" ) && i + 1 < argc )
+        {
+            // the inventory of the daemon covers the transport layers the daemon loaded
+            useInventory = false;
+            transportLayerFilter = argv[++i];
+        }
+        else
+        {
+            printf( "Usage: ListCameras [/e] [/tl <filter>]\n\n" );
+            printf( "Parameters:   /e             Enumerate the cameras, even if the inventory of a running DiscoveryDaemon is available\n" );
+            printf( "              /tl <filter>   Load only the transport layers of a comma separated list of types and paths,\n" );
+            printf( "                             e.g. GigE,USB or /opt/VimbaX/cti/VimbaUSBTL.cti (implies /e)\n\n" );
+            printf( "Execution will not be affected by the provided parameter(s).\n\n" );
+            useInventory = true;
+            transportLayerFilter = NULL;
+            break;
+        }
     }
 
-    return ListCamerasProg();
+    return ListCamerasProg( useInventory, transportLayerFilter );
 }
@@ -0,0 +1,461 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FeatureDiff.h"
+#include "FeatureSnapshot.h"
+#include "ListFeatures.h"
+
+#include <VmbC/VmbC.h>
+
+#include <VmbCExamplesCommon/ArrayAlloc.h>
+#include <VmbCExamplesCommon/FeatureCache.h>
+#include <VmbCExamplesCommon/ListCameras.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/VmbStdatomic.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+#define VALUE_STRING_SIZE       64
+#define WATCH_PERIOD_NS         100000000ull    // time between the checks for invalidated features
+#define WATCH_POLL_PERIOD_NS    1000000000ull   // time between the reads of the features without invalidations
+
+/**
+ * \brief How the changes of a feature are observed
+ */
+typedef enum WatchMode
+{
+    WatchModeNone,          //!< The feature is not watched
+    WatchModeInvalidated,   //!< The feature is read again after its invalidation
+    WatchModePolled         //!< The feature never raises invalidations and is read every WATCH_POLL_PERIOD_NS
+} WatchMode;
+
+/**
+ * \brief The snapshot of a camera read by one of the threads
+ */
+typedef struct CameraSnapshotJob
+{
+    char const*     cameraId;
+    SnapshotModule  module;
+    VmbError_t      result;
+    thrd_t          thread;
+    bool            started;
+} CameraSnapshotJob;
+
+/**
+ * \brief Counters of the comparison of two cameras
+ */
+typedef struct DiffCounts
+{
+    VmbUint32_t different;
+    VmbUint32_t onlyReference;
+    VmbUint32_t onlyOther;
+    VmbUint32_t ignored;
+} DiffCounts;
+
+static int SnapshotCameraThread(void* arg)
+{
+    CameraSnapshotJob* const job = (CameraSnapshotJob*)arg;
+
+    VmbHandle_t remoteDevice = NULL;
+    job->result = VmbCameraOpen(job->cameraId, VmbAccessModeRead, &remoteDevice);
+    if (job->result == VmbErrorSuccess)
+    {
+        job->result = SnapshotReadModule(remoteDevice, &job->module);
+        SnapshotModuleSortByName(&job->module);
+        VmbCameraClose(remoteDevice);
+    }
+    return 0;
+}
+
+static void PrintValueDifference(char marker, SnapshotFeature const* feature, char const* note)
+{
+    printf("  %c %-48s %s\n", marker, feature->name, note);
+}
+
+/**
+ * \brief Compare two modules with features sorted by name
+ */
+static void DiffModules(SnapshotModule const* reference, SnapshotModule const* other, DiffCounts* counts)
+{
+    VmbUint32_t a = 0;
+    VmbUint32_t b = 0;
+    while (a < reference->featureCount || b < other->featureCount)
+    {
+        int const comparison = (a == reference->featureCount) ? 1
+                             : (b == other->featureCount) ? -1
+                             : strcmp(reference->features[a].name, other->features[b].name);
+        if (comparison < 0)
+        {
+            PrintValueDifference('-', &reference->features[a++], "only on the reference camera");
+            ++counts->onlyReference;
+        }
+        else if (comparison > 0)
+        {
+            PrintValueDifference('+', &other->features[b++], "only on this camera");
+            ++counts->onlyOther;
+        }
+        else
+        {
+            SnapshotFeature const* const featureA = &reference->features[a++];
+            SnapshotFeature const* const featureB = &other->features[b++];
+            if ((featureA->flags | featureB->flags) & SnapshotFeatureVolatile)
+            {
+                ++counts->ignored;
+            }
+            else if (!SnapshotFeatureValuesEqual(featureA, featureB))
+            {
+                char valueA[VALUE_STRING_SIZE];
+                char valueB[VALUE_STRING_SIZE];
+                SnapshotFeatureValueToString(featureA, valueA, sizeof(valueA));
+                SnapshotFeatureValueToString(featureB, valueB, sizeof(valueB));
+                printf("  ~ %-48s %s -> %s\n", featureA->name, valueA, valueB);
+                ++counts->different;
+            }
+            else if ((featureA->flags ^ featureB->flags) & (SnapshotFeatureReadable | SnapshotFeatureWriteable))
+            {
+                printf("  ! %-48s access %s%s -> %s%s\n", featureA->name,
+                       (featureA->flags & SnapshotFeatureReadable) ? "R" : "", (featureA->flags & SnapshotFeatureWriteable) ? "W" : "",
+                       (featureB->flags & SnapshotFeatureReadable) ? "R" : "", (featureB->flags & SnapshotFeatureWriteable) ? "W" : "");
+                ++counts->different;
+            }
+        }
+    }
+}
+
+int DiffCameraFeatures(char const* const* cameraArgs, size_t cameraCount)
+{
+    VmbError_t err = StartApi();
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not start the API: %d\n", err);
+        return 1;
+    }
+
+    VmbCameraInfo_t* cameras = NULL;
+    VmbUint32_t systemCameraCount = 0;
+    if (ListCameras(&cameras, &systemCameraCount) != VmbErrorSuccess)
+    {
+        systemCameraCount = 0;
+    }
+    if (cameraCount == 0)
+    {
+        cameraCount = systemCameraCount;
+    }
+    if (cameraCount > FEATURE_DIFF_MAX_CAMERAS)
+    {
+        printf("Only the first %d cameras are compared\n", FEATURE_DIFF_MAX_CAMERAS);
+        cameraCount = FEATURE_DIFF_MAX_CAMERAS;
+    }
+
+    CameraSnapshotJob* const jobs = (cameraCount >= 2) ? calloc(cameraCount, sizeof(CameraSnapshotJob)) : NULL;
+    if (jobs == NULL)
+    {
+        printf((cameraCount < 2) ? "At least two cameras are required for a comparison\n" : "Could not allocate memory\n");
+        free(cameras);
+        VmbShutdown();
+        return 1;
+    }
+
+    VmbUint64_t const startNs = GetMonotonicTimeNs();
+    for (size_t i = 0; i < cameraCount; i++)
+    {
+        jobs[i].cameraId = (cameraArgs != NULL) ? ResolveCameraId(cameraArgs[i], cameras, systemCameraCount) : cameras[i].cameraIdString;
+        jobs[i].module.type = SnapshotModuleRemoteDevice;
+        jobs[i].started = (thrd_create(&jobs[i].thread, SnapshotCameraThread, &jobs[i]) == thrd_success);
+        if (!jobs[i].started)
+        {
+            SnapshotCameraThread(&jobs[i]);
+        }
+    }
+    for (size_t i = 0; i < cameraCount; i++)
+    {
+        if (jobs[i].started)
+        {
+            thrd_join(jobs[i].thread, NULL);
+        }
+    }
+    printf("Read the features of %zu cameras in %.1f ms\n\n", cameraCount, (GetMonotonicTimeNs() - startNs) / 1e6);
+
+    CameraSnapshotJob const* const reference = &jobs[0];
+    size_t failedCount = 0;
+    if (reference->result != VmbErrorSuccess)
+    {
+        printf("Could not read the features of the reference camera %s. Error code: %d\n", reference->cameraId, reference->result);
+        failedCount = 1;
+    }
+    else
+    {
+        printf("Reference camera: %s (%u features)\n\n", reference->cameraId, reference->module.featureCount);
+        for (size_t i = 1; i < cameraCount; i++)
+        {
+            CameraSnapshotJob const* const job = &jobs[i];
+            if (job->result != VmbErrorSuccess)
+            {
+                printf("Could not read the features of camera %s. Error code: %d\n\n", job->cameraId, job->result);
+                ++failedCount;
+                continue;
+            }
+
+            printf("Camera %s (%u features):\n", job->cameraId, job->module.featureCount);
+            DiffCounts counts = { 0 };
+            DiffModules(&reference->module, &job->module, &counts);
+            printf("  %u features differ, %u only on the reference camera, %u only on this camera; %u volatile features not compared\n\n",
+                   counts.different, counts.onlyReference, counts.onlyOther, counts.ignored);
+        }
+    }
+
+    for (size_t i = 0; i < cameraCount; i++)
+    {
+        SnapshotModuleFree(&jobs[i].module);
+    }
+    free(jobs);
+    free(cameras);
+    VmbShutdown();
+    return (failedCount == 0) ? 0 : 1;
+}
+
+static bool IsWatchable(SnapshotFeature const* feature)
+{
+    return (feature->flags & SnapshotFeatureHasValue) && !(feature->flags & SnapshotFeatureVolatile)
+        && (feature->type == VmbFeatureDataInt || feature->type == VmbFeatureDataFloat
+            || feature->type == VmbFeatureDataBool || feature->type == VmbFeatureDataEnum);
+}
+
+/**
+ * \brief Read the value of a feature through the cache
+ *
+ * \param[out] current  receives the value; an enum value is owned by the API
+ */
+static VmbError_t ReadCachedValue(FeatureCache* cache, SnapshotFeature const* feature, SnapshotFeature* current)
+{
+    memset(current, 0, sizeof(SnapshotFeature));
+    current->name = feature->name;
+    current->type = feature->type;
+
+    VmbError_t err = VmbErrorWrongType;
+    switch (feature->type)
+    {
+    case VmbFeatureDataInt:
+        err = FeatureCacheGetInt(cache, feature->name, &current->intValue);
+        break;
+    case VmbFeatureDataFloat:
+        err = FeatureCacheGetFloat(cache, feature->name, &current->floatValue);
+        break;
+    case VmbFeatureDataBool:
+    {
+        VmbBool_t value = VmbBoolFalse;
+        err = FeatureCacheGetBool(cache, feature->name, &value);
+        current->intValue = value ? 1 : 0;
+        break;
+    }
+    case VmbFeatureDataEnum:
+    {
+        char const* value = NULL;
+        err = FeatureCacheGetEnum(cache, feature->name, &value);
+        current->stringValue = (char*)value;
+        break;
+    }
+    default:
+        break;
+    }
+    current->flags = (err == VmbErrorSuccess) ? SnapshotFeatureHasValue : 0;
+    return err;
+}
+
+/**
+ * \brief Store the value read through the cache in the snapshot
+ */
+static void UpdateValue(SnapshotFeature* feature, SnapshotFeature const* current)
+{
+    feature->flags = (feature->flags & ~(VmbUint32_t)SnapshotFeatureHasValue) | (current->flags & SnapshotFeatureHasValue);
+    feature->intValue = current->intValue;
+    feature->floatValue = current->floatValue;
+    if (feature->type == VmbFeatureDataEnum)
+    {
+        free(feature->stringValue);
+        feature->stringValue = NULL;
+        if (current->stringValue != NULL)
+        {
+            size_t const size = strlen(current->stringValue) + 1;
+            feature->stringValue = VMB_MALLOC_ARRAY(char, size);
+            if (feature->stringValue != NULL)
+            {
+                memcpy(feature->stringValue, current->stringValue, size);
+            }
+        }
+    }
+}
+
+static int WaitForEnterThread(void* arg)
+{
+    atomic_ullong* const stop = (atomic_ullong*)arg;
+    ((void)getchar());
+    atomic_store(stop, 1);
+    return 0;
+}
+
+/**
+ * \brief Print the changed values of the watched features until \p stop is set or the end time is reached
+ *
+ * The invalidated features are read again every WATCH_PERIOD_NS. Only the features whose invalidations cannot be
+ * observed are read every WATCH_POLL_PERIOD_NS.
+ *
+ * \return the number of changes printed
+ */
+static VmbUint64_t WatchFeatures(FeatureCache* cache, SnapshotModule* module, WatchMode const* modes, atomic_ullong* stop,
+                                 VmbUint64_t startNs, VmbUint64_t endNs)
+{
+    VmbUint64_t changes = 0;
+    VmbUint64_t wakeUpNs = startNs;
+    VmbUint64_t nextPollNs = startNs + WATCH_POLL_PERIOD_NS;
+    while (atomic_load(stop) == 0 && (endNs == 0 || wakeUpNs < endNs))
+    {
+        wakeUpNs += WATCH_PERIOD_NS;
+        SleepUntilMonotonicNs(wakeUpNs);
+
+        bool const poll = (wakeUpNs >= nextPollNs);
+        if (poll)
+        {
+            nextPollNs += WATCH_POLL_PERIOD_NS;
+        }
+
+        for (VmbUint32_t i = 0; i < module->featureCount; i++)
+        {
+            SnapshotFeature* const feature = &module->features[i];
+            bool const due = (modes[i] == WatchModeInvalidated) ? FeatureCacheIsStale(cache, feature->name)
+                                                                : (modes[i] == WatchModePolled && poll);
+            if (!due)
+            {
+                continue;
+            }
+
+            SnapshotFeature current;
+            ReadCachedValue(cache, feature, &current);
+
+            if (!SnapshotFeatureValuesEqual(feature, &current))
+            {
+                char oldValue[VALUE_STRING_SIZE];
+                char newValue[VALUE_STRING_SIZE];
+                SnapshotFeatureValueToString(feature, oldValue, sizeof(oldValue));
+                SnapshotFeatureValueToString(&current, newValue, sizeof(newValue));
+                printf("[%10.3f s] %-48s %s -> %s\n", (GetMonotonicTimeNs() - startNs) / 1e9, feature->name, oldValue, newValue);
+                UpdateValue(feature, &current);
+                ++changes;
+            }
+        }
+    }
+    return changes;
+}
+
+int WatchCameraFeatures(char const* camera, unsigned long durationS)
+{
+    VmbError_t err = StartApi();
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not start the API: %d\n", err);
+        return 1;
+    }
+
+    VmbCameraInfo_t* cameras = NULL;
+    VmbUint32_t cameraCount = 0;
+    if (ListCameras(&cameras, &cameraCount) != VmbErrorSuccess)
+    {
+        cameraCount = 0;
+    }
+    char const* const cameraId = ResolveCameraId(camera, cameras, cameraCount);
+
+    VmbHandle_t remoteDevice = NULL;
+    err = VmbCameraOpen(cameraId, VmbAccessModeRead, &remoteDevice);
+    if (err != VmbErrorSuccess)
+    {
+        printf("Error opening camera %s: %d\n", cameraId, err);
+        free(cameras);
+        VmbShutdown();
+        return 1;
+    }
+
+    // the cache must not move while the invalidation callbacks are registered
+    SnapshotModule module = { SnapshotModuleRemoteDevice };
+    FeatureCache* const cache = malloc(sizeof(FeatureCache));
+    WatchMode* modes = NULL;
+    err = (cache != NULL) ? SnapshotReadModule(remoteDevice, &module) : VmbErrorResources;
+    if (err == VmbErrorSuccess)
+    {
+        modes = calloc(module.featureCount + 1, sizeof(WatchMode));
+        err = (modes != NULL) ? FeatureCacheInit(cache, remoteDevice) : VmbErrorResources;
+    }
+
+    if (err == VmbErrorSuccess)
+    {
+        VmbUint32_t watchedCount = 0;
+        VmbUint32_t polledCount = 0;
+        for (VmbUint32_t i = 0; i < module.featureCount; i++)
+        {
+            SnapshotFeature current;
+            VmbBool_t invalidated = VmbBoolFalse;
+            if (IsWatchable(&module.features[i])
+                && FeatureCacheWatch(cache, module.features[i].name, &invalidated) == VmbErrorSuccess
+                && ReadCachedValue(cache, &module.features[i], &current) == VmbErrorSuccess)
+            {
+                UpdateValue(&module.features[i], &current);
+                modes[i] = invalidated ? WatchModeInvalidated : WatchModePolled;
+                ++watchedCount;
+                polledCount += invalidated ? 0 : 1;
+            }
+        }
+
+        FeatureCacheStats initialStats;
+        FeatureCacheGetStats(cache, &initialStats);
+
+        printf("Watching %u of %u features of camera %s; volatile, string and command features are not watched\n",
+               watchedCount, module.featureCount, cameraId);
+        printf("%u features without invalidations are polled; changes made by other applications are not observed\n",
+               polledCount);
+
+        atomic_ullong stop;
+        atomic_store(&stop, 0);
+        thrd_t enterThread;
+        bool enterThreadStarted = false;
+        if (durationS == 0)
+        {
+            printf("Press <enter> to stop watching...\n");
+            enterThreadStarted = (thrd_create(&enterThread, WaitForEnterThread, &stop) == thrd_success);
+        }
+        printf("\n");
+
+        VmbUint64_t const startNs = GetMonotonicTimeNs();
+        VmbUint64_t const endNs = (durationS != 0 || !enterThreadStarted) ? startNs + (VmbUint64_t)((durationS != 0) ? durationS : 60) * 1000000000ull : 0;
+        VmbUint64_t const changes = WatchFeatures(cache, &module, modes, &stop, startNs, endNs);
+
+        if (enterThreadStarted)
+        {
+            thrd_join(enterThread, NULL);
+        }
+
+        FeatureCacheStats stats;
+        FeatureCacheGetStats(cache, &stats);
+        printf("\n%llu changes; %llu invalidations, %llu features read again, %llu of them polled\n",
+               (unsigned long long)changes, (unsigned long long)stats.invalidations,
+               (unsigned long long)(stats.misses + stats.uncached - initialStats.misses - initialStats.uncached),
+               (unsigned long long)(stats.uncached - initialStats.uncached));
+        FeatureCacheDestroy(cache);
+    }
+    else
+    {
+        printf("Could not read the features of camera %s. Error code: %d\n", cameraId, err);
+    }
+
+    free(modes);
+    free(cache);
+    SnapshotModuleFree(&module);
+    VmbCameraClose(remoteDevice);
+    free(cameras);
+    VmbShutdown();
+    return (err == VmbErrorSuccess) ? 0 : 1;
+}
@@ -0,0 +1,44 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FEATURE_DIFF_H_
+#define FEATURE_DIFF_H_
+
+#include <stddef.h>
+
+#include "VmbC/VmbCTypeDefinitions.h"
+
+#define FEATURE_DIFF_MAX_CAMERAS    64
+
+/**
+ * \brief compare the remote device features of cameras with the features of the first camera
+ *
+ * The features of all cameras are read in parallel, one thread per camera. The features of every camera are sorted
+ * by name, so a camera is compared to the reference camera by a single linear merge of the two lists. Volatile
+ * features, e.g. temperatures, are not compared.
+ *
+ * \param[in] cameras       the indices or ids of the cameras
+ * \param[in] cameraCount   the number of cameras; 0 for all cameras of the system
+ *
+ * \return a code to return from main()
+ */
+int DiffCameraFeatures(char const* const* cameras, size_t cameraCount);
+
+/**
+ * \brief print the changes of the remote device features of a camera
+ *
+ * Invalidation callbacks are registered for all non volatile features with int, float, bool or enum values. The
+ * invalidated features are read again promptly. Only the features whose invalidation callback cannot be registered
+ * are read once per second. Changes made by other applications are not invalidated and therefore not observed.
+ * Changed values are printed with the time since the start.
+ *
+ * \param[in] camera        the index or the id of the camera
+ * \param[in] durationS     the number of seconds to watch the camera; 0 to watch until enter is pressed
+ *
+ * \return a code to return from main()
+ */
+int WatchCameraFeatures(char const* camera, unsigned long durationS);
+
+#endif
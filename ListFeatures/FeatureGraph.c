@@ -0,0 +1,482 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FeatureGraph.h"
+#include "ListFeatures.h"
+
+#include <VmbC/VmbC.h>
+
+#include <VmbCExamplesCommon/ArrayAlloc.h>
+#include <VmbCExamplesCommon/ListCameras.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/VmbStdatomic.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+/**
+ * \brief The features of one category, processed by a single worker
+ */
+typedef struct CategoryJob
+{
+    VmbUint32_t first;  //!< Position of the first feature of the category in GraphBuildContext::byCategory
+    VmbUint32_t count;
+} CategoryJob;
+
+/**
+ * \brief A sort key of a node, either its feature name or its category, with the index of the node
+ */
+typedef struct SortedNode
+{
+    char const* key;
+    VmbUint32_t index;
+} SortedNode;
+
+/**
+ * \brief The state shared by the workers
+ */
+typedef struct GraphBuildContext
+{
+    VmbHandle_t         handle;
+    FeatureGraph*       graph;
+    SortedNode const*   byName;         //!< Nodes sorted by feature name
+    SortedNode const*   byCategory;     //!< Nodes sorted by category
+    CategoryJob const*  jobs;
+    VmbUint32_t         jobCount;
+    atomic_ullong       nextJob;
+} GraphBuildContext;
+
+static int CompareSortedNodes(void const* a, void const* b)
+{
+    SortedNode const* const nodeA = (SortedNode const*)a;
+    SortedNode const* const nodeB = (SortedNode const*)b;
+    int const comparison = strcmp(nodeA->key, nodeB->key);
+    if (comparison != 0)
+    {
+        return comparison;
+    }
+    return (nodeA->index < nodeB->index) ? -1 : (nodeA->index > nodeB->index);
+}
+
+/**
+ * \return the index of the node of the feature or the node count, if there is no such feature
+ */
+static VmbUint32_t FindNode(FeatureGraph const* graph, SortedNode const* byName, char const* name)
+{
+    VmbUint32_t low = 0;
+    VmbUint32_t high = graph->nodeCount;
+    while (low < high)
+    {
+        VmbUint32_t const middle = low + (high - low) / 2;
+        int const comparison = strcmp(byName[middle].key, name);
+        if (comparison == 0)
+        {
+            return byName[middle].index;
+        }
+        if (comparison < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return graph->nodeCount;
+}
+
+/**
+ * \brief Store the nodes of the features selected by a selector
+ */
+static VmbError_t ListSelectedNodes(GraphBuildContext const* context, FeatureGraphNode* node)
+{
+    VmbUint32_t count = 0;
+    VmbError_t err = VmbFeatureListSelected(context->handle, node->info->name, NULL, 0, &count, sizeof(VmbFeatureInfo_t));
+    if (err != VmbErrorSuccess || count == 0)
+    {
+        return err;
+    }
+
+    VmbFeatureInfo_t* const selected = VMB_MALLOC_ARRAY(VmbFeatureInfo_t, count);
+    node->selected = VMB_MALLOC_ARRAY(VmbUint32_t, count);
+    if (selected == NULL || node->selected == NULL)
+    {
+        free(selected);
+        return VmbErrorResources;
+    }
+
+    err = VmbFeatureListSelected(context->handle, node->info->name, selected, count, &count, sizeof(VmbFeatureInfo_t));
+    for (VmbUint32_t i = 0; err == VmbErrorSuccess && i < count; i++)
+    {
+        VmbUint32_t const target = FindNode(context->graph, context->byName, selected[i].name);
+        if (target < context->graph->nodeCount)
+        {
+            node->selected[node->selectedCount++] = target;
+        }
+    }
+    free(selected);
+    return err;
+}
+
+/**
+ * \brief Worker taking the categories from the list until all categories are taken
+ */
+static int CategoryWorker(void* arg)
+{
+    GraphBuildContext* const context = (GraphBuildContext*)arg;
+    for (;;)
+    {
+        size_t const jobIndex = (size_t)atomic_fetch_add(&context->nextJob, 1);
+        if (jobIndex >= context->jobCount)
+        {
+            return 0;
+        }
+
+        CategoryJob const* const job = &context->jobs[jobIndex];
+        for (VmbUint32_t i = 0; i < job->count; i++)
+        {
+            FeatureGraphNode* const node = &context->graph->nodes[context->byCategory[job->first + i].index];
+            if (node->info->hasSelectedFeatures)
+            {
+                // a selector whose features cannot be listed just has no edges
+                ListSelectedNodes(context, node);
+            }
+        }
+    }
+}
+
+/**
+ * \brief Split the features sorted by category into one job per category
+ *
+ * \return the number of jobs
+ */
+static VmbUint32_t CreateCategoryJobs(FeatureGraph const* graph, SortedNode const* byCategory, CategoryJob* jobs)
+{
+    VmbUint32_t jobCount = 0;
+    for (VmbUint32_t i = 0; i < graph->nodeCount; i++)
+    {
+        if (i == 0 || strcmp(byCategory[i].key, byCategory[i - 1].key) != 0)
+        {
+            jobs[jobCount].first = i;
+            jobs[jobCount].count = 0;
+            ++jobCount;
+        }
+        ++jobs[jobCount - 1].count;
+    }
+    return jobCount;
+}
+
+static void RunCategoryJobs(GraphBuildContext* context, size_t threadCount)
+{
+    thrd_t threads[FEATURE_GRAPH_MAX_THREADS];
+    size_t startedThreads = 0;
+    while (startedThreads < threadCount && thrd_create(&threads[startedThreads], CategoryWorker, context) == thrd_success)
+    {
+        ++startedThreads;
+    }
+    if (startedThreads == 0)
+    {
+        CategoryWorker(context);
+    }
+    for (size_t i = 0; i < startedThreads; i++)
+    {
+        thrd_join(threads[i], NULL);
+    }
+}
+
+/**
+ * \brief Order the nodes using Kahn's algorithm; ties are resolved by the order of the feature list
+ */
+static VmbError_t SortTopologically(FeatureGraph* graph)
+{
+    VmbUint32_t* const remainingSelectors = VMB_MALLOC_ARRAY(VmbUint32_t, (graph->nodeCount + 1));
+    bool* const ordered = calloc(graph->nodeCount + 1, sizeof(bool));
+    graph->order = VMB_MALLOC_ARRAY(VmbUint32_t, (graph->nodeCount + 1));
+    if (remainingSelectors == NULL || ordered == NULL || graph->order == NULL)
+    {
+        free(remainingSelectors);
+        free(ordered);
+        return VmbErrorResources;
+    }
+
+    VmbUint32_t orderCount = 0;
+    for (VmbUint32_t i = 0; i < graph->nodeCount; i++)
+    {
+        remainingSelectors[i] = graph->nodes[i].selectorCount;
+        if (remainingSelectors[i] == 0)
+        {
+            graph->order[orderCount++] = i;
+            ordered[i] = true;
+        }
+    }
+
+    // the order array doubles as the queue of the nodes whose selectors are all ordered
+    for (VmbUint32_t head = 0; head < orderCount; head++)
+    {
+        FeatureGraphNode const* const node = &graph->nodes[graph->order[head]];
+        for (VmbUint32_t i = 0; i < node->selectedCount; i++)
+        {
+            VmbUint32_t const target = node->selected[i];
+            if (--remainingSelectors[target] == 0)
+            {
+                graph->order[orderCount++] = target;
+                ordered[target] = true;
+            }
+        }
+    }
+
+    graph->cyclicCount = graph->nodeCount - orderCount;
+    for (VmbUint32_t i = 0; i < graph->nodeCount && orderCount < graph->nodeCount; i++)
+    {
+        if (!ordered[i])
+        {
+            graph->order[orderCount++] = i;
+        }
+    }
+
+    free(remainingSelectors);
+    free(ordered);
+    return VmbErrorSuccess;
+}
+
+VmbError_t FeatureGraphBuild(VmbHandle_t handle, size_t threadCount, FeatureGraph* graph)
+{
+    memset(graph, 0, sizeof(FeatureGraph));
+
+    VmbUint32_t count = 0;
+    VmbError_t err = VmbFeaturesList(handle, NULL, 0, &count, sizeof(VmbFeatureInfo_t));
+    if (err != VmbErrorSuccess || count == 0)
+    {
+        return err;
+    }
+
+    graph->infos = VMB_MALLOC_ARRAY(VmbFeatureInfo_t, count);
+    graph->nodes = calloc(count, sizeof(FeatureGraphNode));
+    SortedNode* const byName = VMB_MALLOC_ARRAY(SortedNode, count);
+    SortedNode* const byCategory = VMB_MALLOC_ARRAY(SortedNode, count);
+    CategoryJob* const jobs = VMB_MALLOC_ARRAY(CategoryJob, count);
+    err = (graph->infos != NULL && graph->nodes != NULL && byName != NULL && byCategory != NULL && jobs != NULL)
+        ? VmbFeaturesList(handle, graph->infos, count, &count, sizeof(VmbFeatureInfo_t))
+        : VmbErrorResources;
+
+    if (err == VmbErrorSuccess)
+    {
+        graph->nodeCount = count;
+        for (VmbUint32_t i = 0; i < count; i++)
+        {
+            graph->nodes[i].info = &graph->infos[i];
+            byName[i].key = graph->infos[i].name;
+            byName[i].index = i;
+            byCategory[i].key = PrintableString(graph->infos[i].category);
+            byCategory[i].index = i;
+        }
+        qsort(byName, count, sizeof(SortedNode), CompareSortedNodes);
+        qsort(byCategory, count, sizeof(SortedNode), CompareSortedNodes);
+
+        GraphBuildContext context;
+        context.handle = handle;
+        context.graph = graph;
+        context.byName = byName;
+        context.byCategory = byCategory;
+        context.jobs = jobs;
+        context.jobCount = CreateCategoryJobs(graph, byCategory, jobs);
+        atomic_store(&context.nextJob, 0);
+        graph->categoryCount = context.jobCount;
+
+        if (threadCount == 0)
+        {
+            threadCount = FEATURE_GRAPH_DEFAULT_THREADS;
+        }
+        if (threadCount > FEATURE_GRAPH_MAX_THREADS)
+        {
+            threadCount = FEATURE_GRAPH_MAX_THREADS;
+        }
+        if (threadCount > context.jobCount)
+        {
+            threadCount = context.jobCount;
+        }
+        RunCategoryJobs(&context, threadCount);
+
+        for (VmbUint32_t i = 0; i < count; i++)
+        {
+            FeatureGraphNode const* const node = &graph->nodes[i];
+            graph->edgeCount += node->selectedCount;
+            for (VmbUint32_t j = 0; j < node->selectedCount; j++)
+            {
+                ++graph->nodes[node->selected[j]].selectorCount;
+            }
+        }
+        err = SortTopologically(graph);
+    }
+
+    free(jobs);
+    free(byCategory);
+    free(byName);
+    if (err != VmbErrorSuccess)
+    {
+        FeatureGraphFree(graph);
+    }
+    return err;
+}
+
+void FeatureGraphWriteDot(FeatureGraph const* graph, FILE* file)
+{
+    fprintf(file, "digraph Features {\n");
+    fprintf(file, "    rankdir=LR;\n");
+    for (VmbUint32_t i = 0; i < graph->nodeCount; i++)
+    {
+        FeatureGraphNode const* const node = &graph->nodes[i];
+        for (VmbUint32_t j = 0; j < node->selectedCount; j++)
+        {
+            fprintf(file, "    \"%s\" -> \"%s\";\n", node->info->name, graph->nodes[node->selected[j]].info->name);
+        }
+    }
+    fprintf(file, "}\n");
+}
+
+void FeatureGraphWriteJson(FeatureGraph const* graph, FILE* file)
+{
+    fprintf(file, "{\n  \"nodes\": [\n");
+    for (VmbUint32_t i = 0; i < graph->nodeCount; i++)
+    {
+        FeatureGraphNode const* const node = &graph->nodes[i];
+        fprintf(file, "    { \"name\": \"%s\", \"category\": \"%s\", \"selects\": [", node->info->name, PrintableString(node->info->category));
+        for (VmbUint32_t j = 0; j < node->selectedCount; j++)
+        {
+            fprintf(file, "%s\"%s\"", (j == 0) ? "" : ", ", graph->nodes[node->selected[j]].info->name);
+        }
+        fprintf(file, "] }%s\n", (i + 1 < graph->nodeCount) ? "," : "");
+    }
+    fprintf(file, "  ],\n  \"order\": [");
+    for (VmbUint32_t i = 0; i < graph->nodeCount; i++)
+    {
+        fprintf(file, "%s\"%s\"", (i == 0) ? "" : ", ", graph->nodes[graph->order[i]].info->name);
+    }
+    fprintf(file, "],\n  \"cyclic\": %u\n}\n", graph->cyclicCount);
+}
+
+void FeatureGraphFree(FeatureGraph* graph)
+{
+    if (graph->nodes != NULL)
+    {
+        for (VmbUint32_t i = 0; i < graph->nodeCount; i++)
+        {
+            free(graph->nodes[i].selected);
+        }
+    }
+    free(graph->nodes);
+    free(graph->infos);
+    free(graph->order);
+    memset(graph, 0, sizeof(FeatureGraph));
+}
+
+static bool HasExtension(char const* path, char const* extension)
+{
+    size_t const pathLength = strlen(path);
+    size_t const extensionLength = strlen(extension);
+    return pathLength >= extensionLength && strcmp(path + pathLength - extensionLength, extension) == 0;
+}
+
+/**
+ * \brief Print the write order; only the selectors and the features they select are of interest
+ */
+static void PrintOrder(FeatureGraph const* graph)
+{
+    printf("Write order of the selectors and the selected features:\n");
+    VmbUint32_t position = 0;
+    for (VmbUint32_t i = 0; i < graph->nodeCount; i++)
+    {
+        FeatureGraphNode const* const node = &graph->nodes[graph->order[i]];
+        if (node->selectedCount != 0 || node->selectorCount != 0)
+        {
+            printf("  %4u %s%s\n", ++position, node->info->name, (node->selectedCount != 0) ? " (selector)" : "");
+        }
+    }
+    if (graph->cyclicCount != 0)
+    {
+        printf("%u features are part of selector cycles; they are appended in the order of the feature list\n", graph->cyclicCount);
+    }
+}
+
+int ExportFeatureGraph(char const* camera, char const* path, size_t threadCount)
+{
+    VmbError_t err = StartApi();
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not start the API: %d\n", err);
+        return 1;
+    }
+
+    VmbCameraInfo_t* cameras = NULL;
+    VmbUint32_t cameraCount = 0;
+    if (ListCameras(&cameras, &cameraCount) != VmbErrorSuccess)
+    {
+        cameraCount = 0;
+    }
+    char const* const cameraId = ResolveCameraId(camera, cameras, cameraCount);
+
+    VmbHandle_t remoteDevice = NULL;
+    err = VmbCameraOpen(cameraId, VmbAccessModeRead, &remoteDevice);
+    if (err == VmbErrorSuccess)
+    {
+        // the feature infos of the graph are only valid while the camera is open
+        VmbUint64_t const startNs = GetMonotonicTimeNs();
+        FeatureGraph graph;
+        err = FeatureGraphBuild(remoteDevice, threadCount, &graph);
+        if (err == VmbErrorSuccess)
+        {
+            printf("Built the graph of %u features in %u categories with %u selector edges in %.1f ms\n\n",
+                   graph.nodeCount, graph.categoryCount, graph.edgeCount, (GetMonotonicTimeNs() - startNs) / 1e6);
+            PrintOrder(&graph);
+
+            if (path == NULL)
+            {
+                printf("\n");
+                FeatureGraphWriteDot(&graph, stdout);
+            }
+            else
+            {
+                FILE* const file = fopen(path, "w");
+                if (file != NULL)
+                {
+                    if (HasExtension(path, ".json"))
+                    {
+                        FeatureGraphWriteJson(&graph, file);
+                    }
+                    else
+                    {
+                        FeatureGraphWriteDot(&graph, file);
+                    }
+                    bool const ok = (ferror(file) == 0);
+                    err = (fclose(file) == 0 && ok) ? VmbErrorSuccess : VmbErrorInvalidAccess;
+                }
+                else
+                {
+                    err = VmbErrorInvalidAccess;
+                }
+                if (err != VmbErrorSuccess)
+                {
+                    printf("Could not write \"%s\"\n", path);
+                }
+            }
+            FeatureGraphFree(&graph);
+        }
+        else
+        {
+            printf("Could not build the feature graph. Error code: %d\n", err);
+        }
+        VmbCameraClose(remoteDevice);
+    }
+    else
+    {
+        printf("Error opening camera %s: %d\n", cameraId, err);
+    }
+
+    free(cameras);
+    VmbShutdown();
+    return (err == VmbErrorSuccess) ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FEATURE_GRAPH_H_
+#define FEATURE_GRAPH_H_
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "VmbC/VmbCTypeDefinitions.h"
+
+#define FEATURE_GRAPH_DEFAULT_THREADS   8
+#define FEATURE_GRAPH_MAX_THREADS       64
+
+/**
+ * \brief A feature and the features it selects
+ */
+typedef struct FeatureGraphNode
+{
+    VmbFeatureInfo_t const* info;
+    VmbUint32_t*            selected;       //!< Indices of the nodes of the selected features
+    VmbUint32_t             selectedCount;
+    VmbUint32_t             selectorCount;  //!< Number of features selecting this feature
+} FeatureGraphNode;
+
+/**
+ * \brief The selector dependencies of the features of a module
+ *
+ * There is an edge from every selector to each of the features it selects. A feature selected by a selector is
+ * only meaningful after the selector has been written, so the topological order of the graph is an order the
+ * features can be written in without writing any feature twice.
+ */
+typedef struct FeatureGraph
+{
+    VmbFeatureInfo_t*   infos;
+    FeatureGraphNode*   nodes;
+    VmbUint32_t         nodeCount;
+    VmbUint32_t         edgeCount;
+    VmbUint32_t         categoryCount;
+    VmbUint32_t*        order;          //!< The node indices in topological order; nodes on cycles are appended in list order
+    VmbUint32_t         cyclicCount;    //!< Number of nodes that could not be ordered due to cycles
+} FeatureGraph;
+
+/**
+ * \brief Build the selector graph of the features of a module
+ *
+ * The selected features are listed by a pool of worker threads, each worker taking all features of the next
+ * category. The feature infos are only valid as long as the module is open.
+ *
+ * \param[in]  handle       the handle of the module
+ * \param[in]  threadCount  the number of worker threads; 0 for a default
+ * \param[out] graph        the graph to fill
+ */
+VmbError_t FeatureGraphBuild(VmbHandle_t handle, size_t threadCount, FeatureGraph* graph);
+
+/**
+ * \brief Write the edges of the graph in the Graphviz DOT format; features without selector relationship are omitted
+ */
+void FeatureGraphWriteDot(FeatureGraph const* graph, FILE* file);
+
+/**
+ * \brief Write all nodes with their adjacency lists and the topological order as JSON
+ */
+void FeatureGraphWriteJson(FeatureGraph const* graph, FILE* file);
+
+void FeatureGraphFree(FeatureGraph* graph);
+
+/**
+ * \brief print the topological order of the remote device features of a camera and export the graph
+ *
+ * \param[in] camera        the index or the id of the camera
+ * \param[in] path          the file to write; JSON for the extension .json, DOT otherwise; NULL to print the DOT graph
+ * \param[in] threadCount   the number of worker threads; 0 for a default
+ *
+ * \return a code to return from main()
+ */
+int ExportFeatureGraph(char const* camera, char const* path, size_t threadCount);
+
+#endif
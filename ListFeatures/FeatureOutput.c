@@ -0,0 +1,79 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FeatureOutput.h"
+
+#define FEATURE_OUTPUT_INITIAL_CAPACITY 4096
+
+void FeatureOutputPrintf(FeatureOutput* output, char const* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    if (output == NULL)
+    {
+        vprintf(format, args);
+        va_end(args);
+        return;
+    }
+
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    int const required = vsnprintf(NULL, 0, format, argsCopy);
+    va_end(argsCopy);
+
+    if (required > 0)
+    {
+        size_t const neededCapacity = output->length + (size_t)required + 1;
+        if (neededCapacity > output->capacity)
+        {
+            size_t newCapacity = (output->capacity == 0) ? FEATURE_OUTPUT_INITIAL_CAPACITY : output->capacity;
+            while (newCapacity < neededCapacity)
+            {
+                newCapacity *= 2;
+            }
+            char* const newText = realloc(output->text, newCapacity);
+            if (newText != NULL)
+            {
+                output->text = newText;
+                output->capacity = newCapacity;
+            }
+        }
+
+        if (neededCapacity <= output->capacity)
+        {
+            vsnprintf(output->text + output->length, output->capacity - output->length, format, args);
+            output->length += (size_t)required;
+        }
+        else
+        {
+            output->truncated = true;
+        }
+    }
+    va_end(args);
+}
+
+void FeatureOutputWrite(FeatureOutput const* output)
+{
+    if (output->length != 0)
+    {
+        fwrite(output->text, 1, output->length, stdout);
+    }
+    if (output->truncated)
+    {
+        printf("[Output truncated: could not allocate sufficient memory]\n");
+    }
+}
+
+void FeatureOutputFree(FeatureOutput* output)
+{
+    free(output->text);
+    output->text = NULL;
+    output->length = 0;
+    output->capacity = 0;
+}
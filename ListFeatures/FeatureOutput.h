@@ -0,0 +1,40 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FEATURE_OUTPUT_H_
+#define FEATURE_OUTPUT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * \brief Growing text buffer collecting the output for a module, so modules can be listed concurrently
+ */
+typedef struct FeatureOutput
+{
+    char*   text;           //!< Null terminated text; NULL, if nothing was written yet
+    size_t  length;
+    size_t  capacity;
+    bool    truncated;      //!< Some of the text was lost, since the buffer could not be enlarged
+} FeatureOutput;
+
+/**
+ * \brief printf into the buffer
+ *
+ * \param[in,out] output    the buffer to append the text to; NULL for printing to stdout directly
+ */
+void FeatureOutputPrintf(FeatureOutput* output, char const* format, ...);
+
+/**
+ * \brief Write the collected text to stdout
+ */
+void FeatureOutputWrite(FeatureOutput const* output);
+
+/**
+ * \brief Free the text of the buffer
+ */
+void FeatureOutputFree(FeatureOutput* output);
+
+#endif
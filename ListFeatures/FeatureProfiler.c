@@ -0,0 +1,500 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FeatureProfiler.h"
+#include "ListFeatures.h"
+
+#include <VmbC/VmbC.h>
+
+#include <VmbCExamplesCommon/ArrayAlloc.h>
+#include <VmbCExamplesCommon/ListCameras.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+
+#define FEATURE_TYPE_COUNT (VmbFeatureDataNone + 1)
+
+/**
+ * \brief Percentiles of the latencies of a number of accesses in microseconds
+ */
+typedef struct LatencySummary
+{
+    VmbUint32_t count;
+    double      min;
+    double      p50;
+    double      p90;
+    double      p99;
+    double      max;
+} LatencySummary;
+
+/**
+ * \brief The value of a feature read and written back by the profiler
+ */
+typedef struct ProfileValue
+{
+    VmbInt64_t  intValue;
+    double      floatValue;
+    VmbBool_t   boolValue;
+    char const* enumValue;
+    char*       buffer;         //!< Value of string and raw features
+    VmbUint32_t bufferSize;
+    VmbUint32_t size;           //!< Size of the value in the buffer
+} ProfileValue;
+
+/**
+ * \brief The measurements of a single feature
+ */
+typedef struct FeatureProfile
+{
+    VmbFeatureInfo_t const* info;
+    VmbError_t              readError;      //!< Error of the first read; the feature is not profiled unless it succeeded
+    double                  firstReadUs;
+    double*                 readUs;         //!< The latencies of the repeated reads
+    LatencySummary          read;
+    double*                 writeUs;
+    LatencySummary          write;
+    VmbError_t              writeError;     //!< Error of the first failed write
+} FeatureProfile;
+
+static char const* FeatureTypeToString(VmbFeatureData_t type)
+{
+    switch (type)
+    {
+    case VmbFeatureDataInt:     return "Int";
+    case VmbFeatureDataFloat:   return "Float";
+    case VmbFeatureDataEnum:    return "Enum";
+    case VmbFeatureDataString:  return "String";
+    case VmbFeatureDataBool:    return "Bool";
+    case VmbFeatureDataCommand: return "Command";
+    case VmbFeatureDataRaw:     return "Raw";
+    default:                    return "Unknown";
+    }
+}
+
+static int CompareDoubles(void const* a, void const* b)
+{
+    double const valueA = *(double const*)a;
+    double const valueB = *(double const*)b;
+    return (valueA < valueB) ? -1 : (valueA > valueB);
+}
+
+/**
+ * \brief Sort the latencies and determine their percentiles
+ */
+static void SummarizeLatencies(double* latencies, VmbUint32_t count, LatencySummary* summary)
+{
+    memset(summary, 0, sizeof(LatencySummary));
+    summary->count = count;
+    if (count == 0)
+    {
+        return;
+    }
+    qsort(latencies, count, sizeof(double), CompareDoubles);
+    summary->min = latencies[0];
+    summary->p50 = latencies[(count - 1) * 50 / 100];
+    summary->p90 = latencies[(count - 1) * 90 / 100];
+    summary->p99 = latencies[(count - 1) * 99 / 100];
+    summary->max = latencies[count - 1];
+}
+
+/**
+ * \brief Allocate the buffer for the value of a string or raw feature; not part of the measured latency
+ */
+static VmbError_t PrepareValueBuffer(VmbHandle_t handle, VmbFeatureInfo_t const* info, ProfileValue* value)
+{
+    VmbUint32_t size = 0;
+    VmbError_t err = VmbErrorSuccess;
+    if (info->featureDataType == VmbFeatureDataString)
+    {
+        err = VmbFeatureStringGet(handle, info->name, NULL, 0, &size);
+    }
+    else if (info->featureDataType == VmbFeatureDataRaw)
+    {
+        err = VmbFeatureRawLengthQuery(handle, info->name, &size);
+    }
+    if (err != VmbErrorSuccess || size <= value->bufferSize)
+    {
+        return err;
+    }
+
+    char* const buffer = realloc(value->buffer, size);
+    if (buffer == NULL)
+    {
+        return VmbErrorResources;
+    }
+    value->buffer = buffer;
+    value->bufferSize = size;
+    return VmbErrorSuccess;
+}
+
+static VmbError_t ReadValue(VmbHandle_t handle, VmbFeatureInfo_t const* info, ProfileValue* value)
+{
+    switch (info->featureDataType)
+    {
+    case VmbFeatureDataInt:
+        return VmbFeatureIntGet(handle, info->name, &value->intValue);
+    case VmbFeatureDataFloat:
+        return VmbFeatureFloatGet(handle, info->name, &value->floatValue);
+    case VmbFeatureDataEnum:
+        return VmbFeatureEnumGet(handle, info->name, &value->enumValue);
+    case VmbFeatureDataBool:
+        return VmbFeatureBoolGet(handle, info->name, &value->boolValue);
+    case VmbFeatureDataString:
+        return VmbFeatureStringGet(handle, info->name, value->buffer, value->bufferSize, &value->size);
+    case VmbFeatureDataRaw:
+        return VmbFeatureRawGet(handle, info->name, value->buffer, value->bufferSize, &value->size);
+    default:
+        return VmbErrorWrongType;
+    }
+}
+
+static VmbError_t WriteValue(VmbHandle_t handle, VmbFeatureInfo_t const* info, ProfileValue const* value)
+{
+    switch (info->featureDataType)
+    {
+    case VmbFeatureDataInt:
+        return VmbFeatureIntSet(handle, info->name, value->intValue);
+    case VmbFeatureDataFloat:
+        return VmbFeatureFloatSet(handle, info->name, value->floatValue);
+    case VmbFeatureDataEnum:
+        return VmbFeatureEnumSet(handle, info->name, value->enumValue);
+    case VmbFeatureDataBool:
+        return VmbFeatureBoolSet(handle, info->name, value->boolValue);
+    case VmbFeatureDataString:
+        return VmbFeatureStringSet(handle, info->name, value->buffer);
+    case VmbFeatureDataRaw:
+        return VmbFeatureRawSet(handle, info->name, value->buffer, value->size);
+    default:
+        return VmbErrorWrongType;
+    }
+}
+
+static double MicrosecondsSince(VmbUint64_t startNs)
+{
+    return (double)(GetMonotonicTimeNs() - startNs) / 1000.0;
+}
+
+/**
+ * \brief Time the reads and writes of a single feature
+ */
+static void ProfileFeature(VmbHandle_t handle, FeatureProfile* profile, VmbUint32_t repetitions, bool profileWrite, ProfileValue* value)
+{
+    VmbFeatureInfo_t const* const info = profile->info;
+
+    VmbBool_t readable = VmbBoolFalse;
+    VmbBool_t writeable = VmbBoolFalse;
+    profile->readError = VmbFeatureAccessQuery(handle, info->name, &readable, &writeable);
+    if (profile->readError == VmbErrorSuccess && !readable)
+    {
+        profile->readError = VmbErrorInvalidAccess;
+    }
+    if (profile->readError == VmbErrorSuccess)
+    {
+        profile->readError = PrepareValueBuffer(handle, info, value);
+    }
+    if (profile->readError != VmbErrorSuccess)
+    {
+        return;
+    }
+
+    VmbUint64_t startNs = GetMonotonicTimeNs();
+    profile->readError = ReadValue(handle, info, value);
+    profile->firstReadUs = MicrosecondsSince(startNs);
+    if (profile->readError != VmbErrorSuccess)
+    {
+        return;
+    }
+
+    VmbUint32_t reads = 0;
+    for (; reads < repetitions; reads++)
+    {
+        startNs = GetMonotonicTimeNs();
+        VmbError_t const err = ReadValue(handle, info, value);
+        profile->readUs[reads] = MicrosecondsSince(startNs);
+        if (err != VmbErrorSuccess)
+        {
+            break;
+        }
+    }
+    SummarizeLatencies(profile->readUs, reads, &profile->read);
+
+    // after a failed read the buffer may not hold the current value, so writing it could change the feature
+    if (profileWrite && writeable && reads == repetitions)
+    {
+        VmbUint32_t writes = 0;
+        for (; writes < repetitions; writes++)
+        {
+            startNs = GetMonotonicTimeNs();
+            VmbError_t const err = WriteValue(handle, info, value);
+            profile->writeUs[writes] = MicrosecondsSince(startNs);
+            if (err != VmbErrorSuccess)
+            {
+                // e.g. locked features; writing the same value again would fail the same way
+                profile->writeError = err;
+                break;
+            }
+        }
+        SummarizeLatencies(profile->writeUs, writes, &profile->write);
+    }
+}
+
+static int CompareProfilesByMedian(void const* a, void const* b)
+{
+    FeatureProfile const* const profileA = (FeatureProfile const*)a;
+    FeatureProfile const* const profileB = (FeatureProfile const*)b;
+    if (profileA->read.p50 != profileB->read.p50)
+    {
+        return (profileA->read.p50 > profileB->read.p50) ? -1 : 1;
+    }
+    return strcmp(profileA->info->name, profileB->info->name);
+}
+
+static void PrintProfiles(FeatureProfile const* profiles, VmbUint32_t count, bool profileWrite)
+{
+    printf("%-48s %-7s %10s %10s %10s %10s %10s", "Feature", "Type", "First us", "Min us", "p50 us", "p90 us", "Max us");
+    printf(profileWrite ? " | %10s %10s\n" : "\n", "Write p50", "Write max");
+    for (VmbUint32_t i = 0; i < count; i++)
+    {
+        FeatureProfile const* const profile = &profiles[i];
+        printf("%-48s %-7s", profile->info->name, FeatureTypeToString(profile->info->featureDataType));
+        if (profile->readError != VmbErrorSuccess)
+        {
+            printf(" not readable (%d)\n", profile->readError);
+            continue;
+        }
+        printf(" %10.1f %10.1f %10.1f %10.1f %10.1f", profile->firstReadUs, profile->read.min, profile->read.p50, profile->read.p90, profile->read.max);
+        if (!profileWrite)
+        {
+            printf("\n");
+        }
+        else if (profile->write.count != 0)
+        {
+            printf(" | %10.1f %10.1f%s\n", profile->write.p50, profile->write.max, (profile->writeError != VmbErrorSuccess) ? " (failed)" : "");
+        }
+        else if (profile->writeError != VmbErrorSuccess)
+        {
+            printf(" | write failed (%d)\n", profile->writeError);
+        }
+        else
+        {
+            // the feature is not writeable
+            printf(" | %10s\n", "-");
+        }
+    }
+}
+
+/**
+ * \brief Combine the read latencies of the features of every type
+ *
+ * \param[out] summaries    the summaries indexed by the feature type
+ */
+static VmbError_t SummarizeTypes(FeatureProfile const* profiles, VmbUint32_t count, LatencySummary* summaries, VmbUint32_t* featureCounts)
+{
+    for (VmbUint32_t type = 0; type < FEATURE_TYPE_COUNT; type++)
+    {
+        VmbUint32_t sampleCount = 0;
+        featureCounts[type] = 0;
+        for (VmbUint32_t i = 0; i < count; i++)
+        {
+            if (profiles[i].info->featureDataType == type && profiles[i].readError == VmbErrorSuccess)
+            {
+                sampleCount += profiles[i].read.count;
+                ++featureCounts[type];
+            }
+        }
+
+        double* const samples = VMB_MALLOC_ARRAY(double, (sampleCount + 1));
+        if (samples == NULL)
+        {
+            return VmbErrorResources;
+        }
+        sampleCount = 0;
+        for (VmbUint32_t i = 0; i < count; i++)
+        {
+            if (profiles[i].info->featureDataType == type && profiles[i].readError == VmbErrorSuccess)
+            {
+                memcpy(samples + sampleCount, profiles[i].readUs, profiles[i].read.count * sizeof(double));
+                sampleCount += profiles[i].read.count;
+            }
+        }
+        SummarizeLatencies(samples, sampleCount, &summaries[type]);
+        free(samples);
+    }
+    return VmbErrorSuccess;
+}
+
+static void PrintTypeSummaries(LatencySummary const* summaries, VmbUint32_t const* featureCounts)
+{
+    printf("\n%-7s %8s %8s %10s %10s %10s %10s %10s\n", "Type", "Features", "Reads", "Min us", "p50 us", "p90 us", "p99 us", "Max us");
+    for (VmbUint32_t type = 0; type < FEATURE_TYPE_COUNT; type++)
+    {
+        LatencySummary const* const summary = &summaries[type];
+        if (summary->count != 0)
+        {
+            printf("%-7s %8u %8u %10.1f %10.1f %10.1f %10.1f %10.1f\n", FeatureTypeToString((VmbFeatureData_t)type), featureCounts[type],
+                   summary->count, summary->min, summary->p50, summary->p90, summary->p99, summary->max);
+        }
+    }
+}
+
+/**
+ * \brief Write a row per feature and a row per feature type
+ */
+static VmbError_t WriteCsv(char const* path, FeatureProfile const* profiles, VmbUint32_t count, LatencySummary const* typeSummaries)
+{
+    FILE* const file = fopen(path, "w");
+    if (file == NULL)
+    {
+        printf("Could not open \"%s\" for writing\n", path);
+        return VmbErrorInvalidAccess;
+    }
+
+    fprintf(file, "scope,name,type,reads,first_us,min_us,p50_us,p90_us,p99_us,max_us,writes,write_p50_us,write_max_us,error\n");
+    for (VmbUint32_t i = 0; i < count; i++)
+    {
+        FeatureProfile const* const profile = &profiles[i];
+        fprintf(file, "feature,%s,%s,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%.3f,%.3f,%d\n",
+                profile->info->name, FeatureTypeToString(profile->info->featureDataType), profile->read.count, profile->firstReadUs,
+                profile->read.min, profile->read.p50, profile->read.p90, profile->read.p99, profile->read.max,
+                profile->write.count, profile->write.p50, profile->write.max,
+                (profile->readError != VmbErrorSuccess) ? profile->readError : profile->writeError);
+    }
+    for (VmbUint32_t type = 0; type < FEATURE_TYPE_COUNT; type++)
+    {
+        LatencySummary const* const summary = &typeSummaries[type];
+        if (summary->count != 0)
+        {
+            fprintf(file, "type,,%s,%u,,%.3f,%.3f,%.3f,%.3f,%.3f,,,,\n", FeatureTypeToString((VmbFeatureData_t)type),
+                    summary->count, summary->min, summary->p50, summary->p90, summary->p99, summary->max);
+        }
+    }
+
+    bool const ok = (ferror(file) == 0);
+    return (fclose(file) == 0 && ok) ? VmbErrorSuccess : VmbErrorInvalidAccess;
+}
+
+/**
+ * \brief Profile the features of an open module and print the results
+ */
+static VmbError_t ProfileModule(VmbHandle_t handle, VmbFeatureVisibility_t printedFeatureMaximumVisibility, VmbUint32_t repetitions,
+                                bool profileWrite, char const* csvPath)
+{
+    VmbUint32_t infoCount = 0;
+    VmbError_t err = VmbFeaturesList(handle, NULL, 0, &infoCount, sizeof(VmbFeatureInfo_t));
+    if (err != VmbErrorSuccess || infoCount == 0)
+    {
+        printf("Could not get features or the module does not provide any. Error code: %d\n", err);
+        return err;
+    }
+
+    VmbFeatureInfo_t* const infos = VMB_MALLOC_ARRAY(VmbFeatureInfo_t, infoCount);
+    FeatureProfile* const profiles = calloc(infoCount, sizeof(FeatureProfile));
+    double* const samples = VMB_MALLOC_ARRAY(double, ((size_t)infoCount * repetitions * 2));
+    if (infos == NULL || profiles == NULL || samples == NULL)
+    {
+        free(infos);
+        free(profiles);
+        free(samples);
+        return VmbErrorResources;
+    }
+
+    err = VmbFeaturesList(handle, infos, infoCount, &infoCount, sizeof(VmbFeatureInfo_t));
+    if (err == VmbErrorSuccess)
+    {
+        VmbUint64_t const startNs = GetMonotonicTimeNs();
+        ProfileValue value = { 0 };
+        VmbUint32_t count = 0;
+        for (VmbUint32_t i = 0; i < infoCount; i++)
+        {
+            VmbFeatureInfo_t const* const info = &infos[i];
+            if (info->visibility > printedFeatureMaximumVisibility
+                || info->featureDataType == VmbFeatureDataCommand || info->featureDataType == VmbFeatureDataNone)
+            {
+                continue;
+            }
+
+            FeatureProfile* const profile = &profiles[count];
+            profile->info = info;
+            profile->readUs = samples + (size_t)count * repetitions * 2;
+            profile->writeUs = profile->readUs + repetitions;
+            ProfileFeature(handle, profile, repetitions, profileWrite, &value);
+            ++count;
+        }
+        free(value.buffer);
+
+        printf("Profiled %u features with %u repetitions in %.1f ms\n\n", count, repetitions, (GetMonotonicTimeNs() - startNs) / 1e6);
+
+        // the type summaries sort copies of the read latencies, the per feature latencies are already sorted
+        LatencySummary typeSummaries[FEATURE_TYPE_COUNT];
+        VmbUint32_t typeFeatureCounts[FEATURE_TYPE_COUNT];
+        err = SummarizeTypes(profiles, count, typeSummaries, typeFeatureCounts);
+        if (err == VmbErrorSuccess)
+        {
+            qsort(profiles, count, sizeof(FeatureProfile), CompareProfilesByMedian);
+            PrintProfiles(profiles, count, profileWrite);
+            PrintTypeSummaries(typeSummaries, typeFeatureCounts);
+            if (csvPath != NULL)
+            {
+                err = WriteCsv(csvPath, profiles, count, typeSummaries);
+            }
+        }
+    }
+    else
+    {
+        printf("Could not get features. Error code: %d\n", err);
+    }
+
+    free(samples);
+    free(profiles);
+    free(infos);
+    return err;
+}
+
+int ProfileCameraFeatures(char const* camera, VmbFeatureVisibility_t printedFeatureMaximumVisibility, unsigned long repetitions,
+                          bool profileWrite, char const* csvPath)
+{
+    if (repetitions == 0)
+    {
+        repetitions = FEATURE_PROFILER_DEFAULT_REPETITIONS;
+    }
+    if (repetitions > FEATURE_PROFILER_MAX_REPETITIONS)
+    {
+        repetitions = FEATURE_PROFILER_MAX_REPETITIONS;
+    }
+
+    VmbError_t err = StartApi();
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not start the API: %d\n", err);
+        return 1;
+    }
+
+    VmbCameraInfo_t* cameras = NULL;
+    VmbUint32_t cameraCount = 0;
+    if (ListCameras(&cameras, &cameraCount) != VmbErrorSuccess)
+    {
+        cameraCount = 0;
+    }
+    char const* const cameraId = ResolveCameraId(camera, cameras, cameraCount);
+
+    VmbHandle_t remoteDevice = NULL;
+    err = VmbCameraOpen(cameraId, profileWrite ? VmbAccessModeFull : VmbAccessModeRead, &remoteDevice);
+    if (err == VmbErrorSuccess)
+    {
+        printf("Profiling the remote device features of camera %s\n", cameraId);
+        err = ProfileModule(remoteDevice, printedFeatureMaximumVisibility, (VmbUint32_t)repetitions, profileWrite, csvPath);
+        VmbCameraClose(remoteDevice);
+    }
+    else
+    {
+        printf("Error opening camera %s: %d\n", cameraId, err);
+    }
+
+    free(cameras);
+    VmbShutdown();
+    return (err == VmbErrorSuccess) ? 0 : 1;
+}
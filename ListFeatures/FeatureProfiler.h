@@ -0,0 +1,37 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FEATURE_PROFILER_H_
+#define FEATURE_PROFILER_H_
+
+#include <stdbool.h>
+
+#include "VmbC/VmbCTypeDefinitions.h"
+
+#define FEATURE_PROFILER_DEFAULT_REPETITIONS    20
+#define FEATURE_PROFILER_MAX_REPETITIONS        10000
+
+/**
+ * \brief measure the latency of accessing the remote device features of a camera
+ *
+ * Every readable feature is read once and then \p repetitions times more, each call timed with the monotonic clock.
+ * The first read is reported separately, since it may fill a cache of the transport layer. Optionally the value read
+ * is written back \p repetitions times to measure the latency of writing the feature.
+ *
+ * The features are printed sorted by their median read latency, followed by the latencies of all reads of
+ * features of the same type.
+ *
+ * \param[in] camera                            the index or the id of the camera
+ * \param[in] printedFeatureMaximumVisibility   the maximum visibility of the features profiled
+ * \param[in] repetitions                       the number of timed accesses per feature; 0 for a default
+ * \param[in] profileWrite                      true, if the writes should be profiled as well; opens the camera in full access mode
+ * \param[in] csvPath                           the file the results are written to as CSV; may be NULL
+ *
+ * \return a code to return from main()
+ */
+int ProfileCameraFeatures(char const* camera, VmbFeatureVisibility_t printedFeatureMaximumVisibility, unsigned long repetitions,
+                          bool profileWrite, char const* csvPath);
+
+#endif
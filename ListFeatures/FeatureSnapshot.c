@@ -0,0 +1,995 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FeatureSnapshot.h"
+
+#include <VmbC/VmbC.h>
+
+#include <VmbCExamplesCommon/ArrayAlloc.h>
+#include <VmbCExamplesCommon/ListCameras.h>
+#include <VmbCExamplesCommon/ListInterfaces.h>
+#include <VmbCExamplesCommon/ListTransportLayers.h>
+
+#define SNAPSHOT_MAGIC              "VMBSNAP"
+#define SNAPSHOT_VERSION            1
+#define SNAPSHOT_MAX_STRING_LENGTH  (1u << 20)      // sanity limit for loading corrupt files
+#define RESTORE_MAX_PASSES          4
+#define FLOAT_RELATIVE_TOLERANCE    1e-9
+
+static char* CopyString(char const* string)
+{
+    if (string == NULL)
+    {
+        return NULL;
+    }
+    size_t const size = strlen(string) + 1;
+    char* const copy = VMB_MALLOC_ARRAY(char, size);
+    if (copy != NULL)
+    {
+        memcpy(copy, string, size);
+    }
+    return copy;
+}
+
+static bool HasStorableValue(VmbFeatureData_t type)
+{
+    return type == VmbFeatureDataInt || type == VmbFeatureDataFloat || type == VmbFeatureDataEnum
+        || type == VmbFeatureDataString || type == VmbFeatureDataBool;
+}
+
+/**
+ * \brief Guess, if the transport layer locks the feature while the camera is acquiring
+ *
+ * The features determining the size and layout of the payload are locked, so the whole image format category is
+ * treated as locked.
+ */
+static bool IsLockedDuringAcquisition(VmbFeatureInfo_t const* info)
+{
+    static char const* const lockedFeatures[] = { "PixelFormat", "Width", "Height", "BinningHorizontal", "BinningVertical",
+                                                  "DecimationHorizontal", "DecimationVertical", "ChunkModeActive" };
+    if (info->category != NULL && strstr(info->category, "ImageFormatControl") != NULL)
+    {
+        return true;
+    }
+    for (size_t i = 0; i < sizeof(lockedFeatures) / sizeof(lockedFeatures[0]); i++)
+    {
+        if (strcmp(info->name, lockedFeatures[i]) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief Read the current value of a feature into the value members of \p feature
+ */
+static VmbError_t ReadFeatureValue(VmbHandle_t handle, char const* name, VmbFeatureData_t type, SnapshotFeature* feature)
+{
+    VmbError_t err = VmbErrorWrongType;
+    switch (type)
+    {
+    case VmbFeatureDataInt:
+        err = VmbFeatureIntGet(handle, name, &feature->intValue);
+        break;
+    case VmbFeatureDataBool:
+    {
+        VmbBool_t value = VmbBoolFalse;
+        err = VmbFeatureBoolGet(handle, name, &value);
+        feature->intValue = value ? 1 : 0;
+        break;
+    }
+    case VmbFeatureDataFloat:
+        err = VmbFeatureFloatGet(handle, name, &feature->floatValue);
+        break;
+    case VmbFeatureDataEnum:
+    {
+        char const* value = NULL;
+        err = VmbFeatureEnumGet(handle, name, &value);
+        if (err == VmbErrorSuccess)
+        {
+            feature->stringValue = CopyString(value);
+            err = (feature->stringValue != NULL) ? VmbErrorSuccess : VmbErrorResources;
+        }
+        break;
+    }
+    case VmbFeatureDataString:
+    {
+        VmbUint32_t size = 0;
+        err = VmbFeatureStringGet(handle, name, NULL, 0, &size);
+        if (err == VmbErrorSuccess)
+        {
+            feature->stringValue = VMB_MALLOC_ARRAY(char, (size + 1));
+            err = (feature->stringValue != NULL) ? VmbFeatureStringGet(handle, name, feature->stringValue, size + 1, &size) : VmbErrorResources;
+            if (feature->stringValue != NULL)
+            {
+                feature->stringValue[(err == VmbErrorSuccess) ? size : 0] = '\0';
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return err;
+}
+
+static VmbError_t WriteFeatureValue(VmbHandle_t handle, SnapshotFeature const* feature)
+{
+    switch (feature->type)
+    {
+    case VmbFeatureDataInt:
+        return VmbFeatureIntSet(handle, feature->name, feature->intValue);
+    case VmbFeatureDataBool:
+        return VmbFeatureBoolSet(handle, feature->name, feature->intValue ? VmbBoolTrue : VmbBoolFalse);
+    case VmbFeatureDataFloat:
+        return VmbFeatureFloatSet(handle, feature->name, feature->floatValue);
+    case VmbFeatureDataEnum:
+        return VmbFeatureEnumSet(handle, feature->name, feature->stringValue);
+    case VmbFeatureDataString:
+        return VmbFeatureStringSet(handle, feature->name, feature->stringValue);
+    default:
+        return VmbErrorWrongType;
+    }
+}
+
+static bool ValuesEqual(SnapshotFeature const* a, SnapshotFeature const* b)
+{
+    switch (a->type)
+    {
+    case VmbFeatureDataInt:
+    case VmbFeatureDataBool:
+        return a->intValue == b->intValue;
+    case VmbFeatureDataFloat:
+        // the camera may round the written value, which must not cause a write on every restore
+        return fabs(a->floatValue - b->floatValue) <= FLOAT_RELATIVE_TOLERANCE * fmax(fabs(a->floatValue), fabs(b->floatValue));
+    case VmbFeatureDataEnum:
+    case VmbFeatureDataString:
+        return a->stringValue != NULL && b->stringValue != NULL && strcmp(a->stringValue, b->stringValue) == 0;
+    default:
+        return false;
+    }
+}
+
+static void SnapshotFeatureFree(SnapshotFeature* feature)
+{
+    free(feature->name);
+    free(feature->stringValue);
+    for (VmbUint32_t i = 0; i < feature->selectedCount; i++)
+    {
+        free(feature->selectedFeatures[i]);
+    }
+    free(feature->selectedFeatures);
+}
+
+/**
+ * \brief Store the names of the features selected by a selector
+ */
+static VmbError_t ReadSelectedFeatures(VmbHandle_t handle, SnapshotFeature* feature)
+{
+    VmbUint32_t count = 0;
+    VmbError_t err = VmbFeatureListSelected(handle, feature->name, NULL, 0, &count, sizeof(VmbFeatureInfo_t));
+    if (err != VmbErrorSuccess || count == 0)
+    {
+        return err;
+    }
+
+    VmbFeatureInfo_t* const selected = VMB_MALLOC_ARRAY(VmbFeatureInfo_t, count);
+    feature->selectedFeatures = VMB_MALLOC_ARRAY(char*, count);
+    if (selected == NULL || feature->selectedFeatures == NULL)
+    {
+        free(selected);
+        return VmbErrorResources;
+    }
+
+    err = VmbFeatureListSelected(handle, feature->name, selected, count, &count, sizeof(VmbFeatureInfo_t));
+    for (VmbUint32_t i = 0; err == VmbErrorSuccess && i < count; i++)
+    {
+        feature->selectedFeatures[feature->selectedCount] = CopyString(selected[i].name);
+        if (feature->selectedFeatures[feature->selectedCount] != NULL)
+        {
+            ++feature->selectedCount;
+        }
+    }
+    free(selected);
+    return err;
+}
+
+VmbError_t SnapshotReadModule(VmbHandle_t handle, SnapshotModule* module)
+{
+    module->features = NULL;
+    module->featureCount = 0;
+
+    VmbUint32_t count = 0;
+    VmbError_t err = VmbFeaturesList(handle, NULL, 0, &count, sizeof(VmbFeatureInfo_t));
+    if (err != VmbErrorSuccess || count == 0)
+    {
+        return err;
+    }
+
+    VmbFeatureInfo_t* const infos = VMB_MALLOC_ARRAY(VmbFeatureInfo_t, count);
+    module->features = calloc(count, sizeof(SnapshotFeature));
+    if (infos == NULL || module->features == NULL)
+    {
+        free(infos);
+        return VmbErrorResources;
+    }
+
+    err = VmbFeaturesList(handle, infos, count, &count, sizeof(VmbFeatureInfo_t));
+    for (VmbUint32_t i = 0; err == VmbErrorSuccess && i < count; i++)
+    {
+        VmbFeatureInfo_t const* const info = &infos[i];
+        SnapshotFeature* const feature = &module->features[module->featureCount];
+        feature->name = CopyString(info->name);
+        if (feature->name == NULL)
+        {
+            err = VmbErrorResources;
+            break;
+        }
+        ++module->featureCount;
+
+        feature->type = info->featureDataType;
+        feature->flags = (info->isStreamable ? SnapshotFeatureStreamable : 0)
+                       | ((info->featureFlags & VmbFeatureFlagsVolatile) ? SnapshotFeatureVolatile : 0)
+                       | (IsLockedDuringAcquisition(info) ? SnapshotFeatureLocked : 0);
+
+        VmbBool_t readable = VmbBoolFalse;
+        VmbBool_t writeable = VmbBoolFalse;
+        if (VmbFeatureAccessQuery(handle, info->name, &readable, &writeable) == VmbErrorSuccess)
+        {
+            feature->flags |= (readable ? SnapshotFeatureReadable : 0) | (writeable ? SnapshotFeatureWriteable : 0);
+        }
+
+        if (readable && HasStorableValue(feature->type)
+            && ReadFeatureValue(handle, feature->name, feature->type, feature) == VmbErrorSuccess)
+        {
+            feature->flags |= SnapshotFeatureHasValue;
+        }
+
+        if (info->hasSelectedFeatures)
+        {
+            // a selector without its selected features only loses the restore order
+            ReadSelectedFeatures(handle, feature);
+        }
+    }
+
+    free(infos);
+    return err;
+}
+
+/**
+ * \brief Position of a feature in the restore order
+ */
+typedef struct RestoreStep
+{
+    VmbUint32_t depth;          //!< Number of selectors that need to be written before the feature
+    VmbUint32_t unlocked;       //!< 0 for features locked during the acquisition, 1 otherwise
+    VmbUint32_t featureIndex;
+} RestoreStep;
+
+static int CompareRestoreSteps(void const* a, void const* b)
+{
+    RestoreStep const* const stepA = (RestoreStep const*)a;
+    RestoreStep const* const stepB = (RestoreStep const*)b;
+    if (stepA->depth != stepB->depth)
+    {
+        return (stepA->depth < stepB->depth) ? -1 : 1;
+    }
+    if (stepA->unlocked != stepB->unlocked)
+    {
+        return (stepA->unlocked < stepB->unlocked) ? -1 : 1;
+    }
+    return (stepA->featureIndex < stepB->featureIndex) ? -1 : (stepA->featureIndex > stepB->featureIndex);
+}
+
+/**
+ * \brief A feature name with the index of the feature; sorted by name for looking up the selected features
+ */
+typedef struct SortedName
+{
+    char const* name;
+    VmbUint32_t featureIndex;
+} SortedName;
+
+static int CompareSortedNames(void const* a, void const* b)
+{
+    return strcmp(((SortedName const*)a)->name, ((SortedName const*)b)->name);
+}
+
+static VmbUint32_t FindFeature(SnapshotModule const* module, SortedName const* sortedNames, char const* name)
+{
+    VmbUint32_t low = 0;
+    VmbUint32_t high = module->featureCount;
+    while (low < high)
+    {
+        VmbUint32_t const middle = low + (high - low) / 2;
+        int const comparison = strcmp(sortedNames[middle].name, name);
+        if (comparison == 0)
+        {
+            return sortedNames[middle].featureIndex;
+        }
+        if (comparison < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return module->featureCount;
+}
+
+/**
+ * \brief Determine the order the features are written in
+ *
+ * \return the steps sorted by their order; NULL, if the memory could not be allocated
+ */
+static RestoreStep* CreateRestoreOrder(SnapshotModule const* module)
+{
+    VmbUint32_t const count = module->featureCount;
+    RestoreStep* const steps = VMB_MALLOC_ARRAY(RestoreStep, (count + 1));
+    SortedName* const sortedNames = VMB_MALLOC_ARRAY(SortedName, (count + 1));
+    if (steps == NULL || sortedNames == NULL)
+    {
+        free(steps);
+        free(sortedNames);
+        return NULL;
+    }
+
+    for (VmbUint32_t i = 0; i < count; i++)
+    {
+        steps[i].depth = 0;
+        steps[i].unlocked = (module->features[i].flags & SnapshotFeatureLocked) ? 0 : 1;
+        steps[i].featureIndex = i;
+        sortedNames[i].name = module->features[i].name;
+        sortedNames[i].featureIndex = i;
+    }
+    qsort(sortedNames, count, sizeof(SortedName), CompareSortedNames);
+
+    // propagate the depth from the selectors to the selected features; nested selectors need several rounds and
+    // the number of rounds is limited in case the selectors form a cycle
+    bool changed = true;
+    for (VmbUint32_t round = 0; changed && round < count; round++)
+    {
+        changed = false;
+        for (VmbUint32_t i = 0; i < count; i++)
+        {
+            SnapshotFeature const* const selector = &module->features[i];
+            for (VmbUint32_t j = 0; j < selector->selectedCount; j++)
+            {
+                VmbUint32_t const selected = FindFeature(module, sortedNames, selector->selectedFeatures[j]);
+                if (selected < count && selected != i && steps[selected].depth <= steps[i].depth)
+                {
+                    steps[selected].depth = steps[i].depth + 1;
+                    changed = true;
+                }
+            }
+        }
+    }
+    free(sortedNames);
+
+    qsort(steps, count, sizeof(RestoreStep), CompareRestoreSteps);
+    return steps;
+}
+
+static bool IsRestorable(SnapshotFeature const* feature)
+{
+    VmbUint32_t const required = SnapshotFeatureWriteable | SnapshotFeatureStreamable | SnapshotFeatureHasValue;
+    return (feature->flags & required) == required && HasStorableValue(feature->type);
+}
+
+VmbError_t SnapshotRestoreModule(VmbHandle_t handle, SnapshotModule const* module, SnapshotRestoreStats* stats)
+{
+    RestoreStep* const steps = CreateRestoreOrder(module);
+    if (steps == NULL)
+    {
+        return VmbErrorResources;
+    }
+
+    // the features still to be written; failed writes are moved to the front for the next pass
+    VmbUint32_t pending = 0;
+    for (VmbUint32_t i = 0; i < module->featureCount; i++)
+    {
+        if (IsRestorable(&module->features[steps[i].featureIndex]))
+        {
+            steps[pending++] = steps[i];
+        }
+    }
+
+    VmbUint32_t passes = 0;
+    while (pending != 0 && passes < RESTORE_MAX_PASSES)
+    {
+        ++passes;
+        VmbUint32_t failed = 0;
+        for (VmbUint32_t i = 0; i < pending; i++)
+        {
+            SnapshotFeature const* const feature = &module->features[steps[i].featureIndex];
+
+            SnapshotFeature current;
+            memset(&current, 0, sizeof(current));
+            current.type = feature->type;
+            VmbError_t const readErr = ReadFeatureValue(handle, feature->name, feature->type, &current);
+            bool const equal = (readErr == VmbErrorSuccess) && ValuesEqual(feature, &current);
+            free(current.stringValue);
+
+            if (readErr == VmbErrorNotFound)
+            {
+                ++stats->missing;
+            }
+            else if (equal)
+            {
+                ++stats->unchanged;
+            }
+            else if (WriteFeatureValue(handle, feature) == VmbErrorSuccess)
+            {
+                ++stats->written;
+            }
+            else
+            {
+                steps[failed++] = steps[i];
+            }
+        }
+
+        if (failed == pending)
+        {
+            // no progress; another pass would fail the same way
+            break;
+        }
+        pending = failed;
+    }
+
+    stats->failed += pending;
+    stats->passes = (passes > stats->passes) ? passes : stats->passes;
+    free(steps);
+    return (pending == 0) ? VmbErrorSuccess : VmbErrorIncomplete;
+}
+
+bool SnapshotFeatureValuesEqual(SnapshotFeature const* a, SnapshotFeature const* b)
+{
+    bool const aHasValue = (a->flags & SnapshotFeatureHasValue) != 0;
+    bool const bHasValue = (b->flags & SnapshotFeatureHasValue) != 0;
+    if (aHasValue != bHasValue || a->type != b->type)
+    {
+        return false;
+    }
+    return !aHasValue || ValuesEqual(a, b);
+}
+
+int SnapshotFeatureValueToString(SnapshotFeature const* feature, char* buffer, size_t size)
+{
+    if (!(feature->flags & SnapshotFeatureHasValue))
+    {
+        return snprintf(buffer, size, "<no value>");
+    }
+    switch (feature->type)
+    {
+    case VmbFeatureDataInt:
+        return snprintf(buffer, size, "%lld", (long long)feature->intValue);
+    case VmbFeatureDataBool:
+        return snprintf(buffer, size, "%s", feature->intValue ? "true" : "false");
+    case VmbFeatureDataFloat:
+        return snprintf(buffer, size, "%.10g", feature->floatValue);
+    case VmbFeatureDataEnum:
+    case VmbFeatureDataString:
+        return snprintf(buffer, size, "%s", (feature->stringValue != NULL) ? feature->stringValue : "");
+    default:
+        return snprintf(buffer, size, "<unknown type>");
+    }
+}
+
+static int CompareSnapshotFeatures(void const* a, void const* b)
+{
+    return strcmp(((SnapshotFeature const*)a)->name, ((SnapshotFeature const*)b)->name);
+}
+
+void SnapshotModuleSortByName(SnapshotModule* module)
+{
+    if (module->featureCount > 1)
+    {
+        qsort(module->features, module->featureCount, sizeof(SnapshotFeature), CompareSnapshotFeatures);
+    }
+}
+
+void SnapshotModuleFree(SnapshotModule* module)
+{
+    for (VmbUint32_t i = 0; i < module->featureCount; i++)
+    {
+        SnapshotFeatureFree(&module->features[i]);
+    }
+    free(module->features);
+    free(module->id);
+    module->features = NULL;
+    module->featureCount = 0;
+    module->id = NULL;
+}
+
+void FeatureSnapshotFree(FeatureSnapshot* snapshot)
+{
+    for (VmbUint32_t i = 0; i < snapshot->moduleCount; i++)
+    {
+        SnapshotModuleFree(&snapshot->modules[i]);
+    }
+    free(snapshot->modules);
+    snapshot->modules = NULL;
+    snapshot->moduleCount = 0;
+}
+
+char const* SnapshotModuleTypeToString(SnapshotModuleType type)
+{
+    switch (type)
+    {
+    case SnapshotModuleTransportLayer:  return "Transport layer";
+    case SnapshotModuleInterface:       return "Interface";
+    case SnapshotModuleRemoteDevice:    return "Remote device";
+    case SnapshotModuleLocalDevice:     return "Local device";
+    case SnapshotModuleStream:          return "Stream";
+    default:                            return "Unknown module";
+    }
+}
+
+/**
+ * \brief Append a module to the snapshot and read its features
+ */
+static VmbError_t AddModule(FeatureSnapshot* snapshot, VmbHandle_t handle, SnapshotModuleType type, char const* id, VmbUint32_t streamIndex)
+{
+    SnapshotModule* const modules = realloc(snapshot->modules, (snapshot->moduleCount + 1) * sizeof(SnapshotModule));
+    if (modules == NULL)
+    {
+        return VmbErrorResources;
+    }
+    snapshot->modules = modules;
+
+    SnapshotModule* const module = &modules[snapshot->moduleCount++];
+    module->type = type;
+    module->id = CopyString(id);
+    module->streamIndex = streamIndex;
+    VmbError_t const err = SnapshotReadModule(handle, module);
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not read the features of %s %s. Error code: %d\n", SnapshotModuleTypeToString(type), (id != NULL) ? id : "", err);
+    }
+    return (module->id != NULL || id == NULL) ? err : VmbErrorResources;
+}
+
+VmbError_t FeatureSnapshotTake(FeatureSnapshot* snapshot)
+{
+    snapshot->modules = NULL;
+    snapshot->moduleCount = 0;
+
+    VmbError_t err = VmbErrorSuccess;
+    VmbTransportLayerInfo_t* tls = NULL;
+    VmbUint32_t tlCount = 0;
+    if (ListTransportLayers(&tls, &tlCount) == VmbErrorSuccess)
+    {
+        for (VmbUint32_t i = 0; i < tlCount && err != VmbErrorResources; i++)
+        {
+            err = AddModule(snapshot, tls[i].transportLayerHandle, SnapshotModuleTransportLayer, tls[i].transportLayerIdString, 0);
+        }
+        free(tls);
+    }
+
+    VmbInterfaceInfo_t* interfaces = NULL;
+    VmbUint32_t interfaceCount = 0;
+    if (err != VmbErrorResources && ListInterfaces(&interfaces, &interfaceCount) == VmbErrorSuccess)
+    {
+        for (VmbUint32_t i = 0; i < interfaceCount && err != VmbErrorResources; i++)
+        {
+            err = AddModule(snapshot, interfaces[i].interfaceHandle, SnapshotModuleInterface, interfaces[i].interfaceIdString, 0);
+        }
+        free(interfaces);
+    }
+
+    VmbCameraInfo_t* cameras = NULL;
+    VmbUint32_t cameraCount = 0;
+    if (err != VmbErrorResources && ListCameras(&cameras, &cameraCount) == VmbErrorSuccess)
+    {
+        for (VmbUint32_t i = 0; i < cameraCount && err != VmbErrorResources; i++)
+        {
+            char const* const cameraId = cameras[i].cameraIdString;
+            VmbHandle_t remoteDevice = NULL;
+            if (VmbCameraOpen(cameraId, VmbAccessModeRead, &remoteDevice) != VmbErrorSuccess)
+            {
+                printf("Could not open camera %s; it is not part of the snapshot\n", cameraId);
+                continue;
+            }
+
+            // the local device and the streams are only available while the camera is open
+            VmbCameraInfo_t info;
+            err = AddModule(snapshot, remoteDevice, SnapshotModuleRemoteDevice, cameraId, 0);
+            if (err != VmbErrorResources && VmbCameraInfoQueryByHandle(remoteDevice, &info, sizeof(info)) == VmbErrorSuccess)
+            {
+                err = AddModule(snapshot, info.localDeviceHandle, SnapshotModuleLocalDevice, cameraId, 0);
+                for (VmbUint32_t s = 0; s < info.streamCount && err != VmbErrorResources; s++)
+                {
+                    err = AddModule(snapshot, info.streamHandles[s], SnapshotModuleStream, cameraId, s);
+                }
+            }
+            VmbCameraClose(remoteDevice);
+        }
+        free(cameras);
+    }
+
+    if (err == VmbErrorResources)
+    {
+        FeatureSnapshotFree(snapshot);
+        return err;
+    }
+    // modules that could not be read completely are part of the snapshot nevertheless
+    return VmbErrorSuccess;
+}
+
+/**
+ * \brief Find the handle of a transport layer or interface by id
+ */
+static VmbHandle_t FindSystemModule(SnapshotModule const* module, VmbTransportLayerInfo_t const* tls, VmbUint32_t tlCount,
+                                    VmbInterfaceInfo_t const* interfaces, VmbUint32_t interfaceCount)
+{
+    if (module->type == SnapshotModuleTransportLayer)
+    {
+        for (VmbUint32_t i = 0; i < tlCount; i++)
+        {
+            if (tls[i].transportLayerIdString != NULL && strcmp(tls[i].transportLayerIdString, module->id) == 0)
+            {
+                return tls[i].transportLayerHandle;
+            }
+        }
+    }
+    else
+    {
+        for (VmbUint32_t i = 0; i < interfaceCount; i++)
+        {
+            if (interfaces[i].interfaceIdString != NULL && strcmp(interfaces[i].interfaceIdString, module->id) == 0)
+            {
+                return interfaces[i].interfaceHandle;
+            }
+        }
+    }
+    return NULL;
+}
+
+VmbError_t FeatureSnapshotRestore(FeatureSnapshot const* snapshot, SnapshotRestoreStats* stats)
+{
+    VmbTransportLayerInfo_t* tls = NULL;
+    VmbUint32_t tlCount = 0;
+    VmbInterfaceInfo_t* interfaces = NULL;
+    VmbUint32_t interfaceCount = 0;
+    if (ListTransportLayers(&tls, &tlCount) != VmbErrorSuccess)
+    {
+        tlCount = 0;
+    }
+    if (ListInterfaces(&interfaces, &interfaceCount) != VmbErrorSuccess)
+    {
+        interfaceCount = 0;
+    }
+
+    VmbError_t result = VmbErrorSuccess;
+    VmbHandle_t cameraHandle = NULL;
+    char const* openCameraId = NULL;
+    VmbCameraInfo_t cameraInfo;
+
+    for (VmbUint32_t i = 0; i < snapshot->moduleCount; i++)
+    {
+        SnapshotModule const* const module = &snapshot->modules[i];
+        if (module->id == NULL)
+        {
+            continue;
+        }
+
+        VmbHandle_t handle = NULL;
+        if (module->type == SnapshotModuleTransportLayer || module->type == SnapshotModuleInterface)
+        {
+            handle = FindSystemModule(module, tls, tlCount, interfaces, interfaceCount);
+        }
+        else
+        {
+            // the modules of a camera are stored next to each other, so every camera is opened once
+            if (openCameraId == NULL || strcmp(openCameraId, module->id) != 0)
+            {
+                if (cameraHandle != NULL)
+                {
+                    VmbCameraClose(cameraHandle);
+                    cameraHandle = NULL;
+                }
+                openCameraId = module->id;
+                if (VmbCameraOpen(module->id, VmbAccessModeFull, &cameraHandle) != VmbErrorSuccess
+                    || VmbCameraInfoQueryByHandle(cameraHandle, &cameraInfo, sizeof(cameraInfo)) != VmbErrorSuccess)
+                {
+                    printf("Could not open camera %s for writing\n", module->id);
+                    if (cameraHandle != NULL)
+                    {
+                        VmbCameraClose(cameraHandle);
+                        cameraHandle = NULL;
+                    }
+                }
+            }
+
+            if (cameraHandle != NULL)
+            {
+                switch (module->type)
+                {
+                case SnapshotModuleRemoteDevice:
+                    handle = cameraHandle;
+                    break;
+                case SnapshotModuleLocalDevice:
+                    handle = cameraInfo.localDeviceHandle;
+                    break;
+                default:
+                    handle = (module->streamIndex < cameraInfo.streamCount) ? cameraInfo.streamHandles[module->streamIndex] : NULL;
+                    break;
+                }
+            }
+        }
+
+        if (handle == NULL)
+        {
+            printf("%s %s is not available; its features are not restored\n", SnapshotModuleTypeToString(module->type), module->id);
+            result = VmbErrorNotFound;
+            continue;
+        }
+
+        VmbError_t const err = SnapshotRestoreModule(handle, module, stats);
+        if (err != VmbErrorSuccess)
+        {
+            printf("Not all features of %s %s could be restored. Error code: %d\n", SnapshotModuleTypeToString(module->type), module->id, err);
+            result = err;
+        }
+    }
+
+    if (cameraHandle != NULL)
+    {
+        VmbCameraClose(cameraHandle);
+    }
+    free(interfaces);
+    free(tls);
+    return result;
+}
+
+/*
+ * Binary file format
+ */
+
+static void WriteBytes(FILE* file, void const* data, size_t size, bool* ok)
+{
+    *ok = *ok && (fwrite(data, 1, size, file) == size);
+}
+
+static void WriteU32(FILE* file, VmbUint32_t value, bool* ok)
+{
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; i++)
+    {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+    WriteBytes(file, bytes, sizeof(bytes), ok);
+}
+
+static void WriteU64(FILE* file, VmbUint64_t value, bool* ok)
+{
+    unsigned char bytes[8];
+    for (int i = 0; i < 8; i++)
+    {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+    WriteBytes(file, bytes, sizeof(bytes), ok);
+}
+
+static void WriteString(FILE* file, char const* string, bool* ok)
+{
+    size_t const length = (string != NULL) ? strlen(string) : 0;
+    WriteU32(file, (VmbUint32_t)length, ok);
+    WriteBytes(file, string, length, ok);
+}
+
+VmbError_t FeatureSnapshotSave(FeatureSnapshot const* snapshot, char const* path)
+{
+    FILE* const file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        printf("Could not open \"%s\" for writing\n", path);
+        return VmbErrorBadParameter;
+    }
+
+    bool ok = true;
+    WriteBytes(file, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC), &ok);
+    WriteU32(file, SNAPSHOT_VERSION, &ok);
+    WriteU32(file, snapshot->moduleCount, &ok);
+    for (VmbUint32_t m = 0; m < snapshot->moduleCount && ok; m++)
+    {
+        SnapshotModule const* const module = &snapshot->modules[m];
+        unsigned char const type = (unsigned char)module->type;
+        WriteBytes(file, &type, 1, &ok);
+        WriteString(file, module->id, &ok);
+        WriteU32(file, module->streamIndex, &ok);
+        WriteU32(file, module->featureCount, &ok);
+
+        for (VmbUint32_t f = 0; f < module->featureCount && ok; f++)
+        {
+            SnapshotFeature const* const feature = &module->features[f];
+            unsigned char const header[2] = { (unsigned char)feature->type, (unsigned char)feature->flags };
+            WriteString(file, feature->name, &ok);
+            WriteBytes(file, header, sizeof(header), &ok);
+            if (feature->flags & SnapshotFeatureHasValue)
+            {
+                switch (feature->type)
+                {
+                case VmbFeatureDataInt:
+                case VmbFeatureDataBool:
+                    WriteU64(file, (VmbUint64_t)feature->intValue, &ok);
+                    break;
+                case VmbFeatureDataFloat:
+                {
+                    VmbUint64_t bits = 0;
+                    memcpy(&bits, &feature->floatValue, sizeof(bits));
+                    WriteU64(file, bits, &ok);
+                    break;
+                }
+                default:
+                    WriteString(file, feature->stringValue, &ok);
+                    break;
+                }
+            }
+            WriteU32(file, feature->selectedCount, &ok);
+            for (VmbUint32_t s = 0; s < feature->selectedCount; s++)
+            {
+                WriteString(file, feature->selectedFeatures[s], &ok);
+            }
+        }
+    }
+
+    ok = (fclose(file) == 0) && ok;
+    if (!ok)
+    {
+        printf("Could not write the snapshot to \"%s\"\n", path);
+    }
+    return ok ? VmbErrorSuccess : VmbErrorOther;
+}
+
+static void ReadBytes(FILE* file, void* data, size_t size, bool* ok)
+{
+    *ok = *ok && (fread(data, 1, size, file) == size);
+}
+
+static VmbUint32_t ReadU32(FILE* file, bool* ok)
+{
+    unsigned char bytes[4] = { 0 };
+    ReadBytes(file, bytes, sizeof(bytes), ok);
+    VmbUint32_t value = 0;
+    for (int i = 3; i >= 0; i--)
+    {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static VmbUint64_t ReadU64(FILE* file, bool* ok)
+{
+    unsigned char bytes[8] = { 0 };
+    ReadBytes(file, bytes, sizeof(bytes), ok);
+    VmbUint64_t value = 0;
+    for (int i = 7; i >= 0; i--)
+    {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static char* ReadString(FILE* file, bool* ok)
+{
+    VmbUint32_t const length = ReadU32(file, ok);
+    if (!*ok || length > SNAPSHOT_MAX_STRING_LENGTH)
+    {
+        *ok = false;
+        return NULL;
+    }
+    char* const string = VMB_MALLOC_ARRAY(char, (length + 1));
+    if (string == NULL)
+    {
+        *ok = false;
+        return NULL;
+    }
+    ReadBytes(file, string, length, ok);
+    string[length] = '\0';
+    return string;
+}
+
+static bool ReadFeature(FILE* file, SnapshotFeature* feature)
+{
+    bool ok = true;
+    feature->name = ReadString(file, &ok);
+    unsigned char header[2] = { 0 };
+    ReadBytes(file, header, sizeof(header), &ok);
+    feature->type = header[0];
+    feature->flags = header[1];
+    if (ok && (feature->flags & SnapshotFeatureHasValue))
+    {
+        switch (feature->type)
+        {
+        case VmbFeatureDataInt:
+        case VmbFeatureDataBool:
+            feature->intValue = (VmbInt64_t)ReadU64(file, &ok);
+            break;
+        case VmbFeatureDataFloat:
+        {
+            VmbUint64_t const bits = ReadU64(file, &ok);
+            memcpy(&feature->floatValue, &bits, sizeof(bits));
+            break;
+        }
+        default:
+            feature->stringValue = ReadString(file, &ok);
+            break;
+        }
+    }
+
+    VmbUint32_t const selectedCount = ReadU32(file, &ok);
+    if (ok && selectedCount != 0)
+    {
+        feature->selectedFeatures = (selectedCount <= SNAPSHOT_MAX_STRING_LENGTH) ? calloc(selectedCount, sizeof(char*)) : NULL;
+        ok = (feature->selectedFeatures != NULL);
+        for (; ok && feature->selectedCount < selectedCount; ++feature->selectedCount)
+        {
+            feature->selectedFeatures[feature->selectedCount] = ReadString(file, &ok);
+        }
+    }
+    return ok;
+}
+
+VmbError_t FeatureSnapshotLoad(FeatureSnapshot* snapshot, char const* path)
+{
+    snapshot->modules = NULL;
+    snapshot->moduleCount = 0;
+
+    FILE* const file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        printf("Could not open \"%s\" for reading\n", path);
+        return VmbErrorBadParameter;
+    }
+
+    bool ok = true;
+    char magic[sizeof(SNAPSHOT_MAGIC)] = { 0 };
+    ReadBytes(file, magic, sizeof(magic), &ok);
+    ok = ok && memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0 && ReadU32(file, &ok) == SNAPSHOT_VERSION;
+    VmbUint32_t const moduleCount = ReadU32(file, &ok);
+
+    if (ok && moduleCount != 0)
+    {
+        snapshot->modules = calloc(moduleCount, sizeof(SnapshotModule));
+        ok = (snapshot->modules != NULL);
+    }
+    for (; ok && snapshot->moduleCount < moduleCount; ++snapshot->moduleCount)
+    {
+        SnapshotModule* const module = &snapshot->modules[snapshot->moduleCount];
+        unsigned char type = 0;
+        ReadBytes(file, &type, 1, &ok);
+        module->type = (SnapshotModuleType)type;
+        module->id = ReadString(file, &ok);
+        module->streamIndex = ReadU32(file, &ok);
+        VmbUint32_t const featureCount = ReadU32(file, &ok);
+        if (ok && featureCount != 0)
+        {
+            module->features = (featureCount <= SNAPSHOT_MAX_STRING_LENGTH) ? calloc(featureCount, sizeof(SnapshotFeature)) : NULL;
+            ok = (module->features != NULL);
+        }
+        for (; ok && module->featureCount < featureCount; ++module->featureCount)
+        {
+            ok = ReadFeature(file, &module->features[module->featureCount]);
+        }
+    }
+    fclose(file);
+
+    if (!ok)
+    {
+        printf("\"%s\" is not a valid feature snapshot\n", path);
+        FeatureSnapshotFree(snapshot);
+        return VmbErrorInvalidValue;
+    }
+    return VmbErrorSuccess;
+}
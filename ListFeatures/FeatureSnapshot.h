@@ -0,0 +1,171 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef FEATURE_SNAPSHOT_H_
+#define FEATURE_SNAPSHOT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "VmbC/VmbCTypeDefinitions.h"
+
+/**
+ * \brief The kind of module a snapshot of features was taken from
+ */
+typedef enum SnapshotModuleType
+{
+    SnapshotModuleTransportLayer    = 0,
+    SnapshotModuleInterface         = 1,
+    SnapshotModuleRemoteDevice      = 2,
+    SnapshotModuleLocalDevice       = 3,
+    SnapshotModuleStream            = 4,
+} SnapshotModuleType;
+
+/**
+ * \brief Flags stored for every feature of a snapshot
+ */
+typedef enum SnapshotFeatureFlags
+{
+    SnapshotFeatureReadable     = 0x01,
+    SnapshotFeatureWriteable    = 0x02,
+    SnapshotFeatureStreamable   = 0x04,     //!< The feature is meant to be saved and restored
+    SnapshotFeatureVolatile     = 0x08,     //!< The value may change without being written, e.g. a temperature
+    SnapshotFeatureHasValue     = 0x10,     //!< The value could be read
+    SnapshotFeatureLocked       = 0x20,     //!< The feature usually cannot be written while the camera is acquiring
+} SnapshotFeatureFlags;
+
+/**
+ * \brief The value and the properties of a single feature
+ */
+typedef struct SnapshotFeature
+{
+    char*               name;
+    VmbFeatureData_t    type;
+    VmbUint32_t         flags;              //!< Combination of SnapshotFeatureFlags
+    VmbInt64_t          intValue;           //!< Value of int and bool features
+    double              floatValue;
+    char*               stringValue;        //!< Value of enum and string features
+    char**              selectedFeatures;   //!< Names of the features selected by this feature, if it is a selector
+    VmbUint32_t         selectedCount;
+} SnapshotFeature;
+
+/**
+ * \brief The features of a module
+ */
+typedef struct SnapshotModule
+{
+    SnapshotModuleType  type;
+    char*               id;                 //!< Id of the transport layer, interface or camera
+    VmbUint32_t         streamIndex;        //!< Index of the stream for SnapshotModuleStream
+    SnapshotFeature*    features;
+    VmbUint32_t         featureCount;
+} SnapshotModule;
+
+/**
+ * \brief The features of all modules of the system
+ *
+ * Snapshots are stored in a compact binary file:
+ *
+ *   "VMBSNAP" '\0', u32 version, u32 module count, modules
+ *   module:  u8 type, string id, u32 stream index, u32 feature count, features
+ *   feature: string name, u8 type, u8 flags, value, u32 selected count, selected names
+ *   value:   i64 for int and bool features, f64 for float features, string for enum and string features,
+ *            nothing for other types or if the value could not be read
+ *   string:  u32 length, characters without terminating null
+ *
+ * All numbers are stored in little endian byte order.
+ */
+typedef struct FeatureSnapshot
+{
+    SnapshotModule*     modules;
+    VmbUint32_t         moduleCount;
+} FeatureSnapshot;
+
+/**
+ * \brief Counters of a restore operation
+ */
+typedef struct SnapshotRestoreStats
+{
+    VmbUint32_t written;        //!< Features whose value was written
+    VmbUint32_t unchanged;      //!< Features skipped, since they already had the value of the snapshot
+    VmbUint32_t failed;         //!< Features that could not be written
+    VmbUint32_t missing;        //!< Features of the snapshot not provided by the module
+    VmbUint32_t passes;         //!< Number of passes over the features needed
+} SnapshotRestoreStats;
+
+/**
+ * \brief Read all features of a module
+ *
+ * \param[in]  handle   The handle of the module
+ * \param[out] module   The module to fill; type, id and stream index have to be set by the caller
+ */
+VmbError_t SnapshotReadModule(VmbHandle_t handle, SnapshotModule* module);
+
+/**
+ * \brief Write the writeable streamable features of a snapshot to a module
+ *
+ * The features are written in an order respecting their dependencies: Selectors are written before the
+ * features they select and features locked during the acquisition are written before the other features. Features
+ * that already have the value of the snapshot are not written. Writes failing because of dependencies not known
+ * beforehand, e.g. an offset exceeding the maximum for the current size, are retried in further passes as long as
+ * the number of failing writes decreases.
+ *
+ * \param[in]     handle    The handle of the module
+ * \param[in]     module    The features to restore
+ * \param[in,out] stats     The counters incremented
+ */
+VmbError_t SnapshotRestoreModule(VmbHandle_t handle, SnapshotModule const* module, SnapshotRestoreStats* stats);
+
+/**
+ * \brief Take a snapshot of all transport layers, interfaces, cameras and streams
+ *
+ * The cameras are opened in read only mode while their features are read.
+ */
+VmbError_t FeatureSnapshotTake(FeatureSnapshot* snapshot);
+
+/**
+ * \brief Restore the features of all modules of a snapshot present in the system
+ *
+ * The cameras are opened in full access mode while their features are written.
+ */
+VmbError_t FeatureSnapshotRestore(FeatureSnapshot const* snapshot, SnapshotRestoreStats* stats);
+
+VmbError_t FeatureSnapshotSave(FeatureSnapshot const* snapshot, char const* path);
+
+VmbError_t FeatureSnapshotLoad(FeatureSnapshot* snapshot, char const* path);
+
+void FeatureSnapshotFree(FeatureSnapshot* snapshot);
+
+/**
+ * \brief Compare the values of two features
+ *
+ * Features of different types are never equal, features without values are equal, floating point values are equal
+ * within a small relative tolerance.
+ */
+bool SnapshotFeatureValuesEqual(SnapshotFeature const* a, SnapshotFeature const* b);
+
+/**
+ * \brief Format the value of a feature for printing
+ *
+ * \return the result of snprintf
+ */
+int SnapshotFeatureValueToString(SnapshotFeature const* feature, char* buffer, size_t size);
+
+/**
+ * \brief Sort the features of a module by their names using strcmp
+ */
+void SnapshotModuleSortByName(SnapshotModule* module);
+
+/**
+ * \brief Free the features of a module
+ */
+void SnapshotModuleFree(SnapshotModule* module);
+
+/**
+ * \return a printable name of the module type
+ */
+char const* SnapshotModuleTypeToString(SnapshotModuleType type);
+
+#endif
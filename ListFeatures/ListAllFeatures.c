@@ -0,0 +1,329 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ListAllFeatures.h"
+#include "ListFeatures.h"
+
+#include <VmbC/VmbC.h>
+
+#include <VmbCExamplesCommon/ArrayAlloc.h>
+#include <VmbCExamplesCommon/ListCameras.h>
+#include <VmbCExamplesCommon/ListInterfaces.h>
+#include <VmbCExamplesCommon/ListTransportLayers.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/TransportLayerTypeToString.h>
+#include <VmbCExamplesCommon/VmbStdatomic.h>
+#include <VmbCExamplesCommon/VmbThreads.h>
+
+typedef enum ModuleType
+{
+    ModuleTypeTransportLayer,
+    ModuleTypeInterface,
+    ModuleTypeCamera,
+} ModuleType;
+
+/**
+ * \brief A module listed by one of the workers
+ */
+typedef struct ModuleJob
+{
+    ModuleType      type;
+    void const*     info;       //!< VmbTransportLayerInfo_t, VmbInterfaceInfo_t or VmbCameraInfo_t depending on the type
+    FeatureOutput   output;
+    VmbError_t      result;
+    bool            done;       //!< protected by ModuleJobList::mutex
+} ModuleJob;
+
+/**
+ * \brief The modules shared by the workers
+ */
+typedef struct ModuleJobList
+{
+    ModuleJob*              jobs;
+    size_t                  count;
+    atomic_ullong           next;       //!< Index of the next job to be taken by a worker
+    mtx_t                   mutex;
+    cnd_t                   jobDone;
+    VmbFeatureVisibility_t  printedFeatureMaximumVisibility;
+} ModuleJobList;
+
+static void PrintModuleHeader(FeatureOutput* output, char const* title)
+{
+    FeatureOutputPrintf(output, "////////////////////////////////////////\n");
+    FeatureOutputPrintf(output, "/// %s\n", title);
+    FeatureOutputPrintf(output, "////////////////////////////////////////\n\n");
+}
+
+static VmbError_t ListTransportLayerModule(VmbTransportLayerInfo_t const* tl, VmbFeatureVisibility_t visibility, FeatureOutput* output)
+{
+    PrintModuleHeader(output, "Transport layer");
+    FeatureOutputPrintf(output,
+                        "Transport layer id     : %s\n"
+                        "Transport layer model  : %s\n"
+                        "Transport layer name   : %s\n"
+                        "Transport layer path   : %s\n"
+                        "Transport layer type   : %s\n"
+                        "Transport layer vendor : %s\n"
+                        "Transport layer version: %s\n\n",
+                        PrintableString(tl->transportLayerIdString),
+                        PrintableString(tl->transportLayerModelName),
+                        PrintableString(tl->transportLayerName),
+                        PrintableString(tl->transportLayerPath),
+                        TransportLayerTypeToString(tl->transportLayerType),
+                        PrintableString(tl->transportLayerVendor),
+                        PrintableString(tl->transportLayerVersion));
+    return ListFeatures(tl->transportLayerHandle, visibility, output);
+}
+
+static VmbError_t ListInterfaceModule(VmbInterfaceInfo_t const* iFace, VmbFeatureVisibility_t visibility, FeatureOutput* output)
+{
+    PrintModuleHeader(output, "Interface");
+    FeatureOutputPrintf(output,
+                        "Interface id  : %s\n"
+                        "Interface name: %s\n"
+                        "Interface type: %s\n\n",
+                        PrintableString(iFace->interfaceIdString),
+                        PrintableString(iFace->interfaceName),
+                        TransportLayerTypeToString(iFace->interfaceType));
+    return ListFeatures(iFace->interfaceHandle, visibility, output);
+}
+
+/**
+ * \brief list the remote device, local device and stream features of a camera
+ */
+static VmbError_t ListCameraModules(VmbCameraInfo_t const* camera, VmbFeatureVisibility_t visibility, FeatureOutput* output)
+{
+    PrintModuleHeader(output, "Camera");
+
+    VmbHandle_t remoteDeviceHandle = NULL;
+    VmbError_t err = VmbCameraOpen(camera->cameraIdString, VmbAccessModeRead, &remoteDeviceHandle);
+    if (err != VmbErrorSuccess)
+    {
+        FeatureOutputPrintf(output, "Error opening camera %s: %d\n\n", PrintableString(camera->cameraIdString), err);
+        return err;
+    }
+
+    // the handles of the local device and the streams are only available while the camera is open
+    VmbCameraInfo_t cameraInfo;
+    err = VmbCameraInfoQueryByHandle(remoteDeviceHandle, &cameraInfo, sizeof(VmbCameraInfo_t));
+    if (err == VmbErrorSuccess)
+    {
+        FeatureOutputPrintf(output,
+                            "Camera id    : %s\n"
+                            "Camera name  : %s\n"
+                            "Model name   : %s\n"
+                            "Serial string: %s\n\n",
+                            PrintableString(cameraInfo.cameraIdString),
+                            PrintableString(cameraInfo.cameraName),
+                            PrintableString(cameraInfo.modelName),
+                            PrintableString(cameraInfo.serialString));
+
+        FeatureOutputPrintf(output, "/// Remote device features\n\n");
+        err = ListFeatures(remoteDeviceHandle, visibility, output);
+
+        FeatureOutputPrintf(output, "/// Local device features\n\n");
+        ListFeatures(cameraInfo.localDeviceHandle, visibility, output);
+
+        for (VmbUint32_t i = 0; i < cameraInfo.streamCount; i++)
+        {
+            FeatureOutputPrintf(output, "/// Features of stream %u\n\n", i);
+            ListFeatures(cameraInfo.streamHandles[i], visibility, output);
+        }
+    }
+    else
+    {
+        FeatureOutputPrintf(output, "Error retrieving info for the camera %s: %d\n\n", PrintableString(camera->cameraIdString), err);
+    }
+
+    VmbCameraClose(remoteDeviceHandle);
+    return err;
+}
+
+/**
+ * \brief Worker taking the modules from the list until all modules are taken
+ */
+static int ModuleWorker(void* arg)
+{
+    ModuleJobList* const list = (ModuleJobList*)arg;
+
+    for (;;)
+    {
+        size_t const index = (size_t)atomic_fetch_add(&list->next, 1);
+        if (index >= list->count)
+        {
+            return 0;
+        }
+
+        ModuleJob* const job = &list->jobs[index];
+        switch (job->type)
+        {
+        case ModuleTypeTransportLayer:
+            job->result = ListTransportLayerModule((VmbTransportLayerInfo_t const*)job->info, list->printedFeatureMaximumVisibility, &job->output);
+            break;
+        case ModuleTypeInterface:
+            job->result = ListInterfaceModule((VmbInterfaceInfo_t const*)job->info, list->printedFeatureMaximumVisibility, &job->output);
+            break;
+        case ModuleTypeCamera:
+        default:
+            job->result = ListCameraModules((VmbCameraInfo_t const*)job->info, list->printedFeatureMaximumVisibility, &job->output);
+            break;
+        }
+
+        mtx_lock(&list->mutex);
+        job->done = true;
+        cnd_broadcast(&list->jobDone);
+        mtx_unlock(&list->mutex);
+    }
+}
+
+/**
+ * \brief Run the workers and print the output of the modules in order
+ *
+ * \return the number of modules that could not be listed
+ */
+static size_t RunModuleJobs(ModuleJobList* list, size_t threadCount)
+{
+    thrd_t threads[LIST_ALL_FEATURES_MAX_THREADS];
+    size_t startedThreads = 0;
+    while (startedThreads < threadCount && thrd_create(&threads[startedThreads], ModuleWorker, list) == thrd_success)
+    {
+        ++startedThreads;
+    }
+    if (startedThreads == 0)
+    {
+        // list the modules in this thread instead
+        ModuleWorker(list);
+    }
+
+    size_t failedCount = 0;
+    for (size_t i = 0; i < list->count; i++)
+    {
+        ModuleJob* const job = &list->jobs[i];
+
+        mtx_lock(&list->mutex);
+        while (!job->done)
+        {
+            cnd_wait(&list->jobDone, &list->mutex);
+        }
+        mtx_unlock(&list->mutex);
+
+        FeatureOutputWrite(&job->output);
+        FeatureOutputFree(&job->output);
+        failedCount += (job->result != VmbErrorSuccess) ? 1 : 0;
+    }
+
+    for (size_t i = 0; i < startedThreads; i++)
+    {
+        thrd_join(threads[i], NULL);
+    }
+    return failedCount;
+}
+
+int ListAllFeatures(VmbFeatureVisibility_t printedFeatureMaximumVisibility, size_t threadCount)
+{
+    VmbError_t err = StartApi();
+    if (err != VmbErrorSuccess)
+    {
+        printf("Could not start the API: %d\n", err);
+        return 1;
+    }
+
+    VmbUint64_t const startNs = GetMonotonicTimeNs();
+
+    VmbTransportLayerInfo_t* tls = NULL;
+    VmbUint32_t tlCount = 0;
+    VmbInterfaceInfo_t* interfaces = NULL;
+    VmbUint32_t interfaceCount = 0;
+    VmbCameraInfo_t* cameras = NULL;
+    VmbUint32_t cameraCount = 0;
+
+    // an empty system is no error; the report just does not contain these modules
+    if (ListTransportLayers(&tls, &tlCount) != VmbErrorSuccess)
+    {
+        tlCount = 0;
+    }
+    if (ListInterfaces(&interfaces, &interfaceCount) != VmbErrorSuccess)
+    {
+        interfaceCount = 0;
+    }
+    if (ListCameras(&cameras, &cameraCount) != VmbErrorSuccess)
+    {
+        cameraCount = 0;
+    }
+
+    ModuleJobList list;
+    list.count = (size_t)tlCount + interfaceCount + cameraCount;
+    list.jobs = VMB_MALLOC_ARRAY(ModuleJob, (list.count + 1));
+    list.printedFeatureMaximumVisibility = printedFeatureMaximumVisibility;
+    atomic_store(&list.next, 0);
+
+    size_t failedCount = 0;
+    if (list.jobs != NULL
+        && mtx_init(&list.mutex, mtx_plain) == thrd_success)
+    {
+        if (cnd_init(&list.jobDone) == thrd_success)
+        {
+            size_t jobCount = 0;
+            for (VmbUint32_t i = 0; i < tlCount; i++)
+            {
+                ModuleJob const job = { ModuleTypeTransportLayer, tls + i };
+                list.jobs[jobCount++] = job;
+            }
+            for (VmbUint32_t i = 0; i < interfaceCount; i++)
+            {
+                ModuleJob const job = { ModuleTypeInterface, interfaces + i };
+                list.jobs[jobCount++] = job;
+            }
+            for (VmbUint32_t i = 0; i < cameraCount; i++)
+            {
+                ModuleJob const job = { ModuleTypeCamera, cameras + i };
+                list.jobs[jobCount++] = job;
+            }
+
+            if (threadCount == 0)
+            {
+                threadCount = LIST_ALL_FEATURES_DEFAULT_THREADS;
+            }
+            if (threadCount > LIST_ALL_FEATURES_MAX_THREADS)
+            {
+                threadCount = LIST_ALL_FEATURES_MAX_THREADS;
+            }
+            if (threadCount > list.count)
+            {
+                threadCount = list.count;
+            }
+
+            failedCount = RunModuleJobs(&list, threadCount);
+
+            // the timing is not part of the report, so the report can be compared between runs
+            fprintf(stderr, "Listed %u transport layers, %u interfaces and %u cameras using %zu threads in %.1f ms\n",
+                    tlCount, interfaceCount, cameraCount, threadCount, (GetMonotonicTimeNs() - startNs) / 1e6);
+
+            cnd_destroy(&list.jobDone);
+        }
+        else
+        {
+            err = VmbErrorResources;
+        }
+        mtx_destroy(&list.mutex);
+    }
+    else
+    {
+        printf("Could not prepare the module list.\n");
+        err = VmbErrorResources;
+    }
+
+    free(list.jobs);
+    free(cameras);
+    free(interfaces);
+    free(tls);
+    VmbShutdown();
+
+    return (err == VmbErrorSuccess && failedCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+/*=============================================================================
+  Copyright (C) 2023 Allied Vision Technologies. All Rights Reserved.
+  Subject to the BSD 3-Clause License.
+=============================================================================*/
+
+#ifndef LIST_ALL_FEATURES_H_
+#define LIST_ALL_FEATURES_H_
+
+#include <stddef.h>
+
+#include "VmbC/VmbCTypeDefinitions.h"
+
+#define LIST_ALL_FEATURES_DEFAULT_THREADS   8
+#define LIST_ALL_FEATURES_MAX_THREADS       64
+
+/**
+ * \brief list the features of all transport layers, interfaces, cameras and streams
+ *
+ * The modules are listed by a pool of worker threads. Every worker takes the next module from the list and writes
+ * its features to a buffer of the module. The features of a camera, i.e. of its remote and local device and its
+ * streams, are listed by a single worker, since they are only accessible while the camera is open. The buffers are
+ * printed in the order of the modules as soon as they are complete, so the output does not depend on the number of
+ * threads or their timing.
+ *
+ * \param[in] printedFeatureMaximumVisibility   the maximum visibility of features to be printed
+ * \param[in] threadCount                       the number of worker threads; 0 for a default
+ *
+ * \return a code to return from main()
+ */
+int ListAllFeatures(VmbFeatureVisibility_t printedFeatureMaximumVisibility, size_t threadCount);
+
+#endif
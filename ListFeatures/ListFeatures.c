@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "FeatureSnapshot.h"
 #include "ListFeatures.h"
 
 #include <VmbC/VmbC.h>
@@ -15,22 +16,39 @@
 #include <VmbCExamplesCommon/ListCameras.h>
 #include <VmbCExamplesCommon/ListInterfaces.h>
 #include <VmbCExamplesCommon/ListTransportLayers.h>
+#include <VmbCExamplesCommon/MonotonicTime.h>
+#include <VmbCExamplesCommon/TimedStartup.h>
 #include <VmbCExamplesCommon/TransportLayerTypeToString.h>
 
-/**
- * \return \p string or an empty string, if \p string is null
- */
+static char const* g_transportLayerFilter = NULL;   // set once while parsing the command line
+
 char const* PrintableString(char const* string)
 {
     return string == NULL ? "" : string;
 }
 
-/**
- * Prints out all features and their values and details of a given handle.
- *
- * \param[in] moduleHandle The handle to print the features for
- */
-VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t printedFeatureMaximumVisibility)
+void SetTransportLayerFilter(char const* transportLayerFilter)
+{
+    g_transportLayerFilter = transportLayerFilter;
+}
+
+VmbError_t StartApi(void)
+{
+    return TimedStartup(g_transportLayerFilter, NULL);
+}
+
+char const* ResolveCameraId(char const* camera, VmbCameraInfo_t const* cameras, VmbUint32_t cameraCount)
+{
+    char* end = NULL;
+    unsigned long const index = strtoul(camera, &end, 10);
+    if (*camera != '\0' && *end == '\0' && index < cameraCount)
+    {
+        return cameras[index].cameraIdString;
+    }
+    return camera;
+}
+
+VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t printedFeatureMaximumVisibility, FeatureOutput* output)
 {
     VmbUint32_t featureCount = 0;
 
@@ -70,21 +88,21 @@ VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t p
                         // ignore feature with visibility that shouldn't be printed
                         continue;
                     }
-                    printf("/// Feature Name: %s\n", PrintableString(feature->name));
-                    printf("/// Display Name: %s\n", PrintableString(feature->displayName));
-                    printf("/// Tooltip: %s\n", PrintableString(feature->tooltip));
-                    printf("/// Description: %s\n", PrintableString(feature->description));
-                    printf("/// SNFC Namespace: %s\n", PrintableString(feature->sfncNamespace));
-                    printf("/// Value: ");
+                    FeatureOutputPrintf(output, "/// Feature Name: %s\n", PrintableString(feature->name));
+                    FeatureOutputPrintf(output, "/// Display Name: %s\n", PrintableString(feature->displayName));
+                    FeatureOutputPrintf(output, "/// Tooltip: %s\n", PrintableString(feature->tooltip));
+                    FeatureOutputPrintf(output, "/// Description: %s\n", PrintableString(feature->description));
+                    FeatureOutputPrintf(output, "/// SNFC Namespace: %s\n", PrintableString(feature->sfncNamespace));
+                    FeatureOutputPrintf(output, "/// Value: ");
 
                     VmbBool_t readable;
                     if (VmbFeatureAccessQuery(moduleHandle, feature->name, &readable, NULL) != VmbErrorSuccess)
                     {
-                        printf("Unable to determine, if the feature is readable\n");
+                        FeatureOutputPrintf(output, "Unable to determine, if the feature is readable\n");
                     }
                     else if (!readable)
                     {
-                        printf("The feature is not readable\n");
+                        FeatureOutputPrintf(output, "The feature is not readable\n");
                     }
                     else
                     {
@@ -96,7 +114,7 @@ VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t p
                             err = VmbFeatureBoolGet(moduleHandle, feature->name, &value);
                             if (VmbErrorSuccess == err)
                             {
-                                printf("%d\n", value);
+                                FeatureOutputPrintf(output, "%d\n", value);
                             }
                             break;
                         }
@@ -106,7 +124,7 @@ VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t p
                             err = VmbFeatureEnumGet(moduleHandle, feature->name, &value);
                             if (VmbErrorSuccess == err)
                             {
-                                printf("%s\n", value);
+                                FeatureOutputPrintf(output, "%s\n", value);
                             }
                             break;
                         }
@@ -116,7 +134,7 @@ VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t p
                             err = VmbFeatureFloatGet(moduleHandle, feature->name, &value);
                             if (err == VmbErrorSuccess)
                             {
-                                printf("%f\n", value);
+                                FeatureOutputPrintf(output, "%f\n", value);
                             }
                             break;
                         }
@@ -126,7 +144,7 @@ VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t p
                             err = VmbFeatureIntGet(moduleHandle, feature->name, &value);
                             if (err == VmbErrorSuccess)
                             {
-                                printf("%lld\n", value);
+                                FeatureOutputPrintf(output, "%lld\n", value);
                             }
                             break;
                         }
@@ -152,29 +170,29 @@ VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t p
                                     err = VmbFeatureStringGet(moduleHandle, feature->name, stringBuffer, size, &size);
                                     if (VmbErrorSuccess == err)
                                     {
-                                        printf("%s\n", stringBuffer);
+                                        FeatureOutputPrintf(output, "%s\n", stringBuffer);
                                     }
                                 }
                                 else
                                 {
-                                    printf("Could not allocate sufficient memory for string.\n");
+                                    FeatureOutputPrintf(output, "Could not allocate sufficient memory for string.\n");
                                 }
                             }
                             break;
                         }
                         case VmbFeatureDataCommand:
                         default:
-                            printf("[None]\n");
+                            FeatureOutputPrintf(output, "[None]\n");
                             break;
                         }
                     }
 
                     if (VmbErrorSuccess != err)
                     {
-                        printf("Could not get feature value. Error code: %s\n", ErrorCodeToMessage(err));
+                        FeatureOutputPrintf(output, "Could not get feature value. Error code: %s\n", ErrorCodeToMessage(err));
                     }
 
-                    printf("\n");
+                    FeatureOutputPrintf(output, "\n");
                 }
 
                 free(stringBuffer);
@@ -182,27 +200,27 @@ VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t p
             }
             else
             {
-                printf("Could not get features. Error code: %d\n", err);
+                FeatureOutputPrintf(output, "Could not get features. Error code: %d\n", err);
             }
 
             free(features);
         }
         else
         {
-            printf("Could not allocate feature list.\n");
+            FeatureOutputPrintf(output, "Could not allocate feature list.\n");
             err = VmbErrorResources;
         }
     }
     else
     {
-        printf("Could not get features or the module does not provide any. Error code: %d\n", err);
+        FeatureOutputPrintf(output, "Could not get features or the module does not provide any. Error code: %d\n", err);
     }
     return VmbErrorSuccess;
 }
 
 int ListTransportLayerFeatures(size_t tlIndex, VmbFeatureVisibility_t printedFeatureMaximumVisibility)
 {
-    VmbError_t err = VmbStartup(NULL);
+    VmbError_t err = StartApi();
     if (err == VmbErrorSuccess)
     {
         VmbUint32_t count = 0;
@@ -233,7 +251,7 @@ int ListTransportLayerFeatures(size_t tlIndex, VmbFeatureVisibility_t printedFea
                     PrintableString(tl->transportLayerVendor),
                     PrintableString(tl->transportLayerVersion));
 
-            err = ListFeatures(tl->transportLayerHandle, printedFeatureMaximumVisibility);
+            err = ListFeatures(tl->transportLayerHandle, printedFeatureMaximumVisibility, NULL);
             free(tls);
         }
         else
@@ -248,7 +266,7 @@ int ListTransportLayerFeatures(size_t tlIndex, VmbFeatureVisibility_t printedFea
 
 int ListInterfaceFeatures(size_t interfaceIndex, VmbFeatureVisibility_t printedFeatureMaximumVisibility)
 {
-    VmbError_t err = VmbStartup(NULL);
+    VmbError_t err = StartApi();
     if (err == VmbErrorSuccess)
     {
         VmbUint32_t count = 0;
@@ -268,7 +286,7 @@ int ListInterfaceFeatures(size_t interfaceIndex, VmbFeatureVisibility_t printedF
                     PrintableString(iFace->interfaceIdString),
                     PrintableString(iFace->interfaceName),
                     TransportLayerTypeToString(iFace->interfaceType));
-            err = ListFeatures(iFace->interfaceHandle, printedFeatureMaximumVisibility);
+            err = ListFeatures(iFace->interfaceHandle, printedFeatureMaximumVisibility, NULL);
             free(interfaces);
         }
         else if (count == 0)
@@ -330,7 +348,7 @@ VmbError_t ListCameraRelatedFeatures(char const* cameraId, FeatureModuleExtracto
             VmbHandle_t handle = featureExtractor(remoteDeviceHandle, &cameraInfo, featureExtractorParam);
             if (handle != NULL)
             {
-                err = ListFeatures(handle, printedFeatureMaximumVisibility);
+                err = ListFeatures(handle, printedFeatureMaximumVisibility, NULL);
             }
             else
             {
@@ -354,7 +372,7 @@ VmbError_t ListCameraRelatedFeatures(char const* cameraId, FeatureModuleExtracto
 int ListCameraFeaturesAtIndex(size_t index, bool remoteDevice, VmbFeatureVisibility_t printedFeatureMaximumVisibility)
 {
     printf("Printing %s features of the camera at index %zu\n\n", remoteDevice ? "remote device" : "local device", index);
-    VmbError_t err = VmbStartup(NULL);
+    VmbError_t err = StartApi();
     if (err == VmbErrorSuccess)
     {
         VmbUint32_t cameraCount = 0;
@@ -375,7 +393,7 @@ int ListCameraFeaturesAtIndex(size_t index, bool remoteDevice, VmbFeatureVisibil
 int ListCameraFeaturesAtId(char const* id, bool remoteDevice, VmbFeatureVisibility_t printedFeatureMaximumVisibility)
 {
     printf("Printing %s features of the camera with id %s\n\n", remoteDevice ? "remote device" : "local device", id);
-    VmbError_t err = VmbStartup(NULL);
+    VmbError_t err = StartApi();
     if (err == VmbErrorSuccess)
     {
         err = ListCameraRelatedFeatures(id, &CameraModuleExtractor, remoteDevice ? 1 : 0, printedFeatureMaximumVisibility);
@@ -403,7 +421,7 @@ VmbHandle_t StreamModuleExtractor(VmbHandle_t remoteDevice, VmbCameraInfo_t* cam
 int ListStreamFeaturesAtIndex(size_t cameraIndex, size_t streamIndex, VmbFeatureVisibility_t printedFeatureMaximumVisibility)
 {
     printf("Printing features of stream %zu of the camera at index %zu\n\n", streamIndex, cameraIndex);
-    VmbError_t err = VmbStartup(NULL);
+    VmbError_t err = StartApi();
     if (err == VmbErrorSuccess)
     {
         VmbUint32_t cameraCount = 0;
@@ -425,7 +443,7 @@ int ListStreamFeaturesAtId(char const* cameraId, size_t streamIndex, VmbFeatureV
 {
     printf("Printing features of stream %zu of the camera with id %s\n\n", streamIndex, cameraId);
 
-    VmbError_t err = VmbStartup(NULL);
+    VmbError_t err = StartApi();
     if (err == VmbErrorSuccess)
     {
         err = ListCameraRelatedFeatures(cameraId, &StreamModuleExtractor, streamIndex, printedFeatureMaximumVisibility);
@@ -433,3 +451,60 @@ int ListStreamFeaturesAtId(char const* cameraId, size_t streamIndex, VmbFeatureV
     }
     return (err == VmbErrorSuccess ? 0 : 1);
 }
+
+int ExportFeatureSnapshot(char const* path)
+{
+    VmbError_t err = StartApi();
+    if (err == VmbErrorSuccess)
+    {
+        VmbUint64_t const startNs = GetMonotonicTimeNs();
+
+        FeatureSnapshot snapshot;
+        err = FeatureSnapshotTake(&snapshot);
+        if (err == VmbErrorSuccess)
+        {
+            err = FeatureSnapshotSave(&snapshot, path);
+            if (err == VmbErrorSuccess)
+            {
+                size_t featureCount = 0;
+                for (VmbUint32_t i = 0; i < snapshot.moduleCount; i++)
+                {
+                    featureCount += snapshot.modules[i].featureCount;
+                }
+                printf("Saved %zu features of %u modules to \"%s\" in %.1f ms\n",
+                       featureCount, snapshot.moduleCount, path, (GetMonotonicTimeNs() - startNs) / 1e6);
+            }
+            FeatureSnapshotFree(&snapshot);
+        }
+        else
+        {
+            printf("Could not take the snapshot. Error code: %d\n", err);
+        }
+        VmbShutdown();
+    }
+    return (err == VmbErrorSuccess ? 0 : 1);
+}
+
+int RestoreFeatureSnapshot(char const* path)
+{
+    FeatureSnapshot snapshot;
+    VmbError_t err = FeatureSnapshotLoad(&snapshot, path);
+    if (err != VmbErrorSuccess)
+    {
+        return 1;
+    }
+
+    err = StartApi();
+    if (err == VmbErrorSuccess)
+    {
+        VmbUint64_t const startNs = GetMonotonicTimeNs();
+        SnapshotRestoreStats stats = { 0 };
+        err = FeatureSnapshotRestore(&snapshot, &stats);
+        printf("Restored %u modules in %.1f ms: %u features written, %u already up to date, %u failed, %u missing; %u passes\n",
+               snapshot.moduleCount, (GetMonotonicTimeNs() - startNs) / 1e6,
+               stats.written, stats.unchanged, stats.failed, stats.missing, stats.passes);
+        VmbShutdown();
+    }
+    FeatureSnapshotFree(&snapshot);
+    return (err == VmbErrorSuccess ? 0 : 1);
+}
@@ -11,6 +11,41 @@
 
 #include "VmbC/VmbCTypeDefinitions.h"
 
+#include "FeatureOutput.h"
+
+/**
+ * \return \p string or an empty string, if \p string is null
+ */
+char const* PrintableString(char const* string);
+
+/**
+ * \brief select the transport layers loaded by StartApi
+ *
+ * \param[in] transportLayerFilter  a filter for ParseTransportLayerFilter; NULL for all transport layers
+ */
+void SetTransportLayerFilter(char const* transportLayerFilter);
+
+/**
+ * \brief start the API with the transport layers selected by SetTransportLayerFilter
+ */
+VmbError_t StartApi(void);
+
+/**
+ * \brief interpret a command line parameter as camera index or camera id
+ *
+ * \return the id of the camera at the index given by \p camera or \p camera itself, if it is no valid index
+ */
+char const* ResolveCameraId(char const* camera, VmbCameraInfo_t const* cameras, VmbUint32_t cameraCount);
+
+/**
+ * Prints out all features and their values and details of a given handle.
+ *
+ * \param[in] moduleHandle                      The handle to print the features for
+ * \param[in] printedFeatureMaximumVisibility   the maximum visibility of features to be printed
+ * \param[in] output                            the buffer the text is written to; NULL for stdout
+ */
+VmbError_t ListFeatures(VmbHandle_t const moduleHandle, VmbFeatureVisibility_t printedFeatureMaximumVisibility, FeatureOutput* output);
+
 /**
  * \brief list the features of a transport layer at a given index
  *
@@ -74,4 +109,22 @@ int ListStreamFeaturesAtIndex(size_t cameraIndex, size_t streamIndex, VmbFeature
  */
 int ListStreamFeaturesAtId(char const* cameraId, size_t streamIndex, VmbFeatureVisibility_t printedFeatureMaximumVisibility);
 
+/**
+ * \brief write a snapshot of the features of all modules to a file
+ *
+ * \param[in] path  the file to write
+ *
+ * \return a code to return from main()
+ */
+int ExportFeatureSnapshot(char const* path);
+
+/**
+ * \brief apply a snapshot written by ExportFeatureSnapshot to the modules of the system
+ *
+ * \param[in] path  the file to read
+ *
+ * \return a code to return from main()
+ */
+int RestoreFeatureSnapshot(char const* path);
+
 #endif
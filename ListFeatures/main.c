@@ -14,6 +14,10 @@
 
 #include <VmbCExamplesCommon/PrintVmbVersion.h>
 
+#include "FeatureDiff.h"
+#include "FeatureGraph.h"
+#include "FeatureProfiler.h"
+#include "ListAllFeatures.h"
 #include "ListFeatures.h"
 
 #define VMB_PARAM_TL                    "/t"
@@ -21,7 +25,17 @@
 #define VMB_PARAM_REMOTE_DEVICE         "/c"
 #define VMB_PARAM_LOCAL_DEVICE          "/l"
 #define VMB_PARAM_FEATURE_VISIBILITY    "/v"
+#define VMB_PARAM_TRANSPORT_LAYERS      "/tl"
 #define VMB_PARAM_STREAM                "/s"
+#define VMB_PARAM_ALL                   "/a"
+#define VMB_PARAM_ALL_LONG              "--all"
+#define VMB_PARAM_EXPORT                "/x"
+#define VMB_PARAM_RESTORE               "/r"
+#define VMB_PARAM_DIFF                  "/d"
+#define VMB_PARAM_WATCH                 "/w"
+#define VMB_PARAM_PROFILE               "/p"
+#define VMB_PARAM_PROFILE_WRITE         "/pw"
+#define VMB_PARAM_GRAPH                 "/g"
 #define VMB_PARAM_USAGE                 "/?"
 
 typedef struct VisibilityOption
@@ -112,8 +126,27 @@ void PrintUsage(void)
            "  ListFeatures <Options> %s (CameraIndex | CameraId)                 Show the remote device features of the specified camera\n"
            "  ListFeatures <Options> %s (CameraIndex | CameraId)                 Show the local device features of the specified camera\n"
            "  ListFeatures <Options> %s (CameraIndex | CameraId) [StreamIndex]   Show the features of a stream for the specified camera\n"
+           "  ListFeatures <Options> %s [ThreadCount]                            Show the features of all modules, listed by up to\n"
+           "                                                                     ThreadCount threads (default %d); %s is accepted as well\n"
+           "  ListFeatures %s SnapshotFile                                       Save the features of all modules to a binary snapshot\n"
+           "  ListFeatures %s SnapshotFile                                       Write the features of a snapshot back to the modules\n"
+           "  ListFeatures %s [(CameraIndex | CameraId) ...]                     Compare the remote device features of the cameras with\n"
+           "                                                                     the first camera; all cameras, if none are specified\n"
+           "  ListFeatures %s (CameraIndex | CameraId) [DurationS]               Print the changes of the remote device features\n"
+           "                                                                     of a camera until enter is pressed or for DurationS seconds\n"
+           "  ListFeatures <Options> %s (CameraIndex | CameraId) [Repetitions] [CsvFile]\n"
+           "                                                                     Measure the read latency of the remote device features;\n"
+           "                                                                     each feature is read Repetitions times (default %d)\n"
+           "  ListFeatures <Options> %s (CameraIndex | CameraId) [Repetitions] [CsvFile]\n"
+           "                                                                     Measure the read latency and the latency of writing the\n"
+           "                                                                     value read back; opens the camera in full access mode\n"
+           "  ListFeatures %s (CameraIndex | CameraId) [GraphFile]               Print the order to write the selectors and the selected\n"
+           "                                                                     features in and save their graph as JSON (.json) or DOT\n"
            "Options:\n",
-           VMB_PARAM_USAGE, VMB_PARAM_TL, VMB_PARAM_INTERFACE, VMB_PARAM_REMOTE_DEVICE, VMB_PARAM_LOCAL_DEVICE, VMB_PARAM_STREAM);
+           VMB_PARAM_USAGE, VMB_PARAM_TL, VMB_PARAM_INTERFACE, VMB_PARAM_REMOTE_DEVICE, VMB_PARAM_LOCAL_DEVICE, VMB_PARAM_STREAM,
+           VMB_PARAM_ALL, LIST_ALL_FEATURES_DEFAULT_THREADS, VMB_PARAM_ALL_LONG, VMB_PARAM_EXPORT, VMB_PARAM_RESTORE,
+           VMB_PARAM_DIFF, VMB_PARAM_WATCH, VMB_PARAM_PROFILE, FEATURE_PROFILER_DEFAULT_REPETITIONS, VMB_PARAM_PROFILE_WRITE,
+           VMB_PARAM_GRAPH);
 
     // print options for visibility
     printf("  %s (", VMB_PARAM_FEATURE_VISIBILITY);
@@ -138,6 +171,9 @@ void PrintUsage(void)
                toupper(*(option->m_fullName)), option->m_fullName + 1
         );
     }
+    printf("  %s <filter>  Load only the transport layers of a comma separated list of types and paths,\n"
+           "                e.g. GigE,USB or /opt/VimbaX/cti/VimbaUSBTL.cti; applies to all commands\n",
+           VMB_PARAM_TRANSPORT_LAYERS);
 }
 
 /**
@@ -172,10 +208,23 @@ int main(int argc, char* argv[])
 
     VmbFeatureVisibility_t printedFeatureMaximumVisibility = VmbFeatureVisibilityGuru;
 
-    // parse visibility (optional parameter)
-    if (argc >= 2)
+    // parse the visibility and the transport layer filter (optional parameters)
+    while (argc >= 2)
     {
-        if (strcmp(argv[1], VMB_PARAM_FEATURE_VISIBILITY) == 0)
+        if (strcmp(argv[1], VMB_PARAM_TRANSPORT_LAYERS) == 0)
+        {
+            if (argc == 2)
+            {
+                printf("the value of the %s command line option is missing\n", VMB_PARAM_TRANSPORT_LAYERS);
+                PrintUsage();
+                return 1;
+            }
+            SetTransportLayerFilter(argv[2]);
+
+            argc -= 2;
+            argv += 2;
+        }
+        else if (strcmp(argv[1], VMB_PARAM_FEATURE_VISIBILITY) == 0)
         {
             if (argc == 2)
             {
@@ -205,6 +254,10 @@ int main(int argc, char* argv[])
             argc -= 2;
             argv += 2;
         }
+        else
+        {
+            break;
+        }
     }
 
     if(argc < 2)
@@ -309,6 +362,102 @@ int main(int argc, char* argv[])
                 }
             }
         }
+        else if (strcmp(moduleCommand, VMB_PARAM_ALL) == 0
+                 || strcmp(moduleCommand, VMB_PARAM_ALL_LONG) == 0)
+        {
+            unsigned long threadCount = 0;
+            if (argc >= 3)
+            {
+                char* end = argv[2];
+                threadCount = strtoul(argv[2], &end, 10);
+                if (*end != '\0' || threadCount == 0 || threadCount > LIST_ALL_FEATURES_MAX_THREADS)
+                {
+                    printf("the number of threads needs to be between 1 and %d, but found %s\n", LIST_ALL_FEATURES_MAX_THREADS, argv[2]);
+                    return 1;
+                }
+            }
+            return ListAllFeatures(printedFeatureMaximumVisibility, threadCount);
+        }
+        else if (strcmp(moduleCommand, VMB_PARAM_EXPORT) == 0
+                 || strcmp(moduleCommand, VMB_PARAM_RESTORE) == 0)
+        {
+            if (argc < 3)
+            {
+                printf("the snapshot file is missing but required for option %s\n", moduleCommand);
+            }
+            else
+            {
+                return (strcmp(moduleCommand, VMB_PARAM_EXPORT) == 0) ? ExportFeatureSnapshot(argv[2]) : RestoreFeatureSnapshot(argv[2]);
+            }
+        }
+        else if (strcmp(moduleCommand, VMB_PARAM_DIFF) == 0)
+        {
+            if (argc == 3)
+            {
+                printf("at least two cameras are required for option %s\n", VMB_PARAM_DIFF);
+            }
+            else
+            {
+                return DiffCameraFeatures((argc > 2) ? (char const* const*)(argv + 2) : NULL, (size_t)(argc - 2));
+            }
+        }
+        else if (strcmp(moduleCommand, VMB_PARAM_WATCH) == 0)
+        {
+            if (argc < 3)
+            {
+                printf("watching features requires the index or the id of the camera to be provided\n");
+            }
+            else
+            {
+                unsigned long durationS = 0;
+                if (argc >= 4)
+                {
+                    char* end = argv[3];
+                    durationS = strtoul(argv[3], &end, 10);
+                    if (*end != '\0')
+                    {
+                        printf("the duration needs to be a number of seconds, but found %s\n", argv[3]);
+                        return 1;
+                    }
+                }
+                return WatchCameraFeatures(argv[2], durationS);
+            }
+        }
+        else if (strcmp(moduleCommand, VMB_PARAM_PROFILE) == 0
+                 || strcmp(moduleCommand, VMB_PARAM_PROFILE_WRITE) == 0)
+        {
+            if (argc < 3)
+            {
+                printf("profiling features requires the index or the id of the camera to be provided\n");
+            }
+            else
+            {
+                unsigned long repetitions = 0;
+                if (argc >= 4)
+                {
+                    char* end = argv[3];
+                    repetitions = strtoul(argv[3], &end, 10);
+                    if (*end != '\0' || repetitions == 0 || repetitions > FEATURE_PROFILER_MAX_REPETITIONS)
+                    {
+                        printf("the number of repetitions needs to be between 1 and %d, but found %s\n", FEATURE_PROFILER_MAX_REPETITIONS, argv[3]);
+                        return 1;
+                    }
+                }
+                return ProfileCameraFeatures(argv[2], printedFeatureMaximumVisibility, repetitions,
+                                             strcmp(moduleCommand, VMB_PARAM_PROFILE_WRITE) == 0, (argc >= 5) ? argv[4] : NULL);
+            }
+        }
+        else if (strcmp(moduleCommand, VMB_PARAM_GRAPH) == 0)
+        {
+            if (argc < 3)
+            {
+                printf("the feature graph requires the index or the id of the camera to be provided\n");
+            }
+            else
+            {
+                return ExportFeatureGraph(argv[2], (argc >= 4) ? argv[3] : NULL, 0);
+            }
+        }
         else if(strcmp(moduleCommand, VMB_PARAM_USAGE) == 0)
         {
             PrintUsage();